@@ -19,7 +19,8 @@ public class MRUtilityKit : ModuleRules
 			{
 				"Core",
 				"RenderCore",
-				"Projects"
+				"Projects",
+				"OculusXRHMD",
 			});
 
 
@@ -40,7 +41,6 @@ public class MRUtilityKit : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
-				"OculusXRHMD",
 				"OculusXRAnchors",
 				"OculusXRScene",
 				"Json",
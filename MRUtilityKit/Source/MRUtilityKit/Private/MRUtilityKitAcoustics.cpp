@@ -0,0 +1,168 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#include "MRUtilityKitAcoustics.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitAnchor.h"
+#include "MRUtilityKitBPLibrary.h"
+
+namespace
+{
+	double ComputePolygonArea(const TArray<FVector2D>& Polygon)
+	{
+		double Area = 0.0;
+		for (int32 I = 0; I < Polygon.Num(); ++I)
+		{
+			const FVector2D& A = Polygon[I];
+			const FVector2D& B = Polygon[(I + 1) % Polygon.Num()];
+			Area += A.X * B.Y - B.X * A.Y;
+		}
+		return FMath::Abs(Area) * 0.5;
+	}
+} // namespace
+
+double FMRUKAcousticAbsorption::GetCoefficient(EMRUKAcousticSurface Surface) const
+{
+	switch (Surface)
+	{
+		case EMRUKAcousticSurface::Floor:
+			return Floor;
+		case EMRUKAcousticSurface::Ceiling:
+			return Ceiling;
+		case EMRUKAcousticSurface::Wall:
+			return Wall;
+		case EMRUKAcousticSurface::Window:
+			return Window;
+		case EMRUKAcousticSurface::Opening:
+			return Opening;
+		case EMRUKAcousticSurface::SoftFurnishing:
+			return SoftFurnishing;
+		case EMRUKAcousticSurface::HardFurnishing:
+			return HardFurnishing;
+	}
+	return 0.0;
+}
+
+double FMRUKRoomAcousticProfile::GetSurfaceArea(EMRUKAcousticSurface Surface) const
+{
+	const double* Area = SurfaceAreas.Find(Surface);
+	return Area ? *Area : 0.0;
+}
+
+FMRUKRoomAcousticProfile MRUKComputeRoomAcousticProfile(const AMRUKRoom& Room, const FMRUKAcousticAbsorption& Absorption, double WorldToMeters, double SpeedOfSound)
+{
+	FMRUKRoomAcousticProfile Profile;
+
+	const AMRUKAnchor* Floor = Room.FloorAnchor;
+	const AMRUKAnchor* Ceiling = Room.CeilingAnchor;
+	if (!Floor || !Ceiling || WorldToMeters <= 0.0)
+	{
+		return Profile;
+	}
+
+	const double AreaScale = 1.0 / (WorldToMeters * WorldToMeters);
+	double Areas[(int32)EMRUKAcousticSurface::HardFurnishing + 1] = {};
+	double FurnitureVolume = 0.0;
+	double FrameArea = 0.0;
+	double InvisibleWallArea = 0.0;
+
+	for (const AMRUKAnchor* Anchor : Room.AllAnchors)
+	{
+		if (!Anchor)
+		{
+			continue;
+		}
+
+		const double PlaneArea = ComputePolygonArea(Anchor->PlaneBoundary2D) * AreaScale;
+		if (Anchor->HasLabel(FMRUKLabels::Floor))
+		{
+			Areas[(int32)EMRUKAcousticSurface::Floor] += PlaneArea;
+		}
+		else if (Anchor->HasLabel(FMRUKLabels::Ceiling))
+		{
+			Areas[(int32)EMRUKAcousticSurface::Ceiling] += PlaneArea;
+		}
+		else if (Anchor->HasLabel(FMRUKLabels::WallFace))
+		{
+			Areas[(int32)EMRUKAcousticSurface::Wall] += PlaneArea;
+		}
+		else if (Anchor->HasLabel(FMRUKLabels::InvisibleWallFace))
+		{
+			// Invisible walls bound the room on their own, e.g. towards the rest of an open plan space, sound leaves through them
+			Areas[(int32)EMRUKAcousticSurface::Opening] += PlaneArea;
+			InvisibleWallArea += PlaneArea;
+		}
+		else if (Anchor->HasLabel(FMRUKLabels::DoorFrame))
+		{
+			Areas[(int32)EMRUKAcousticSurface::Opening] += PlaneArea;
+			FrameArea += PlaneArea;
+		}
+		else if (Anchor->HasLabel(FMRUKLabels::WindowFrame))
+		{
+			Areas[(int32)EMRUKAcousticSurface::Window] += PlaneArea;
+			FrameArea += PlaneArea;
+		}
+		else if (Anchor->VolumeBounds.IsValid)
+		{
+			// The X axis of volumes points down, the bottom face rests on the floor and doesn't reflect sound
+			const FVector Size = Anchor->VolumeBounds.GetSize() / WorldToMeters;
+			const double BoxArea = 2.0 * (Size.X * Size.Y + Size.Y * Size.Z + Size.X * Size.Z) - Size.Y * Size.Z;
+			FurnitureVolume += Size.X * Size.Y * Size.Z;
+			const bool bIsSoft = Anchor->HasAnyLabel({ FMRUKLabels::Couch, FMRUKLabels::Bed });
+			Areas[(int32)(bIsSoft ? EMRUKAcousticSurface::SoftFurnishing : EMRUKAcousticSurface::HardFurnishing)] += BoxArea;
+		}
+		else if (!Anchor->HasLabel(FMRUKLabels::WallArt))
+		{
+			// Wall art lies flat on a wall and is already part of the wall area
+			Areas[(int32)EMRUKAcousticSurface::HardFurnishing] += PlaneArea;
+		}
+	}
+
+	// Doors and windows are cut out of the walls they are in, invisible walls are not part of any wall
+	const double GrossWallArea = Areas[(int32)EMRUKAcousticSurface::Wall];
+	Areas[(int32)EMRUKAcousticSurface::Wall] = FMath::Max(GrossWallArea - FrameArea, 0.0);
+	const double BoundaryArea = GrossWallArea + InvisibleWallArea;
+	Profile.Openness = BoundaryArea > 0.0 ? FMath::Clamp((FrameArea + InvisibleWallArea) / BoundaryArea, 0.0, 1.0) : 0.0;
+
+	for (int32 I = 0; I < UE_ARRAY_COUNT(Areas); ++I)
+	{
+		const EMRUKAcousticSurface Surface = (EMRUKAcousticSurface)I;
+		Profile.SurfaceAreas.Add(Surface, Areas[I]);
+		Profile.TotalSurfaceArea += Areas[I];
+		Profile.AbsorptionArea += Areas[I] * Absorption.GetCoefficient(Surface);
+	}
+
+	Profile.CeilingHeight = (Ceiling->GetActorLocation().Z - Floor->GetActorLocation().Z) / WorldToMeters;
+	Profile.Volume = FMath::Max(Areas[(int32)EMRUKAcousticSurface::Floor] * Profile.CeilingHeight - FurnitureVolume, 0.0);
+
+	// Sabine: RT60 = 0.161 s/m * V / A
+	Profile.DecayTime = Profile.AbsorptionArea > 0.0 ? 0.161 * Profile.Volume / Profile.AbsorptionArea : 0.0;
+	Profile.MeanFreePath = Profile.TotalSurfaceArea > 0.0 ? 4.0 * Profile.Volume / Profile.TotalSurfaceArea : 0.0;
+
+	// First order image sources for a listener half way between floor and ceiling above the floor centroid
+	const FVector2D CentroidLS = UMRUKBPLibrary::ComputeCentroid(Floor->PlaneBoundary2D);
+	const FVector Listener = Floor->GetActorTransform().TransformPosition(FVector(0.0, CentroidLS.X, CentroidLS.Y))
+		+ (Ceiling->GetActorLocation() - Floor->GetActorLocation()) * 0.5;
+
+	const auto AddReflection = [&Profile, &Listener, WorldToMeters, SpeedOfSound](const AMRUKAnchor* Anchor) {
+		const double Distance = FMath::Abs(FVector::DotProduct(Listener - Anchor->GetActorLocation(), Anchor->GetActorForwardVector())) / WorldToMeters;
+		Profile.EarlyReflectionDelays.Add(2.0 * Distance / SpeedOfSound);
+	};
+	AddReflection(Floor);
+	AddReflection(Ceiling);
+	for (const AMRUKAnchor* Wall : Room.WallAnchors)
+	{
+		if (Wall)
+		{
+			AddReflection(Wall);
+		}
+	}
+	Profile.EarlyReflectionDelays.Sort();
+
+	Profile.bIsValid = true;
+	return Profile;
+}
@@ -0,0 +1,616 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#include "MRUtilityKitAmbientOcclusion.h"
+#include "MRUtilityKitSubsystem.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitAnchor.h"
+#include "ProceduralMeshComponent.h"
+#include "Async/Async.h"
+#include "Engine/GameInstance.h"
+#include "HAL/PlatformTime.h"
+#include "Tasks/Task.h"
+
+struct AMRUKAmbientOcclusionBaker::FBakeSource
+{
+	struct FSection
+	{
+		TArray<FProcMeshVertex> Vertices;
+		TArray<int32> Indices;
+		bool bEnableCollision = false;
+	};
+
+	/** Transform of the mesh component */
+	FTransform Transform;
+	TArray<FSection> Sections;
+};
+
+struct AMRUKAmbientOcclusionBaker::FOccluder
+{
+	FTransform Transform;
+	/** Local bounds of a volume, only valid for volumes */
+	FBox VolumeBounds{ ForceInit };
+	/** Boundary of a plane, empty for volumes */
+	TArray<FVector2D> Boundary;
+	FBox2D BoundaryBounds{ ForceInit };
+	/** Anchor the occluder belongs to, used to skip self intersections */
+	const AMRUKAnchor* Anchor = nullptr;
+};
+
+namespace
+{
+	using FBakeSource = AMRUKAmbientOcclusionBaker::FBakeSource;
+	using FOccluder = AMRUKAmbientOcclusionBaker::FOccluder;
+
+	bool IsOccluder(const AMRUKAnchor* Anchor)
+	{
+		// Door and window frames or invisible walls are openings, they don't block light
+		if (Anchor->VolumeBounds.IsValid)
+		{
+			return true;
+		}
+		return Anchor->PlaneBounds.bIsValid && Anchor->HasAnyLabel({ FMRUKLabels::WallFace, FMRUKLabels::Floor, FMRUKLabels::Ceiling });
+	}
+
+	FBox ComputeAnchorBounds(const AMRUKAnchor* Anchor)
+	{
+		const FTransform& Transform = Anchor->GetActorTransform();
+		FBox Bounds(ForceInit);
+		if (Anchor->VolumeBounds.IsValid)
+		{
+			Bounds += Anchor->VolumeBounds.TransformBy(Transform);
+		}
+		if (Anchor->PlaneBounds.bIsValid)
+		{
+			const FBox2D& Plane = Anchor->PlaneBounds;
+			Bounds += Transform.TransformPosition(FVector(0.0, Plane.Min.X, Plane.Min.Y));
+			Bounds += Transform.TransformPosition(FVector(0.0, Plane.Max.X, Plane.Min.Y));
+			Bounds += Transform.TransformPosition(FVector(0.0, Plane.Min.X, Plane.Max.Y));
+			Bounds += Transform.TransformPosition(FVector(0.0, Plane.Max.X, Plane.Max.Y));
+		}
+		return Bounds;
+	}
+
+	bool IsPointInPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+	{
+		bool bInside = false;
+		for (int32 I = 0, J = Polygon.Num() - 1; I < Polygon.Num(); J = I++)
+		{
+			const FVector2D& A = Polygon[I];
+			const FVector2D& B = Polygon[J];
+			if ((A.Y > Point.Y) != (B.Y > Point.Y) && Point.X < (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y) + A.X)
+			{
+				bInside = !bInside;
+			}
+		}
+		return bInside;
+	}
+
+	/** Distance to the closest hit along the ray or MaxDist if nothing was hit */
+	double TraceOccluder(const FOccluder& Occluder, const FVector& Origin, const FVector& Direction, double MaxDist)
+	{
+		const FVector LocalOrigin = Occluder.Transform.InverseTransformPosition(Origin);
+		const FVector LocalDirection = Occluder.Transform.InverseTransformVectorNoScale(Direction);
+
+		if (Occluder.Boundary.IsEmpty())
+		{
+			// Slab test against the volume box
+			double TMin = 0.0;
+			double TMax = MaxDist;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (FMath::Abs(LocalDirection[Axis]) < UE_SMALL_NUMBER)
+				{
+					if (LocalOrigin[Axis] < Occluder.VolumeBounds.Min[Axis] || LocalOrigin[Axis] > Occluder.VolumeBounds.Max[Axis])
+					{
+						return MaxDist;
+					}
+					continue;
+				}
+				const double InvDirection = 1.0 / LocalDirection[Axis];
+				double T0 = (Occluder.VolumeBounds.Min[Axis] - LocalOrigin[Axis]) * InvDirection;
+				double T1 = (Occluder.VolumeBounds.Max[Axis] - LocalOrigin[Axis]) * InvDirection;
+				if (T0 > T1)
+				{
+					Swap(T0, T1);
+				}
+				TMin = FMath::Max(TMin, T0);
+				TMax = FMath::Min(TMax, T1);
+				if (TMin > TMax)
+				{
+					return MaxDist;
+				}
+			}
+			return TMin;
+		}
+
+		// Planes lie in the local YZ plane
+		if (FMath::Abs(LocalDirection.X) < UE_SMALL_NUMBER)
+		{
+			return MaxDist;
+		}
+		const double T = -LocalOrigin.X / LocalDirection.X;
+		if (T <= 0.0 || T >= MaxDist)
+		{
+			return MaxDist;
+		}
+		const FVector Hit = LocalOrigin + T * LocalDirection;
+		const FVector2D Hit2D(Hit.Y, Hit.Z);
+		if (!Occluder.BoundaryBounds.IsInside(Hit2D) || !IsPointInPolygon(Occluder.Boundary, Hit2D))
+		{
+			return MaxDist;
+		}
+		return T;
+	}
+
+	/** Subdivide every triangle into 4 by splitting its edges at the midpoints. Shared edges produce shared vertices. */
+	void SubdivideSection(FBakeSource::FSection& Section)
+	{
+		TMap<uint64, int32> Midpoints;
+		TArray<int32> NewIndices;
+		NewIndices.Reserve(Section.Indices.Num() * 4);
+		Section.Vertices.Reserve(Section.Vertices.Num() + Section.Indices.Num());
+
+		const auto GetMidpoint = [&Section, &Midpoints](int32 A, int32 B) {
+			const uint64 Key = A < B ? (uint64(A) << 32 | uint32(B)) : (uint64(B) << 32 | uint32(A));
+			if (const int32* Found = Midpoints.Find(Key))
+			{
+				return *Found;
+			}
+			const FProcMeshVertex& VA = Section.Vertices[A];
+			const FProcMeshVertex& VB = Section.Vertices[B];
+			FProcMeshVertex Mid = VA;
+			Mid.Position = (VA.Position + VB.Position) * 0.5;
+			Mid.Normal = (VA.Normal + VB.Normal).GetSafeNormal(UE_SMALL_NUMBER, VA.Normal);
+			Mid.UV0 = (VA.UV0 + VB.UV0) * 0.5;
+			Mid.UV1 = (VA.UV1 + VB.UV1) * 0.5;
+			Mid.UV2 = (VA.UV2 + VB.UV2) * 0.5;
+			Mid.UV3 = (VA.UV3 + VB.UV3) * 0.5;
+			const int32 Index = Section.Vertices.Add(Mid);
+			Midpoints.Add(Key, Index);
+			return Index;
+		};
+
+		for (int32 I = 0; I + 2 < Section.Indices.Num(); I += 3)
+		{
+			const int32 A = Section.Indices[I];
+			const int32 B = Section.Indices[I + 1];
+			const int32 C = Section.Indices[I + 2];
+			const int32 AB = GetMidpoint(A, B);
+			const int32 BC = GetMidpoint(B, C);
+			const int32 CA = GetMidpoint(C, A);
+			NewIndices.Append({ A, AB, CA, AB, B, BC, CA, BC, C, AB, BC, CA });
+		}
+		Section.Indices = MoveTemp(NewIndices);
+	}
+
+	int32 ComputeSubdivisionLevel(const FBakeSource::FSection& Section, const FMRUKAmbientOcclusionSettings& Settings)
+	{
+		double MaxEdgeSquared = 0.0;
+		for (int32 I = 0; I + 2 < Section.Indices.Num(); I += 3)
+		{
+			for (int32 E = 0; E < 3; ++E)
+			{
+				const FVector& A = Section.Vertices[Section.Indices[I + E]].Position;
+				const FVector& B = Section.Vertices[Section.Indices[I + (E + 1) % 3]].Position;
+				MaxEdgeSquared = FMath::Max(MaxEdgeSquared, FVector::DistSquared(A, B));
+			}
+		}
+		const double Ratio = FMath::Sqrt(MaxEdgeSquared) / Settings.VertexSpacing;
+		if (Ratio <= 1.0)
+		{
+			return 0;
+		}
+		return FMath::Min(FMath::CeilToInt(FMath::Log2(Ratio)), Settings.MaxSubdivisionLevel);
+	}
+
+	/** Cosine weighted directions on the hemisphere around +Z, generated from a Hammersley set */
+	void ComputeHemisphereSamples(int32 SampleCount, TArray<FVector>& OutSamples)
+	{
+		OutSamples.Reset(SampleCount);
+		for (int32 I = 0; I < SampleCount; ++I)
+		{
+			const double U = (I + 0.5) / SampleCount;
+			const double V = double(ReverseBits(uint32(I))) / 4294967296.0;
+			const double Radius = FMath::Sqrt(U);
+			const double Phi = 2.0 * UE_DOUBLE_PI * V;
+			OutSamples.Add(FVector(Radius * FMath::Cos(Phi), Radius * FMath::Sin(Phi), FMath::Sqrt(1.0 - U)));
+		}
+	}
+
+	void Bake(FBakeSource& Source, const TArray<FOccluder>& Occluders, const AMRUKAnchor* Self, const FMRUKAmbientOcclusionSettings& Settings)
+	{
+		TArray<FVector> Samples;
+		ComputeHemisphereSamples(Settings.SampleCount, Samples);
+
+		// Only occluders that can be reached from the mesh within MaxDistance matter
+		FBox MeshBounds(ForceInit);
+		for (const FBakeSource::FSection& Section : Source.Sections)
+		{
+			for (const FProcMeshVertex& Vertex : Section.Vertices)
+			{
+				MeshBounds += Source.Transform.TransformPosition(Vertex.Position);
+			}
+		}
+		MeshBounds = MeshBounds.ExpandBy(Settings.MaxDistance);
+
+		TArray<const FOccluder*> NearbyOccluders;
+		for (const FOccluder& Occluder : Occluders)
+		{
+			if (Occluder.Anchor == Self)
+			{
+				continue;
+			}
+			const FBox Local = Occluder.Boundary.IsEmpty()
+				? Occluder.VolumeBounds
+				: FBox(FVector(0.0, Occluder.BoundaryBounds.Min.X, Occluder.BoundaryBounds.Min.Y), FVector(0.0, Occluder.BoundaryBounds.Max.X, Occluder.BoundaryBounds.Max.Y));
+			if (Local.TransformBy(Occluder.Transform).Intersect(MeshBounds))
+			{
+				NearbyOccluders.Add(&Occluder);
+			}
+		}
+
+		// Small offset along the normal to not hit the surface the vertex lies on
+		const double SurfaceOffset = Settings.MaxDistance * 1e-3;
+
+		for (FBakeSource::FSection& Section : Source.Sections)
+		{
+			const int32 Levels = ComputeSubdivisionLevel(Section, Settings);
+			for (int32 Level = 0; Level < Levels; ++Level)
+			{
+				SubdivideSection(Section);
+			}
+
+			for (int32 VertexIndex = 0; VertexIndex < Section.Vertices.Num(); ++VertexIndex)
+			{
+				FProcMeshVertex& Vertex = Section.Vertices[VertexIndex];
+				const FVector Normal = Source.Transform.TransformVectorNoScale(Vertex.Normal).GetSafeNormal();
+				const FVector Origin = Source.Transform.TransformPosition(Vertex.Position) + Normal * SurfaceOffset;
+
+				FVector TangentX;
+				FVector TangentY;
+				Normal.FindBestAxisVectors(TangentX, TangentY);
+
+				// Rotate the sample set per vertex to turn banding into noise
+				const double Rotation = 2.0 * UE_DOUBLE_PI * (double(GetTypeHash(VertexIndex) * 2654435761u) / 4294967296.0);
+				const double CosRotation = FMath::Cos(Rotation);
+				const double SinRotation = FMath::Sin(Rotation);
+
+				double Occlusion = 0.0;
+				for (const FVector& Sample : Samples)
+				{
+					const double X = Sample.X * CosRotation - Sample.Y * SinRotation;
+					const double Y = Sample.X * SinRotation + Sample.Y * CosRotation;
+					const FVector Direction = TangentX * X + TangentY * Y + Normal * Sample.Z;
+
+					double Closest = Settings.MaxDistance;
+					for (const FOccluder* Occluder : NearbyOccluders)
+					{
+						Closest = FMath::Min(Closest, TraceOccluder(*Occluder, Origin, Direction, Closest));
+					}
+					Occlusion += 1.0 - Closest / Settings.MaxDistance;
+				}
+
+				const double Visibility = FMath::Clamp(1.0 - Settings.Intensity * Occlusion / Samples.Num(), 0.0, 1.0);
+				const uint8 Value = (uint8)FMath::RoundToInt(Visibility * 255.0);
+				Vertex.Color = FColor(Value, Value, Value, 255);
+			}
+		}
+	}
+} // namespace
+
+AMRUKAmbientOcclusionBaker::AMRUKAmbientOcclusionBaker()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	// Pick up meshes that were created during the frame
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+}
+
+void AMRUKAmbientOcclusionBaker::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+	if (SpawnMode == EMRUKSpawnMode::CurrentRoomOnly)
+	{
+		if (Subsystem->SceneLoadStatus == EMRUKInitStatus::Complete)
+		{
+			BakeRoom(Subsystem->GetCurrentRoom());
+		}
+		else
+		{
+			Subsystem->OnRoomCreated.AddUniqueDynamic(this, &AMRUKAmbientOcclusionBaker::OnRoomCreated);
+		}
+	}
+	else if (SpawnMode == EMRUKSpawnMode::AllRooms)
+	{
+		for (auto& Room : Subsystem->Rooms)
+		{
+			BakeRoom(Room);
+		}
+		Subsystem->OnRoomCreated.AddUniqueDynamic(this, &AMRUKAmbientOcclusionBaker::OnRoomCreated);
+	}
+
+	Subsystem->OnRoomUpdated.AddUniqueDynamic(this, &AMRUKAmbientOcclusionBaker::OnRoomUpdated);
+	Subsystem->OnRoomRemoved.AddUniqueDynamic(this, &AMRUKAmbientOcclusionBaker::OnRoomRemoved);
+}
+
+void AMRUKAmbientOcclusionBaker::BakeRoom(AMRUKRoom* Room)
+{
+	if (!IsValid(Room))
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Can not bake ambient occlusion for a room that is a nullptr"));
+		return;
+	}
+	// The bake itself happens in the next tick, the procedural meshes may not have been created yet
+	Rooms.FindOrAdd(Room).bDirty = true;
+}
+
+void AMRUKAmbientOcclusionBaker::RemoveRoom(AMRUKRoom* Room)
+{
+	Rooms.Remove(Room);
+}
+
+void AMRUKAmbientOcclusionBaker::OnRoomCreated(AMRUKRoom* Room)
+{
+	if (SpawnMode == EMRUKSpawnMode::CurrentRoomOnly && !Rooms.IsEmpty())
+	{
+		// Only one room should be handled in this mode
+		return;
+	}
+	BakeRoom(Room);
+}
+
+void AMRUKAmbientOcclusionBaker::OnRoomUpdated(AMRUKRoom* Room)
+{
+	if (FRoomRecord* RoomRecord = Rooms.Find(Room))
+	{
+		RoomRecord->bDirty = true;
+	}
+}
+
+void AMRUKAmbientOcclusionBaker::OnRoomRemoved(AMRUKRoom* Room)
+{
+	RemoveRoom(Room);
+}
+
+void AMRUKAmbientOcclusionBaker::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	for (auto It = Rooms.CreateIterator(); It; ++It)
+	{
+		AMRUKRoom* Room = It->Key.Get();
+		if (!IsValid(Room))
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		UpdateRoom(Room, It->Value);
+	}
+}
+
+void AMRUKAmbientOcclusionBaker::UpdateRoom(AMRUKRoom* Room, FRoomRecord& RoomRecord)
+{
+	// World bounds of geometry that appeared, disappeared or moved. Meshes close to it need to be baked again.
+	TArray<FBox, TInlineAllocator<16>> ChangedBounds;
+	TArray<AMRUKAnchor*, TInlineAllocator<16>> AnchorsToBake;
+
+	for (auto It = RoomRecord.Anchors.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid() || !Room->AllAnchors.Contains(It->Key.Get()))
+		{
+			ChangedBounds.Add(It->Value.Bounds);
+			It.RemoveCurrent();
+		}
+	}
+
+	for (AMRUKAnchor* Anchor : Room->AllAnchors)
+	{
+		if (!IsValid(Anchor))
+		{
+			continue;
+		}
+
+		FAnchorRecord* Record = RoomRecord.Anchors.Find(Anchor);
+		if (!Record)
+		{
+			Record = &RoomRecord.Anchors.Add(Anchor);
+			Record->Transform = Anchor->GetActorTransform();
+			Record->Bounds = ComputeAnchorBounds(Anchor);
+			if (IsOccluder(Anchor))
+			{
+				ChangedBounds.Add(Record->Bounds);
+			}
+		}
+		else if (RoomRecord.bDirty || !Record->Transform.Equals(Anchor->GetActorTransform()))
+		{
+			// Anchor data only changes on room updates, transforms are cheap enough to compare every tick
+			const FBox NewBounds = ComputeAnchorBounds(Anchor);
+			if (!Record->Transform.Equals(Anchor->GetActorTransform()) || !NewBounds.Equals(Record->Bounds))
+			{
+				ChangedBounds.Add(Record->Bounds);
+				ChangedBounds.Add(NewBounds);
+				Record->Transform = Anchor->GetActorTransform();
+				Record->Bounds = NewBounds;
+				AnchorsToBake.Add(Anchor);
+			}
+		}
+
+		UProceduralMeshComponent* Mesh = Anchor->ProceduralMeshComponent;
+		if (Mesh != Record->Component.Get())
+		{
+			Record->Component = Mesh;
+			Record->Source.Reset();
+			if (Mesh)
+			{
+				// Capture the sections before they are replaced by the baked ones
+				const TSharedRef<FBakeSource, ESPMode::ThreadSafe> Source = MakeShared<FBakeSource, ESPMode::ThreadSafe>();
+				for (int32 SectionIndex = 0; SectionIndex < Mesh->GetNumSections(); ++SectionIndex)
+				{
+					const FProcMeshSection* ProcSection = Mesh->GetProcMeshSection(SectionIndex);
+					FBakeSource::FSection& Section = Source->Sections.AddDefaulted_GetRef();
+					Section.Vertices = ProcSection->ProcVertexBuffer;
+					Section.Indices.Reserve(ProcSection->ProcIndexBuffer.Num());
+					for (const uint32 Index : ProcSection->ProcIndexBuffer)
+					{
+						Section.Indices.Add((int32)Index);
+					}
+					Section.bEnableCollision = ProcSection->bEnableCollision;
+				}
+				Record->Source = Source;
+				AnchorsToBake.AddUnique(Anchor);
+			}
+		}
+	}
+	RoomRecord.bDirty = false;
+
+	if (ChangedBounds.IsEmpty() && AnchorsToBake.IsEmpty())
+	{
+		return;
+	}
+
+	for (auto& Pair : RoomRecord.Anchors)
+	{
+		if (!Pair.Value.Source.IsValid() || AnchorsToBake.Contains(Pair.Key.Get()))
+		{
+			continue;
+		}
+		const FBox Reach = Pair.Value.Bounds.ExpandBy(Settings.MaxDistance);
+		for (const FBox& Changed : ChangedBounds)
+		{
+			if (Reach.Intersect(Changed))
+			{
+				AnchorsToBake.Add(Pair.Key.Get());
+				break;
+			}
+		}
+	}
+
+	if (AnchorsToBake.IsEmpty())
+	{
+		return;
+	}
+
+	// The occluders are shared by all bakes of this update
+	const TSharedRef<TArray<FOccluder>, ESPMode::ThreadSafe> Occluders = MakeShared<TArray<FOccluder>, ESPMode::ThreadSafe>();
+	for (const AMRUKAnchor* Anchor : Room->AllAnchors)
+	{
+		if (!IsValid(Anchor) || !IsOccluder(Anchor))
+		{
+			continue;
+		}
+		FOccluder& Occluder = Occluders->AddDefaulted_GetRef();
+		Occluder.Transform = Anchor->GetActorTransform();
+		Occluder.Anchor = Anchor;
+		if (Anchor->VolumeBounds.IsValid)
+		{
+			Occluder.VolumeBounds = Anchor->VolumeBounds;
+		}
+		else
+		{
+			Occluder.Boundary = Anchor->PlaneBoundary2D;
+			Occluder.BoundaryBounds = Anchor->PlaneBounds;
+		}
+	}
+
+	UE_LOG(LogMRUK, Log, TEXT("Baking ambient occlusion for %d anchors of room %s"), AnchorsToBake.Num(), *Room->GetName());
+	for (AMRUKAnchor* Anchor : AnchorsToBake)
+	{
+		FAnchorRecord& Record = RoomRecord.Anchors.FindChecked(Anchor);
+		if (Record.Source.IsValid())
+		{
+			LaunchBake(Anchor, Record, Occluders);
+		}
+	}
+}
+
+void AMRUKAmbientOcclusionBaker::LaunchBake(AMRUKAnchor* Anchor, FAnchorRecord& Record, const TSharedRef<const TArray<FOccluder>, ESPMode::ThreadSafe>& Occluders)
+{
+	const UProceduralMeshComponent* Mesh = Record.Component.Get();
+	if (!IsValid(Mesh))
+	{
+		// The mesh got destroyed since its sections were captured, they are captured again once the anchor has a new one
+		UE_LOG(LogMRUK, Verbose, TEXT("Skipping the ambient occlusion bake of %s, its procedural mesh is gone"), *GetNameSafe(Anchor));
+		Record.Component.Reset();
+		Record.Source.Reset();
+		return;
+	}
+
+	// Work on a copy of the source, it must stay unmodified for later bakes
+	const TSharedRef<FBakeSource, ESPMode::ThreadSafe> Job = MakeShared<FBakeSource, ESPMode::ThreadSafe>(*Record.Source);
+	Job->Transform = Mesh->GetComponentTransform();
+
+	const int32 Generation = ++Record.Generation;
+	const FMRUKAmbientOcclusionSettings BakeSettings = Settings;
+	const TWeakObjectPtr<AMRUKAmbientOcclusionBaker> WeakThis = this;
+	const TWeakObjectPtr<AMRUKRoom> WeakRoom = Anchor->Room;
+	const TWeakObjectPtr<AMRUKAnchor> WeakAnchor = Anchor;
+	const AMRUKAnchor* Self = Anchor;
+
+	++PendingBakes;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job, Occluders, Self, BakeSettings, WeakThis, WeakRoom, WeakAnchor, Generation]() {
+		const double StartTime = FPlatformTime::Seconds();
+		Bake(*Job, *Occluders, Self, BakeSettings);
+		UE_LOG(LogMRUK, Verbose, TEXT("Baked ambient occlusion in %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+		AsyncTask(ENamedThreads::GameThread, [Job, WeakThis, WeakRoom, WeakAnchor, Generation]() {
+			if (AMRUKAmbientOcclusionBaker* Baker = WeakThis.Get())
+			{
+				Baker->ApplyBake(WeakRoom, WeakAnchor, Generation, Job);
+			}
+		});
+	});
+}
+
+void AMRUKAmbientOcclusionBaker::ApplyBake(TWeakObjectPtr<AMRUKRoom> Room, TWeakObjectPtr<AMRUKAnchor> Anchor, int32 Generation, const TSharedRef<const FBakeSource, ESPMode::ThreadSafe>& Result)
+{
+	--PendingBakes;
+
+	FRoomRecord* RoomRecord = Rooms.Find(Room);
+	FAnchorRecord* Record = RoomRecord ? RoomRecord->Anchors.Find(Anchor) : nullptr;
+	if (!Record || Record->Generation != Generation || !Record->Component.IsValid())
+	{
+		// The anchor changed or got removed while baking
+		return;
+	}
+
+	UProceduralMeshComponent* Mesh = Record->Component.Get();
+	TArray<FVector> Vertices;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UV0s;
+	TArray<FVector2D> UV1s;
+	TArray<FVector2D> UV2s;
+	TArray<FVector2D> UV3s;
+	TArray<FColor> Colors;
+	TArray<FProcMeshTangent> Tangents;
+	for (int32 SectionIndex = 0; SectionIndex < Result->Sections.Num(); ++SectionIndex)
+	{
+		const FBakeSource::FSection& Section = Result->Sections[SectionIndex];
+		const int32 NumVertices = Section.Vertices.Num();
+		Vertices.Reset(NumVertices);
+		Normals.Reset(NumVertices);
+		UV0s.Reset(NumVertices);
+		UV1s.Reset(NumVertices);
+		UV2s.Reset(NumVertices);
+		UV3s.Reset(NumVertices);
+		Colors.Reset(NumVertices);
+		Tangents.Reset(NumVertices);
+		for (const FProcMeshVertex& Vertex : Section.Vertices)
+		{
+			Vertices.Add(Vertex.Position);
+			Normals.Add(Vertex.Normal);
+			UV0s.Add(Vertex.UV0);
+			UV1s.Add(Vertex.UV1);
+			UV2s.Add(Vertex.UV2);
+			UV3s.Add(Vertex.UV3);
+			Colors.Add(Vertex.Color);
+			Tangents.Add(Vertex.Tangent);
+		}
+		Mesh->CreateMeshSection(SectionIndex, Vertices, Section.Indices, Normals, UV0s, UV1s, UV2s, UV3s, Colors, Tangents, Section.bEnableCollision);
+	}
+}
@@ -159,35 +159,7 @@ bool AMRUKAnchor::LoadFromData(UMRUKAnchorData* AnchorData)
 
 bool AMRUKAnchor::IsPositionInBoundary(const FVector2D& Position)
 {
-	if (PlaneBoundary2D.IsEmpty())
-	{
-		return false;
-	}
-
-	int Intersections = 0;
-
-	for (int i = 1; i <= PlaneBoundary2D.Num(); i++)
-	{
-		const FVector2D P1 = PlaneBoundary2D[i - 1];
-		const FVector2D P2 = PlaneBoundary2D[i % PlaneBoundary2D.Num()];
-		if (Position.Y > FMath::Min(P1.Y, P2.Y) && Position.Y <= FMath::Max(P1.Y, P2.Y))
-		{
-			if (Position.X <= FMath::Max(P1.X, P2.X))
-			{
-				if (P1.Y != P2.Y)
-				{
-					const auto Frac = (Position.Y - P1.Y) / (P2.Y - P1.Y);
-					const auto XIntersection = P1.X + Frac * (P2.X - P1.X);
-					if (P1.X == P2.X || Position.X <= XIntersection)
-					{
-						Intersections++;
-					}
-				}
-			}
-		}
-	}
-
-	return Intersections % 2 == 1;
+	return MRUKIsPositionInPolygon(PlaneBoundary2D, Position);
 }
 
 FVector AMRUKAnchor::GenerateRandomPositionOnPlane()
@@ -217,62 +189,13 @@ FVector AMRUKAnchor::GenerateRandomPositionOnPlaneFromStream(const FRandomStream
 		Mesh.Triangles = MRUKTriangulatePoints(Mesh.Vertices);
 
 		// Compute the area of each triangle and the total surface area of the mesh
-		Mesh.Areas.Reserve(Mesh.Triangles.Num() / 3);
-		Mesh.TotalArea = 0.0f;
-		for (int i = 0; i < Mesh.Triangles.Num(); i += 3)
-		{
-			const auto I0 = Mesh.Triangles[i];
-			const auto I1 = Mesh.Triangles[i + 1];
-			const auto I2 = Mesh.Triangles[i + 2];
-			auto V0 = Mesh.Vertices[I0];
-			auto V1 = Mesh.Vertices[I1];
-			auto V2 = Mesh.Vertices[I2];
-			const auto Cross = FVector2D::CrossProduct(V1 - V0, V2 - V0);
-			float Area = Cross * 0.5f;
-			Mesh.TotalArea += Area;
-			Mesh.Areas.Add(Area);
-		}
+		Mesh.TotalArea = MRUKComputeTriangleAreas(Mesh.Vertices, Mesh.Triangles, Mesh.Areas);
 		CachedMesh.Emplace(MoveTemp(Mesh));
 	}
 
 	const auto& [Vertices, Triangles, Areas, TotalArea] = CachedMesh.GetValue();
-
-	// Pick a random triangle weighted by surface area (triangles with larger surface
-	// area have more chance of being chosen)
-	auto Rand = RandomStream.FRandRange(0.0f, TotalArea);
-	int TriangleIndex = 0;
-	for (; TriangleIndex < Areas.Num() - 1; ++TriangleIndex)
-	{
-		Rand -= Areas[TriangleIndex];
-		if (Rand <= 0.0f)
-		{
-			break;
-		}
-	}
-
-	// Get the vertices of the chosen triangle
-	const auto I0 = Triangles[TriangleIndex * 3];
-	const auto I1 = Triangles[TriangleIndex * 3 + 1];
-	const auto I2 = Triangles[TriangleIndex * 3 + 2];
-	const auto V0 = FVector(0.0, Vertices[I0].X, Vertices[I0].Y);
-	const auto V1 = FVector(0.0, Vertices[I1].X, Vertices[I1].Y);
-	const auto V2 = FVector(0.0, Vertices[I2].X, Vertices[I2].Y);
-
-	// Calculate a random point on that triangle
-	float U = RandomStream.FRandRange(0.0f, 1.0f);
-	float V = RandomStream.FRandRange(0.0f, 1.0f);
-	if (U + V > 1.0f)
-	{
-		if (U > V)
-		{
-			U = 1.0f - U;
-		}
-		else
-		{
-			V = 1.0f - V;
-		}
-	}
-	return V0 + U * (V1 - V0) + V * (V2 - V0);
+	const FVector2D Position = MRUKRandomPositionOnTriangles(Vertices, Triangles, Areas, TotalArea, RandomStream);
+	return FVector(0.0, Position.X, Position.Y);
 }
 
 bool AMRUKAnchor::Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, FMRUKHit& OutHit)
@@ -900,84 +823,28 @@ void AMRUKAnchor::EndPlay(EEndPlayReason::Type Reason)
 
 bool AMRUKAnchor::RayCastPlane(const FRay& LocalRay, float MaxDist, FMRUKHit& OutHit)
 {
-	// If the ray is behind or parallel to the anchor's plane then ignore it
-	if (LocalRay.Direction.X >= UE_KINDA_SMALL_NUMBER)
+	if (!MRUKRaycastPlane(LocalRay, MaxDist, PlaneBounds, PlaneBoundary2D, OutHit))
 	{
-		// Distance to the plane from the ray origin along the ray's direction
-		const float Dist = -LocalRay.Origin.X / LocalRay.Direction.X;
-		// If the distance is negative or less than the maximum distance then ignore it
-		if (Dist >= 0.0f && (MaxDist <= 0 || Dist < MaxDist))
-		{
-			const FVector HitPos = LocalRay.PointAt(Dist);
-			// Ensure the hit is within the plane extends and within the boundary
-			const FVector2D Pos2D(HitPos.Y, HitPos.Z);
-			if (PlaneBounds.IsInside(Pos2D) && IsPositionInBoundary(Pos2D))
-			{
-				// Transform the result back into world space
-				const auto Transform = GetTransform();
-				OutHit.HitPosition = Transform.TransformPositionNoScale(HitPos);
-				OutHit.HitNormal = Transform.TransformVectorNoScale(-FVector::XAxisVector);
-				OutHit.HitDistance = Dist;
-				return true;
-			}
-		}
+		return false;
 	}
-	return false;
+	// Transform the result back into world space
+	const auto Transform = GetTransform();
+	OutHit.HitPosition = Transform.TransformPositionNoScale(OutHit.HitPosition);
+	OutHit.HitNormal = Transform.TransformVectorNoScale(OutHit.HitNormal);
+	return true;
 }
 
 bool AMRUKAnchor::RayCastVolume(const FRay& LocalRay, float MaxDist, FMRUKHit& OutHit)
 {
-	// Use the slab method to determine if the ray intersects with the bounding box
-	// https://education.siggraph.org/static/HyperGraph/raytrace/rtinter3.htm
-	float DistNear = -UE_BIG_NUMBER, DistFar = UE_BIG_NUMBER;
-	int HitAxis = 0;
-	for (int i = 0; i < 3; ++i)
+	if (!MRUKRaycastVolume(LocalRay, MaxDist, VolumeBounds, OutHit))
 	{
-		if (FMath::Abs(LocalRay.Direction.Component(i)) >= UE_KINDA_SMALL_NUMBER)
-		{
-			// Distance to the plane from the ray origin along the ray's direction
-			float Dist1 = (VolumeBounds.Min.Component(i) - LocalRay.Origin.Component(i)) / LocalRay.Direction.Component(i);
-			float Dist2 = (VolumeBounds.Max.Component(i) - LocalRay.Origin.Component(i)) / LocalRay.Direction.Component(i);
-
-			if (Dist1 > Dist2)
-			{
-				std::swap(Dist1, Dist2);
-			}
-			if (Dist1 > DistNear)
-			{
-				DistNear = Dist1;
-				HitAxis = i;
-			}
-			if (Dist2 < DistFar)
-			{
-				DistFar = Dist2;
-			}
-		}
-		else
-		{
-			// In this case there is no intersection because the ray is parallel to the plane
-			// Check that it is within bounds
-			if (LocalRay.Origin.Component(i) < VolumeBounds.Min.Component(i) || LocalRay.Origin.Component(i) > VolumeBounds.Max.Component(i))
-			{
-				// No intersection, set DistNear to a large number
-				DistNear = UE_BIG_NUMBER;
-				break;
-			}
-		}
-	}
-	if (DistNear >= 0 && DistNear <= DistFar && (MaxDist <= 0 || DistNear < MaxDist))
-	{
-		const FVector HitPos = LocalRay.PointAt(DistNear);
-		FVector HitNormal = FVector::ZeroVector;
-		HitNormal.Component(HitAxis) = LocalRay.Direction.Component(HitAxis) > 0 ? -1 : 1;
-		// Transform the result back into world space
-		const auto Transform = GetTransform();
-		OutHit.HitPosition = Transform.TransformPositionNoScale(HitPos);
-		OutHit.HitNormal = Transform.TransformVectorNoScale(HitNormal);
-		OutHit.HitDistance = DistNear;
-		return true;
+		return false;
 	}
-	return false;
+	// Transform the result back into world space
+	const auto Transform = GetTransform();
+	OutHit.HitPosition = Transform.TransformPositionNoScale(OutHit.HitPosition);
+	OutHit.HitNormal = Transform.TransformVectorNoScale(OutHit.HitNormal);
+	return true;
 }
 
 void AMRUKAnchor::TriangulatedMeshCache::Clear()
@@ -8,8 +8,18 @@ LICENSE file in the root directory of this source tree.
 #include "MRUtilityKitAnchorActorSpawner.h"
 #include "MRUtilityKitTelemetry.h"
 #include "MRUtilityKitSubsystem.h"
+#include "MRUtilityKitAnchor.h"
 
 #include "Engine/GameInstance.h"
+#include "Kismet/GameplayStatics.h"
+#include "Camera/PlayerCameraManager.h"
+
+AMRUKAnchorActorSpawner::AMRUKAnchorActorSpawner()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	// Only ticks while actors are spawned over multiple frames
+	PrimaryActorTick.bStartWithTickEnabled = false;
+}
 
 void AMRUKAnchorActorSpawner::BeginPlay()
 {
@@ -94,6 +104,8 @@ void AMRUKAnchorActorSpawner::RemoveActors(AMRUKRoom* Room)
 		Actors->Empty();
 		SpawnedActors.Remove(Room);
 	}
+
+	PendingSpawns.RemoveAll([Room](const FPendingSpawn& Pending) { return Pending.Room == Room; });
 }
 
 void AMRUKAnchorActorSpawner::SpawnActors(AMRUKRoom* Room)
@@ -132,6 +144,13 @@ void AMRUKAnchorActorSpawner::SpawnActors(AMRUKRoom* Room)
 		RandomStream.GenerateNewSeed();
 	}
 	LastSeed = RandomStream.GetCurrentSeed();
+
+	if (SpawnOverMultipleFrames)
+	{
+		StartSpawningOverMultipleFrames(Room, RandomStream);
+		return;
+	}
+
 	const TArray<AActor*>& Actors = Room->SpawnInteriorFromStream(SpawnGroups, RandomStream, CutHoleLabels,
 		ProceduralMaterial, ShouldFallbackToProcedural);
 	SpawnedActors.Add(Room, Actors);
@@ -143,6 +162,122 @@ void AMRUKAnchorActorSpawner::SpawnActors(AMRUKRoom* Room)
 	OnActorsSpawned.Broadcast(Room);
 }
 
+void AMRUKAnchorActorSpawner::StartSpawningOverMultipleFrames(AMRUKRoom* Room, const FRandomStream& RandomStream)
+{
+	// The plan makes all random choices up front in anchor order, that way the result is the same as
+	// spawning everything at once with the same seed, no matter in which order the anchors get processed.
+	FPendingSpawn& Pending = PendingSpawns.AddDefaulted_GetRef();
+	Pending.Room = Room;
+	Room->PlanInteriorSpawn(SpawnGroups, RandomStream, CutHoleLabels, ProceduralMaterial, ShouldFallbackToProcedural, Pending.Plan);
+	SortByPriority(Pending.Plan);
+
+	SpawnedActors.Add(Room, {});
+
+	const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+	Subsystem->OnRoomUpdated.AddUniqueDynamic(this, &AMRUKAnchorActorSpawner::OnRoomUpdated);
+	Subsystem->OnRoomRemoved.AddUniqueDynamic(this, &AMRUKAnchorActorSpawner::OnRoomRemoved);
+
+	SetActorTickEnabled(true);
+}
+
+void AMRUKAnchorActorSpawner::SortByPriority(FMRUKInteriorSpawnPlan& Plan) const
+{
+	FVector UserLocation = FVector::ZeroVector;
+	if (const APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(this, 0))
+	{
+		UserLocation = CameraManager->GetCameraLocation();
+	}
+
+	// The room shell comes first so the user is never looking through missing walls, then the closest anchors
+	const auto GetPriority = [&UserLocation](const FMRUKInteriorSpawnStep& Step) -> double {
+		AMRUKAnchor* Anchor = Step.Anchor.Get();
+		if (!Anchor)
+		{
+			return -1.0;
+		}
+		const AMRUKRoom* Room = Anchor->Room;
+		if (Room && (Anchor == Room->FloorAnchor || Anchor == Room->CeilingAnchor || Room->IsWallAnchor(Anchor)))
+		{
+			return 0.0;
+		}
+		return 1.0 + FVector::DistSquared(UserLocation, Anchor->GetActorLocation());
+	};
+
+	TArray<TPair<double, int32>> Priorities;
+	Priorities.Reserve(Plan.Steps.Num());
+	for (int32 i = 0; i < Plan.Steps.Num(); ++i)
+	{
+		Priorities.Add({ GetPriority(Plan.Steps[i]), i });
+	}
+	// Keep the plan order between steps of the same priority, e.g. the floor and walls
+	Priorities.StableSort([](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; });
+
+	TArray<FMRUKInteriorSpawnStep> SortedSteps;
+	SortedSteps.Reserve(Plan.Steps.Num());
+	for (const auto& Priority : Priorities)
+	{
+		SortedSteps.Add(MoveTemp(Plan.Steps[Priority.Value]));
+	}
+	Plan.Steps = MoveTemp(SortedSteps);
+}
+
+void AMRUKAnchorActorSpawner::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	const double EndTime = FPlatformTime::Seconds() + SpawnFrameBudgetMs / 1000.0;
+	bool bProcessedStep = false;
+
+	while (!PendingSpawns.IsEmpty())
+	{
+		FPendingSpawn& Pending = PendingSpawns[0];
+		AMRUKRoom* Room = Pending.Room.Get();
+		if (!IsValid(Room))
+		{
+			PendingSpawns.RemoveAt(0);
+			continue;
+		}
+
+		const int32 NumSteps = Pending.Plan.Steps.Num();
+		while (Pending.NextStep < NumSteps && (!bProcessedStep || FPlatformTime::Seconds() < EndTime))
+		{
+			if (AActor* InteriorActor = Room->ExecuteInteriorSpawnStep(Pending.Plan, Pending.Plan.Steps[Pending.NextStep]))
+			{
+				SpawnedActors.FindOrAdd(Room).Push(InteriorActor);
+			}
+			++Pending.NextStep;
+			bProcessedStep = true;
+		}
+
+		const float Progress = NumSteps > 0 ? static_cast<float>(Pending.NextStep) / NumSteps : 1.0f;
+		if (Pending.NextStep < NumSteps)
+		{
+			// Out of time for this frame
+			OnSpawnProgress.Broadcast(Room, Progress);
+			break;
+		}
+
+		// Remove before broadcasting, listeners may start spawning again
+		PendingSpawns.RemoveAt(0);
+		OnSpawnProgress.Broadcast(Room, Progress);
+		OnActorsSpawned.Broadcast(Room);
+	}
+
+	if (PendingSpawns.IsEmpty())
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+bool AMRUKAnchorActorSpawner::IsSpawning(AMRUKRoom* Room) const
+{
+	if (!Room)
+	{
+		return !PendingSpawns.IsEmpty();
+	}
+	return PendingSpawns.ContainsByPredicate([Room](const FPendingSpawn& Pending) { return Pending.Room == Room; });
+}
+
 void AMRUKAnchorActorSpawner::GetSpawnedActorsByRoom(AMRUKRoom* Room, TArray<AActor*>& Actors)
 {
 	if (const TArray<AActor*>* A = SpawnedActors.Find(Room))
@@ -17,6 +17,40 @@ LICENSE file in the root directory of this source tree.
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
+bool FMRUKDeviceSceneDiscovery::DiscoverRooms(const FOculusXRDiscoverAnchorsResultsDelegate& OnResults, const FOculusXRDiscoverAnchorsCompleteDelegate& OnComplete)
+{
+	const auto Filter = NewObject<UOculusXRSpaceDiscoveryComponentsFilter>();
+	Filter->ComponentType = EOculusXRSpaceComponentType::RoomLayout;
+	FOculusXRSpaceDiscoveryInfo DiscoveryInfo{};
+	DiscoveryInfo.Filters.Push(Filter);
+
+	EOculusXRAnchorResult::Type Result{};
+	OculusXRAnchors::FOculusXRAnchors::DiscoverAnchors(DiscoveryInfo, OnResults, OnComplete, Result);
+	return Result == EOculusXRAnchorResult::Success;
+}
+
+bool FMRUKDeviceSceneDiscovery::DiscoverAnchors(const TArray<FOculusXRUUID>& Uuids, const FOculusXRDiscoverAnchorsResultsDelegate& OnResults, const FOculusXRDiscoverAnchorsCompleteDelegate& OnComplete)
+{
+	const auto Filter = NewObject<UOculusXRSpaceDiscoveryIdsFilter>();
+	Filter->Uuids = Uuids;
+	FOculusXRSpaceDiscoveryInfo DiscoveryInfo{};
+	DiscoveryInfo.Filters.Push(Filter);
+
+	EOculusXRAnchorResult::Type Result{};
+	OculusXRAnchors::FOculusXRAnchors::DiscoverAnchors(DiscoveryInfo, OnResults, OnComplete, Result);
+	return Result == EOculusXRAnchorResult::Success;
+}
+
+bool FMRUKDeviceSceneDiscovery::GetRoomLayout(const FOculusXRAnchorsDiscoverResult& Room, FOculusXRRoomLayout& OutRoomLayout)
+{
+	return UOculusXRAnchorBPFunctionLibrary::GetRoomLayout(Room.Space, OutRoomLayout);
+}
+
+void FMRUKDeviceSceneDiscovery::LoadAnchorData(const FOculusXRAnchorsDiscoverResult& Anchor, UMRUKAnchorData* AnchorData)
+{
+	AnchorData->LoadFromDevice(Anchor);
+}
+
 AMRUKLocalizer::AMRUKLocalizer()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -125,24 +159,19 @@ void UMRUKRoomData::LoadFromDevice(const FOculusXRAnchorsDiscoverResult& Anchors
 {
 	SpaceQuery = AnchorsDiscoverResult;
 
-	const auto Subsystem = GetWorld()->GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+	if (!Discovery)
+	{
+		Discovery = MakeShared<FMRUKDeviceSceneDiscovery>();
+	}
 
-	if (!Subsystem->GetRoomLayoutManager()->GetRoomLayout(SpaceQuery.Space.Value, RoomLayout))
+	if (!Discovery->GetRoomLayout(SpaceQuery, RoomLayout))
 	{
 		UE_LOG(LogMRUK, Error, TEXT("Could not query room layout"));
 		FinishQuery(false);
 		return;
 	}
 
-	EOculusXRAnchorResult::Type Result{};
-
-	const auto Filter = NewObject<UOculusXRSpaceDiscoveryIdsFilter>(this);
-	Filter->Uuids = RoomLayout.RoomObjectUUIDs;
-	FOculusXRSpaceDiscoveryInfo DiscoveryInfo{};
-	DiscoveryInfo.Filters.Push(Filter);
-
-	OculusXRAnchors::FOculusXRAnchors::DiscoverAnchors(DiscoveryInfo, FOculusXRDiscoverAnchorsResultsDelegate::CreateUObject(this, &UMRUKRoomData::RoomDataLoadedComplete), FOculusXRDiscoverAnchorsCompleteDelegate::CreateUObject(this, &UMRUKRoomData::RoomDataLoadedResult), Result);
-	if (Result != EOculusXRAnchorResult::Success)
+	if (!Discovery->DiscoverAnchors(RoomLayout.RoomObjectUUIDs, FOculusXRDiscoverAnchorsResultsDelegate::CreateUObject(this, &UMRUKRoomData::RoomDataLoadedComplete), FOculusXRDiscoverAnchorsCompleteDelegate::CreateUObject(this, &UMRUKRoomData::RoomDataLoadedResult)))
 	{
 		UE_LOG(LogMRUK, Error, TEXT("Failed to discover anchors"));
 		FinishQuery(false);
@@ -167,7 +196,13 @@ void UMRUKRoomData::LoadFromJson(const FJsonValue& Value)
 
 void UMRUKRoomData::FinishQuery(bool Success)
 {
-	OnComplete.Broadcast(Success);
+	// A failed discovery may report its failure both when starting and on completion
+	if (Finished)
+	{
+		return;
+	}
+	Finished = true;
+	OnComplete.Broadcast(this, Success);
 }
 
 void UMRUKRoomData::RoomDataLoadedResult(EOculusXRAnchorResult::Type Result)
@@ -178,43 +213,38 @@ void UMRUKRoomData::RoomDataLoadedResult(EOculusXRAnchorResult::Type Result)
 		FinishQuery(false);
 		return;
 	}
-}
 
-void UMRUKRoomData::RoomDataLoadedComplete(const TArray<FOculusXRAnchorsDiscoverResult>& DiscoverResults)
-{
-	if (DiscoverResults.Num() == 0)
+	// All batches of anchors have been received
+	if (!AnchorQueriesLocalization.IsEmpty())
 	{
-		return;
+		UE_LOG(LogMRUK, Log, TEXT("Could not localize all anchors. Going to localize them async"));
+		FActorSpawnParameters ActorSpawnParams;
+		ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		LocalizationActor = GetWorld()->SpawnActor<AMRUKLocalizer>(ActorSpawnParams);
+		LocalizationActor->AnchorsData = AnchorQueriesLocalization;
+		LocalizationActor->OnComplete.AddDynamic(this, &UMRUKRoomData::AnchorsInitialized);
+		AnchorQueriesLocalization.Empty();
 	}
+	else
+	{
+		AnchorsInitialized(true);
+	}
+}
 
-	TArray<UMRUKAnchorData*> AnchorQueriesLocalization;
-
+void UMRUKRoomData::RoomDataLoadedComplete(const TArray<FOculusXRAnchorsDiscoverResult>& DiscoverResults)
+{
 	UE_LOG(LogMRUK, Log, TEXT("Received %d anchors from device"), DiscoverResults.Num());
 
 	for (auto& DiscoverResult : DiscoverResults)
 	{
 		auto AnchorQuery = NewObject<UMRUKAnchorData>(this);
-		AnchorQuery->LoadFromDevice(DiscoverResult);
+		Discovery->LoadAnchorData(DiscoverResult, AnchorQuery);
 		if (AnchorQuery->NeedAnchorLocalization)
 		{
 			AnchorQueriesLocalization.Push(AnchorQuery);
 		}
 		AnchorsData.Push(AnchorQuery);
 	}
-
-	if (!AnchorQueriesLocalization.IsEmpty())
-	{
-		UE_LOG(LogMRUK, Log, TEXT("Could not localize all anchors. Going to localize them async"));
-		FActorSpawnParameters ActorSpawnParams;
-		ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		LocalizationActor = GetWorld()->SpawnActor<AMRUKLocalizer>(ActorSpawnParams);
-		LocalizationActor->AnchorsData = AnchorQueriesLocalization;
-		LocalizationActor->OnComplete.AddDynamic(this, &UMRUKRoomData::AnchorsInitialized);
-	}
-	else
-	{
-		AnchorsInitialized(true);
-	}
 }
 
 void UMRUKRoomData::AnchorsInitialized(bool Success)
@@ -228,19 +258,13 @@ void UMRUKRoomData::AnchorsInitialized(bool Success)
 	FinishQuery(Success);
 }
 
-void UMRUKSceneData::LoadFromDevice(int32 MaxQueries)
+void UMRUKSceneData::LoadFromDevice(int32 MaxQueries, TSharedPtr<IMRUKSceneDiscovery> InDiscovery)
 {
-	NumRoomsLeftToInitialize = 0;
-
-	EOculusXRAnchorResult::Type Result{};
-
-	const auto Filter = NewObject<UOculusXRSpaceDiscoveryComponentsFilter>(this);
-	Filter->ComponentType = EOculusXRSpaceComponentType::RoomLayout;
-	FOculusXRSpaceDiscoveryInfo DiscoveryInfo{};
-	DiscoveryInfo.Filters.Push(Filter);
+	Discovery = InDiscovery ? InDiscovery : MakeShared<FMRUKDeviceSceneDiscovery>();
+	MaxAnchorQueries = MaxQueries;
+	Status = EMRUKInitStatus::Busy;
 
-	OculusXRAnchors::FOculusXRAnchors::DiscoverAnchors(DiscoveryInfo, FOculusXRDiscoverAnchorsResultsDelegate::CreateUObject(this, &UMRUKSceneData::SceneDataLoadedComplete), FOculusXRDiscoverAnchorsCompleteDelegate::CreateUObject(this, &UMRUKSceneData::SceneDataLoadedResult), Result);
-	if (Result != EOculusXRAnchorResult::Success)
+	if (!Discovery->DiscoverRooms(FOculusXRDiscoverAnchorsResultsDelegate::CreateUObject(this, &UMRUKSceneData::SceneDataLoadedComplete), FOculusXRDiscoverAnchorsCompleteDelegate::CreateUObject(this, &UMRUKSceneData::SceneDataLoadedResult)))
 	{
 		UE_LOG(LogMRUK, Error, TEXT("Failed to discover room layouts"));
 		FinishQuery(false);
@@ -277,79 +301,108 @@ void UMRUKSceneData::LoadFromJson(const FString& Json)
 		FinishQuery(false);
 		return;
 	}
-	NumRoomsLeftToInitialize = RoomsJson.Num();
-	UE_LOG(LogMRUK, Log, TEXT("Found %d rooms in JSON"), NumRoomsLeftToInitialize);
+	UE_LOG(LogMRUK, Log, TEXT("Found %d rooms in JSON"), RoomsJson.Num());
+	Status = EMRUKInitStatus::Busy;
 	for (const auto& RoomJson : RoomsJson)
 	{
 		auto RoomQuery = NewObject<UMRUKRoomData>(this);
 		RoomsData.Push(RoomQuery);
 		RoomQuery->OnComplete.AddDynamic(this, &UMRUKSceneData::RoomQueryComplete);
+		++NumRoomQueriesInFlight;
 		RoomQuery->LoadFromJson(*RoomJson);
 	}
+	DiscoveryComplete = true;
+	TryFinishQuery();
 }
 
 void UMRUKSceneData::FinishQuery(bool Success)
 {
-	if (!Success)
+	if (Status != EMRUKInitStatus::Busy && Status != EMRUKInitStatus::None)
 	{
-		AnyRoomFailed = true;
+		return;
 	}
-	--NumRoomsLeftToInitialize;
-	if (NumRoomsLeftToInitialize <= 0)
+	Status = Success ? EMRUKInitStatus::Complete : EMRUKInitStatus::Failed;
+	OnComplete.Broadcast(Success);
+}
+
+void UMRUKSceneData::StartRoomQueries()
+{
+	while (!PendingRoomQueries.IsEmpty() && NumRoomQueriesInFlight < FMath::Max(MaxConcurrentRoomQueries, 1))
 	{
-		OnComplete.Broadcast(!AnyRoomFailed);
+		UMRUKRoomData* RoomQuery = PendingRoomQueries[0];
+		PendingRoomQueries.RemoveAt(0);
+		++NumRoomQueriesInFlight;
+		// May complete right away, which starts the next query from RoomQueryComplete()
+		RoomQuery->LoadFromDevice(RoomQuery->SpaceQuery, MaxAnchorQueries);
 	}
 }
 
-void UMRUKSceneData::SceneDataLoadedResult(EOculusXRAnchorResult::Type Result)
+void UMRUKSceneData::TryFinishQuery()
 {
-	if (!UOculusXRAnchorBPFunctionLibrary::IsAnchorResultSuccess(Result) || RoomsData.IsEmpty())
+	if (DiscoveryComplete && PendingRoomQueries.IsEmpty() && NumRoomQueriesInFlight == 0)
 	{
-		UE_LOG(LogMRUK, Error, TEXT("Discovering room layouts failed"));
-		FinishQuery(false);
+		FinishQuery(!AnyRoomFailed && !RoomsData.IsEmpty());
 	}
 }
 
-void UMRUKSceneData::SceneDataLoadedComplete(const TArray<FOculusXRAnchorsDiscoverResult>& DiscoverResults)
+void UMRUKSceneData::SceneDataLoadedResult(EOculusXRAnchorResult::Type Result)
 {
-	NumRoomsLeftToInitialize = DiscoverResults.Num();
-	UE_LOG(LogMRUK, Log, TEXT("Found on %d rooms on the device"), NumRoomsLeftToInitialize);
+	DiscoveryComplete = true;
+	UE_LOG(LogMRUK, Log, TEXT("Found %d rooms on the device"), RoomsData.Num());
 
 #if WITH_EDITOR
 	if (OculusXRTelemetry::IsActive())
 	{
 		MRUKTelemetry::FLoadSceneFromDeviceMarker()
 			.Start()
-			.AddAnnotation("NumRooms", TCHAR_TO_ANSI(*FString::FromInt(DiscoverResults.Num())))
-			.End(DiscoverResults.Num() > 0 ? OculusXRTelemetry::EAction::Success : OculusXRTelemetry::EAction::Fail);
+			.AddAnnotation("NumRooms", TCHAR_TO_ANSI(*FString::FromInt(RoomsData.Num())))
+			.End(RoomsData.Num() > 0 ? OculusXRTelemetry::EAction::Success : OculusXRTelemetry::EAction::Fail);
 	}
 #endif
 
-	if (NumRoomsLeftToInitialize == 0)
+	if (!UOculusXRAnchorBPFunctionLibrary::IsAnchorResultSuccess(Result))
+	{
+		UE_LOG(LogMRUK, Error, TEXT("Discovering room layouts failed"));
+		AnyRoomFailed = true;
+	}
+	else if (RoomsData.IsEmpty())
 	{
 		UE_LOG(LogMRUK, Error, TEXT("No room layouts discovered"));
-		FinishQuery(false);
-		return;
 	}
 
+	// Rooms that are still loading finish the query once they are done
+	TryFinishQuery();
+}
+
+void UMRUKSceneData::SceneDataLoadedComplete(const TArray<FOculusXRAnchorsDiscoverResult>& DiscoverResults)
+{
+	UE_LOG(LogMRUK, Log, TEXT("Received %d rooms from device"), DiscoverResults.Num());
+
+	// Start loading the rooms of this batch right away instead of waiting for the whole discovery
 	for (auto& DiscoverResult : DiscoverResults)
 	{
 		auto RoomQuery = NewObject<UMRUKRoomData>(this);
-		RoomsData.Push(RoomQuery);
+		RoomQuery->Discovery = Discovery;
+		RoomQuery->SpaceQuery = DiscoverResult;
 		RoomQuery->OnComplete.AddDynamic(this, &UMRUKSceneData::RoomQueryComplete);
-		RoomQuery->LoadFromDevice(DiscoverResult);
+		RoomsData.Push(RoomQuery);
+		PendingRoomQueries.Push(RoomQuery);
 	}
+	StartRoomQueries();
 }
 
-void UMRUKSceneData::RoomQueryComplete(bool Success)
+void UMRUKSceneData::RoomQueryComplete(UMRUKRoomData* RoomData, bool Success)
 {
-	if (!Success)
+	--NumRoomQueriesInFlight;
+	if (Success)
 	{
-		AnyRoomFailed = true;
+		OnRoomLoaded.Broadcast(RoomData);
 	}
-	--NumRoomsLeftToInitialize;
-	if (NumRoomsLeftToInitialize == 0)
+	else
 	{
-		FinishQuery(!AnyRoomFailed);
+		AnyRoomFailed = true;
 	}
+
+	StartRoomQueries();
+	TryFinishQuery();
 }
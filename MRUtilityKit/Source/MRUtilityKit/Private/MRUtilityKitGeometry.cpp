@@ -229,3 +229,167 @@ FMRUKOutline MRUKComputeOutline(const TArray<FVector2D>& Vertices, TArray<TArray
 
 	return Outline;
 }
+
+bool MRUKIsPositionInPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Position)
+{
+	if (Polygon.IsEmpty())
+	{
+		return false;
+	}
+
+	int Intersections = 0;
+
+	for (int i = 1; i <= Polygon.Num(); i++)
+	{
+		const FVector2D P1 = Polygon[i - 1];
+		const FVector2D P2 = Polygon[i % Polygon.Num()];
+		if (Position.Y > FMath::Min(P1.Y, P2.Y) && Position.Y <= FMath::Max(P1.Y, P2.Y))
+		{
+			if (Position.X <= FMath::Max(P1.X, P2.X))
+			{
+				if (P1.Y != P2.Y)
+				{
+					const auto Frac = (Position.Y - P1.Y) / (P2.Y - P1.Y);
+					const auto XIntersection = P1.X + Frac * (P2.X - P1.X);
+					if (P1.X == P2.X || Position.X <= XIntersection)
+					{
+						Intersections++;
+					}
+				}
+			}
+		}
+	}
+
+	return Intersections % 2 == 1;
+}
+
+bool MRUKRaycastPlane(const FRay& LocalRay, float MaxDist, const FBox2D& PlaneBounds, const TArray<FVector2D>& PlaneBoundary, FMRUKHit& OutLocalHit)
+{
+	// If the ray is behind or parallel to the anchor's plane then ignore it
+	if (LocalRay.Direction.X >= UE_KINDA_SMALL_NUMBER)
+	{
+		// Distance to the plane from the ray origin along the ray's direction
+		const float Dist = -LocalRay.Origin.X / LocalRay.Direction.X;
+		// If the distance is negative or less than the maximum distance then ignore it
+		if (Dist >= 0.0f && (MaxDist <= 0 || Dist < MaxDist))
+		{
+			const FVector HitPos = LocalRay.PointAt(Dist);
+			// Ensure the hit is within the plane extends and within the boundary
+			const FVector2D Pos2D(HitPos.Y, HitPos.Z);
+			if (PlaneBounds.IsInside(Pos2D) && MRUKIsPositionInPolygon(PlaneBoundary, Pos2D))
+			{
+				OutLocalHit.HitPosition = HitPos;
+				OutLocalHit.HitNormal = -FVector::XAxisVector;
+				OutLocalHit.HitDistance = Dist;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool MRUKRaycastVolume(const FRay& LocalRay, float MaxDist, const FBox& VolumeBounds, FMRUKHit& OutLocalHit)
+{
+	// Use the slab method to determine if the ray intersects with the bounding box
+	// https://education.siggraph.org/static/HyperGraph/raytrace/rtinter3.htm
+	float DistNear = -UE_BIG_NUMBER, DistFar = UE_BIG_NUMBER;
+	int HitAxis = 0;
+	for (int i = 0; i < 3; ++i)
+	{
+		if (FMath::Abs(LocalRay.Direction.Component(i)) >= UE_KINDA_SMALL_NUMBER)
+		{
+			// Distance to the plane from the ray origin along the ray's direction
+			float Dist1 = (VolumeBounds.Min.Component(i) - LocalRay.Origin.Component(i)) / LocalRay.Direction.Component(i);
+			float Dist2 = (VolumeBounds.Max.Component(i) - LocalRay.Origin.Component(i)) / LocalRay.Direction.Component(i);
+
+			if (Dist1 > Dist2)
+			{
+				std::swap(Dist1, Dist2);
+			}
+			if (Dist1 > DistNear)
+			{
+				DistNear = Dist1;
+				HitAxis = i;
+			}
+			if (Dist2 < DistFar)
+			{
+				DistFar = Dist2;
+			}
+		}
+		else
+		{
+			// In this case there is no intersection because the ray is parallel to the plane
+			// Check that it is within bounds
+			if (LocalRay.Origin.Component(i) < VolumeBounds.Min.Component(i) || LocalRay.Origin.Component(i) > VolumeBounds.Max.Component(i))
+			{
+				// No intersection, set DistNear to a large number
+				DistNear = UE_BIG_NUMBER;
+				break;
+			}
+		}
+	}
+	if (DistNear >= 0 && DistNear <= DistFar && (MaxDist <= 0 || DistNear < MaxDist))
+	{
+		FVector HitNormal = FVector::ZeroVector;
+		HitNormal.Component(HitAxis) = LocalRay.Direction.Component(HitAxis) > 0 ? -1 : 1;
+		OutLocalHit.HitPosition = LocalRay.PointAt(DistNear);
+		OutLocalHit.HitNormal = HitNormal;
+		OutLocalHit.HitDistance = DistNear;
+		return true;
+	}
+	return false;
+}
+
+float MRUKComputeTriangleAreas(const TArray<FVector2D>& Vertices, const TArray<int32>& Triangles, TArray<float>& OutAreas)
+{
+	OutAreas.Reset(Triangles.Num() / 3);
+	float TotalArea = 0.0f;
+	for (int i = 0; i < Triangles.Num(); i += 3)
+	{
+		const auto V0 = Vertices[Triangles[i]];
+		const auto V1 = Vertices[Triangles[i + 1]];
+		const auto V2 = Vertices[Triangles[i + 2]];
+		const auto Cross = FVector2D::CrossProduct(V1 - V0, V2 - V0);
+		float Area = Cross * 0.5f;
+		TotalArea += Area;
+		OutAreas.Add(Area);
+	}
+	return TotalArea;
+}
+
+FVector2D MRUKRandomPositionOnTriangles(const TArray<FVector2D>& Vertices, const TArray<int32>& Triangles, const TArray<float>& Areas, float TotalArea, const FRandomStream& RandomStream)
+{
+	// Pick a random triangle weighted by surface area (triangles with larger surface
+	// area have more chance of being chosen)
+	auto Rand = RandomStream.FRandRange(0.0f, TotalArea);
+	int TriangleIndex = 0;
+	for (; TriangleIndex < Areas.Num() - 1; ++TriangleIndex)
+	{
+		Rand -= Areas[TriangleIndex];
+		if (Rand <= 0.0f)
+		{
+			break;
+		}
+	}
+
+	// Get the vertices of the chosen triangle
+	const auto V0 = Vertices[Triangles[TriangleIndex * 3]];
+	const auto V1 = Vertices[Triangles[TriangleIndex * 3 + 1]];
+	const auto V2 = Vertices[Triangles[TriangleIndex * 3 + 2]];
+
+	// Calculate a random point on that triangle
+	float U = RandomStream.FRandRange(0.0f, 1.0f);
+	float V = RandomStream.FRandRange(0.0f, 1.0f);
+	if (U + V > 1.0f)
+	{
+		if (U > V)
+		{
+			U = 1.0f - U;
+		}
+		else
+		{
+			V = 1.0f - V;
+		}
+	}
+	return V0 + U * (V1 - V0) + V * (V2 - V0);
+}
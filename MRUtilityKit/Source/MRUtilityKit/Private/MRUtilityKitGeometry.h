@@ -19,3 +19,31 @@ TArray<int32> MRUKTriangulatePoints(const TArray<FVector2D>& Vertices);
 TArray<int32> MRUKTriangulateMesh(const FMRUKOutline& Outline);
 
 FMRUKOutline MRUKComputeOutline(const TArray<FVector2D>& Vertices, TArray<TArray<FVector2D>> Holes);
+
+struct FMRUKHit;
+
+/**
+ * Ray crossing test of a position against a closed polygon, e.g. the plane boundary of an anchor.
+ */
+bool MRUKIsPositionInPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Position);
+
+/**
+ * Intersects a ray with the plane of an anchor. The ray and the hit are in the local space of the anchor.
+ */
+bool MRUKRaycastPlane(const FRay& LocalRay, float MaxDist, const FBox2D& PlaneBounds, const TArray<FVector2D>& PlaneBoundary, FMRUKHit& OutLocalHit);
+
+/**
+ * Intersects a ray with the volume of an anchor. The ray and the hit are in the local space of the anchor.
+ */
+bool MRUKRaycastVolume(const FRay& LocalRay, float MaxDist, const FBox& VolumeBounds, FMRUKHit& OutLocalHit);
+
+/**
+ * Computes the area of each triangle of a triangulated polygon.
+ * @return The total area.
+ */
+float MRUKComputeTriangleAreas(const TArray<FVector2D>& Vertices, const TArray<int32>& Triangles, TArray<float>& OutAreas);
+
+/**
+ * Picks a uniformly distributed position on a triangulated polygon, triangles are chosen weighted by their area.
+ */
+FVector2D MRUKRandomPositionOnTriangles(const TArray<FVector2D>& Vertices, const TArray<int32>& Triangles, const TArray<float>& Areas, float TotalArea, const FRandomStream& RandomStream);
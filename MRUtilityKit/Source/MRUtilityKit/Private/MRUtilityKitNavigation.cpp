@@ -0,0 +1,811 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+
+#include "MRUtilityKitNavigation.h"
+#include "MRUtilityKitSubsystem.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitAnchor.h"
+#include "ProceduralMeshComponent.h"
+#include "Engine/GameInstance.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+	constexpr double NavEpsilon = 0.01; // 0.1 mm
+
+	struct FNavEdge
+	{
+		FVector2D A;
+		FVector2D B;
+
+		double GetYAt(double X) const
+		{
+			const double T = (X - A.X) / (B.X - A.X);
+			return A.Y + T * (B.Y - A.Y);
+		}
+	};
+
+	double Cross2D(const FVector2D& U, const FVector2D& V)
+	{
+		return U.X * V.Y - U.Y * V.X;
+	}
+
+	double SignedArea(const TArray<FVector2D>& Polygon)
+	{
+		double Area = 0.0;
+		for (int32 I = 0; I < Polygon.Num(); ++I)
+		{
+			Area += Cross2D(Polygon[I], Polygon[(I + 1) % Polygon.Num()]);
+		}
+		return 0.5 * Area;
+	}
+
+	bool IsPointInPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+	{
+		bool bInside = false;
+		for (int32 I = 0, J = Polygon.Num() - 1; I < Polygon.Num(); J = I++)
+		{
+			const FVector2D& P1 = Polygon[I];
+			const FVector2D& P2 = Polygon[J];
+			if ((P1.Y > Point.Y) != (P2.Y > Point.Y) && Point.X < (P2.X - P1.X) * (Point.Y - P1.Y) / (P2.Y - P1.Y) + P1.X)
+			{
+				bInside = !bInside;
+			}
+		}
+		return bInside;
+	}
+
+	/**
+	 * Move every edge of the polygon by Distance along its normal. Positive distances grow counter clockwise
+	 * polygons. Corners are mitered, very sharp corners are clamped so they don't produce long spikes.
+	 */
+	TArray<FVector2D> OffsetPolygon(const TArray<FVector2D>& Polygon, double Distance)
+	{
+		const int32 Num = Polygon.Num();
+		TArray<FVector2D> Result;
+		Result.Reserve(Num);
+		for (int32 I = 0; I < Num; ++I)
+		{
+			const FVector2D& Prev = Polygon[(I + Num - 1) % Num];
+			const FVector2D& Curr = Polygon[I];
+			const FVector2D& Next = Polygon[(I + 1) % Num];
+
+			const FVector2D DirIn = (Curr - Prev).GetSafeNormal();
+			const FVector2D DirOut = (Next - Curr).GetSafeNormal();
+			// Outward normals of a counter clockwise polygon
+			const FVector2D NormalIn(DirIn.Y, -DirIn.X);
+			const FVector2D NormalOut(DirOut.Y, -DirOut.X);
+
+			FVector2D Miter = NormalIn + NormalOut;
+			const double MiterLengthSquared = Miter.SizeSquared();
+			if (MiterLengthSquared < UE_KINDA_SMALL_NUMBER)
+			{
+				Result.Add(Curr + NormalOut * Distance);
+				continue;
+			}
+			// Scale the bisector so both offset edges are at the requested distance
+			const double Scale = FMath::Min(2.0 / MiterLengthSquared, 4.0);
+			Result.Add(Curr + Miter * (Scale * Distance));
+		}
+		return Result;
+	}
+
+	bool IntersectSegments(const FNavEdge& E1, const FNavEdge& E2, FVector2D& OutPoint)
+	{
+		const FVector2D R = E1.B - E1.A;
+		const FVector2D S = E2.B - E2.A;
+		const double Denominator = Cross2D(R, S);
+		if (FMath::Abs(Denominator) < UE_DOUBLE_SMALL_NUMBER)
+		{
+			return false;
+		}
+		const FVector2D AToC = E2.A - E1.A;
+		const double T = Cross2D(AToC, S) / Denominator;
+		const double U = Cross2D(AToC, R) / Denominator;
+		if (T < 0.0 || T > 1.0 || U < 0.0 || U > 1.0)
+		{
+			return false;
+		}
+		OutPoint = E1.A + R * T;
+		return true;
+	}
+
+	void AddPolygonEdges(const TArray<FVector2D>& Polygon, TArray<FNavEdge>& OutEdges)
+	{
+		for (int32 I = 0; I < Polygon.Num(); ++I)
+		{
+			FVector2D A = Polygon[I];
+			FVector2D B = Polygon[(I + 1) % Polygon.Num()];
+			// Vertical edges lie on slab boundaries and never bound a cell
+			if (FMath::Abs(B.X - A.X) < NavEpsilon)
+			{
+				continue;
+			}
+			if (A.X > B.X)
+			{
+				Swap(A, B);
+			}
+			OutEdges.Add({ A, B });
+		}
+	}
+} // namespace
+
+double FMRUKNavCell::GetBottomY(double X) const
+{
+	const double T = MaxX > MinX ? (X - MinX) / (MaxX - MinX) : 0.0;
+	return FMath::Lerp(Bottom.X, Bottom.Y, T);
+}
+
+double FMRUKNavCell::GetTopY(double X) const
+{
+	const double T = MaxX > MinX ? (X - MinX) / (MaxX - MinX) : 0.0;
+	return FMath::Lerp(Top.X, Top.Y, T);
+}
+
+bool FMRUKNavCell::Contains(const FVector2D& Point, double Tolerance) const
+{
+	if (Point.X < MinX - Tolerance || Point.X > MaxX + Tolerance)
+	{
+		return false;
+	}
+	const double X = FMath::Clamp(Point.X, MinX, MaxX);
+	return Point.Y >= GetBottomY(X) - Tolerance && Point.Y <= GetTopY(X) + Tolerance;
+}
+
+FVector2D FMRUKNavCell::ClosestPoint(const FVector2D& Point) const
+{
+	if (Contains(Point))
+	{
+		return Point;
+	}
+
+	const FVector2D Corners[4] = {
+		FVector2D(MinX, Bottom.X),
+		FVector2D(MaxX, Bottom.Y),
+		FVector2D(MaxX, Top.Y),
+		FVector2D(MinX, Top.X),
+	};
+	FVector2D Closest = Corners[0];
+	double ClosestDistanceSquared = DBL_MAX;
+	for (int32 I = 0; I < 4; ++I)
+	{
+		const FVector2D Candidate = FMath::ClosestPointOnSegment2D(Point, Corners[I], Corners[(I + 1) % 4]);
+		const double DistanceSquared = FVector2D::DistSquared(Candidate, Point);
+		if (DistanceSquared < ClosestDistanceSquared)
+		{
+			ClosestDistanceSquared = DistanceSquared;
+			Closest = Candidate;
+		}
+	}
+	return Closest;
+}
+
+FVector2D FMRUKNavCell::GetCentroid() const
+{
+	const double MidX = 0.5 * (MinX + MaxX);
+	return FVector2D(MidX, 0.5 * (GetBottomY(MidX) + GetTopY(MidX)));
+}
+
+double FMRUKNavCell::GetArea() const
+{
+	return 0.5 * ((Top.X - Bottom.X) + (Top.Y - Bottom.Y)) * (MaxX - MinX);
+}
+
+void FMRUKNavigationData::Reset()
+{
+	// The floor transform is kept, it is set up before building from a room
+	Cells.Reset();
+	SlabX.Reset();
+	SlabCellStart.Reset();
+	BuildTime = 0.0;
+}
+
+bool FMRUKNavigationData::Build(const TArray<FVector2D>& Boundary, const TArray<TArray<FVector2D>>& Obstacles, double AgentRadius)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	Reset();
+
+	if (Boundary.Num() < 3)
+	{
+		return false;
+	}
+
+	// Erode the floor and grow the obstacles by the agent radius so the agent center can move freely inside the cells
+	TArray<FVector2D> WalkableBoundary = Boundary;
+	if (SignedArea(WalkableBoundary) < 0.0)
+	{
+		Algo::Reverse(WalkableBoundary);
+	}
+	WalkableBoundary = OffsetPolygon(WalkableBoundary, -AgentRadius);
+
+	TArray<TArray<FVector2D>> Blocked;
+	Blocked.Reserve(Obstacles.Num());
+	for (const TArray<FVector2D>& Obstacle : Obstacles)
+	{
+		if (Obstacle.Num() < 3)
+		{
+			continue;
+		}
+		TArray<FVector2D>& Footprint = Blocked.Add_GetRef(Obstacle);
+		if (SignedArea(Footprint) < 0.0)
+		{
+			Algo::Reverse(Footprint);
+		}
+		Footprint = OffsetPolygon(Footprint, AgentRadius);
+	}
+
+	TArray<FNavEdge> Edges;
+	AddPolygonEdges(WalkableBoundary, Edges);
+	for (const TArray<FVector2D>& Footprint : Blocked)
+	{
+		AddPolygonEdges(Footprint, Edges);
+	}
+
+	// Slab boundaries are at every vertex and every edge intersection, so edges never cross inside a slab
+	TArray<double> Breaks;
+	for (const FNavEdge& Edge : Edges)
+	{
+		Breaks.Add(Edge.A.X);
+		Breaks.Add(Edge.B.X);
+	}
+	for (int32 I = 0; I < Edges.Num(); ++I)
+	{
+		for (int32 J = I + 1; J < Edges.Num(); ++J)
+		{
+			FVector2D Intersection;
+			if (IntersectSegments(Edges[I], Edges[J], Intersection))
+			{
+				Breaks.Add(Intersection.X);
+			}
+		}
+	}
+	Breaks.Sort();
+	for (double X : Breaks)
+	{
+		if (SlabX.Num() == 0 || X - SlabX.Last() > NavEpsilon)
+		{
+			SlabX.Add(X);
+		}
+	}
+
+	TArray<const FNavEdge*> SlabEdges;
+	for (int32 Slab = 0; Slab + 1 < SlabX.Num(); ++Slab)
+	{
+		SlabCellStart.Add(Cells.Num());
+
+		const double X0 = SlabX[Slab];
+		const double X1 = SlabX[Slab + 1];
+		const double MidX = 0.5 * (X0 + X1);
+
+		SlabEdges.Reset();
+		for (const FNavEdge& Edge : Edges)
+		{
+			if (Edge.A.X <= X0 + NavEpsilon && Edge.B.X >= X1 - NavEpsilon)
+			{
+				SlabEdges.Add(&Edge);
+			}
+		}
+		SlabEdges.Sort([MidX](const FNavEdge& A, const FNavEdge& B) { return A.GetYAt(MidX) < B.GetYAt(MidX); });
+
+		for (int32 I = 0; I + 1 < SlabEdges.Num(); ++I)
+		{
+			const FNavEdge& Lower = *SlabEdges[I];
+			const FNavEdge& Upper = *SlabEdges[I + 1];
+			const double LowerMid = Lower.GetYAt(MidX);
+			const double UpperMid = Upper.GetYAt(MidX);
+			if (UpperMid - LowerMid < NavEpsilon)
+			{
+				continue;
+			}
+
+			const FVector2D Sample(MidX, 0.5 * (LowerMid + UpperMid));
+			if (!IsPointInPolygon(WalkableBoundary, Sample))
+			{
+				continue;
+			}
+			bool bBlocked = false;
+			for (const TArray<FVector2D>& Footprint : Blocked)
+			{
+				if (IsPointInPolygon(Footprint, Sample))
+				{
+					bBlocked = true;
+					break;
+				}
+			}
+			if (bBlocked)
+			{
+				continue;
+			}
+
+			FMRUKNavCell& Cell = Cells.AddDefaulted_GetRef();
+			Cell.MinX = X0;
+			Cell.MaxX = X1;
+			Cell.Bottom = FVector2D(Lower.GetYAt(X0), Lower.GetYAt(X1));
+			Cell.Top = FVector2D(Upper.GetYAt(X0), Upper.GetYAt(X1));
+		}
+	}
+	SlabCellStart.Add(Cells.Num());
+
+	// Link cells of neighbouring slabs that overlap on the shared boundary
+	for (int32 Slab = 0; Slab + 2 < SlabX.Num(); ++Slab)
+	{
+		const double X = SlabX[Slab + 1];
+		for (int32 A = SlabCellStart[Slab]; A < SlabCellStart[Slab + 1]; ++A)
+		{
+			for (int32 B = SlabCellStart[Slab + 1]; B < SlabCellStart[Slab + 2]; ++B)
+			{
+				const double Low = FMath::Max(Cells[A].Bottom.Y, Cells[B].Bottom.X);
+				const double High = FMath::Min(Cells[A].Top.Y, Cells[B].Top.X);
+				if (High - Low > NavEpsilon)
+				{
+					const FVector2D PortalMin(X, Low);
+					const FVector2D PortalMax(X, High);
+					Cells[A].Links.Add({ B, PortalMin, PortalMax });
+					Cells[B].Links.Add({ A, PortalMin, PortalMax });
+				}
+			}
+		}
+	}
+
+	BuildTime = FPlatformTime::Seconds() - StartTime;
+	return Cells.Num() > 0;
+}
+
+bool FMRUKNavigationData::BuildFromRoom(const AMRUKRoom* Room, double AgentRadius)
+{
+	Reset();
+	if (!Room || !Room->FloorAnchor)
+	{
+		return false;
+	}
+
+	const AMRUKAnchor* Floor = Room->FloorAnchor;
+	FloorTransform = Floor->GetTransform();
+
+	TArray<TArray<FVector2D>> Obstacles;
+	for (const AMRUKAnchor* Child : Floor->ChildAnchors)
+	{
+		if (!Child || !Child->VolumeBounds.IsValid)
+		{
+			continue;
+		}
+		// Volumes have their X axis pointing down, the footprint is spanned by Y and Z
+		const FBox& Bounds = Child->VolumeBounds;
+		const FTransform& ChildTransform = Child->GetTransform();
+		TArray<FVector2D>& Footprint = Obstacles.AddDefaulted_GetRef();
+		for (const FVector2D& Corner : { FVector2D(Bounds.Min.Y, Bounds.Min.Z), FVector2D(Bounds.Max.Y, Bounds.Min.Z), FVector2D(Bounds.Max.Y, Bounds.Max.Z), FVector2D(Bounds.Min.Y, Bounds.Max.Z) })
+		{
+			const FVector WorldPos = ChildTransform.TransformPosition(FVector(0.0, Corner.X, Corner.Y));
+			Footprint.Add(ToLocal(WorldPos));
+		}
+	}
+
+	return Build(Floor->PlaneBoundary2D, Obstacles, AgentRadius);
+}
+
+FVector FMRUKNavigationData::ToWorld(const FVector2D& Point) const
+{
+	return FloorTransform.TransformPositionNoScale(FVector(0.0, Point.X, Point.Y));
+}
+
+FVector2D FMRUKNavigationData::ToLocal(const FVector& Position) const
+{
+	const FVector LocalPos = FloorTransform.InverseTransformPositionNoScale(Position);
+	return FVector2D(LocalPos.Y, LocalPos.Z);
+}
+
+int32 FMRUKNavigationData::FindCell(const FVector2D& Point) const
+{
+	if (SlabX.Num() < 2 || Point.X < SlabX[0] || Point.X > SlabX.Last())
+	{
+		return INDEX_NONE;
+	}
+	const int32 Slab = FMath::Clamp(Algo::UpperBound(SlabX, Point.X) - 1, 0, SlabX.Num() - 2);
+	for (int32 I = SlabCellStart[Slab]; I < SlabCellStart[Slab + 1]; ++I)
+	{
+		if (Cells[I].Contains(Point, NavEpsilon))
+		{
+			return I;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FMRUKNavigationData::ProjectPoint(const FVector2D& Point, FVector2D& OutPoint) const
+{
+	const int32 ContainingCell = FindCell(Point);
+	if (ContainingCell != INDEX_NONE)
+	{
+		OutPoint = Point;
+		return ContainingCell;
+	}
+
+	int32 ClosestCell = INDEX_NONE;
+	double ClosestDistanceSquared = DBL_MAX;
+	for (int32 I = 0; I < Cells.Num(); ++I)
+	{
+		const FVector2D Candidate = Cells[I].ClosestPoint(Point);
+		const double DistanceSquared = FVector2D::DistSquared(Candidate, Point);
+		if (DistanceSquared < ClosestDistanceSquared)
+		{
+			ClosestDistanceSquared = DistanceSquared;
+			ClosestCell = I;
+			OutPoint = Candidate;
+		}
+	}
+	return ClosestCell;
+}
+
+bool FMRUKNavigationData::FindPath(const FVector2D& Start, const FVector2D& End, TArray<FVector2D>& OutPath) const
+{
+	OutPath.Reset();
+
+	FVector2D StartPoint, EndPoint;
+	const int32 StartCell = ProjectPoint(Start, StartPoint);
+	const int32 EndCell = ProjectPoint(End, EndPoint);
+	if (StartCell == INDEX_NONE || EndCell == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// A* over the cells, the position of a node is the midpoint of the portal it was entered through
+	struct FNode
+	{
+		double Cost = DBL_MAX;
+		int32 Parent = INDEX_NONE;
+		FVector2D Position;
+		bool bClosed = false;
+	};
+	TArray<FNode> Nodes;
+	Nodes.SetNum(Cells.Num());
+	Nodes[StartCell].Cost = 0.0;
+	Nodes[StartCell].Position = StartPoint;
+
+	typedef TPair<double, int32> FOpenEntry;
+	TArray<FOpenEntry> Open;
+	const auto Compare = [](const FOpenEntry& A, const FOpenEntry& B) { return A.Key < B.Key; };
+	Open.HeapPush(FOpenEntry(FVector2D::Distance(StartPoint, EndPoint), StartCell), Compare);
+
+	bool bFound = false;
+	while (Open.Num() > 0)
+	{
+		FOpenEntry Entry;
+		Open.HeapPop(Entry, Compare, EAllowShrinking::No);
+		const int32 Current = Entry.Value;
+		if (Nodes[Current].bClosed)
+		{
+			continue;
+		}
+		Nodes[Current].bClosed = true;
+		if (Current == EndCell)
+		{
+			bFound = true;
+			break;
+		}
+
+		for (const FMRUKNavLink& Link : Cells[Current].Links)
+		{
+			FNode& Neighbor = Nodes[Link.Cell];
+			if (Neighbor.bClosed)
+			{
+				continue;
+			}
+			const FVector2D Position = Link.Cell == EndCell ? EndPoint : 0.5 * (Link.PortalMin + Link.PortalMax);
+			const double Cost = Nodes[Current].Cost + FVector2D::Distance(Nodes[Current].Position, Position);
+			if (Cost < Neighbor.Cost)
+			{
+				Neighbor.Cost = Cost;
+				Neighbor.Parent = Current;
+				Neighbor.Position = Position;
+				Open.HeapPush(FOpenEntry(Cost + FVector2D::Distance(Position, EndPoint), Link.Cell), Compare);
+			}
+		}
+	}
+
+	if (!bFound)
+	{
+		return false;
+	}
+
+	TArray<int32> CellPath;
+	for (int32 Cell = EndCell; Cell != INDEX_NONE; Cell = Nodes[Cell].Parent)
+	{
+		CellPath.Add(Cell);
+	}
+	Algo::Reverse(CellPath);
+
+	StringPull(StartPoint, EndPoint, CellPath, OutPath);
+	return true;
+}
+
+void FMRUKNavigationData::StringPull(const FVector2D& Start, const FVector2D& End, const TArray<int32>& CellPath, TArray<FVector2D>& OutPath) const
+{
+	// Portals as seen when walking along the path, left and right relative to the walking direction
+	TArray<FVector2D> Lefts;
+	TArray<FVector2D> Rights;
+	Lefts.Add(Start);
+	Rights.Add(Start);
+	for (int32 I = 0; I + 1 < CellPath.Num(); ++I)
+	{
+		const FMRUKNavCell& Cell = Cells[CellPath[I]];
+		const FMRUKNavLink* Link = Cell.Links.FindByPredicate([Next = CellPath[I + 1]](const FMRUKNavLink& L) { return L.Cell == Next; });
+		check(Link);
+		const bool bForward = Cells[CellPath[I + 1]].MinX >= Cell.MinX;
+		Lefts.Add(bForward ? Link->PortalMax : Link->PortalMin);
+		Rights.Add(bForward ? Link->PortalMin : Link->PortalMax);
+	}
+	Lefts.Add(End);
+	Rights.Add(End);
+
+	// Simple stupid funnel algorithm
+	OutPath.Add(Start);
+	FVector2D Apex = Start;
+	FVector2D Left = Lefts[0];
+	FVector2D Right = Rights[0];
+	int32 ApexIndex = 0, LeftIndex = 0, RightIndex = 0;
+
+	for (int32 I = 1; I < Lefts.Num(); ++I)
+	{
+		const FVector2D& NewLeft = Lefts[I];
+		const FVector2D& NewRight = Rights[I];
+
+		// Tighten the right side
+		if (Cross2D(Right - Apex, NewRight - Apex) >= 0.0)
+		{
+			if (Apex.Equals(Right) || Cross2D(Left - Apex, NewRight - Apex) < 0.0)
+			{
+				Right = NewRight;
+				RightIndex = I;
+			}
+			else
+			{
+				// Right crossed over left, left becomes a corner of the path
+				Apex = Left;
+				ApexIndex = LeftIndex;
+				OutPath.Add(Apex);
+				Left = Right = Apex;
+				LeftIndex = RightIndex = ApexIndex;
+				I = ApexIndex;
+				continue;
+			}
+		}
+
+		// Tighten the left side
+		if (Cross2D(Left - Apex, NewLeft - Apex) <= 0.0)
+		{
+			if (Apex.Equals(Left) || Cross2D(Right - Apex, NewLeft - Apex) > 0.0)
+			{
+				Left = NewLeft;
+				LeftIndex = I;
+			}
+			else
+			{
+				// Left crossed over right, right becomes a corner of the path
+				Apex = Right;
+				ApexIndex = RightIndex;
+				OutPath.Add(Apex);
+				Left = Right = Apex;
+				LeftIndex = RightIndex = ApexIndex;
+				I = ApexIndex;
+				continue;
+			}
+		}
+	}
+
+	if (!OutPath.Last().Equals(End))
+	{
+		OutPath.Add(End);
+	}
+}
+
+void FMRUKNavigationData::GetTriangles(TArray<FVector2D>& OutVertices, TArray<int32>& OutIndices) const
+{
+	OutVertices.Reset(Cells.Num() * 4);
+	OutIndices.Reset(Cells.Num() * 6);
+	for (const FMRUKNavCell& Cell : Cells)
+	{
+		const int32 Base = OutVertices.Num();
+		OutVertices.Add(FVector2D(Cell.MinX, Cell.Bottom.X));
+		OutVertices.Add(FVector2D(Cell.MaxX, Cell.Bottom.Y));
+		OutVertices.Add(FVector2D(Cell.MaxX, Cell.Top.Y));
+		OutVertices.Add(FVector2D(Cell.MinX, Cell.Top.X));
+		OutIndices.Append({ Base, Base + 1, Base + 2, Base, Base + 2, Base + 3 });
+	}
+}
+
+double FMRUKNavigationData::GetWalkableArea() const
+{
+	double Area = 0.0;
+	for (const FMRUKNavCell& Cell : Cells)
+	{
+		Area += Cell.GetArea();
+	}
+	return Area;
+}
+
+AMRUKNavigationGenerator::AMRUKNavigationGenerator()
+{
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("DefaultSceneRoot"));
+}
+
+void AMRUKNavigationGenerator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+	if (SpawnMode == EMRUKSpawnMode::CurrentRoomOnly)
+	{
+		if (AMRUKRoom* CurrentRoom = Subsystem->GetCurrentRoom())
+		{
+			BuildNavigationForRoom(CurrentRoom);
+		}
+		else
+		{
+			Subsystem->OnRoomCreated.AddUniqueDynamic(this, &AMRUKNavigationGenerator::OnRoomCreated);
+		}
+	}
+	else if (SpawnMode == EMRUKSpawnMode::AllRooms)
+	{
+		for (auto& Room : Subsystem->Rooms)
+		{
+			BuildNavigationForRoom(Room);
+		}
+		Subsystem->OnRoomCreated.AddUniqueDynamic(this, &AMRUKNavigationGenerator::OnRoomCreated);
+	}
+
+	if (SpawnMode != EMRUKSpawnMode::None)
+	{
+		Subsystem->OnRoomUpdated.AddUniqueDynamic(this, &AMRUKNavigationGenerator::OnRoomCreated);
+		Subsystem->OnRoomRemoved.AddUniqueDynamic(this, &AMRUKNavigationGenerator::OnRoomRemoved);
+	}
+}
+
+void AMRUKNavigationGenerator::OnRoomCreated(AMRUKRoom* Room)
+{
+	if (SpawnMode == EMRUKSpawnMode::CurrentRoomOnly && !NavigationData.IsEmpty() && !NavigationData.Contains(Room))
+	{
+		// Only one room should be handled in this mode
+		return;
+	}
+	BuildNavigationForRoom(Room);
+}
+
+void AMRUKNavigationGenerator::OnRoomRemoved(AMRUKRoom* Room)
+{
+	RemoveNavigationForRoom(Room);
+}
+
+bool AMRUKNavigationGenerator::BuildNavigationForRoom(AMRUKRoom* Room)
+{
+	if (!Room)
+	{
+		return false;
+	}
+
+	FMRUKNavigationData& Data = NavigationData.FindOrAdd(Room);
+	const bool bResult = Data.BuildFromRoom(Room, AgentRadius);
+	UE_LOG(LogMRUK, Log, TEXT("Built navigation for room %s: %d cells, %.2f m2 walkable in %.2f ms"),
+		*Room->GetName(), Data.GetCells().Num(), Data.GetWalkableArea() / 10000.0, Data.GetBuildTime() * 1000.0);
+
+	if (bCreateWalkableMesh)
+	{
+		UpdateWalkableMesh(Room, Data);
+	}
+	return bResult;
+}
+
+void AMRUKNavigationGenerator::RemoveNavigationForRoom(AMRUKRoom* Room)
+{
+	NavigationData.Remove(Room);
+
+	TObjectPtr<UProceduralMeshComponent> Mesh;
+	if (WalkableMeshes.RemoveAndCopyValue(Room, Mesh) && Mesh)
+	{
+		Mesh->DestroyComponent();
+	}
+}
+
+void AMRUKNavigationGenerator::UpdateWalkableMesh(AMRUKRoom* Room, const FMRUKNavigationData& Data)
+{
+	TObjectPtr<UProceduralMeshComponent>& Mesh = WalkableMeshes.FindOrAdd(Room);
+	if (!Mesh)
+	{
+		Mesh = NewObject<UProceduralMeshComponent>(this);
+		Mesh->SetupAttachment(RootComponent);
+		Mesh->RegisterComponent();
+		Mesh->SetCanEverAffectNavigation(true);
+	}
+
+	TArray<FVector2D> Vertices2D;
+	TArray<int32> Indices;
+	Data.GetTriangles(Vertices2D, Indices);
+
+	TArray<FVector> Vertices;
+	Vertices.Reserve(Vertices2D.Num());
+	for (const FVector2D& Vertex : Vertices2D)
+	{
+		Vertices.Add(Data.ToWorld(Vertex));
+	}
+	// Make sure the triangles face up in world space
+	if (Indices.Num() >= 3 && ((Vertices[Indices[1]] - Vertices[Indices[0]]) ^ (Vertices[Indices[2]] - Vertices[Indices[0]])).Z < 0.0)
+	{
+		for (int32 I = 0; I + 2 < Indices.Num(); I += 3)
+		{
+			Swap(Indices[I + 1], Indices[I + 2]);
+		}
+	}
+
+	Mesh->SetWorldTransform(FTransform::Identity);
+	Mesh->ClearAllMeshSections();
+	Mesh->CreateMeshSection(0, Vertices, Indices, {}, {}, {}, {}, true);
+	if (WalkableMeshMaterial)
+	{
+		Mesh->SetMaterial(0, WalkableMeshMaterial);
+	}
+}
+
+const FMRUKNavigationData* AMRUKNavigationGenerator::GetNavigationData(const AMRUKRoom* Room) const
+{
+	return NavigationData.Find(Room);
+}
+
+const FMRUKNavigationData* AMRUKNavigationGenerator::FindNavigationDataForPosition(const FVector& Position) const
+{
+	for (const auto& Entry : NavigationData)
+	{
+		if (Entry.Key && Entry.Key->IsPositionInRoom(Position, false))
+		{
+			return &Entry.Value;
+		}
+	}
+	return nullptr;
+}
+
+bool AMRUKNavigationGenerator::FindPath(const FVector& Start, const FVector& End, TArray<FVector>& OutPath) const
+{
+	OutPath.Reset();
+
+	const FMRUKNavigationData* Data = FindNavigationDataForPosition(Start);
+	if (!Data)
+	{
+		return false;
+	}
+
+	TArray<FVector2D> Path;
+	if (!Data->FindPath(Data->ToLocal(Start), Data->ToLocal(End), Path))
+	{
+		return false;
+	}
+
+	OutPath.Reserve(Path.Num());
+	for (const FVector2D& Point : Path)
+	{
+		OutPath.Add(Data->ToWorld(Point));
+	}
+	return true;
+}
+
+bool AMRUKNavigationGenerator::ProjectPosition(const FVector& Position, FVector& OutPosition) const
+{
+	const FMRUKNavigationData* Data = FindNavigationDataForPosition(Position);
+	FVector2D Projected;
+	if (!Data || Data->ProjectPoint(Data->ToLocal(Position), Projected) == INDEX_NONE)
+	{
+		return false;
+	}
+	OutPosition = Data->ToWorld(Projected);
+	return true;
+}
+
+bool AMRUKNavigationGenerator::IsPositionWalkable(const FVector& Position) const
+{
+	const FMRUKNavigationData* Data = FindNavigationDataForPosition(Position);
+	return Data && Data->FindCell(Data->ToLocal(Position)) != INDEX_NONE;
+}
@@ -0,0 +1,186 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+
+#include "MRUtilityKitPoissonDisk.h"
+#include "MRUtilityKitAnchor.h"
+
+FMRUKPoissonDiskSampler::FMRUKPoissonDiskSampler(double InMinSpacing, const FRandomStream& InRandomStream)
+	: MinSpacing(FMath::Max(InMinSpacing, UE_KINDA_SMALL_NUMBER))
+	// The diagonal of a cell is the spacing, so there is at most one position per cell
+	, CellSize(MinSpacing / UE_SQRT_3)
+	, RandomStream(InRandomStream)
+{
+}
+
+void FMRUKPoissonDiskSampler::SampleSurfaces(const TArray<FMRUKSampleSurface>& Surfaces, float MinDistanceToEdge, FIsValidPosition IsValidPosition)
+{
+	TArray<FVector2D> Active;
+	for (const auto& Surface : Surfaces)
+	{
+		if (Positions.Num() >= MaxPositions)
+		{
+			return;
+		}
+
+		const FBox2D Usable(Surface.Bounds.Min + FVector2D(MinDistanceToEdge), Surface.Bounds.Max - FVector2D(MinDistanceToEdge));
+		const double LengthU = Surface.AxisU.Size();
+		const double LengthV = Surface.AxisV.Size();
+		if (Usable.Min.X > Usable.Max.X || Usable.Min.Y > Usable.Max.Y || LengthU < UE_KINDA_SMALL_NUMBER || LengthV < UE_KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		const auto TryAddOnSurface = [&](const FVector2D& Pos) {
+			if (!Usable.IsInsideOrOn(Pos))
+			{
+				return false;
+			}
+			if (Surface.IsPlane && !Surface.Anchor->IsPositionInBoundary(Pos))
+			{
+				return false;
+			}
+			if (!TryAdd(Surface.GetWorldPosition(Pos), Surface.Normal, IsValidPosition))
+			{
+				return false;
+			}
+			Active.Add(Pos);
+			return true;
+		};
+
+		// The surface may have been partially filled by other surfaces already, so a seed can take a few tries
+		for (int32 i = 0; i < NumCandidates; ++i)
+		{
+			const FVector2D Seed(RandomStream.FRandRange(Usable.Min.X, Usable.Max.X), RandomStream.FRandRange(Usable.Min.Y, Usable.Max.Y));
+			if (TryAddOnSurface(Seed))
+			{
+				break;
+			}
+		}
+
+		while (!Active.IsEmpty() && Positions.Num() < MaxPositions)
+		{
+			const int32 Index = RandomStream.RandRange(0, Active.Num() - 1);
+			const FVector2D Center = Active[Index];
+			bool bAdded = false;
+			for (int32 i = 0; i < NumCandidates && !bAdded; ++i)
+			{
+				const double Angle = RandomStream.FRandRange(0.0, UE_TWO_PI);
+				const double Distance = RandomStream.FRandRange(MinSpacing, 2.0 * MinSpacing);
+				double Sin, Cos;
+				FMath::SinCos(&Sin, &Cos, Angle);
+				bAdded = TryAddOnSurface(Center + FVector2D(Cos * Distance / LengthU, Sin * Distance / LengthV));
+			}
+			if (!bAdded)
+			{
+				Active.RemoveAtSwap(Index);
+			}
+		}
+	}
+}
+
+void FMRUKPoissonDiskSampler::SampleVolume(const FBox& Box, FIsValidPosition IsValidPosition)
+{
+	if (!Box.IsValid)
+	{
+		return;
+	}
+
+	TArray<FVector> Active;
+	const auto TryAddInVolume = [&](const FVector& Position) {
+		if (!Box.IsInsideOrOn(Position) || !TryAdd(Position, FVector::ZeroVector, IsValidPosition))
+		{
+			return false;
+		}
+		Active.Add(Position);
+		return true;
+	};
+
+	for (int32 i = 0; i < NumCandidates && Positions.Num() < MaxPositions; ++i)
+	{
+		if (TryAddInVolume(RandomStream.RandPointInBox(Box)))
+		{
+			break;
+		}
+	}
+
+	while (!Active.IsEmpty() && Positions.Num() < MaxPositions)
+	{
+		const int32 Index = RandomStream.RandRange(0, Active.Num() - 1);
+		const FVector Center = Active[Index];
+		bool bAdded = false;
+		for (int32 i = 0; i < NumCandidates && !bAdded; ++i)
+		{
+			const double Distance = RandomStream.FRandRange(MinSpacing, 2.0 * MinSpacing);
+			bAdded = TryAddInVolume(Center + RandomStream.VRand() * Distance);
+		}
+		if (!bAdded)
+		{
+			Active.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void FMRUKPoissonDiskSampler::GetRandomPositions(int32 Count, TArray<FVector>& OutPositions, TArray<FVector>& OutNormals) const
+{
+	TArray<int32> Indices;
+	Indices.Reserve(Positions.Num());
+	for (int32 i = 0; i < Positions.Num(); ++i)
+	{
+		Indices.Add(i);
+	}
+
+	// Partial Fisher-Yates shuffle, only the picked positions need to be shuffled
+	Count = FMath::Clamp(Count, 0, Positions.Num());
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Indices.Swap(i, RandomStream.RandRange(i, Indices.Num() - 1));
+		OutPositions.Add(Positions[Indices[i]]);
+		OutNormals.Add(Normals[Indices[i]]);
+	}
+}
+
+FIntVector FMRUKPoissonDiskSampler::GetCell(const FVector& Position) const
+{
+	return FIntVector(FMath::FloorToInt32(Position.X / CellSize), FMath::FloorToInt32(Position.Y / CellSize), FMath::FloorToInt32(Position.Z / CellSize));
+}
+
+bool FMRUKPoissonDiskSampler::IsFarEnough(const FVector& Position) const
+{
+	// Positions closer than the spacing are at most two cells away
+	const FIntVector Cell = GetCell(Position);
+	const double MinSpacingSquared = MinSpacing * MinSpacing;
+	for (int32 Z = -2; Z <= 2; ++Z)
+	{
+		for (int32 Y = -2; Y <= 2; ++Y)
+		{
+			for (int32 X = -2; X <= 2; ++X)
+			{
+				const int32* Index = Cells.Find(Cell + FIntVector(X, Y, Z));
+				if (Index && FVector::DistSquared(Positions[*Index], Position) < MinSpacingSquared)
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool FMRUKPoissonDiskSampler::TryAdd(const FVector& Position, const FVector& Normal, FIsValidPosition IsValidPosition)
+{
+	// The spacing check is cheap, so do it before the constraints of the caller
+	if (!IsFarEnough(Position) || !IsValidPosition(Position, Normal))
+	{
+		return false;
+	}
+
+	Cells.Add(GetCell(Position), Positions.Num());
+	Positions.Add(Position);
+	Normals.Add(Normal);
+	return true;
+}
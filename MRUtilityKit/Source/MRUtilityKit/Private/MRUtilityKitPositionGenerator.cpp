@@ -8,6 +8,17 @@ LICENSE file in the root directory of this source tree.
 
 #include "MRUtilityKitPositionGenerator.h"
 #include "MRUtilityKitSubsystem.h"
+#include "MRUtilityKitPoissonDisk.h"
+
+namespace
+{
+	// Smallest spacing between evenly distributed positions, in world units
+	constexpr double MinEvenSpacing = 1.0;
+	// The spacing is raised so that about this many positions per requested one are spread over the whole room
+	constexpr double EvenPositionsPerSpawn = 8.0;
+	// Sampling stops after this many positions per requested one
+	constexpr int32 MaxEvenPositionsPerSpawn = 16;
+} // namespace
 
 bool AMRUtilityKitPositionGenerator::CanSpawnBox(const UWorld* World, const FBox& Box, const FVector& SpawnPosition, const FQuat& SpawnRotation, const FCollisionQueryParams& QueryParams, const ECollisionChannel CollisionChannel)
 {
@@ -117,6 +128,127 @@ bool AMRUtilityKitPositionGenerator::GenerateRandomPositionsOnSurfaceInRoom(AMRU
 		}
 	}
 
+	if (RandomSpawnSettings.DistributeEvenly)
+	{
+		const auto CanSpawnAt = [&](const FVector& SpawnPosition, const FQuat& SpawnRotation) {
+			if (!RandomSpawnSettings.CheckOverlaps || !Bounds.IsValid)
+			{
+				return true;
+			}
+			const FBox WorldBounds(AdjustedBounds.Min + SpawnPosition - AdjustedBounds.GetCenter(), AdjustedBounds.Max + SpawnPosition - AdjustedBounds.GetCenter());
+			const FVector AdjustedSpawnPos = SpawnPosition + SpawnRotation * AdjustedBounds.GetCenter();
+			return CanSpawnBox(GetTickableGameObjectWorld(), WorldBounds, AdjustedSpawnPos, SpawnRotation, FCollisionQueryParams::DefaultQueryParam, RandomSpawnSettings.CollisionChannel);
+		};
+
+		const int32 Count = bInitializedAnchor ? 1 : RandomSpawnSettings.SpawnAmount;
+		if (Count <= 0)
+		{
+			return true;
+		}
+
+		// Every candidate runs the room queries and the overlap check. Spreading a few times the requested positions
+		// over the whole room is enough to pick from, so the spacing is raised on large surfaces instead of filling them.
+		// The actors don't overlap each other if the spacing is at least the diameter of their bounds.
+		const double SpawnRadius = Bounds.IsValid ? AdjustedBounds.GetExtent().Size() : 0.0;
+		double Spacing = FMath::Max3(static_cast<double>(RandomSpawnSettings.MinSpacing), 2.0 * SpawnRadius, MinEvenSpacing);
+
+		FBox SampleBounds(ForceInit);
+		TArray<FMRUKSampleSurface> Surfaces;
+		if (RandomSpawnSettings.SpawnLocations == EMRUKSpawnLocation::Floating)
+		{
+			if (!Room->FloorAnchor)
+			{
+				return false;
+			}
+			SampleBounds = Room->RoomBounds.ExpandBy(-MinRadius);
+			if (SampleBounds.IsValid)
+			{
+				Spacing = FMath::Max(Spacing, FMath::Pow(SampleBounds.GetVolume() / (Count * EvenPositionsPerSpawn), 1.0 / 3.0));
+			}
+		}
+		else
+		{
+			Room->GetSpawnSurfaces(RandomSpawnSettings.SpawnLocations, MinRadius, RandomSpawnSettings.Labels, Surfaces);
+			double UsableArea = 0.0;
+			for (const auto& Surface : Surfaces)
+			{
+				UsableArea += Surface.UsableArea;
+			}
+			Spacing = FMath::Max(Spacing, FMath::Sqrt(UsableArea / (Count * EvenPositionsPerSpawn)));
+		}
+		if (Spacing > RandomSpawnSettings.MinSpacing)
+		{
+			UE_LOG(LogMRUK, Verbose, TEXT("Raised the spacing of the evenly distributed positions in %s from %.1f to %.1f, the actor bounds are %.1f across"),
+				*Room->GetName(), RandomSpawnSettings.MinSpacing, Spacing, 2.0 * SpawnRadius);
+		}
+
+		FRandomStream RandomStream;
+		RandomStream.GenerateNewSeed();
+		FMRUKPoissonDiskSampler Sampler(Spacing, RandomStream);
+		Sampler.MaxPositions = Count * MaxEvenPositionsPerSpawn;
+		if (RandomSpawnSettings.SpawnLocations == EMRUKSpawnLocation::Floating)
+		{
+			FMRUKLabelFilter WallFilter;
+			WallFilter.IncludedLabels = { FMRUKLabels::WallFace };
+			Sampler.SampleVolume(SampleBounds, [&](const FVector& Position, const FVector&) {
+				if (!Room->IsPositionInRoom(Position))
+				{
+					return false;
+				}
+				FVector SurfacePos;
+				double SurfaceDistance;
+				if (MinRadius > 0.0f && Room->TryGetClosestSurfacePosition(Position, SurfacePos, SurfaceDistance, WallFilter, MinRadius))
+				{
+					return false;
+				}
+				if (Room->IsPositionInSceneVolume(Position, true, MinRadius))
+				{
+					return false;
+				}
+				return CanSpawnAt(Position, FQuat::Identity);
+			});
+		}
+		else
+		{
+			Sampler.SampleSurfaces(Surfaces, MinRadius, [&](const FVector& Position, const FVector& Normal) {
+				const FVector SpawnPosition = Position + Normal * BaseOffset;
+				const FVector Center = SpawnPosition + Normal * CenterOffset;
+				if (!Room->IsPositionInRoom(Center) || Room->IsPositionInSceneVolume(Center))
+				{
+					return false;
+				}
+				if (FMRUKHit Hit{}; Room->Raycast(SpawnPosition, Normal, RandomSpawnSettings.SurfaceClearanceDistance, RandomSpawnSettings.Labels, Hit))
+				{
+					return false;
+				}
+				return CanSpawnAt(SpawnPosition, FQuat::FindBetweenNormals(FVector::UpVector, Normal));
+			});
+		}
+
+		TArray<FVector> Positions;
+		TArray<FVector> Normals;
+		Sampler.GetRandomPositions(Count, Positions, Normals);
+		for (int32 i = 0; i < Positions.Num(); ++i)
+		{
+			// Positions in the room volume have no normal
+			const FVector& SpawnNormal = Normals[i];
+			const FVector SpawnPosition = Positions[i] + SpawnNormal * BaseOffset;
+			const FQuat SpawnRotation = SpawnNormal.IsNearlyZero() ? FQuat::Identity : FQuat::FindBetweenNormals(FVector::UpVector, SpawnNormal);
+			if (bInitializedAnchor)
+			{
+				RandomSpawnSettings.ActorInstance->SetActorLocationAndRotation(SpawnPosition, SpawnRotation);
+				return true;
+			}
+			OutTransforms.Add(FTransform(SpawnRotation, SpawnPosition, FVector::OneVector));
+		}
+		if (Positions.Num() < Count)
+		{
+			UE_LOG(LogMRUK, Verbose, TEXT("Generated %d of %d evenly distributed positions in %s with a spacing of %.1f"),
+				Positions.Num(), Count, *Room->GetName(), Spacing);
+		}
+		return Positions.Num() == Count;
+	}
+
 	int FoundPositions = 0;
 
 	for (int i = 0; i < RandomSpawnSettings.SpawnAmount; ++i)
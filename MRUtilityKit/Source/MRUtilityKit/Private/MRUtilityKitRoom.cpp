@@ -14,6 +14,7 @@ LICENSE file in the root directory of this source tree.
 #include "MRUtilityKitBPLibrary.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/WorldSettings.h"
 
 #define LOCTEXT_NAMESPACE "MRUtilityKitRoom"
 
@@ -290,7 +291,29 @@ void AMRUKRoom::InitializeRoom()
 	ComputeAnchorHierarchy();
 	ComputeSeats();
 	ComputeRoomEdges();
-	KeyWallAnchor = nullptr;
+	ComputeWallGraph();
+	ComputeAcousticProfile();
+	PublishSnapshot();
+}
+
+void AMRUKRoom::PublishSnapshot()
+{
+	// Tasks that still hold on to the previous snapshot keep it alive, it is never modified
+	Snapshot = FMRUKRoomSnapshot::Create(*this, ++SnapshotVersion);
+}
+
+void AMRUKRoom::ComputeWallGraph()
+{
+	// Only the walls that were added, removed or moved get relinked
+	WallGraph.SetRoomCorners(RoomEdges);
+	WallGraph.Update(WallAnchors);
+}
+
+void AMRUKRoom::ComputeAcousticProfile()
+{
+	const AWorldSettings* WorldSettings = GetWorldSettings();
+	const double WorldToMeters = WorldSettings ? WorldSettings->WorldToMeters : 100.0;
+	AcousticProfile = MRUKComputeRoomAcousticProfile(*this, GetDefault<UMRUKSettings>()->AcousticAbsorption, WorldToMeters);
 }
 
 void AMRUKRoom::ComputeRoomBounds()
@@ -485,6 +508,19 @@ void AMRUKRoom::ComputeSeats()
 			SeatsComponent->CalculateSeatPoses();
 		}
 	}
+
+	SeatReservations.Build(SeatAnchors);
+	bSeatsDirty = false;
+}
+
+FMRUKSeatIndex& AMRUKRoom::GetSeatIndex()
+{
+	if (bSeatsDirty)
+	{
+		SeatReservations.Build(SeatAnchors);
+		bSeatsDirty = false;
+	}
+	return SeatReservations;
 }
 
 void AMRUKRoom::ComputeRoomEdges()
@@ -592,12 +628,57 @@ bool AMRUKRoom::GenerateRandomPositionInRoomFromStream(FVector& OutPosition, con
 bool AMRUKRoom::GenerateRandomPositionOnSurface(EMRUKSpawnLocation SpawnLocation, float MinDistanceToEdge,
 	FMRUKLabelFilter LabelFilter, FVector& OutPosition, FVector& OutNormal)
 {
-	TArray<Surface> Surfaces;
+	TArray<FMRUKSampleSurface> Surfaces;
+	GetSpawnSurfaces(SpawnLocation, MinDistanceToEdge, LabelFilter, Surfaces);
 	float TotalUsableSurfaceArea = 0.0f;
-	const float MinWidth = 2.0f * MinDistanceToEdge;
+	for (const auto& Surface : Surfaces)
+	{
+		TotalUsableSurfaceArea += Surface.UsableArea;
+	}
 
 	OutPosition = FVector::ZeroVector;
 	OutNormal = FVector::ForwardVector;
+	if (Surfaces.Num() == 0)
+	{
+		return false;
+	}
+
+	constexpr int MaxIterations = 1000;
+	for (int i = 0; i < MaxIterations; ++i)
+	{
+		// Pick a random surface weighted by surface area (surfaces with a larger
+		// area have more chance of being chosen)
+		float Rand = FMath::RandRange(0.f, TotalUsableSurfaceArea);
+		int Index = 0;
+		for (; Index < Surfaces.Num() - 1; ++Index)
+		{
+			Rand -= Surfaces[Index].UsableArea;
+			if (Rand <= 0.0f)
+			{
+				break;
+			}
+		}
+		const FMRUKSampleSurface& Surface = Surfaces[Index];
+		const FBox2D& Bounds = Surface.Bounds;
+
+		FVector2D Pos = FVector2D(
+			FMath::RandRange(Bounds.Min.X + MinDistanceToEdge, Bounds.Max.X - MinDistanceToEdge),
+			FMath::RandRange(Bounds.Min.Y + MinDistanceToEdge, Bounds.Max.Y - MinDistanceToEdge));
+
+		if (Surface.IsPlane && !Surface.Anchor->IsPositionInBoundary(Pos))
+			continue;
+
+		OutPosition = Surface.GetWorldPosition(Pos);
+		OutNormal = Surface.Normal;
+		return true;
+	}
+	return false;
+}
+
+void AMRUKRoom::GetSpawnSurfaces(EMRUKSpawnLocation SpawnLocation, float MinDistanceToEdge, const FMRUKLabelFilter& LabelFilter, TArray<FMRUKSampleSurface>& OutSurfaces) const
+{
+	const float MinWidth = 2.0f * MinDistanceToEdge;
+
 	for (auto& Anchor : AllAnchors)
 	{
 		if (!LabelFilter.PassesFilter(Anchor->SemanticClassifications))
@@ -636,9 +717,16 @@ bool AMRUKRoom::GenerateRandomPositionOnSurface(EMRUKSpawnLocation SpawnLocation
 				const auto Size = Anchor->PlaneBounds.GetSize();
 				if (Size.X > MinWidth && Size.Y > MinWidth)
 				{
-					const float UsableArea = (Size.X - MinWidth) * (Size.Y - MinWidth);
-					TotalUsableSurfaceArea += UsableArea;
-					Surfaces.Add({ Anchor, UsableArea, true, Anchor->PlaneBounds, EMRUKBoxSide{} });
+					const FTransform& Transform = Anchor->ActorToWorld();
+					FMRUKSampleSurface& Surface = OutSurfaces.AddDefaulted_GetRef();
+					Surface.Anchor = Anchor;
+					Surface.Origin = Transform.GetLocation();
+					Surface.AxisU = Transform.TransformVector(FVector::RightVector);
+					Surface.AxisV = Transform.TransformVector(FVector::UpVector);
+					Surface.Normal = Transform.TransformVector(FVector::BackwardVector).GetSafeNormal();
+					Surface.Bounds = Anchor->PlaneBounds;
+					Surface.UsableArea = (Size.X - MinWidth) * (Size.Y - MinWidth);
+					Surface.IsPlane = true;
 				}
 			}
 		}
@@ -665,55 +753,20 @@ bool AMRUKRoom::GenerateRandomPositionOnSurface(EMRUKSpawnLocation SpawnLocation
 
 				if (const auto Size = Bound.GetSize(); Size.X > MinWidth && Size.Y > MinWidth)
 				{
-					const float UsableArea = (Size.X - MinWidth) * (Size.Y - MinWidth);
-					TotalUsableSurfaceArea += UsableArea;
-					Surfaces.Add({ Anchor, UsableArea, false, Bound, BoxSide });
+					// The face is a rectangle in world space, so it is fully described by its origin and the two axes
+					FMRUKSampleSurface& Surface = OutSurfaces.AddDefaulted_GetRef();
+					Surface.Anchor = Anchor;
+					Surface.Origin = GetWorldPos(FVector2D::ZeroVector, Anchor, BoxSide);
+					Surface.AxisU = GetWorldPos(FVector2D(1.0, 0.0), Anchor, BoxSide) - Surface.Origin;
+					Surface.AxisV = GetWorldPos(FVector2D(0.0, 1.0), Anchor, BoxSide) - Surface.Origin;
+					Surface.Normal = Anchor->ActorToWorld().TransformVector(GetNormalBoxSide(BoxSide)).GetSafeNormal();
+					Surface.Bounds = Bound;
+					Surface.UsableArea = (Size.X - MinWidth) * (Size.Y - MinWidth);
+					Surface.IsPlane = false;
 				}
 			}
 		}
 	}
-	if (Surfaces.Num() == 0)
-	{
-		return false;
-	}
-
-	constexpr int MaxIterations = 1000;
-	for (int i = 0; i < MaxIterations; ++i)
-	{
-		// Pick a random surface weighted by surface area (surfaces with a larger
-		// area have more chance of being chosen)
-		float Rand = FMath::RandRange(0.f, TotalUsableSurfaceArea);
-		int Index = 0;
-		for (; Index < Surfaces.Num() - 1; ++Index)
-		{
-			Rand -= Surfaces[Index].UsableArea;
-			if (Rand <= 0.0f)
-			{
-				break;
-			}
-		}
-		auto& [Anchor, UsableArea, IsPlane, Bounds, BoxSide] = Surfaces[Index];
-
-		FVector2D Pos = FVector2D(
-			FMath::RandRange(Bounds.Min.X + MinDistanceToEdge, Bounds.Max.X - MinDistanceToEdge),
-			FMath::RandRange(Bounds.Min.Y + MinDistanceToEdge, Bounds.Max.Y - MinDistanceToEdge));
-
-		if (IsPlane && !Anchor->IsPositionInBoundary(Pos))
-			continue;
-
-		if (IsPlane)
-		{
-			const FVector Pos3DPlane = Anchor->ActorToWorld().TransformPosition(FVector(0.f, Pos.X, Pos.Y));
-			OutPosition = Pos3DPlane;
-			OutNormal = Anchor->ActorToWorld().TransformVector(FVector::BackwardVector);
-			return true;
-		}
-
-		OutPosition = GetWorldPos(Pos, Anchor, BoxSide);
-		OutNormal = Anchor->ActorToWorld().TransformVector(GetNormalBoxSide(BoxSide));
-		return true;
-	}
-	return false;
 }
 
 AMRUKAnchor* AMRUKRoom::Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, const FMRUKLabelFilter& LabelFilter, FMRUKHit& OutHit)
@@ -778,7 +831,10 @@ void AMRUKRoom::ClearRoom()
 	SeatAnchors.Empty();
 	FloorAnchor = nullptr;
 	CeilingAnchor = nullptr;
-	KeyWallAnchor = nullptr;
+	WallGraph.Reset();
+	SeatReservations.Reset();
+	bSeatsDirty = false;
+	PublishSnapshot();
 }
 
 bool AMRUKRoom::DoesRoomHave(const TArray<FString>& Labels)
@@ -863,36 +919,74 @@ AMRUKAnchor* AMRUKRoom::TryGetClosestSeatPose(const FVector& RayOrigin, const FV
 	AMRUKAnchor* ClosestAnchor = nullptr;
 	double ClosestDot = DBL_MIN;
 
-	for (const auto& SeatAnchor : SeatAnchors)
+	for (const auto& Seat : GetSeatIndex().GetSeats())
 	{
-		if (!SeatAnchor)
+		const auto VecToSeat = (Seat.Pose.GetLocation() - RayOrigin).GetSafeNormal();
+		const auto ThisDot = RayDirection.Dot(VecToSeat);
+		if (ThisDot <= ClosestDot)
 		{
 			continue;
 		}
-		const auto SeatsComponent = SeatAnchor->FindComponentByClass<UMRUKSeatsComponent>();
-		if (!SeatsComponent)
-		{
-			continue;
-		}
-
-		for (const auto& SeatPose : SeatsComponent->SeatPoses)
-		{
-			const auto VecToSeat = (SeatPose.GetLocation() - RayOrigin).GetSafeNormal();
-			const auto ThisDot = RayDirection.Dot(VecToSeat);
-			if (ThisDot <= ClosestDot)
-			{
-				continue;
-			}
-			ClosestDot = ThisDot;
-			ClosestPose = SeatPose;
-			ClosestAnchor = SeatAnchor;
-		}
+		ClosestDot = ThisDot;
+		ClosestPose = Seat.Pose;
+		ClosestAnchor = Seat.Anchor;
 	}
 
 	OutSeatTransform = ClosestPose;
 	return ClosestAnchor;
 }
 
+bool AMRUKRoom::GetClosestFreeSeat(const FVector& Position, FMRUKSeat& OutSeat, FVector FacingDirection, double MaxFacingAngle)
+{
+	FMRUKSeatIndex& Seats = GetSeatIndex();
+	const int32 Seat = Seats.FindClosestFreeSeat(Position, FacingDirection, MaxFacingAngle);
+	if (Seat == INDEX_NONE)
+	{
+		return false;
+	}
+	OutSeat = Seats.GetSeats()[Seat];
+	return true;
+}
+
+bool AMRUKRoom::TryReserveClosestSeat(const FVector& Position, UObject* Occupant, FMRUKSeat& OutSeat, FVector FacingDirection, double MaxFacingAngle)
+{
+	if (!Occupant)
+	{
+		return false;
+	}
+	FMRUKSeatIndex& Seats = GetSeatIndex();
+	const int32 Seat = Seats.FindClosestFreeSeat(Position, FacingDirection, MaxFacingAngle);
+	if (Seat == INDEX_NONE || !Seats.Reserve(Seat, Occupant))
+	{
+		return false;
+	}
+	OutSeat = Seats.GetSeats()[Seat];
+	return true;
+}
+
+bool AMRUKRoom::ReserveSeat(AMRUKAnchor* Anchor, int32 SeatIndex, UObject* Occupant)
+{
+	FMRUKSeatIndex& Seats = GetSeatIndex();
+	return Seats.Reserve(Seats.FindSeat(Anchor, SeatIndex), Occupant);
+}
+
+bool AMRUKRoom::ReleaseSeat(AMRUKAnchor* Anchor, int32 SeatIndex)
+{
+	FMRUKSeatIndex& Seats = GetSeatIndex();
+	return Seats.Release(Seats.FindSeat(Anchor, SeatIndex));
+}
+
+void AMRUKRoom::ReleaseSeatsOf(UObject* Occupant)
+{
+	GetSeatIndex().ReleaseAll(Occupant);
+}
+
+UObject* AMRUKRoom::GetSeatOccupant(AMRUKAnchor* Anchor, int32 SeatIndex)
+{
+	FMRUKSeatIndex& Seats = GetSeatIndex();
+	return Seats.GetOccupant(Seats.FindSeat(Anchor, SeatIndex));
+}
+
 TArray<AMRUKAnchor*> AMRUKRoom::GetAnchorsByLabel(const FString& Label) const
 {
 	TArray<TObjectPtr<AMRUKAnchor>> Anchors;
@@ -1044,44 +1138,39 @@ AMRUKAnchor* AMRUKRoom::GetBestPoseFromRaycast(const FVector& RayOrigin, const F
 
 AMRUKAnchor* AMRUKRoom::GetKeyWall(double Tolerance)
 {
-	if (KeyWallAnchor)
+	return WallGraph.GetKeyWall(Tolerance);
+}
+
+bool AMRUKRoom::GetWallNeighbors(AMRUKAnchor* Wall, AMRUKAnchor*& OutLeftWall, AMRUKAnchor*& OutRightWall, double& OutLeftCornerAngle, double& OutRightCornerAngle) const
+{
+	OutLeftWall = nullptr;
+	OutRightWall = nullptr;
+	OutLeftCornerAngle = 0.0;
+	OutRightCornerAngle = 0.0;
+
+	const FMRUKWallNode* Node = WallGraph.FindNode(Wall);
+	if (!Node)
 	{
-		return KeyWallAnchor;
+		return false;
 	}
 
-	TArray<TObjectPtr<AMRUKAnchor>> SortedWalls = WallAnchors;
-	SortedWalls.Sort([](const AMRUKAnchor& a, const AMRUKAnchor& b) { return a.PlaneBounds.GetExtent().X < b.PlaneBounds.GetExtent().X; });
-	// Find the first one with no other walls behind it.
-	// SortedWalls is sorted from shortest side to longest
-	for (int i = SortedWalls.Num() - 1; i >= 0; --i)
+	const TArray<FMRUKWallNode>& Nodes = WallGraph.GetNodes();
+	if (Node->LeftIndex != INDEX_NONE)
 	{
-		const auto WallAnchor = SortedWalls[i];
-
-		bool NoPointsBehind = true;
-
-		// Loop through the other corners, making sure none is behind the wall in question
-		for (const auto& RoomEdge : RoomEdges)
-		{
-			auto VecToCorner = RoomEdge - WallAnchor->GetActorLocation();
-			// Due to anchor precision, we use a tolerance value.
-			// For example, an adjacent wall edge may be just behind the wall, leading to a false result
-			VecToCorner -= WallAnchor->GetActorForwardVector() * Tolerance;
-
-			NoPointsBehind &= (-WallAnchor->GetActorForwardVector()).Dot(VecToCorner) >= 0.0;
-			if (!NoPointsBehind)
-			{
-				break;
-			}
-		}
-
-		if (NoPointsBehind)
-		{
-			KeyWallAnchor = WallAnchor;
-			return WallAnchor;
-		}
+		OutLeftWall = Nodes[Node->LeftIndex].Wall;
+		OutLeftCornerAngle = Nodes[Node->LeftIndex].RightCornerAngle;
+	}
+	if (Node->RightIndex != INDEX_NONE)
+	{
+		OutRightWall = Nodes[Node->RightIndex].Wall;
+		OutRightCornerAngle = Node->RightCornerAngle;
 	}
+	return true;
+}
 
-	return nullptr;
+TArray<AMRUKAnchor*> AMRUKRoom::GetWallsInPerimeterOrder() const
+{
+	return WallGraph.GetPerimeterWalls();
 }
 
 AMRUKAnchor* AMRUKRoom::GetLargestSurface(const FString& Label)
@@ -1125,7 +1214,7 @@ void AMRUKRoom::AttachProceduralMeshToWalls(const TArray<FString>& CutHoleLabels
 
 void AMRUKRoom::ComputeWallMeshUVAdjustments(const TArray<FMRUKTexCoordModes>& WallTextureCoordinateModes, TArray<FMRUKAnchorWithPlaneUVs>& OutAnchorsWithPlaneUVs)
 {
-	TArray<TObjectPtr<AMRUKAnchor>> ConnectedWalls = ComputeConnectedWalls();
+	const TArray<TObjectPtr<AMRUKAnchor>>& ConnectedWalls = WallGraph.GetPerimeterWalls();
 	double Perimeter = 0.0;
 	for (const auto& WallAnchor : ConnectedWalls)
 	{
@@ -1302,62 +1391,40 @@ void AMRUKRoom::AttachProceduralMeshToWalls(const TArray<FMRUKTexCoordModes>& Wa
 	}
 }
 
-TArray<TObjectPtr<AMRUKAnchor>> AMRUKRoom::ComputeConnectedWalls() const
+TArray<AActor*> AMRUKRoom::SpawnInterior(const TMap<FString, FMRUKSpawnGroup>& SpawnGroups, const TArray<FString>& CutHoleLabels, UMaterialInterface* ProceduralMaterial, bool ShouldFallbackToProcedural)
 {
-	if (WallAnchors.IsEmpty())
-	{
-		return {};
-	}
-
-	TArray<TObjectPtr<AMRUKAnchor>> ConnectedWalls;
-	TArray<TObjectPtr<AMRUKAnchor>> RemainingWalls = WallAnchors;
-
-	for (int i = RemainingWalls.Num() - 1; i >= 0; --i)
-	{
-		if (RemainingWalls[i] == nullptr)
-		{
-			RemainingWalls.RemoveAt(i);
-		}
-	}
+	return SpawnInteriorFromStream(SpawnGroups, FRandomStream(NAME_None), CutHoleLabels, ProceduralMaterial, ShouldFallbackToProcedural);
+}
 
-	ConnectedWalls.Reserve(WallAnchors.Num());
-	ConnectedWalls.Push(RemainingWalls.Last());
-	RemainingWalls.Pop();
+TArray<AActor*> AMRUKRoom::SpawnInteriorFromStream(const TMap<FString, FMRUKSpawnGroup>& SpawnGroups, const FRandomStream& RandomStream, const TArray<FString>& CutHoleLabels, UMaterialInterface* ProceduralMaterial, bool ShouldFallbackToProcedural)
+{
+	FMRUKInteriorSpawnPlan Plan;
+	PlanInteriorSpawn(SpawnGroups, RandomStream, CutHoleLabels, ProceduralMaterial, ShouldFallbackToProcedural, Plan);
 
-	while (!RemainingWalls.IsEmpty())
+	TArray<AActor*> InteriorActors;
+	for (const auto& Step : Plan.Steps)
 	{
-		const auto PrevWall = ConnectedWalls.Last();
-		FVector LocalMaxEdge(0, PrevWall->PlaneBounds.Max.X, 0);
-		auto MaxEdge = PrevWall->GetTransform().TransformPosition(LocalMaxEdge);
-		int ClosestIndex = 0;
-		float ClosestDist = UE_MAX_FLT;
-		for (int i = 0; i < RemainingWalls.Num(); i++)
+		if (AActor* InteriorActor = ExecuteInteriorSpawnStep(Plan, Step))
 		{
-			const auto& WallAnchor = RemainingWalls[i];
-			FVector LocalMinEdge(0, WallAnchor->PlaneBounds.Min.X, 0);
-			auto MinEdge = WallAnchor->GetTransform().TransformPosition(LocalMinEdge);
-			const double Dist = FVector::Dist2D(MaxEdge, MinEdge);
-			if (Dist < ClosestDist)
-			{
-				ClosestDist = Dist;
-				ClosestIndex = i;
-			}
+			InteriorActors.Push(InteriorActor);
 		}
-		ConnectedWalls.Push(RemainingWalls[ClosestIndex]);
-		RemainingWalls.RemoveAt(ClosestIndex);
 	}
 
-	return ConnectedWalls;
-}
-
-TArray<AActor*> AMRUKRoom::SpawnInterior(const TMap<FString, FMRUKSpawnGroup>& SpawnGroups, const TArray<FString>& CutHoleLabels, UMaterialInterface* ProceduralMaterial, bool ShouldFallbackToProcedural)
-{
-	return SpawnInteriorFromStream(SpawnGroups, FRandomStream(NAME_None), CutHoleLabels, ProceduralMaterial, ShouldFallbackToProcedural);
+	return InteriorActors;
 }
 
-TArray<AActor*> AMRUKRoom::SpawnInteriorFromStream(const TMap<FString, FMRUKSpawnGroup>& SpawnGroups, const FRandomStream& RandomStream, const TArray<FString>& CutHoleLabels, UMaterialInterface* ProceduralMaterial, bool GlobalShouldFallbackToProcedural)
+void AMRUKRoom::PlanInteriorSpawn(const TMap<FString, FMRUKSpawnGroup>& SpawnGroups, const FRandomStream& RandomStream, const TArray<FString>& CutHoleLabels, UMaterialInterface* ProceduralMaterial, bool GlobalShouldFallbackToProcedural, FMRUKInteriorSpawnPlan& OutPlan)
 {
-	TArray<AActor*> InteriorActors;
+	OutPlan.Steps.Reset();
+	OutPlan.CutHoleLabels = CutHoleLabels;
+	OutPlan.ProceduralMaterial = ProceduralMaterial;
+
+	const auto AddStep = [&OutPlan](FMRUKInteriorSpawnStep::EType Type, AMRUKAnchor* Anchor) -> FMRUKInteriorSpawnStep& {
+		FMRUKInteriorSpawnStep& Step = OutPlan.Steps.AddDefaulted_GetRef();
+		Step.Type = Type;
+		Step.Anchor = Anchor;
+		return Step;
+	};
 
 	const auto ShouldFallbackToProcedural = [GlobalShouldFallbackToProcedural](const FMRUKSpawnGroup* Anchor) -> bool {
 		check(Anchor);
@@ -1378,21 +1445,21 @@ TArray<AActor*> AMRUKRoom::SpawnInteriorFromStream(const TMap<FString, FMRUKSpaw
 	if (!WallFace || (WallFace->Actors.IsEmpty() && ShouldFallbackToProcedural(WallFace)))
 	{
 		// If no wall mesh is given we want to spawn the walls procedural to make seamless UVs
-		AttachProceduralMeshToWalls(CutHoleLabels, ProceduralMaterial);
+		AddStep(FMRUKInteriorSpawnStep::EType::ProceduralWalls, nullptr);
 	}
 	const auto Floor = SpawnGroups.Find(FMRUKLabels::Floor);
 	if (FloorAnchor && (!Floor || (Floor->Actors.IsEmpty() && ShouldFallbackToProcedural(Floor))))
 	{
 		// Use metric scaling to match walls
 		const FVector2D Scale = FloorAnchor->PlaneBounds.GetSize() / WorldToMeters;
-		FloorAnchor->AttachProceduralMesh({ { FVector2D::ZeroVector, Scale } }, CutHoleLabels, true, ProceduralMaterial);
+		AddStep(FMRUKInteriorSpawnStep::EType::ProceduralPlane, FloorAnchor).PlaneUVs = { { FVector2D::ZeroVector, Scale } };
 	}
 	const auto Ceiling = SpawnGroups.Find(FMRUKLabels::Ceiling);
 	if (CeilingAnchor && (!Ceiling || (Ceiling->Actors.IsEmpty() && ShouldFallbackToProcedural(Ceiling))))
 	{
 		// Use metric scaling to match walls
 		const FVector2D Scale = CeilingAnchor->PlaneBounds.GetSize() / WorldToMeters;
-		CeilingAnchor->AttachProceduralMesh({ { FVector2D::ZeroVector, Scale } }, CutHoleLabels, true, ProceduralMaterial);
+		AddStep(FMRUKInteriorSpawnStep::EType::ProceduralPlane, CeilingAnchor).PlaneUVs = { { FVector2D::ZeroVector, Scale } };
 	}
 	const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
 
@@ -1404,7 +1471,7 @@ TArray<AActor*> AMRUKRoom::SpawnInteriorFromStream(const TMap<FString, FMRUKSpaw
 		}
 		if (Anchor->SemanticClassifications.IsEmpty())
 		{
-			Anchor->AttachProceduralMesh();
+			AddStep(FMRUKInteriorSpawnStep::EType::ProceduralMeshUnlabeled, Anchor);
 			continue;
 		}
 
@@ -1469,8 +1536,7 @@ TArray<AActor*> AMRUKRoom::SpawnInteriorFromStream(const TMap<FString, FMRUKSpaw
 			const auto& SpawnActor = SpawnGroup->Actors[Index];
 			if (SpawnActor.Actor)
 			{
-				auto InteriorActor = Anchor->SpawnInterior(SpawnActor.Actor, SpawnActor.MatchAspectRatio, SpawnActor.CalculateFacingDirection, SpawnActor.ScalingMode);
-				InteriorActors.Push(InteriorActor);
+				AddStep(FMRUKInteriorSpawnStep::EType::Actor, Anchor).SpawnActor = SpawnActor;
 			}
 			else
 			{
@@ -1481,11 +1547,38 @@ TArray<AActor*> AMRUKRoom::SpawnInteriorFromStream(const TMap<FString, FMRUKSpaw
 
 		if (SpawnProceduralMesh)
 		{
-			Anchor->AttachProceduralMesh(CutHoleLabels, true, ProceduralMaterial);
+			AddStep(FMRUKInteriorSpawnStep::EType::ProceduralMesh, Anchor);
 		}
 	}
+}
 
-	return InteriorActors;
+AActor* AMRUKRoom::ExecuteInteriorSpawnStep(const FMRUKInteriorSpawnPlan& Plan, const FMRUKInteriorSpawnStep& Step)
+{
+	AMRUKAnchor* Anchor = Step.Anchor.Get();
+	if (Step.Type != FMRUKInteriorSpawnStep::EType::ProceduralWalls && !IsValid(Anchor))
+	{
+		// The anchor may have been removed by a room update while the interior was spawned over multiple frames
+		return nullptr;
+	}
+
+	switch (Step.Type)
+	{
+		case FMRUKInteriorSpawnStep::EType::ProceduralWalls:
+			AttachProceduralMeshToWalls(Plan.CutHoleLabels, Plan.ProceduralMaterial);
+			break;
+		case FMRUKInteriorSpawnStep::EType::ProceduralPlane:
+			Anchor->AttachProceduralMesh(Step.PlaneUVs, Plan.CutHoleLabels, true, Plan.ProceduralMaterial);
+			break;
+		case FMRUKInteriorSpawnStep::EType::ProceduralMesh:
+			Anchor->AttachProceduralMesh(Plan.CutHoleLabels, true, Plan.ProceduralMaterial);
+			break;
+		case FMRUKInteriorSpawnStep::EType::ProceduralMeshUnlabeled:
+			Anchor->AttachProceduralMesh();
+			break;
+		case FMRUKInteriorSpawnStep::EType::Actor:
+			return Anchor->SpawnInterior(Step.SpawnActor.Actor, Step.SpawnActor.MatchAspectRatio, Step.SpawnActor.CalculateFacingDirection, Step.SpawnActor.ScalingMode);
+	}
+	return nullptr;
 }
 
 bool AMRUKRoom::IsWallAnchor(AMRUKAnchor* Anchor) const
@@ -0,0 +1,303 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+
+#include "MRUtilityKitRoomSnapshot.h"
+#include "MRUtilityKitAnchor.h"
+#include "MRUtilityKitGeometry.h"
+#include "MRUtilityKitRoom.h"
+
+bool FMRUKAnchorSnapshot::IsPositionInBoundary(const FVector2D& Position) const
+{
+	return MRUKIsPositionInPolygon(PlaneBoundary2D, Position);
+}
+
+bool FMRUKAnchorSnapshot::Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, FMRUKHit& OutHit) const
+{
+	if (bIsGlobalMesh)
+	{
+		return false;
+	}
+
+	// Transform the ray into local space
+	const auto InverseTransform = Transform.Inverse();
+	const FRay LocalRay(InverseTransform.TransformPositionNoScale(Origin), InverseTransform.TransformVectorNoScale(Direction));
+	bool FoundHit = false;
+
+	FMRUKHit LocalHit;
+	if (PlaneBounds.bIsValid && MRUKRaycastPlane(LocalRay, MaxDist, PlaneBounds, PlaneBoundary2D, LocalHit))
+	{
+		// Update max dist for the volume raycast
+		MaxDist = LocalHit.HitDistance;
+		FoundHit = true;
+	}
+	if (VolumeBounds.IsValid && MRUKRaycastVolume(LocalRay, MaxDist, VolumeBounds, LocalHit))
+	{
+		FoundHit = true;
+	}
+
+	if (FoundHit)
+	{
+		OutHit.HitPosition = Transform.TransformPositionNoScale(LocalHit.HitPosition);
+		OutHit.HitNormal = Transform.TransformVectorNoScale(LocalHit.HitNormal);
+		OutHit.HitDistance = LocalHit.HitDistance;
+	}
+	return FoundHit;
+}
+
+bool FMRUKAnchorSnapshot::RaycastAll(const FVector& Origin, const FVector& Direction, float MaxDist, TArray<FMRUKHit>& OutHits) const
+{
+	if (bIsGlobalMesh)
+	{
+		return false;
+	}
+
+	const auto InverseTransform = Transform.Inverse();
+	const FRay LocalRay(InverseTransform.TransformPositionNoScale(Origin), InverseTransform.TransformVectorNoScale(Direction));
+	bool FoundHit = false;
+
+	FMRUKHit LocalHit;
+	const auto AddHit = [this, &OutHits, &LocalHit]() {
+		FMRUKHit& Hit = OutHits.AddDefaulted_GetRef();
+		Hit.HitPosition = Transform.TransformPositionNoScale(LocalHit.HitPosition);
+		Hit.HitNormal = Transform.TransformVectorNoScale(LocalHit.HitNormal);
+		Hit.HitDistance = LocalHit.HitDistance;
+	};
+	if (PlaneBounds.bIsValid && MRUKRaycastPlane(LocalRay, MaxDist, PlaneBounds, PlaneBoundary2D, LocalHit))
+	{
+		AddHit();
+		FoundHit = true;
+	}
+	if (VolumeBounds.IsValid && MRUKRaycastVolume(LocalRay, MaxDist, VolumeBounds, LocalHit))
+	{
+		AddHit();
+		FoundHit = true;
+	}
+
+	return FoundHit;
+}
+
+double FMRUKAnchorSnapshot::GetClosestSurfacePosition(const FVector& TestPosition, FVector& OutSurfacePosition) const
+{
+	const auto TestPositionLocal = Transform.InverseTransformPosition(TestPosition);
+
+	double ClosestDistance = DBL_MAX;
+	FVector ClosestPoint = FVector::ZeroVector;
+
+	if (PlaneBounds.bIsValid)
+	{
+		const auto BestPoint2D = PlaneBounds.GetClosestPointTo(FVector2D(TestPositionLocal.Y, TestPositionLocal.Z));
+		const FVector BestPoint(0.0, BestPoint2D.X, BestPoint2D.Y);
+		const auto Distance = FVector::Distance(BestPoint, TestPositionLocal);
+		if (Distance < ClosestDistance)
+		{
+			ClosestPoint = BestPoint;
+			ClosestDistance = Distance;
+		}
+	}
+	if (VolumeBounds.IsValid)
+	{
+		const auto BestPoint = VolumeBounds.GetClosestPointTo(TestPositionLocal);
+		const auto Distance = FVector::Distance(BestPoint, TestPositionLocal);
+		if (Distance < ClosestDistance)
+		{
+			ClosestPoint = BestPoint;
+			ClosestDistance = Distance;
+		}
+	}
+
+	OutSurfacePosition = Transform.TransformPosition(ClosestPoint);
+	return ClosestDistance;
+}
+
+bool FMRUKAnchorSnapshot::IsPositionInVolumeBounds(const FVector& Position, bool TestVerticalBounds, double Tolerance) const
+{
+	if (!VolumeBounds.IsValid)
+	{
+		return false;
+	}
+
+	const auto LocalPosition = Transform.InverseTransformPosition(Position);
+
+	return ((TestVerticalBounds ? ((LocalPosition.X >= VolumeBounds.Min.X - Tolerance) && (LocalPosition.X <= VolumeBounds.Max.X + Tolerance)) : true)
+		&& (LocalPosition.Y >= VolumeBounds.Min.Y - Tolerance) && (LocalPosition.Y <= VolumeBounds.Max.Y + Tolerance)
+		&& (LocalPosition.Z >= VolumeBounds.Min.Z - Tolerance) && (LocalPosition.Z <= VolumeBounds.Max.Z + Tolerance));
+}
+
+FVector FMRUKAnchorSnapshot::GenerateRandomPositionOnPlane(const FRandomStream& RandomStream) const
+{
+	if (PlaneTriangles.IsEmpty())
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FVector2D Position = MRUKRandomPositionOnTriangles(PlaneBoundary2D, PlaneTriangles, PlaneTriangleAreas, PlaneArea, RandomStream);
+	return FVector(0.0, Position.X, Position.Y);
+}
+
+FMRUKRoomSnapshotRef FMRUKRoomSnapshot::Create(const AMRUKRoom& Room, uint32 Version)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FMRUKRoomSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShareable(new FMRUKRoomSnapshot());
+	Snapshot->Version = Version;
+	Snapshot->RoomUUID = Room.AnchorUUID;
+	Snapshot->RoomBounds = Room.RoomBounds;
+
+	// Null anchors are skipped so the indices of the snapshot are not the same as the ones of AllAnchors
+	TMap<const AMRUKAnchor*, int32> AnchorIndices;
+	AnchorIndices.Reserve(Room.AllAnchors.Num());
+	Snapshot->Anchors.Reserve(Room.AllAnchors.Num());
+	for (const auto& Anchor : Room.AllAnchors)
+	{
+		if (!Anchor)
+		{
+			continue;
+		}
+
+		AnchorIndices.Add(Anchor.Get(), Snapshot->Anchors.Num());
+		FMRUKAnchorSnapshot& AnchorSnapshot = Snapshot->Anchors.AddDefaulted_GetRef();
+		AnchorSnapshot.AnchorUUID = Anchor->AnchorUUID;
+		AnchorSnapshot.SemanticClassifications = Anchor->SemanticClassifications;
+		AnchorSnapshot.Transform = Anchor->GetActorTransform();
+		AnchorSnapshot.PlaneBounds = Anchor->PlaneBounds;
+		AnchorSnapshot.PlaneBoundary2D = Anchor->PlaneBoundary2D;
+		AnchorSnapshot.VolumeBounds = Anchor->VolumeBounds;
+		AnchorSnapshot.bIsGlobalMesh = Anchor == Room.GlobalMeshAnchor;
+		AnchorSnapshot.Anchor = Anchor.Get();
+
+		// Triangulated up front, so tasks that sample positions on the planes don't have to
+		if (!AnchorSnapshot.PlaneBoundary2D.IsEmpty())
+		{
+			AnchorSnapshot.PlaneTriangles = MRUKTriangulatePoints(AnchorSnapshot.PlaneBoundary2D);
+			AnchorSnapshot.PlaneArea = MRUKComputeTriangleAreas(AnchorSnapshot.PlaneBoundary2D, AnchorSnapshot.PlaneTriangles, AnchorSnapshot.PlaneTriangleAreas);
+		}
+	}
+
+	for (FMRUKAnchorSnapshot& AnchorSnapshot : Snapshot->Anchors)
+	{
+		const AMRUKAnchor* Anchor = AnchorSnapshot.Anchor.Get();
+		if (const int32* ParentIndex = AnchorIndices.Find(Anchor->ParentAnchor.Get()))
+		{
+			AnchorSnapshot.ParentIndex = *ParentIndex;
+		}
+	}
+
+	if (const int32* FloorIndex = AnchorIndices.Find(Room.FloorAnchor.Get()))
+	{
+		Snapshot->FloorIndex = *FloorIndex;
+	}
+	if (const int32* CeilingIndex = AnchorIndices.Find(Room.CeilingAnchor.Get()))
+	{
+		Snapshot->CeilingIndex = *CeilingIndex;
+	}
+
+	return Snapshot;
+}
+
+int32 FMRUKRoomSnapshot::FindAnchor(const FOculusXRUUID& AnchorUUID) const
+{
+	return Anchors.IndexOfByPredicate([&AnchorUUID](const FMRUKAnchorSnapshot& Anchor) {
+		return Anchor.AnchorUUID == AnchorUUID;
+	});
+}
+
+bool FMRUKRoomSnapshot::IsPositionInRoom(const FVector& Position, bool TestVerticalBounds) const
+{
+	const FMRUKAnchorSnapshot* Floor = GetFloor();
+	if (!Floor)
+	{
+		return false;
+	}
+
+	if (!(TestVerticalBounds ? RoomBounds.IsInside(Position) : RoomBounds.IsInsideXY(Position)))
+	{
+		return false;
+	}
+
+	const FVector LocalPos = Floor->Transform.InverseTransformPositionNoScale(Position);
+	return Floor->IsPositionInBoundary(FVector2D(LocalPos.Y, LocalPos.Z));
+}
+
+int32 FMRUKRoomSnapshot::Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, const FMRUKLabelFilter& LabelFilter, FMRUKHit& OutHit) const
+{
+	int32 HitIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Anchors.Num(); ++Index)
+	{
+		if (!Anchors[Index].PassesLabelFilter(LabelFilter))
+		{
+			continue;
+		}
+		FMRUKHit HitResult;
+		if (Anchors[Index].Raycast(Origin, Direction, MaxDist, HitResult))
+		{
+			// Prevent further hits which are further away from being found
+			MaxDist = HitResult.HitDistance;
+			OutHit = HitResult;
+			HitIndex = Index;
+		}
+	}
+	return HitIndex;
+}
+
+bool FMRUKRoomSnapshot::RaycastAll(const FVector& Origin, const FVector& Direction, float MaxDist, const FMRUKLabelFilter& LabelFilter, TArray<FMRUKHit>& OutHits, TArray<int32>& OutAnchorIndices) const
+{
+	bool HitAnything = false;
+	for (int32 Index = 0; Index < Anchors.Num(); ++Index)
+	{
+		if (!Anchors[Index].PassesLabelFilter(LabelFilter))
+		{
+			continue;
+		}
+		if (Anchors[Index].RaycastAll(Origin, Direction, MaxDist, OutHits))
+		{
+			HitAnything = true;
+			while (OutHits.Num() > OutAnchorIndices.Num())
+			{
+				OutAnchorIndices.Push(Index);
+			}
+		}
+	}
+	return HitAnything;
+}
+
+int32 FMRUKRoomSnapshot::TryGetClosestSurfacePosition(const FVector& WorldPosition, FVector& OutSurfacePosition, double& OutSurfaceDistance, const FMRUKLabelFilter& LabelFilter, double MaxDistance) const
+{
+	if (MaxDistance <= 0.0)
+	{
+		MaxDistance = DBL_MAX;
+	}
+	OutSurfacePosition = FVector::Zero();
+	int32 ClosestIndex = INDEX_NONE;
+
+	for (int32 Index = 0; Index < Anchors.Num(); ++Index)
+	{
+		if (!Anchors[Index].PassesLabelFilter(LabelFilter))
+		{
+			continue;
+		}
+
+		FVector SurfacePos{};
+		const auto Distance = Anchors[Index].GetClosestSurfacePosition(WorldPosition, SurfacePos);
+		if (Distance < MaxDistance)
+		{
+			MaxDistance = Distance;
+			OutSurfacePosition = SurfacePos;
+			ClosestIndex = Index;
+		}
+	}
+
+	OutSurfaceDistance = MaxDistance;
+	return ClosestIndex;
+}
+
+int32 FMRUKRoomSnapshot::IsPositionInSceneVolume(const FVector& WorldPosition, bool TestVerticalBounds, double Tolerance) const
+{
+	return Anchors.IndexOfByPredicate([&](const FMRUKAnchorSnapshot& Anchor) {
+		return Anchor.IsPositionInVolumeBounds(WorldPosition, TestVerticalBounds, Tolerance);
+	});
+}
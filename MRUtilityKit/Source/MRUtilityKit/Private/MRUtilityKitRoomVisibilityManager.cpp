@@ -0,0 +1,371 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#include "MRUtilityKitRoomVisibilityManager.h"
+#include "MRUtilityKitSubsystem.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitAnchor.h"
+#include "Components/MeshComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/GameInstance.h"
+#include "Kismet/GameplayStatics.h"
+
+AMRUKRoomVisibilityManager::AMRUKRoomVisibilityManager()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	// Run after the camera has been updated for this frame
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+}
+
+void AMRUKRoomVisibilityManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+	Subsystem->OnRoomCreated.AddUniqueDynamic(this, &AMRUKRoomVisibilityManager::OnRoomChanged);
+	Subsystem->OnRoomUpdated.AddUniqueDynamic(this, &AMRUKRoomVisibilityManager::OnRoomChanged);
+	Subsystem->OnRoomRemoved.AddUniqueDynamic(this, &AMRUKRoomVisibilityManager::OnRoomChanged);
+}
+
+void AMRUKRoomVisibilityManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ShowAllRooms();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AMRUKRoomVisibilityManager::SetCullingEnabled(bool bEnabled)
+{
+	bCullingEnabled = bEnabled;
+	if (!bCullingEnabled)
+	{
+		ShowAllRooms();
+	}
+	RefreshVisibility();
+}
+
+void AMRUKRoomVisibilityManager::SetRoomCullingEnabled(AMRUKRoom* Room, bool bEnabled)
+{
+	if (!IsValid(Room))
+	{
+		return;
+	}
+
+	if (bEnabled)
+	{
+		ExcludedRooms.Remove(Room);
+	}
+	else
+	{
+		ExcludedRooms.Add(Room);
+	}
+	RefreshVisibility();
+}
+
+bool AMRUKRoomVisibilityManager::IsRoomCullingEnabled(AMRUKRoom* Room) const
+{
+	return !ExcludedRooms.Contains(Room);
+}
+
+bool AMRUKRoomVisibilityManager::IsRoomVisible(AMRUKRoom* Room) const
+{
+	if (!bCullingEnabled || !CurrentRoom.IsValid() || !IsRoomCullingEnabled(Room))
+	{
+		return true;
+	}
+	return VisibleRooms.Contains(Room);
+}
+
+void AMRUKRoomVisibilityManager::RefreshVisibility()
+{
+	bVisibilityDirty = true;
+}
+
+void AMRUKRoomVisibilityManager::OnRoomChanged(AMRUKRoom* Room)
+{
+	bPortalsDirty = true;
+	bVisibilityDirty = true;
+}
+
+void AMRUKRoomVisibilityManager::RebuildPortals()
+{
+	Portals.Reset();
+
+	const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+	for (AMRUKRoom* Room : Subsystem->Rooms)
+	{
+		if (!IsValid(Room))
+		{
+			continue;
+		}
+
+		TArray<FPortal>& RoomPortals = Portals.Add(Room);
+		for (AMRUKAnchor* Anchor : Room->AllAnchors)
+		{
+			if (!IsValid(Anchor) || !Anchor->HasAnyLabel(PortalLabels))
+			{
+				continue;
+			}
+
+			const FVector PortalCenter = Anchor->GetActorLocation();
+			for (AMRUKRoom* OtherRoom : Subsystem->Rooms)
+			{
+				if (OtherRoom == Room || !IsValid(OtherRoom))
+				{
+					continue;
+				}
+				// Doors between two rooms lie on the boundary of both rooms. Windows to the outside don't lead anywhere.
+				if (OtherRoom->RoomBounds.ExpandBy(PortalConnectionTolerance).IsInsideOrOn(PortalCenter))
+				{
+					RoomPortals.Add({ Anchor, Room, OtherRoom });
+				}
+			}
+		}
+	}
+
+	bPortalsDirty = false;
+}
+
+bool AMRUKRoomVisibilityManager::GetView(FVector& OutLocation, FVector& OutDirection, double& OutHalfFOV) const
+{
+	const APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(this, 0);
+	if (!CameraManager)
+	{
+		return false;
+	}
+
+	OutLocation = CameraManager->GetCameraLocation();
+	OutDirection = CameraManager->GetCameraRotation().Vector();
+	// The horizontal FOV is the larger one on HMDs, use it for both axes to stay conservative
+	OutHalfFOV = FMath::Min(CameraManager->GetFOVAngle() * 0.5 + ViewAngleMargin, 180.0);
+	return true;
+}
+
+AMRUKRoom* AMRUKRoomVisibilityManager::FindRoomAtPosition(const FVector& Position) const
+{
+	const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+
+	// Check the cached current room first, this is the common case
+	AMRUKRoom* SubsystemRoom = Subsystem->GetCurrentRoom();
+	if (IsValid(SubsystemRoom) && SubsystemRoom->IsPositionInRoom(Position))
+	{
+		return SubsystemRoom;
+	}
+
+	for (AMRUKRoom* Room : Subsystem->Rooms)
+	{
+		if (Room != SubsystemRoom && IsValid(Room) && Room->IsPositionInRoom(Position))
+		{
+			return Room;
+		}
+	}
+	return nullptr;
+}
+
+bool AMRUKRoomVisibilityManager::IsPortalInView(const AMRUKAnchor* Anchor, const FVector& ViewLocation, const FVector& ViewDirection, double CosHalfFOV) const
+{
+	const FTransform& Transform = Anchor->GetActorTransform();
+	const FBox2D& Bounds = Anchor->PlaneBounds;
+
+	const FVector Points[] = {
+		Transform.GetLocation(),
+		Transform.TransformPosition(FVector(0.0, Bounds.Min.X, Bounds.Min.Y)),
+		Transform.TransformPosition(FVector(0.0, Bounds.Max.X, Bounds.Min.Y)),
+		Transform.TransformPosition(FVector(0.0, Bounds.Max.X, Bounds.Max.Y)),
+		Transform.TransformPosition(FVector(0.0, Bounds.Min.X, Bounds.Max.Y)),
+	};
+
+	if (FVector::DistSquared(ViewLocation, Points[0]) <= FMath::Square(PortalNearDistance))
+	{
+		return true;
+	}
+
+	for (const FVector& Point : Points)
+	{
+		const FVector ToPoint = (Point - ViewLocation).GetSafeNormal();
+		if (FVector::DotProduct(ToPoint, ViewDirection) >= CosHalfFOV)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void AMRUKRoomVisibilityManager::ComputeVisibleRooms(AMRUKRoom* Room, const FVector& ViewLocation, const FVector& ViewDirection, double HalfFOV, TArray<TWeakObjectPtr<AMRUKRoom>>& OutRooms) const
+{
+	OutRooms.Reset();
+	OutRooms.Add(Room);
+
+	const double CosHalfFOV = FMath::Cos(FMath::DegreesToRadians(HalfFOV));
+
+	// Breadth first through the visible portals, rooms can be reached over multiple portals
+	int32 FrontierStart = 0;
+	for (int32 Depth = 0; Depth < MaxPortalDepth; ++Depth)
+	{
+		const int32 FrontierEnd = OutRooms.Num();
+		for (int32 i = FrontierStart; i < FrontierEnd; ++i)
+		{
+			const TArray<FPortal>* RoomPortals = Portals.Find(OutRooms[i]);
+			if (!RoomPortals)
+			{
+				continue;
+			}
+			for (const FPortal& Portal : *RoomPortals)
+			{
+				if (!Portal.Anchor.IsValid() || !Portal.ToRoom.IsValid() || OutRooms.Contains(Portal.ToRoom))
+				{
+					continue;
+				}
+				if (IsPortalInView(Portal.Anchor.Get(), ViewLocation, ViewDirection, CosHalfFOV))
+				{
+					OutRooms.Add(Portal.ToRoom);
+				}
+			}
+		}
+		FrontierStart = FrontierEnd;
+	}
+
+	OutRooms.Sort([](const TWeakObjectPtr<AMRUKRoom>& A, const TWeakObjectPtr<AMRUKRoom>& B) { return A.Get() < B.Get(); });
+}
+
+void AMRUKRoomVisibilityManager::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!bCullingEnabled)
+	{
+		return;
+	}
+
+	if (bPortalsDirty)
+	{
+		RebuildPortals();
+	}
+
+	FVector ViewLocation;
+	FVector ViewDirection;
+	double HalfFOV;
+	if (!GetView(ViewLocation, ViewDirection, HalfFOV))
+	{
+		return;
+	}
+
+	AMRUKRoom* Room = FindRoomAtPosition(ViewLocation);
+	if (!Room)
+	{
+		// Outside of all rooms nothing is occluded by walls
+		if (CurrentRoom.IsValid() || bVisibilityDirty)
+		{
+			CurrentRoom = nullptr;
+			VisibleRooms.Reset();
+			ShowAllRooms();
+			bVisibilityDirty = false;
+		}
+		return;
+	}
+
+	ComputeVisibleRooms(Room, ViewLocation, ViewDirection, HalfFOV, NewVisibleRooms);
+
+	if (Room != CurrentRoom.Get() || bVisibilityDirty || NewVisibleRooms != VisibleRooms)
+	{
+		Swap(VisibleRooms, NewVisibleRooms);
+		CurrentRoom = Room;
+		ApplyVisibility();
+		bVisibilityDirty = false;
+	}
+}
+
+void AMRUKRoomVisibilityManager::ApplyVisibility()
+{
+	CullingStats.VisibleRooms = VisibleRooms.Num();
+	CullingStats.CulledRooms = 0;
+	CullingStats.CulledActors = 0;
+	CullingStats.CulledPrimitives = 0;
+	CullingStats.CulledDrawCalls = 0;
+	++CullingStats.VisibilityUpdates;
+
+	TSet<TWeakObjectPtr<AActor>> PreviouslyHidden = MoveTemp(HiddenActors);
+	HiddenActors.Reset();
+
+	const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+	TArray<AActor*> RoomActors;
+	TArray<UPrimitiveComponent*> Primitives;
+	for (AMRUKRoom* Room : Subsystem->Rooms)
+	{
+		if (!IsValid(Room) || VisibleRooms.Contains(Room) || !IsRoomCullingEnabled(Room))
+		{
+			continue;
+		}
+		++CullingStats.CulledRooms;
+
+		RoomActors.Reset();
+		RoomActors.Add(Room);
+		Room->GetAttachedActors(RoomActors, false, true);
+
+		for (AActor* Actor : RoomActors)
+		{
+			if (!IsValid(Actor) || Actor->ActorHasTag(GMRUK_NO_ROOM_CULLING_ACTOR_TAG))
+			{
+				continue;
+			}
+
+			const bool bHiddenByUs = PreviouslyHidden.Remove(Actor) > 0;
+			// Don't touch actors that are hidden by someone else, otherwise they would be shown again later
+			if (!bHiddenByUs && Actor->IsHidden())
+			{
+				continue;
+			}
+
+			Actor->GetComponents(Primitives);
+			for (const UPrimitiveComponent* Primitive : Primitives)
+			{
+				if (Primitive->IsRegistered() && Primitive->IsVisible())
+				{
+					++CullingStats.CulledPrimitives;
+					const UMeshComponent* Mesh = Cast<UMeshComponent>(Primitive);
+					CullingStats.CulledDrawCalls += Mesh ? FMath::Max(Mesh->GetNumMaterials(), 1) : 1;
+				}
+			}
+
+			if (!bHiddenByUs)
+			{
+				Actor->SetActorHiddenInGame(true);
+			}
+			HiddenActors.Add(Actor);
+			++CullingStats.CulledActors;
+		}
+	}
+
+	// Show what is not culled anymore
+	for (const TWeakObjectPtr<AActor>& Actor : PreviouslyHidden)
+	{
+		if (Actor.IsValid())
+		{
+			Actor->SetActorHiddenInGame(false);
+		}
+	}
+
+	UE_LOG(LogMRUK, Verbose, TEXT("Room visibility updated: %d rooms visible, %d rooms culled (%d actors, %d primitives, ~%d draw calls)"),
+		CullingStats.VisibleRooms, CullingStats.CulledRooms, CullingStats.CulledActors, CullingStats.CulledPrimitives, CullingStats.CulledDrawCalls);
+}
+
+void AMRUKRoomVisibilityManager::ShowAllRooms()
+{
+	for (const TWeakObjectPtr<AActor>& Actor : HiddenActors)
+	{
+		if (Actor.IsValid())
+		{
+			Actor->SetActorHiddenInGame(false);
+		}
+	}
+	HiddenActors.Reset();
+
+	CullingStats.CulledRooms = 0;
+	CullingStats.CulledActors = 0;
+	CullingStats.CulledPrimitives = 0;
+	CullingStats.CulledDrawCalls = 0;
+}
@@ -0,0 +1,293 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#include "MRUtilityKitSceneGenerator.h"
+#include "MRUtilityKit.h"
+#include "MRUtilityKitSerializationHelpers.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	struct FFurnitureType
+	{
+		const FString& Label;
+		// Width, depth and height ranges in cm
+		FVector MinSize;
+		FVector MaxSize;
+	};
+
+	struct FWallObjectType
+	{
+		const FString& Label;
+		// Width and height in cm
+		FVector2D Size;
+		// Height of the center above the floor in cm
+		double CenterHeight;
+	};
+
+	FOculusXRUUID GenerateUUID(FRandomStream& Stream)
+	{
+		FOculusXRUUID UUID;
+		for (uint8& Byte : UUID.UUIDBytes)
+		{
+			Byte = (uint8)Stream.RandRange(0, 255);
+		}
+		return UUID;
+	}
+
+	TSharedRef<FJsonObject> MakeAnchorJson(const FOculusXRUUID& UUID, const FString& Label, const FTransform& Transform)
+	{
+		TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+		JsonObject->SetField(TEXT("UUID"), MRUKSerialize(UUID));
+		JsonObject->SetField(TEXT("SemanticClassifications"), MRUKSerialize(TArray<FString>{ Label }));
+		JsonObject->SetField(TEXT("Transform"), MRUKSerialize(Transform));
+		return JsonObject;
+	}
+
+	void SetPlane(FJsonObject& JsonObject, const TArray<FVector2D>& Boundary)
+	{
+		JsonObject.SetField(TEXT("PlaneBounds"), MRUKSerialize(FBox2D(Boundary)));
+		JsonObject.SetField(TEXT("PlaneBoundary2D"), MRUKSerialize(Boundary));
+	}
+
+	TArray<FVector2D> MakeRectangle(const FVector2D& Extent)
+	{
+		return { { -Extent.X, -Extent.Y }, { Extent.X, -Extent.Y }, { Extent.X, Extent.Y }, { -Extent.X, Extent.Y } };
+	}
+
+	TSharedRef<FJsonObject> MakeGlobalMeshJson(const FOculusXRUUID& UUID, const FBox2D& Bounds, const TArray<FBox>& Obstacles, int32 NumTriangles, double WorldToMeters)
+	{
+		// Height field over the room with bumps where the furniture is. Two triangles per grid cell.
+		const FVector2D Size = Bounds.GetSize();
+		const double CellSize = FMath::Sqrt(Size.X * Size.Y / FMath::Max(NumTriangles / 2, 1));
+		const int32 NumX = FMath::Max(FMath::CeilToInt32(Size.X / CellSize), 1);
+		const int32 NumY = FMath::Max(FMath::CeilToInt32(Size.Y / CellSize), 1);
+
+		TArray<TSharedPtr<FJsonValue>> PositionsJson;
+		PositionsJson.Reserve((NumX + 1) * (NumY + 1));
+		for (int32 Y = 0; Y <= NumY; ++Y)
+		{
+			for (int32 X = 0; X <= NumX; ++X)
+			{
+				FVector Position(Bounds.Min.X + Size.X * X / NumX, Bounds.Min.Y + Size.Y * Y / NumY, 0.0);
+				for (const FBox& Obstacle : Obstacles)
+				{
+					if (Obstacle.IsInsideOrOnXY(Position))
+					{
+						Position.Z = FMath::Max(Position.Z, Obstacle.Max.Z);
+					}
+				}
+				// The global mesh is scaled by WorldToMeters when it is loaded
+				PositionsJson.Add(MRUKSerialize(Position / WorldToMeters));
+			}
+		}
+
+		TArray<TSharedPtr<FJsonValue>> IndicesJson;
+		IndicesJson.Reserve(NumX * NumY * 6);
+		for (int32 Y = 0; Y < NumY; ++Y)
+		{
+			for (int32 X = 0; X < NumX; ++X)
+			{
+				const int32 I0 = Y * (NumX + 1) + X;
+				const int32 I1 = I0 + 1;
+				const int32 I2 = I0 + NumX + 1;
+				const int32 I3 = I2 + 1;
+				for (const int32 Index : { I0, I2, I1, I1, I2, I3 })
+				{
+					IndicesJson.Add(MakeShared<FJsonValueNumber>(Index));
+				}
+			}
+		}
+
+		auto GlobalMeshJson = MakeShared<FJsonObject>();
+		GlobalMeshJson->SetField(TEXT("UUID"), MRUKSerialize(UUID));
+		GlobalMeshJson->SetArrayField(TEXT("Positions"), PositionsJson);
+		GlobalMeshJson->SetArrayField(TEXT("Indices"), IndicesJson);
+		return GlobalMeshJson;
+	}
+
+	TSharedRef<FJsonObject> GenerateRoom(const FMRUKSceneGeneratorSettings& Settings, const FVector& Origin, double WorldToMeters, FRandomStream& Stream)
+	{
+		static const FFurnitureType FurnitureTypes[] = {
+			{ FMRUKLabels::Table, { 80.0, 60.0, 70.0 }, { 160.0, 100.0, 80.0 } },
+			{ FMRUKLabels::Couch, { 160.0, 80.0, 40.0 }, { 220.0, 100.0, 90.0 } },
+			{ FMRUKLabels::Storage, { 40.0, 30.0, 80.0 }, { 120.0, 60.0, 200.0 } },
+			{ FMRUKLabels::Bed, { 140.0, 190.0, 40.0 }, { 200.0, 210.0, 60.0 } },
+			{ FMRUKLabels::Screen, { 60.0, 5.0, 40.0 }, { 120.0, 10.0, 70.0 } },
+			{ FMRUKLabels::Lamp, { 30.0, 30.0, 120.0 }, { 50.0, 50.0, 180.0 } },
+			{ FMRUKLabels::Plant, { 30.0, 30.0, 50.0 }, { 60.0, 60.0, 150.0 } },
+			{ FMRUKLabels::Other, { 20.0, 20.0, 20.0 }, { 100.0, 100.0, 100.0 } },
+		};
+		static const FWallObjectType WallObjectTypes[] = {
+			{ FMRUKLabels::DoorFrame, { 90.0, 200.0 }, 100.0 },
+			{ FMRUKLabels::WindowFrame, { 100.0, 100.0 }, 150.0 },
+			{ FMRUKLabels::WallArt, { 60.0, 40.0 }, 150.0 },
+		};
+
+		const double Height = Settings.RoomHeight;
+		const int32 WallCount = FMath::Max(Settings.WallCount, 3);
+		const double MaxRadius = FMath::Max(Settings.MinRoomRadius, Settings.MaxRoomRadius);
+
+		// Star shaped outline around the origin, counter clockwise seen from above
+		TArray<FVector> Corners;
+		Corners.Reserve(WallCount);
+		for (int32 I = 0; I < WallCount; ++I)
+		{
+			const double Angle = UE_TWO_PI * (I + Stream.FRandRange(-0.3, 0.3)) / WallCount;
+			const double Radius = Stream.FRandRange(Settings.MinRoomRadius, MaxRadius);
+			Corners.Add(Origin + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0) * Radius);
+		}
+
+		FOculusXRRoomLayout RoomLayout;
+		TArray<TSharedPtr<FJsonValue>> AnchorsJson;
+
+		const auto AddPlane = [&AnchorsJson, &Stream](const FString& Label, const FTransform& Transform, const TArray<FVector2D>& Boundary) {
+			const FOculusXRUUID UUID = GenerateUUID(Stream);
+			const auto AnchorJson = MakeAnchorJson(UUID, Label, Transform);
+			SetPlane(*AnchorJson, Boundary);
+			AnchorsJson.Add(MakeShareable(new FJsonValueObject(AnchorJson)));
+			return UUID;
+		};
+
+		// Floor and ceiling, the plane boundary is the outline in the local space of the anchor
+		for (const bool bIsFloor : { true, false })
+		{
+			const FTransform Transform(FRotator(bIsFloor ? -90.0 : 90.0, 0.0, 0.0), Origin + FVector(0.0, 0.0, bIsFloor ? 0.0 : Height));
+			TArray<FVector2D> Boundary;
+			Boundary.Reserve(Corners.Num());
+			for (const FVector& Corner : Corners)
+			{
+				const FVector Local = Transform.InverseTransformPosition(Corner + FVector(0.0, 0.0, bIsFloor ? 0.0 : Height));
+				Boundary.Emplace(Local.Y, Local.Z);
+			}
+			const FOculusXRUUID UUID = AddPlane(bIsFloor ? FMRUKLabels::Floor : FMRUKLabels::Ceiling, Transform, Boundary);
+			(bIsFloor ? RoomLayout.FloorUuid : RoomLayout.CeilingUuid) = UUID;
+		}
+
+		// One wall per outline edge. The wall normal points out of the room and the local Y axis along the edge so
+		// that the max edge of a wall touches the min edge of the next one.
+		for (int32 I = 0; I < Corners.Num(); ++I)
+		{
+			const FVector& A = Corners[I];
+			const FVector& B = Corners[(I + 1) % Corners.Num()];
+			const FVector Edge = B - A;
+			const double Length = Edge.Size2D();
+			const double Yaw = FMath::RadiansToDegrees(FMath::Atan2(-Edge.X, Edge.Y));
+			const FTransform Transform(FRotator(0.0, Yaw, 0.0), (A + B) * 0.5 + FVector(0.0, 0.0, Height * 0.5));
+			RoomLayout.WallsUuid.Add(AddPlane(FMRUKLabels::WallFace, Transform, MakeRectangle({ Length * 0.5, Height * 0.5 })));
+
+			if (Stream.FRand() >= Settings.WallObjectProbability)
+			{
+				continue;
+			}
+			const FWallObjectType& Type = WallObjectTypes[Stream.RandRange(0, (int32)UE_ARRAY_COUNT(WallObjectTypes) - 1)];
+			const double Slack = Length - Type.Size.X - 20.0;
+			if (Slack <= 0.0 || Type.CenterHeight + Type.Size.Y * 0.5 > Height)
+			{
+				continue;
+			}
+			const double Offset = Stream.FRandRange(-Slack * 0.5, Slack * 0.5);
+			const FVector Location = Transform.TransformPosition(FVector(0.0, Offset, Type.CenterHeight - Height * 0.5));
+			AddPlane(Type.Label, FTransform(Transform.GetRotation(), Location), MakeRectangle(Type.Size * 0.5));
+		}
+
+		// Furniture volumes, uniformly distributed over the fan triangles of the outline. The outline is shrunk towards
+		// the origin to keep the volumes away from the walls.
+		TArray<double> TriangleAreas;
+		double FloorArea = 0.0;
+		for (int32 I = 0; I < Corners.Num(); ++I)
+		{
+			const FVector A = Corners[I] - Origin;
+			const FVector B = Corners[(I + 1) % Corners.Num()] - Origin;
+			const double Area = 0.5 * FMath::Abs(A.X * B.Y - A.Y * B.X);
+			TriangleAreas.Add(Area);
+			FloorArea += Area;
+		}
+
+		TArray<FBox> Obstacles;
+		const int32 FurnitureCount = FMath::RoundToInt32(FloorArea / (WorldToMeters * WorldToMeters) * Settings.FurnitureDensity);
+		for (int32 I = 0; I < FurnitureCount; ++I)
+		{
+			double Pick = Stream.FRand() * FloorArea;
+			int32 Triangle = 0;
+			while (Triangle < TriangleAreas.Num() - 1 && Pick > TriangleAreas[Triangle])
+			{
+				Pick -= TriangleAreas[Triangle++];
+			}
+			double U = Stream.FRand();
+			double V = Stream.FRand();
+			if (U + V > 1.0)
+			{
+				U = 1.0 - U;
+				V = 1.0 - V;
+			}
+			const FVector A = Corners[Triangle] - Origin;
+			const FVector B = Corners[(Triangle + 1) % Corners.Num()] - Origin;
+			const FVector Position = Origin + (A * U + B * V) * 0.7;
+
+			const FFurnitureType& Type = FurnitureTypes[Stream.RandRange(0, (int32)UE_ARRAY_COUNT(FurnitureTypes) - 1)];
+			const FVector Size(
+				Stream.FRandRange(Type.MinSize.X, Type.MaxSize.X),
+				Stream.FRandRange(Type.MinSize.Y, Type.MaxSize.Y),
+				FMath::Min(Stream.FRandRange(Type.MinSize.Z, Type.MaxSize.Z), Height));
+			const double Yaw = Stream.FRandRange(-180.0, 180.0);
+
+			// Volumes have their origin on the top face and the X axis pointing down
+			const FTransform Transform(FRotator(-90.0, -90.0, Yaw), Position + FVector(0.0, 0.0, Size.Z));
+			const auto AnchorJson = MakeAnchorJson(GenerateUUID(Stream), Type.Label, Transform);
+			SetPlane(*AnchorJson, MakeRectangle({ Size.X * 0.5, Size.Y * 0.5 }));
+			AnchorJson->SetField(TEXT("VolumeBounds"), MRUKSerialize(FBox(FVector(0.0, -Size.X * 0.5, -Size.Y * 0.5), FVector(Size.Z, Size.X * 0.5, Size.Y * 0.5))));
+			AnchorsJson.Add(MakeShareable(new FJsonValueObject(AnchorJson)));
+
+			const double Radius = FVector2D(Size.X, Size.Y).Size() * 0.5;
+			Obstacles.Add(FBox(FVector(-Radius, -Radius, 0.0), FVector(Radius, Radius, Size.Z)).ShiftBy(Position - Origin));
+		}
+
+		const FOculusXRUUID RoomUUID = GenerateUUID(Stream);
+		if (Settings.GlobalMeshTriangles > 0)
+		{
+			const FOculusXRUUID UUID = GenerateUUID(Stream);
+			const auto AnchorJson = MakeAnchorJson(UUID, FMRUKLabels::GlobalMesh, FTransform(Origin));
+			FBox2D Bounds(ForceInit);
+			for (const FVector& Corner : Corners)
+			{
+				Bounds += FVector2D(Corner - Origin);
+			}
+			AnchorJson->SetObjectField(TEXT("GlobalMesh"), MakeGlobalMeshJson(UUID, Bounds, Obstacles, Settings.GlobalMeshTriangles, WorldToMeters));
+			AnchorsJson.Add(MakeShareable(new FJsonValueObject(AnchorJson)));
+		}
+
+		TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+		JsonObject->SetField(TEXT("UUID"), MRUKSerialize(RoomUUID));
+		JsonObject->SetField(TEXT("RoomLayout"), MRUKSerialize(RoomLayout));
+		JsonObject->SetArrayField(TEXT("Anchors"), AnchorsJson);
+		return JsonObject;
+	}
+} // namespace
+
+FString MRUKGenerateSceneJson(const FMRUKSceneGeneratorSettings& Settings, double WorldToMeters)
+{
+	FRandomStream Stream(Settings.Seed);
+
+	// Leave a gap between the rooms so they never overlap
+	const double RoomSpacing = FMath::Max(Settings.MinRoomRadius, Settings.MaxRoomRadius) * 2.5;
+
+	TArray<TSharedPtr<FJsonValue>> RoomsArray;
+	for (int32 I = 0; I < FMath::Max(Settings.RoomCount, 1); ++I)
+	{
+		RoomsArray.Add(MakeShareable(new FJsonValueObject(GenerateRoom(Settings, FVector(I * RoomSpacing, 0.0, 0.0), WorldToMeters, Stream))));
+	}
+
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	JsonObject->SetArrayField(TEXT("Rooms"), RoomsArray);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Json, 0);
+	FJsonSerializer::Serialize(JsonObject, JsonWriter);
+	return Json;
+}
@@ -0,0 +1,247 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+
+#include "MRUtilityKitSeatIndex.h"
+#include "MRUtilityKitAnchor.h"
+#include "MRUtilityKitSeatsComponent.h"
+#include "Algo/Sort.h"
+
+void FMRUKSeatIndex::Build(const TArray<TObjectPtr<AMRUKAnchor>>& SeatAnchors)
+{
+	// Remember the reservations by seat identity, the seat indices change with the rebuild
+	TArray<TPair<TPair<const AMRUKAnchor*, int32>, TWeakObjectPtr<UObject>>> OldReservations;
+	for (const auto& Reservation : Reservations)
+	{
+		const FMRUKSeat& Seat = Seats[Reservation.Key];
+		OldReservations.Add({ { Seat.Anchor, Seat.SeatIndex }, Reservation.Value });
+	}
+
+	Reset();
+
+	for (const auto& SeatAnchor : SeatAnchors)
+	{
+		if (!SeatAnchor)
+		{
+			continue;
+		}
+		const auto SeatsComponent = SeatAnchor->FindComponentByClass<UMRUKSeatsComponent>();
+		if (!SeatsComponent)
+		{
+			continue;
+		}
+		for (int32 i = 0; i < SeatsComponent->SeatPoses.Num(); ++i)
+		{
+			SeatLookup.Add({ SeatAnchor, i }, Seats.Num());
+			FMRUKSeat& Seat = Seats.AddDefaulted_GetRef();
+			Seat.Anchor = SeatAnchor;
+			Seat.SeatIndex = i;
+			Seat.Pose = SeatsComponent->SeatPoses[i];
+		}
+	}
+
+	TArray<int32> SeatIndices;
+	SeatIndices.Reserve(Seats.Num());
+	for (int32 i = 0; i < Seats.Num(); ++i)
+	{
+		SeatIndices.Add(i);
+	}
+	Nodes.SetNum(Seats.Num());
+	SeatNodes.SetNum(Seats.Num());
+	BuildNodes(SeatIndices, 0, Seats.Num(), INDEX_NONE);
+
+	for (const auto& Reservation : OldReservations)
+	{
+		const int32 Seat = FindSeat(Reservation.Key.Key, Reservation.Key.Value);
+		if (Seat != INDEX_NONE && Reservation.Value.IsValid())
+		{
+			Reserve(Seat, Reservation.Value.Get());
+		}
+	}
+}
+
+void FMRUKSeatIndex::Reset()
+{
+	Seats.Empty();
+	Nodes.Empty();
+	SeatNodes.Empty();
+	SeatLookup.Empty();
+	Reservations.Empty();
+}
+
+int32 FMRUKSeatIndex::FindSeat(const AMRUKAnchor* Anchor, int32 SeatIndex) const
+{
+	const int32* Seat = SeatLookup.Find({ Anchor, SeatIndex });
+	return Seat ? *Seat : INDEX_NONE;
+}
+
+int32 FMRUKSeatIndex::FindClosestFreeSeat(const FVector& Position, const FVector& FacingDirection, double MaxFacingAngle)
+{
+	ReleaseStaleReservations();
+
+	FQuery Query;
+	Query.Position = Position;
+	Query.FacingDirection = FacingDirection.GetSafeNormal();
+	Query.MinFacingDot = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(MaxFacingAngle, 0.0, 180.0)));
+	Query.BestSeat = INDEX_NONE;
+	Query.BestDistSquared = TNumericLimits<double>::Max();
+	Search(0, Nodes.Num(), Query);
+	return Query.BestSeat;
+}
+
+bool FMRUKSeatIndex::Reserve(int32 Seat, UObject* Occupant)
+{
+	if (!Seats.IsValidIndex(Seat) || !Occupant)
+	{
+		return false;
+	}
+
+	ReleaseStaleReservations();
+	if (const auto* Reservation = Reservations.Find(Seat))
+	{
+		return Reservation->Get() == Occupant;
+	}
+
+	ReleaseAll(Occupant);
+	Reservations.Add(Seat, Occupant);
+	UpdateFreeCount(Seat, -1);
+	return true;
+}
+
+bool FMRUKSeatIndex::Release(int32 Seat)
+{
+	if (Reservations.Remove(Seat) == 0)
+	{
+		return false;
+	}
+	UpdateFreeCount(Seat, 1);
+	return true;
+}
+
+void FMRUKSeatIndex::ReleaseAll(const UObject* Occupant)
+{
+	TArray<int32, TInlineAllocator<4>> SeatsToRelease;
+	for (const auto& Reservation : Reservations)
+	{
+		if (Reservation.Value.Get() == Occupant)
+		{
+			SeatsToRelease.Add(Reservation.Key);
+		}
+	}
+	for (const int32 Seat : SeatsToRelease)
+	{
+		Release(Seat);
+	}
+}
+
+UObject* FMRUKSeatIndex::GetOccupant(int32 Seat) const
+{
+	const auto* Reservation = Reservations.Find(Seat);
+	return Reservation ? Reservation->Get() : nullptr;
+}
+
+int32 FMRUKSeatIndex::BuildNodes(TArray<int32>& SeatIndices, int32 Begin, int32 End, int32 Parent)
+{
+	if (Begin >= End)
+	{
+		return INDEX_NONE;
+	}
+
+	// Split along the axis in which the seats are spread the most
+	FBox Bounds(ForceInit);
+	for (int32 i = Begin; i < End; ++i)
+	{
+		Bounds += Seats[SeatIndices[i]].Pose.GetLocation();
+	}
+	const FVector Size = Bounds.GetSize();
+	const uint8 Axis = Size.X >= Size.Y && Size.X >= Size.Z ? 0 : (Size.Y >= Size.Z ? 1 : 2);
+	Algo::Sort(MakeArrayView(SeatIndices.GetData() + Begin, End - Begin), [this, Axis](int32 A, int32 B) {
+		return Seats[A].Pose.GetLocation()[Axis] < Seats[B].Pose.GetLocation()[Axis];
+	});
+
+	const int32 Mid = (Begin + End) / 2;
+	FNode& Node = Nodes[Mid];
+	Node.Seat = SeatIndices[Mid];
+	Node.Parent = Parent;
+	Node.NumFreeSeats = End - Begin;
+	Node.Axis = Axis;
+	SeatNodes[Node.Seat] = Mid;
+
+	BuildNodes(SeatIndices, Begin, Mid, Mid);
+	BuildNodes(SeatIndices, Mid + 1, End, Mid);
+	return Mid;
+}
+
+void FMRUKSeatIndex::Search(int32 Begin, int32 End, FQuery& Query) const
+{
+	if (Begin >= End)
+	{
+		return;
+	}
+
+	const int32 Mid = (Begin + End) / 2;
+	const FNode& Node = Nodes[Mid];
+	if (Node.NumFreeSeats == 0)
+	{
+		return;
+	}
+
+	const FTransform& Pose = Seats[Node.Seat].Pose;
+	const FVector Location = Pose.GetLocation();
+	if (!Reservations.Contains(Node.Seat) && (Query.FacingDirection.IsZero() || Pose.GetUnitAxis(EAxis::X).Dot(Query.FacingDirection) >= Query.MinFacingDot))
+	{
+		const double DistSquared = FVector::DistSquared(Query.Position, Location);
+		if (DistSquared < Query.BestDistSquared)
+		{
+			Query.BestDistSquared = DistSquared;
+			Query.BestSeat = Node.Seat;
+		}
+	}
+
+	// Visit the side of the position first, the other side only if it can have closer seats
+	const double Diff = Query.Position[Node.Axis] - Location[Node.Axis];
+	if (Diff < 0.0)
+	{
+		Search(Begin, Mid, Query);
+		if (Diff * Diff < Query.BestDistSquared)
+		{
+			Search(Mid + 1, End, Query);
+		}
+	}
+	else
+	{
+		Search(Mid + 1, End, Query);
+		if (Diff * Diff < Query.BestDistSquared)
+		{
+			Search(Begin, Mid, Query);
+		}
+	}
+}
+
+void FMRUKSeatIndex::UpdateFreeCount(int32 Seat, int32 Delta)
+{
+	for (int32 NodeIndex = SeatNodes[Seat]; NodeIndex != INDEX_NONE; NodeIndex = Nodes[NodeIndex].Parent)
+	{
+		Nodes[NodeIndex].NumFreeSeats += Delta;
+	}
+}
+
+void FMRUKSeatIndex::ReleaseStaleReservations()
+{
+	TArray<int32, TInlineAllocator<4>> StaleSeats;
+	for (const auto& Reservation : Reservations)
+	{
+		if (!Reservation.Value.IsValid())
+		{
+			StaleSeats.Add(Reservation.Key);
+		}
+	}
+	for (const int32 Seat : StaleSeats)
+	{
+		Release(Seat);
+	}
+}
@@ -57,4 +57,9 @@ void UMRUKSeatsComponent::CalculateSeatPoses(double SeatWidth)
 			SeatPoses.Add(SeatPose);
 		}
 	}
+
+	if (Anchor->Room)
+	{
+		Anchor->Room->MarkSeatsDirty();
+	}
 }
@@ -14,6 +14,7 @@ LICENSE file in the root directory of this source tree.
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonSerializer.h"
 #include "GameFramework/Pawn.h"
+#include "Engine/Engine.h"
 #include "OculusXRRoomLayoutManagerComponent.h"
 #include "OculusXRSceneEventDelegates.h"
 #include "OculusXRSceneFunctionLibrary.h"
@@ -60,6 +61,21 @@ void UMRUKSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	const UMRUKSettings* Settings = GetMutableDefault<UMRUKSettings>();
 	EnableWorldLock = Settings->EnableWorldLock;
+
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->RegisterThrottleable(this);
+	}
+}
+
+void UMRUKSubsystem::Deinitialize()
+{
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->UnregisterThrottleable(this);
+	}
+
+	Super::Deinitialize();
 }
 
 TSharedRef<FJsonObject> UMRUKSubsystem::JsonSerialize()
@@ -159,6 +175,7 @@ void UMRUKSubsystem::LoadSceneFromJsonString(const FString& String)
 	else
 	{
 		UE_LOG(LogMRUK, Log, TEXT("Load scene from JSON"));
+		SceneData->OnRoomLoaded.AddUObject(this, &UMRUKSubsystem::SceneRoomDataLoaded);
 		SceneData->OnComplete.AddDynamic(this, &UMRUKSubsystem::SceneDataLoadedComplete);
 	}
 	SceneLoadStatus = EMRUKInitStatus::Busy;
@@ -189,12 +206,23 @@ void UMRUKSubsystem::LoadSceneFromDevice(int MaxQueries)
 	else
 	{
 		UE_LOG(LogMRUK, Log, TEXT("Load scene from device"));
+		SceneData->OnRoomLoaded.AddUObject(this, &UMRUKSubsystem::SceneRoomDataLoaded);
 		SceneData->OnComplete.AddDynamic(this, &UMRUKSubsystem::SceneDataLoadedComplete);
 	}
 	SceneLoadStatus = EMRUKInitStatus::Busy;
+	SceneData->MaxConcurrentRoomQueries = GetDefault<UMRUKSettings>()->MaxConcurrentRoomQueries;
 	SceneData->LoadFromDevice(MaxQueries);
 }
 
+void UMRUKSubsystem::SceneRoomDataLoaded(UMRUKRoomData* RoomData)
+{
+	// Rooms are spawned as soon as they are loaded, while the other rooms are still loading
+	UE_LOG(LogMRUK, Log, TEXT("Spawn room from scene data"));
+	AMRUKRoom* Room = SpawnRoom();
+	Room->LoadFromData(RoomData);
+	OnRoomCreated.Broadcast(Room);
+}
+
 void UMRUKSubsystem::SceneDataLoadedComplete(bool Success)
 {
 	UE_LOG(LogMRUK, Log, TEXT("Loaded scene data. Sucess==%d"), Success);
@@ -211,21 +239,8 @@ void UMRUKSubsystem::SceneDataLoadedComplete(bool Success)
 		return;
 	}
 
-	if (Success)
-	{
-		UE_LOG(LogMRUK, Log, TEXT("Spawn rooms from scene data"));
-		for (const auto& RoomData : SceneData->RoomsData)
-		{
-			AMRUKRoom* Room = SpawnRoom();
-			Room->LoadFromData(RoomData);
-		}
-	}
+	// Rooms that loaded successfully have already been spawned, even if other rooms failed
 	FinishedLoading(Success);
-
-	for (auto Room : Rooms)
-	{
-		OnRoomCreated.Broadcast(Room);
-	}
 }
 
 void UMRUKSubsystem::UpdatedSceneDataLoadedComplete(bool Success)
@@ -356,6 +371,62 @@ AMRUKAnchor* UMRUKSubsystem::TryGetClosestSeatPose(const FVector& RayOrigin, con
 	return ClosestAnchor;
 }
 
+bool UMRUKSubsystem::TryReserveClosestSeat(const FVector& Position, UObject* Occupant, FMRUKSeat& OutSeat, FVector FacingDirection, double MaxFacingAngle)
+{
+	if (!Occupant)
+	{
+		return false;
+	}
+
+	AMRUKRoom* ClosestRoom = nullptr;
+	double ClosestSeatDistanceSq = DBL_MAX;
+	FMRUKSeat ClosestSeat;
+	for (const auto& Room : Rooms)
+	{
+		FMRUKSeat Seat;
+		if (Room && Room->GetClosestFreeSeat(Position, Seat, FacingDirection, MaxFacingAngle))
+		{
+			const double SeatDistanceSq = FVector::DistSquared(Position, Seat.Pose.GetLocation());
+			if (SeatDistanceSq < ClosestSeatDistanceSq)
+			{
+				ClosestRoom = Room;
+				ClosestSeatDistanceSq = SeatDistanceSq;
+				ClosestSeat = Seat;
+			}
+		}
+	}
+
+	if (!ClosestRoom)
+	{
+		return false;
+	}
+
+	for (const auto& Room : Rooms)
+	{
+		if (Room && Room != ClosestRoom)
+		{
+			Room->ReleaseSeatsOf(Occupant);
+		}
+	}
+	if (!ClosestRoom->ReserveSeat(ClosestSeat.Anchor, ClosestSeat.SeatIndex, Occupant))
+	{
+		return false;
+	}
+	OutSeat = ClosestSeat;
+	return true;
+}
+
+void UMRUKSubsystem::ReleaseSeatsOf(UObject* Occupant)
+{
+	for (const auto& Room : Rooms)
+	{
+		if (Room)
+		{
+			Room->ReleaseSeatsOf(Occupant);
+		}
+	}
+}
+
 AMRUKAnchor* UMRUKSubsystem::GetBestPoseFromRaycast(const FVector& RayOrigin, const FVector& RayDirection, double MaxDist, const FMRUKLabelFilter& LabelFilter, FTransform& OutPose, EMRUKPositioningMethod PositioningMethod)
 {
 	AMRUKAnchor* ClosestAnchor = nullptr;
@@ -528,9 +599,29 @@ void UMRUKSubsystem::FinishedLoading(bool Success)
 	OnSceneLoaded.Broadcast(Success);
 }
 
+FMRUKRoomAcousticProfile UMRUKSubsystem::GetCurrentRoomAcousticProfile() const
+{
+	if (const AMRUKRoom* CurrentRoom = GetCurrentRoom())
+	{
+		return CurrentRoom->AcousticProfile;
+	}
+	return FMRUKRoomAcousticProfile();
+}
+
 void UMRUKSubsystem::Tick(float DeltaTime)
 {
-	if (EnableWorldLock)
+	if (OnCurrentRoomChanged.IsBound())
+	{
+		AMRUKRoom* CurrentRoom = GetCurrentRoom();
+		AMRUKRoom* PreviousRoom = LastCurrentRoom.Get();
+		if (CurrentRoom != PreviousRoom)
+		{
+			LastCurrentRoom = CurrentRoom;
+			OnCurrentRoomChanged.Broadcast(CurrentRoom, PreviousRoom);
+		}
+	}
+
+	if (EnableWorldLock && !bWorldLockPausedByWorkloadThrottle)
 	{
 		if (const auto Room = GetCurrentRoom())
 		{
@@ -556,7 +647,17 @@ void UMRUKSubsystem::Tick(float DeltaTime)
 
 }
 
+void UMRUKSubsystem::OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy)
+{
+	bWorldLockPausedByWorkloadThrottle = Policy.bPauseWorldLock;
+}
+
+void UMRUKSubsystem::OnWorkloadRestored_Implementation()
+{
+	bWorldLockPausedByWorkloadThrottle = false;
+}
+
 bool UMRUKSubsystem::IsTickable() const
 {
-	return !HasAnyFlags(RF_BeginDestroyed) && IsValidChecked(this) && (EnableWorldLock);
+	return !HasAnyFlags(RF_BeginDestroyed) && IsValidChecked(this) && (EnableWorldLock || OnCurrentRoomChanged.IsBound());
 }
@@ -0,0 +1,395 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+
+#include "MRUtilityKitWallGraph.h"
+#include "MRUtilityKitAnchor.h"
+
+bool FMRUKWallGraph::Update(const TArray<TObjectPtr<AMRUKAnchor>>& Walls)
+{
+	TSet<const AMRUKAnchor*> CurrentWalls;
+	CurrentWalls.Reserve(Walls.Num());
+	const AMRUKAnchor* LastWall = nullptr;
+	for (const auto& Wall : Walls)
+	{
+		if (Wall)
+		{
+			CurrentWalls.Add(Wall);
+			LastWall = Wall;
+		}
+	}
+
+	bool bChanged = false;
+	if (PerimeterStartWall != LastWall)
+	{
+		PerimeterStartWall = LastWall;
+		bChanged = true;
+	}
+
+	for (int32 i = Nodes.Num() - 1; i >= 0; --i)
+	{
+		if (!CurrentWalls.Contains(Nodes[i].Wall))
+		{
+			RemoveWall(i);
+			bChanged = true;
+		}
+	}
+
+	for (const auto& Wall : Walls)
+	{
+		if (Wall)
+		{
+			bChanged |= AddOrUpdateWall(Wall);
+		}
+	}
+
+	if (!bChanged)
+	{
+		return false;
+	}
+
+	Finalize();
+	return true;
+}
+
+void FMRUKWallGraph::SetRoomCorners(const TArray<FVector>& Corners)
+{
+	if (RoomCorners == Corners)
+	{
+		return;
+	}
+
+	RoomCorners = Corners;
+	for (auto& Node : Nodes)
+	{
+		ComputeCornerOffset(Node);
+	}
+}
+
+void FMRUKWallGraph::Reset()
+{
+	Nodes.Empty();
+	NodeIndices.Empty();
+	StartCells.Empty();
+	EndCells.Empty();
+	RoomCorners.Empty();
+	Loops.Empty();
+	PerimeterWalls.Empty();
+	WallsByLength.Empty();
+	DirtyNodes.Empty();
+	bRelinkFallbacks = false;
+	PerimeterStartWall = nullptr;
+}
+
+const FMRUKWallNode* FMRUKWallGraph::FindNode(const AMRUKAnchor* Wall) const
+{
+	const int32* Index = NodeIndices.Find(Wall);
+	return Index ? &Nodes[*Index] : nullptr;
+}
+
+AMRUKAnchor* FMRUKWallGraph::GetKeyWall(double Tolerance) const
+{
+	for (const int32 Index : WallsByLength)
+	{
+		if (Nodes[Index].MaxCornerOffset <= Tolerance)
+		{
+			return Nodes[Index].Wall;
+		}
+	}
+	return nullptr;
+}
+
+bool FMRUKWallGraph::AddOrUpdateWall(AMRUKAnchor* Wall)
+{
+	int32 Index;
+	if (const int32* Found = NodeIndices.Find(Wall))
+	{
+		Index = *Found;
+		const FMRUKWallNode& Node = Nodes[Index];
+		if (Node.SourceTransform.Equals(Wall->GetActorTransform()) && Node.SourcePlaneBounds == Wall->PlaneBounds)
+		{
+			return false;
+		}
+
+		// Walls that connected to the old start may not connect anymore
+		TArray<int32> NodesEndingNearOldStart;
+		FindNodesNear(EndCells, Node.Start, NodesEndingNearOldStart);
+		DirtyNodes.Append(NodesEndingNearOldStart);
+		UnhashNode(Index);
+	}
+	else
+	{
+		Index = Nodes.AddDefaulted();
+		NodeIndices.Add(Wall, Index);
+	}
+
+	FMRUKWallNode& Node = Nodes[Index];
+	Node.Wall = Wall;
+	ComputeGeometry(Node);
+	ComputeCornerOffset(Node);
+	HashNode(Index);
+	DirtyNodes.Add(Index);
+
+	// Walls ending at the new start connect to this wall now, walls that only had a fallback may have a better one.
+	// The fallbacks are relinked once in Finalize rather than on every insert.
+	TArray<int32> NodesEndingNear;
+	FindNodesNear(EndCells, Node.Start, NodesEndingNear);
+	DirtyNodes.Append(NodesEndingNear);
+	bRelinkFallbacks = true;
+	return true;
+}
+
+void FMRUKWallGraph::RemoveWall(int32 Index)
+{
+	UnhashNode(Index);
+	NodeIndices.Remove(Nodes[Index].Wall);
+	DirtyNodes.Remove(Index);
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		if (i != Index && (Nodes[i].RightIndex == Index || !Nodes[i].bRightSnapped))
+		{
+			Nodes[i].RightIndex = INDEX_NONE;
+			DirtyNodes.Add(i);
+		}
+	}
+
+	// Move the last node into the gap and patch the references to it
+	const int32 LastIndex = Nodes.Num() - 1;
+	if (Index != LastIndex)
+	{
+		UnhashNode(LastIndex);
+		for (auto& Node : Nodes)
+		{
+			if (Node.RightIndex == LastIndex)
+			{
+				Node.RightIndex = Index;
+			}
+		}
+		if (DirtyNodes.Remove(LastIndex) > 0)
+		{
+			DirtyNodes.Add(Index);
+		}
+	}
+	Nodes.RemoveAtSwap(Index);
+	if (Index != LastIndex)
+	{
+		NodeIndices.Add(Nodes[Index].Wall, Index);
+		HashNode(Index);
+	}
+}
+
+void FMRUKWallGraph::ComputeGeometry(FMRUKWallNode& Node)
+{
+	const AMRUKAnchor* Wall = Node.Wall;
+	Node.SourceTransform = Wall->GetActorTransform();
+	Node.SourcePlaneBounds = Wall->PlaneBounds;
+	Node.Start = Node.SourceTransform.TransformPosition(FVector(0.0, Wall->PlaneBounds.Min.X, 0.0));
+	Node.End = Node.SourceTransform.TransformPosition(FVector(0.0, Wall->PlaneBounds.Max.X, 0.0));
+	Node.Length = Wall->PlaneBounds.GetSize().X;
+}
+
+void FMRUKWallGraph::ComputeCornerOffset(FMRUKWallNode& Node) const
+{
+	const FVector Location = Node.SourceTransform.GetLocation();
+	const FVector Forward = Node.SourceTransform.GetUnitAxis(EAxis::X);
+	Node.MaxCornerOffset = TNumericLimits<double>::Lowest();
+	for (const auto& Corner : RoomCorners)
+	{
+		Node.MaxCornerOffset = FMath::Max(Node.MaxCornerOffset, Forward.Dot(Corner - Location));
+	}
+}
+
+FIntPoint FMRUKWallGraph::GetCell(const FVector& Position) const
+{
+	return FIntPoint(FMath::FloorToInt32(Position.X / SnapDistance), FMath::FloorToInt32(Position.Y / SnapDistance));
+}
+
+void FMRUKWallGraph::HashNode(int32 Index)
+{
+	StartCells.Add(GetCell(Nodes[Index].Start), Index);
+	EndCells.Add(GetCell(Nodes[Index].End), Index);
+}
+
+void FMRUKWallGraph::UnhashNode(int32 Index)
+{
+	StartCells.RemoveSingle(GetCell(Nodes[Index].Start), Index);
+	EndCells.RemoveSingle(GetCell(Nodes[Index].End), Index);
+}
+
+void FMRUKWallGraph::FindNodesNear(const TMultiMap<FIntPoint, int32>& Cells, const FVector& Position, TArray<int32>& OutIndices) const
+{
+	// Everything within the snap distance is in the cell of the position or one of its neighbours
+	const FIntPoint Cell = GetCell(Position);
+	for (int32 Y = -1; Y <= 1; ++Y)
+	{
+		for (int32 X = -1; X <= 1; ++X)
+		{
+			Cells.MultiFind(Cell + FIntPoint(X, Y), OutIndices);
+		}
+	}
+}
+
+void FMRUKWallGraph::LinkRight(int32 Index)
+{
+	FMRUKWallNode& Node = Nodes[Index];
+	Node.RightIndex = INDEX_NONE;
+	Node.bRightSnapped = false;
+
+	TArray<int32> Candidates;
+	FindNodesNear(StartCells, Node.End, Candidates);
+	double ClosestDist = SnapDistance;
+	for (const int32 Candidate : Candidates)
+	{
+		const double Dist = FVector::Dist2D(Node.End, Nodes[Candidate].Start);
+		if (Candidate != Index && Dist <= ClosestDist)
+		{
+			ClosestDist = Dist;
+			Node.RightIndex = Candidate;
+			Node.bRightSnapped = true;
+		}
+	}
+
+	if (Node.bRightSnapped)
+	{
+		return;
+	}
+
+	// Fall back to the closest wall start for rooms that aren't closed properly
+	ClosestDist = TNumericLimits<double>::Max();
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		const double Dist = FVector::Dist2D(Node.End, Nodes[i].Start);
+		if (i != Index && Dist < ClosestDist)
+		{
+			ClosestDist = Dist;
+			Node.RightIndex = i;
+		}
+	}
+}
+
+void FMRUKWallGraph::Finalize()
+{
+	if (bRelinkFallbacks)
+	{
+		for (int32 i = 0; i < Nodes.Num(); ++i)
+		{
+			if (!Nodes[i].bRightSnapped)
+			{
+				DirtyNodes.Add(i);
+			}
+		}
+		bRelinkFallbacks = false;
+	}
+
+	for (const int32 Index : DirtyNodes)
+	{
+		LinkRight(Index);
+	}
+	DirtyNodes.Reset();
+
+	// Left links are the inverse of the right links, snapped connections win over fallbacks
+	for (auto& Node : Nodes)
+	{
+		Node.LeftIndex = INDEX_NONE;
+	}
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		const FMRUKWallNode& Node = Nodes[i];
+		if (Node.RightIndex == INDEX_NONE)
+		{
+			continue;
+		}
+		FMRUKWallNode& RightNode = Nodes[Node.RightIndex];
+		if (RightNode.LeftIndex == INDEX_NONE || (Node.bRightSnapped && !Nodes[RightNode.LeftIndex].bRightSnapped))
+		{
+			RightNode.LeftIndex = i;
+		}
+	}
+
+	for (auto& Node : Nodes)
+	{
+		Node.RightCornerAngle = 0.0;
+		if (Node.RightIndex == INDEX_NONE)
+		{
+			continue;
+		}
+		const FMRUKWallNode& RightNode = Nodes[Node.RightIndex];
+		const FVector Direction = (Node.End - Node.Start).GetSafeNormal2D();
+		const FVector RightDirection = (RightNode.End - RightNode.Start).GetSafeNormal2D();
+		const double Turn = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(Direction.Dot(RightDirection), -1.0, 1.0)));
+		// Walls face out of the room, so the corner is convex if the next wall turns away from the facing direction
+		const bool bConvex = RightDirection.Dot(Node.SourceTransform.GetUnitAxis(EAxis::X)) < 0.0;
+		Node.RightCornerAngle = bConvex ? 180.0 - Turn : 180.0 + Turn;
+	}
+
+	// Open chains first, starting at the walls without a left wall, then the closed loops
+	Loops.Reset();
+	TBitArray<> Visited(false, Nodes.Num());
+	const auto AddLoop = [this, &Visited](int32 First) {
+		TArray<int32>& Loop = Loops.AddDefaulted_GetRef();
+		for (int32 Index = First; Index != INDEX_NONE && !Visited[Index]; Index = Nodes[Index].RightIndex)
+		{
+			Visited[Index] = true;
+			Loop.Add(Index);
+		}
+	};
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		if (Nodes[i].LeftIndex == INDEX_NONE)
+		{
+			AddLoop(i);
+		}
+	}
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		if (!Visited[i])
+		{
+			AddLoop(i);
+		}
+	}
+
+	// The perimeter starts at the last wall of the room like it always did, otherwise the wall UVs would shift.
+	// Its loop goes first and, if it is closed, is rotated to start at that wall.
+	if (const int32* StartIndex = NodeIndices.Find(PerimeterStartWall))
+	{
+		const int32 StartLoopIndex = Loops.IndexOfByPredicate([StartIndex](const TArray<int32>& Loop) { return Loop.Contains(*StartIndex); });
+		if (StartLoopIndex != INDEX_NONE)
+		{
+			TArray<int32> StartLoop = MoveTemp(Loops[StartLoopIndex]);
+			Loops.RemoveAt(StartLoopIndex);
+			if (Nodes[StartLoop[0]].LeftIndex != INDEX_NONE)
+			{
+				const int32 Offset = StartLoop.Find(*StartIndex);
+				TArray<int32> Rotated;
+				Rotated.Reserve(StartLoop.Num());
+				Rotated.Append(StartLoop.GetData() + Offset, StartLoop.Num() - Offset);
+				Rotated.Append(StartLoop.GetData(), Offset);
+				StartLoop = MoveTemp(Rotated);
+			}
+			Loops.Insert(MoveTemp(StartLoop), 0);
+		}
+	}
+
+	PerimeterWalls.Reset(Nodes.Num());
+	for (int32 LoopIndex = 0; LoopIndex < Loops.Num(); ++LoopIndex)
+	{
+		for (int32 IndexInLoop = 0; IndexInLoop < Loops[LoopIndex].Num(); ++IndexInLoop)
+		{
+			FMRUKWallNode& Node = Nodes[Loops[LoopIndex][IndexInLoop]];
+			Node.LoopIndex = LoopIndex;
+			Node.IndexInLoop = IndexInLoop;
+			PerimeterWalls.Add(Node.Wall);
+		}
+	}
+
+	WallsByLength.Reset(Nodes.Num());
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		WallsByLength.Add(i);
+	}
+	WallsByLength.StableSort([this](int32 A, int32 B) { return Nodes[A].Length > Nodes[B].Length; });
+}
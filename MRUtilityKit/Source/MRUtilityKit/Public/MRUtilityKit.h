@@ -238,6 +238,61 @@ struct MRUTILITYKIT_API FMRUKSpawnGroup
 	EMRUKFallbackToProceduralOverwrite FallbackToProcedural = EMRUKFallbackToProceduralOverwrite::Default;
 };
 
+/**
+ * Acoustic material classes that the surfaces of a room are grouped into.
+ */
+UENUM(BlueprintType)
+enum class EMRUKAcousticSurface : uint8
+{
+	/// The floor.
+	Floor,
+	/// The ceiling.
+	Ceiling,
+	/// Walls, excluding door and window openings.
+	Wall,
+	/// Window frames.
+	Window,
+	/// Door frames and invisible walls. Sound passes through these.
+	Opening,
+	/// Couches and beds.
+	SoftFurnishing,
+	/// All other volumes and furniture planes.
+	HardFurnishing,
+};
+
+/**
+ * Sound absorption coefficients in the range [0, 1] for the acoustic surface classes.
+ * The defaults are typical mid frequency (500 Hz - 1 kHz) values for a furnished living room.
+ */
+USTRUCT(BlueprintType)
+struct MRUTILITYKIT_API FMRUKAcousticAbsorption
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	double Floor = 0.10;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	double Ceiling = 0.10;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	double Wall = 0.05;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	double Window = 0.04;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	double Opening = 1.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	double SoftFurnishing = 0.55;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	double HardFurnishing = 0.10;
+
+	double GetCoefficient(EMRUKAcousticSurface Surface) const;
+};
+
 /**
  * Implements the settings for the MRUtilityKit plugin.
  */
@@ -257,6 +312,18 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "MR Utility Kit")
 	bool EnableWorldLock = true;
 
+	/**
+	 * Absorption coefficients used to compute the acoustic profile of rooms.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "MR Utility Kit")
+	FMRUKAcousticAbsorption AcousticAbsorption;
+
+	/**
+	 * Maximum number of rooms whose anchors are queried at the same time when loading the scene from the device.
+	 * Further rooms wait for a free query.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "MR Utility Kit", meta = (ClampMin = "1", UIMin = "1"))
+	int32 MaxConcurrentRoomQueries = 4;
 };
 
 struct MRUTILITYKIT_API FMRUKLabels
@@ -0,0 +1,96 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "MRUtilityKit.h"
+#include "MRUtilityKitAcoustics.generated.h"
+
+class AMRUKRoom;
+
+/**
+ * Acoustic properties of a room derived from its scene anchors. All values are in SI units (meters, seconds).
+ * The profile is computed when a room gets loaded or updated, so audio code can drive reverb without querying the
+ * room geometry at runtime.
+ */
+USTRUCT(BlueprintType)
+struct MRUTILITYKIT_API FMRUKRoomAcousticProfile
+{
+	GENERATED_BODY()
+
+	/**
+	 * Whether the room had a floor and a ceiling to compute the profile from.
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	bool bIsValid = false;
+
+	/**
+	 * Volume of air in the room in m³: floor area times ceiling height minus the volume of the furniture.
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	double Volume = 0.0;
+
+	/**
+	 * Distance between floor and ceiling in m.
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	double CeilingHeight = 0.0;
+
+	/**
+	 * Surface area in m² by acoustic surface class. Furniture volumes count with all faces except the bottom one.
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	TMap<EMRUKAcousticSurface, double> SurfaceAreas;
+
+	/**
+	 * Sum of all surface areas in m².
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	double TotalSurfaceArea = 0.0;
+
+	/**
+	 * Equivalent absorption area in m², the sum of all surface areas weighted by their absorption coefficient.
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	double AbsorptionArea = 0.0;
+
+	/**
+	 * Estimated time in seconds for the sound to decay by 60 dB (RT60), computed with the Sabine formula.
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	double DecayTime = 0.0;
+
+	/**
+	 * Average distance in m sound travels between two reflections (4V/S).
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	double MeanFreePath = 0.0;
+
+	/**
+	 * Delays in seconds of the first order reflections off the floor, ceiling and every wall for a listener
+	 * at the center of the room, sorted from shortest to longest. The first entry is a good reverb pre delay.
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	TArray<double> EarlyReflectionDelays;
+
+	/**
+	 * Fraction in [0, 1] of the walls and invisible walls around the room that is open: doors, windows and invisible walls.
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "MR Utility Kit")
+	double Openness = 0.0;
+
+	double GetSurfaceArea(EMRUKAcousticSurface Surface) const;
+};
+
+/**
+ * Compute the acoustic profile of a room from its anchors.
+ * @param Room           The room.
+ * @param Absorption     Absorption coefficients of the surface classes.
+ * @param WorldToMeters  World units per meter.
+ * @param SpeedOfSound   Speed of sound in m/s.
+ */
+MRUTILITYKIT_API FMRUKRoomAcousticProfile MRUKComputeRoomAcousticProfile(const AMRUKRoom& Room, const FMRUKAcousticAbsorption& Absorption, double WorldToMeters = 100.0, double SpeedOfSound = 343.0);
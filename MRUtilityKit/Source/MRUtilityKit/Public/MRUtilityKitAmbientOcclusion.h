@@ -0,0 +1,152 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "MRUtilityKit.h"
+#include "GameFramework/Actor.h"
+#include "MRUtilityKitAmbientOcclusion.generated.h"
+
+class AMRUKRoom;
+class AMRUKAnchor;
+class UProceduralMeshComponent;
+
+/**
+ * Quality settings for baking ambient occlusion into the vertex colors of procedural room meshes.
+ */
+USTRUCT(BlueprintType)
+struct MRUTILITYKIT_API FMRUKAmbientOcclusionSettings
+{
+	GENERATED_BODY()
+
+	/**
+	 * Number of rays that are cast per vertex.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "1", ClampMax = "256"))
+	int32 SampleCount = 32;
+
+	/**
+	 * Geometry further away than this distance in world units does not occlude.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "1.0"))
+	double MaxDistance = 100.0;
+
+	/**
+	 * Strength of the occlusion. 0 disables the darkening, 1 makes fully occluded vertices black.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	double Intensity = 0.8;
+
+	/**
+	 * The meshes are subdivided until their edges are shorter than this distance in world units, so that the occlusion
+	 * has enough vertices to vary over large walls. Smaller values give better quality at the cost of more vertices.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "1.0"))
+	double VertexSpacing = 30.0;
+
+	/**
+	 * Upper limit for the subdivision. Every level multiplies the triangle count by 4.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0", ClampMax = "6"))
+	int32 MaxSubdivisionLevel = 4;
+};
+
+/**
+ * Bakes ambient occlusion into the vertex colors of the procedural meshes of anchors.
+ *
+ * Mobile devices usually can't afford screen space ambient occlusion. The room geometry is static though, so the
+ * occlusion from the walls, floor, ceiling and volumes can be computed once on the CPU. The bake runs on worker threads
+ * and the result gets written into the vertex colors of the mesh sections. Use the vertex color in the material of the
+ * procedural meshes to apply it.
+ *
+ * Anchors are picked up as soon as their procedural mesh exists, e.g. after the anchor actor spawner created it. When a
+ * room gets updated only the anchors that changed and the anchors within MaxDistance of a change are baked again.
+ */
+UCLASS(ClassGroup = MRUtilityKit, meta = (DisplayName = "MR Utility Kit Ambient Occlusion Baker"))
+class MRUTILITYKIT_API AMRUKAmbientOcclusionBaker : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Whether rooms should be baked automatically after the scene has been loaded.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
+	EMRUKSpawnMode SpawnMode = EMRUKSpawnMode::CurrentRoomOnly;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
+	FMRUKAmbientOcclusionSettings Settings;
+
+	/**
+	 * Bake ambient occlusion for all procedural meshes of a room and keep them up to date.
+	 * This only needs to be called manually if SpawnMode is None.
+	 * @param Room The room to bake.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void BakeRoom(AMRUKRoom* Room);
+
+	/**
+	 * Stop tracking a room. Already baked vertex colors are kept.
+	 * @param Room The room.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void RemoveRoom(AMRUKRoom* Room);
+
+	/**
+	 * Whether there are bakes running on worker threads.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool IsBaking() const { return PendingBakes > 0; }
+
+public:
+	AMRUKAmbientOcclusionBaker();
+
+	void Tick(float DeltaSeconds) override;
+
+	struct FBakeSource;
+	struct FOccluder;
+
+protected:
+	void BeginPlay() override;
+
+private:
+	struct FAnchorRecord
+	{
+		/** Transform and world bounds of the geometry when it was last seen */
+		FTransform Transform;
+		FBox Bounds{ ForceInit };
+		/** The mesh component the source was captured from */
+		TWeakObjectPtr<UProceduralMeshComponent> Component;
+		/** Mesh sections as they were before the bake */
+		TSharedPtr<const FBakeSource, ESPMode::ThreadSafe> Source;
+		/** Incremented on every bake, results of older bakes get discarded */
+		int32 Generation = 0;
+	};
+
+	struct FRoomRecord
+	{
+		TMap<TWeakObjectPtr<AMRUKAnchor>, FAnchorRecord> Anchors;
+		/** Anchor data may have changed, compare the bounds of all anchors */
+		bool bDirty = true;
+	};
+
+	TMap<TWeakObjectPtr<AMRUKRoom>, FRoomRecord> Rooms;
+	int32 PendingBakes = 0;
+
+	void UpdateRoom(AMRUKRoom* Room, FRoomRecord& RoomRecord);
+	void LaunchBake(AMRUKAnchor* Anchor, FAnchorRecord& Record, const TSharedRef<const TArray<FOccluder>, ESPMode::ThreadSafe>& Occluders);
+	void ApplyBake(TWeakObjectPtr<AMRUKRoom> Room, TWeakObjectPtr<AMRUKAnchor> Anchor, int32 Generation, const TSharedRef<const FBakeSource, ESPMode::ThreadSafe>& Result);
+
+	UFUNCTION()
+	void OnRoomCreated(AMRUKRoom* Room);
+
+	UFUNCTION()
+	void OnRoomUpdated(AMRUKRoom* Room);
+
+	UFUNCTION()
+	void OnRoomRemoved(AMRUKRoom* Room);
+};
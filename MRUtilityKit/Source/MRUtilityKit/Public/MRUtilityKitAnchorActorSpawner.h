@@ -9,6 +9,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "GameFramework/Actor.h"
 #include "MRUtilityKit.h"
+#include "MRUtilityKitRoom.h"
 #include "MRUtilityKitAnchorActorSpawner.generated.h"
 
 /**
@@ -21,6 +22,7 @@ class MRUTILITYKIT_API AMRUKAnchorActorSpawner : public AActor
 
 public:
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInteriorSpawned, AMRUKRoom*, Room);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInteriorSpawnProgress, AMRUKRoom*, Room, float, Progress);
 
 	/**
 	 * Event that gets fired when the interior spawner finished spawning actors.
@@ -28,6 +30,13 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "MR Utility Kit")
 	FOnInteriorSpawned OnActorsSpawned;
 
+	/**
+	 * Event that gets fired every frame in which actors have been spawned in a room when spawning over multiple frames.
+	 * Progress goes from 0 to 1, OnActorsSpawned follows after the progress reached 1.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "MR Utility Kit")
+	FOnInteriorSpawnProgress OnSpawnProgress;
+
 	/**
 	 * Seed to use for the random generator that decideds wich actor class to 
 	 * spawn if there a given multiple for a label.
@@ -58,6 +67,21 @@ public:
 	UPROPERTY(EditAnywhere, Category = "MR Utility Kit")
 	bool ShouldFallbackToProcedural = true;
 
+	/**
+	 * Whether the actors should be spawned over multiple frames instead of all at once. Spawning the whole
+	 * room in one frame can cause a noticeable hitch on large rooms. The walls, floor and ceiling are spawned
+	 * first, then the other anchors from the closest to the farthest from the user.
+	 */
+	UPROPERTY(EditAnywhere, Category = "MR Utility Kit")
+	bool SpawnOverMultipleFrames = false;
+
+	/**
+	 * Time in milliseconds that may be spent spawning actors per frame when spawning over multiple frames.
+	 * At least one anchor is processed per frame, so spawning always finishes.
+	 */
+	UPROPERTY(EditAnywhere, Category = "MR Utility Kit", meta = (EditCondition = "SpawnOverMultipleFrames", ClampMin = "0.0", UIMin = "0.0"))
+	float SpawnFrameBudgetMs = 2.0f;
+
 	/**
 	 * Labels for which holes should be created in the parents plane mesh.
 	 * E.g. if holes are needed in the walls where the windows and doors are, specify DOOR_FRAME and WINDOW_FRAME.
@@ -114,6 +138,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	void GetSpawnedActors(TArray<AActor*>& Actors);
 
+	/**
+	 * Check if the spawner is still spawning actors over multiple frames.
+	 * @param Room The room to check. If nullptr any room is checked.
+	 * @return Whether spawning is still in progress.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool IsSpawning(AMRUKRoom* Room = nullptr) const;
+
+	AMRUKAnchorActorSpawner();
+
+	void Tick(float DeltaSeconds) override;
+
 protected:
 	void BeginPlay() override;
 
@@ -130,8 +166,21 @@ protected:
 	void RemoveActors(AMRUKRoom* Room);
 
 private:
+	struct FPendingSpawn
+	{
+		TWeakObjectPtr<AMRUKRoom> Room;
+		FMRUKInteriorSpawnPlan Plan;
+		int32 NextStep = 0;
+	};
+
+	void StartSpawningOverMultipleFrames(AMRUKRoom* Room, const FRandomStream& RandomStream);
+	void SortByPriority(FMRUKInteriorSpawnPlan& Plan) const;
+
 	// Room UUID to spawned actors in this room
 	TMap<AMRUKRoom*, TArray<AActor*>> SpawnedActors;
 
+	// Rooms that are spawned over multiple frames, in the order they get processed
+	TArray<FPendingSpawn> PendingSpawns;
+
 	int32 LastSeed = -1;
 };
@@ -9,10 +9,56 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "GameFramework/Actor.h"
+#include "MRUtilityKit.h"
+#include "OculusXRAnchors.h"
 #include "OculusXRRoomLayoutManagerComponent.h"
 #include "Dom/JsonValue.h"
 #include "MRUtilityKitData.generated.h"
 
+class UMRUKAnchorData;
+
+/**
+ * Source of the scene data that is loaded from device.
+ * Discoveries may report their results in multiple batches before they complete.
+ * The scene can be loaded from a simulated discovery to test the loading without a device.
+ */
+class MRUTILITYKIT_API IMRUKSceneDiscovery
+{
+public:
+	virtual ~IMRUKSceneDiscovery() = default;
+
+	/**
+	 * Discovers the room layout anchors.
+	 * @return Whether the discovery has been started.
+	 */
+	virtual bool DiscoverRooms(const FOculusXRDiscoverAnchorsResultsDelegate& OnResults, const FOculusXRDiscoverAnchorsCompleteDelegate& OnComplete) = 0;
+
+	/**
+	 * Discovers the anchors with the given UUIDs.
+	 * @return Whether the discovery has been started.
+	 */
+	virtual bool DiscoverAnchors(const TArray<FOculusXRUUID>& Uuids, const FOculusXRDiscoverAnchorsResultsDelegate& OnResults, const FOculusXRDiscoverAnchorsCompleteDelegate& OnComplete) = 0;
+
+	virtual bool GetRoomLayout(const FOculusXRAnchorsDiscoverResult& Room, FOculusXRRoomLayout& OutRoomLayout) = 0;
+
+	/**
+	 * Fills the data of a discovered anchor.
+	 */
+	virtual void LoadAnchorData(const FOculusXRAnchorsDiscoverResult& Anchor, UMRUKAnchorData* AnchorData) = 0;
+};
+
+/**
+ * Discovers the scene anchors on the device.
+ */
+class MRUTILITYKIT_API FMRUKDeviceSceneDiscovery : public IMRUKSceneDiscovery
+{
+public:
+	bool DiscoverRooms(const FOculusXRDiscoverAnchorsResultsDelegate& OnResults, const FOculusXRDiscoverAnchorsCompleteDelegate& OnComplete) override;
+	bool DiscoverAnchors(const TArray<FOculusXRUUID>& Uuids, const FOculusXRDiscoverAnchorsResultsDelegate& OnResults, const FOculusXRDiscoverAnchorsCompleteDelegate& OnComplete) override;
+	bool GetRoomLayout(const FOculusXRAnchorsDiscoverResult& Room, FOculusXRRoomLayout& OutRoomLayout) override;
+	void LoadAnchorData(const FOculusXRAnchorsDiscoverResult& Anchor, UMRUKAnchorData* AnchorData) override;
+};
+
 /**
  * Actor to help finding the localization of actors.
  * It gets a list of all anchor queries that should be localized
@@ -77,7 +123,7 @@ class MRUTILITYKIT_API UMRUKRoomData : public UObject
 	GENERATED_BODY()
 
 public:
-	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnComplete, bool, Success);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnComplete, UMRUKRoomData*, RoomData, bool, Success);
 
 	/**
 	 * Event that gets fired after all room data has been loaded.
@@ -85,6 +131,11 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "MR Utility Kit")
 	FOnComplete OnComplete;
 
+	/**
+	 * Discovery the room is loaded from. The device is used if none is set.
+	 */
+	TSharedPtr<IMRUKSceneDiscovery> Discovery;
+
 	FOculusXRAnchorsDiscoverResult SpaceQuery;
 	FOculusXRRoomLayout RoomLayout;
 
@@ -98,6 +149,11 @@ public:
 	void LoadFromJson(const FJsonValue& Value);
 
 private:
+	UPROPERTY()
+	TArray<TObjectPtr<UMRUKAnchorData>> AnchorQueriesLocalization;
+
+	bool Finished = false;
+
 	void FinishQuery(bool Success);
 	void RoomDataLoadedResult(EOculusXRAnchorResult::Type Result);
 	void RoomDataLoadedComplete(const TArray<FOculusXRAnchorsDiscoverResult>& DiscoverResults);
@@ -107,6 +163,9 @@ private:
 
 /**
  * Load scene data from device.
+ * Loading is pipelined: every batch of discovered rooms immediately starts the anchor queries of these rooms,
+ * while the discovery of the other rooms is still running. The OnRoomLoaded event is fired for every room as
+ * soon as it is loaded, so the first rooms can be used before the slowest query finishes.
  * When all scene data has been loaded, the OnComplete event will be fired.
  */
 UCLASS(ClassGroup = MRUtilityKit, Hidden)
@@ -116,6 +175,7 @@ class MRUTILITYKIT_API UMRUKSceneData : public UObject
 
 public:
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnComplete, bool, Success);
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnRoomLoaded, UMRUKRoomData*);
 
 	/**
 	 * Event that gets fired after all scene data has been loaded.
@@ -123,19 +183,51 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "MR Utility Kit")
 	FOnComplete OnComplete;
 
+	/**
+	 * Event that gets fired for every room that has been loaded successfully, before OnComplete.
+	 */
+	FOnRoomLoaded OnRoomLoaded;
+
 	UPROPERTY()
 	TArray<TObjectPtr<UMRUKRoomData>> RoomsData;
 
-	void LoadFromDevice(int32 MaxQueries = 64);
+	/**
+	 * Maximum number of rooms whose anchors are queried at the same time. Further rooms wait for a free query.
+	 * UMRUKSubsystem::LoadSceneFromDevice sets it from UMRUKSettings::MaxConcurrentRoomQueries.
+	 */
+	int32 MaxConcurrentRoomQueries = 4;
+
+	/**
+	 * Load the scene from device.
+	 * @param InDiscovery Discovery to load the scene from, the device is used if none is given.
+	 */
+	void LoadFromDevice(int32 MaxQueries = 64, TSharedPtr<IMRUKSceneDiscovery> InDiscovery = nullptr);
 	void LoadFromJson(const FString& Json);
 
+	/**
+	 * Busy while loading, then complete or failed.
+	 */
+	EMRUKInitStatus GetStatus() const { return Status; }
+
+	int32 GetNumRoomQueriesInFlight() const { return NumRoomQueriesInFlight; }
+
 private:
-	int32 NumRoomsLeftToInitialize = 0;
+	TSharedPtr<IMRUKSceneDiscovery> Discovery;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UMRUKRoomData>> PendingRoomQueries;
+
+	EMRUKInitStatus Status = EMRUKInitStatus::None;
+	int32 MaxAnchorQueries = 64;
+	int32 NumRoomQueriesInFlight = 0;
+	bool DiscoveryComplete = false;
 	bool AnyRoomFailed = false;
 
 	void FinishQuery(bool Success);
+	void StartRoomQueries();
+	void TryFinishQuery();
 	void SceneDataLoadedResult(EOculusXRAnchorResult::Type Result);
 	void SceneDataLoadedComplete(const TArray<FOculusXRAnchorsDiscoverResult>& DiscoverResults);
 	UFUNCTION()
-	void RoomQueryComplete(bool Success);
+	void RoomQueryComplete(UMRUKRoomData* RoomData, bool Success);
 };
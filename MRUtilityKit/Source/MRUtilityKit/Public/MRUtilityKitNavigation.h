@@ -0,0 +1,212 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "MRUtilityKit.h"
+#include "GameFramework/Actor.h"
+#include "MRUtilityKitNavigation.generated.h"
+
+class AMRUKRoom;
+class UProceduralMeshComponent;
+
+/**
+ * Connection between two navigation cells. The portal is the segment both cells share.
+ */
+struct FMRUKNavLink
+{
+	int32 Cell = INDEX_NONE;
+	FVector2D PortalMin;
+	FVector2D PortalMax;
+};
+
+/**
+ * Convex walkable cell. Cells are trapezoids with two vertical sides (constant X) in the
+ * floor's local 2D coordinate system.
+ */
+struct FMRUKNavCell
+{
+	double MinX = 0.0;
+	double MaxX = 0.0;
+	/** Bottom edge Y at MinX and MaxX */
+	FVector2D Bottom;
+	/** Top edge Y at MinX and MaxX */
+	FVector2D Top;
+	TArray<FMRUKNavLink> Links;
+
+	double GetBottomY(double X) const;
+	double GetTopY(double X) const;
+	bool Contains(const FVector2D& Point, double Tolerance = 0.0) const;
+	FVector2D ClosestPoint(const FVector2D& Point) const;
+	FVector2D GetCentroid() const;
+	double GetArea() const;
+};
+
+/**
+ * Walkable area of a room computed analytically from the scene geometry instead of voxelizing it.
+ *
+ * The walkable area is the floor boundary eroded by the agent radius minus the footprints of the volumes
+ * standing on the floor inflated by the agent radius. It is decomposed into trapezoid cells with a vertical
+ * sweep, cells sharing a vertical edge are linked. Paths are found with A* over the cells and shortened
+ * with the funnel algorithm.
+ *
+ * All 2D coordinates are in the local plane coordinate system of the floor anchor.
+ */
+class MRUTILITYKIT_API FMRUKNavigationData
+{
+public:
+	/**
+	 * Build the cells from a floor boundary and a list of convex obstacle footprints.
+	 * @return true if at least one walkable cell was generated.
+	 */
+	bool Build(const TArray<FVector2D>& Boundary, const TArray<TArray<FVector2D>>& Obstacles, double AgentRadius);
+
+	/**
+	 * Build the cells from the floor of a room and the volumes that have the floor as parent anchor.
+	 */
+	bool BuildFromRoom(const AMRUKRoom* Room, double AgentRadius);
+
+	void Reset();
+
+	/** Index of the cell containing the point or INDEX_NONE */
+	int32 FindCell(const FVector2D& Point) const;
+
+	/** Clamp a point to the walkable area. Returns the cell index of the projected point or INDEX_NONE if there are no cells. */
+	int32 ProjectPoint(const FVector2D& Point, FVector2D& OutPoint) const;
+
+	/**
+	 * Find the shortest path between two points. Points outside of the walkable area are projected onto it first.
+	 * @return false if the points are not connected.
+	 */
+	bool FindPath(const FVector2D& Start, const FVector2D& End, TArray<FVector2D>& OutPath) const;
+
+	/** Triangulated cells, e.g. for debug drawing */
+	void GetTriangles(TArray<FVector2D>& OutVertices, TArray<int32>& OutIndices) const;
+
+	double GetWalkableArea() const;
+
+	const TArray<FMRUKNavCell>& GetCells() const { return Cells; }
+
+	/** Floor local to world, only set when built from a room */
+	const FTransform& GetFloorTransform() const { return FloorTransform; }
+	FVector ToWorld(const FVector2D& Point) const;
+	FVector2D ToLocal(const FVector& Position) const;
+
+	/** Time it took to build the cells in seconds */
+	double GetBuildTime() const { return BuildTime; }
+
+private:
+	TArray<FMRUKNavCell> Cells;
+
+	/** X coordinates of the slab boundaries, cells of slab i are in [SlabCellStart[i], SlabCellStart[i + 1]) */
+	TArray<double> SlabX;
+	TArray<int32> SlabCellStart;
+
+	FTransform FloorTransform = FTransform::Identity;
+	double BuildTime = 0.0;
+
+	void StringPull(const FVector2D& Start, const FVector2D& End, const TArray<int32>& CellPath, TArray<FVector2D>& OutPath) const;
+};
+
+/**
+ * Generates navigation data for rooms as soon as they are loaded and keeps it up to date when rooms change.
+ * Use FindPath() to query paths in world space.
+ */
+UCLASS(ClassGroup = MRUtilityKit, meta = (DisplayName = "MR Utility Kit Navigation Generator"))
+class MRUTILITYKIT_API AMRUKNavigationGenerator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
+	EMRUKSpawnMode SpawnMode = EMRUKSpawnMode::CurrentRoomOnly;
+
+	/**
+	 * Radius of the agent. The walkable area keeps this distance to walls and volumes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0"))
+	double AgentRadius = 20.0;
+
+	/**
+	 * Create a flat mesh of the walkable area with collision for each room. The engine navigation system can
+	 * build its nav mesh from this single mesh instead of all the anchor geometry.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
+	bool bCreateWalkableMesh = false;
+
+	/**
+	 * Material for the walkable area mesh.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
+	TObjectPtr<UMaterialInterface> WalkableMeshMaterial;
+
+	/**
+	 * Build the navigation data for the given room. This only needs to be called manually if SpawnMode is None.
+	 * @param Room The room to build navigation data for.
+	 * @return Whether any walkable area was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool BuildNavigationForRoom(AMRUKRoom* Room);
+
+	/**
+	 * Remove the navigation data of a room.
+	 * @param Room The room to remove.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void RemoveNavigationForRoom(AMRUKRoom* Room);
+
+	/**
+	 * Find the shortest walkable path between two positions in the same room.
+	 * @param Start    Start position in world space.
+	 * @param End      End position in world space.
+	 * @param OutPath  Path points in world space at floor height, including start and end.
+	 * @return Whether a path was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool FindPath(const FVector& Start, const FVector& End, TArray<FVector>& OutPath) const;
+
+	/**
+	 * Project a position onto the walkable area of the room it is in.
+	 * @param Position     Position in world space.
+	 * @param OutPosition  Closest walkable position at floor height.
+	 * @return Whether a walkable area was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool ProjectPosition(const FVector& Position, FVector& OutPosition) const;
+
+	/**
+	 * Check whether a position is on the walkable area.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool IsPositionWalkable(const FVector& Position) const;
+
+	/**
+	 * Navigation data of a room or nullptr if it hasn't been built.
+	 */
+	const FMRUKNavigationData* GetNavigationData(const AMRUKRoom* Room) const;
+
+public:
+	AMRUKNavigationGenerator();
+
+protected:
+	void BeginPlay() override;
+
+private:
+	TMap<AMRUKRoom*, FMRUKNavigationData> NavigationData;
+
+	UPROPERTY()
+	TMap<TObjectPtr<AMRUKRoom>, TObjectPtr<UProceduralMeshComponent>> WalkableMeshes;
+
+	const FMRUKNavigationData* FindNavigationDataForPosition(const FVector& Position) const;
+	void UpdateWalkableMesh(AMRUKRoom* Room, const FMRUKNavigationData& Data);
+
+	UFUNCTION()
+	void OnRoomCreated(AMRUKRoom* Room);
+
+	UFUNCTION()
+	void OnRoomRemoved(AMRUKRoom* Room);
+};
@@ -0,0 +1,103 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AMRUKAnchor;
+
+/**
+ * A rectangular surface of an anchor positions can be generated on, either the plane or one face of the volume.
+ * Surface coordinates map linearly to world space: Origin + U * AxisU + V * AxisV.
+ */
+struct MRUTILITYKIT_API FMRUKSampleSurface
+{
+	AMRUKAnchor* Anchor = nullptr;
+	FVector Origin = FVector::ZeroVector;
+	FVector AxisU = FVector::RightVector;
+	FVector AxisV = FVector::UpVector;
+	// Unit length
+	FVector Normal = FVector::ForwardVector;
+	FBox2D Bounds;
+
+	/**
+	 * Area that is further away from the edges than the min distance to edge.
+	 */
+	float UsableArea = 0.0f;
+
+	/**
+	 * Whether this is the plane of the anchor. Positions on planes must be inside the plane boundary.
+	 */
+	bool IsPlane = false;
+
+	FVector GetWorldPosition(const FVector2D& Pos) const { return Origin + Pos.X * AxisU + Pos.Y * AxisV; }
+};
+
+/**
+ * Generates evenly spread (blue noise) positions with a minimum spacing between all of them.
+ *
+ * Positions are grown outwards from seed positions: candidates are only generated in the ring between one and two
+ * times the spacing around existing positions, and every position gets a fixed number of candidates before it is
+ * retired (Bridson's algorithm). All positions are hashed in a grid with a cell size that fits at most one position,
+ * so checking the spacing only looks at the neighbouring cells. Compared to drawing random positions and rejecting
+ * the ones that are too close, the time this takes is bounded by the number of positions that fit, no matter how
+ * densely they are packed. The grid is shared between all surfaces and volumes that are sampled, so the spacing is
+ * also kept across surfaces.
+ */
+class MRUTILITYKIT_API FMRUKPoissonDiskSampler
+{
+public:
+	/**
+	 * Called for every candidate position that keeps the spacing, to apply any additional constraints.
+	 */
+	using FIsValidPosition = TFunctionRef<bool(const FVector& Position, const FVector& Normal)>;
+
+	/**
+	 * Number of candidates per position before it is retired.
+	 */
+	int32 NumCandidates = 30;
+
+	/**
+	 * Sampling stops once this many positions were generated. Every candidate runs the constraints of the caller,
+	 * so this bounds the cost on large surfaces when only a few positions are needed.
+	 */
+	int32 MaxPositions = MAX_int32;
+
+	FMRUKPoissonDiskSampler(double InMinSpacing, const FRandomStream& InRandomStream);
+
+	/**
+	 * Fills the surfaces with positions.
+	 * @param MinDistanceToEdge Distance the positions keep to the edges of the surfaces.
+	 */
+	void SampleSurfaces(const TArray<FMRUKSampleSurface>& Surfaces, float MinDistanceToEdge, FIsValidPosition IsValidPosition);
+
+	/**
+	 * Fills the box with positions.
+	 */
+	void SampleVolume(const FBox& Box, FIsValidPosition IsValidPosition);
+
+	/**
+	 * Picks random positions from all positions generated so far. Every subset is still evenly spread.
+	 */
+	void GetRandomPositions(int32 Count, TArray<FVector>& OutPositions, TArray<FVector>& OutNormals) const;
+
+	int32 GetNumPositions() const { return Positions.Num(); }
+
+private:
+	FIntVector GetCell(const FVector& Position) const;
+	bool IsFarEnough(const FVector& Position) const;
+	bool TryAdd(const FVector& Position, const FVector& Normal, FIsValidPosition IsValidPosition);
+
+	double MinSpacing;
+	double CellSize;
+	const FRandomStream& RandomStream;
+
+	TArray<FVector> Positions;
+	TArray<FVector> Normals;
+	TMap<FIntVector, int32> Cells;
+};
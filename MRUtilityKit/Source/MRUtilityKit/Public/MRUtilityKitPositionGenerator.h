@@ -52,6 +52,22 @@ struct FMRUKRandomSpawnSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
 	int MaxIterations = 1000;
 
+	/**
+	 * Spread the positions evenly with at least MinSpacing between them, instead of drawing every position on its own
+	 * and retrying until it fits. All positions are generated in a single pass, so this stays fast for hundreds of
+	 * positions, also when they are packed densely. MaxIterations is not used in this mode.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
+	bool DistributeEvenly = false;
+
+	/**
+	 * Minimum distance between the generated positions when distributing them evenly. The spacing is raised to the
+	 * diameter of the actor bounds so the actors don't overlap, and on large surfaces so only a few times SpawnAmount
+	 * positions are generated. The raised spacing is logged at Verbose (LogMRUK).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (EditCondition = "DistributeEvenly", ClampMin = "1.0", UIMin = "1.0"))
+	float MinSpacing = 50.0f;
+
 	/**
 	* The type of surface by which to limit the generation.
 	 */
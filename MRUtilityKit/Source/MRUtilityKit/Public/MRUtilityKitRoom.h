@@ -10,6 +10,11 @@ LICENSE file in the root directory of this source tree.
 #include "GameFramework/Actor.h"
 #include "Dom/JsonObject.h"
 #include "MRUtilityKit.h"
+#include "MRUtilityKitAcoustics.h"
+#include "MRUtilityKitWallGraph.h"
+#include "MRUtilityKitSeatIndex.h"
+#include "MRUtilityKitPoissonDisk.h"
+#include "MRUtilityKitRoomSnapshot.h"
 #include "OculusXRAnchorTypes.h"
 #include "MRUtilityKitRoom.generated.h"
 
@@ -79,6 +84,45 @@ struct FMRUKAnchorWithPlaneUVs
 	TArray<FMRUKPlaneUV> PlaneUVs;
 };
 
+/**
+ * A single unit of work when spawning the interior of a room: the procedural walls, a procedural mesh
+ * or an actor on one anchor.
+ */
+struct MRUTILITYKIT_API FMRUKInteriorSpawnStep
+{
+	enum class EType : uint8
+	{
+		// Procedural meshes on all walls at once, so the UVs are seamless
+		ProceduralWalls,
+		// Procedural mesh on the anchor with the given plane UVs
+		ProceduralPlane,
+		// Procedural mesh on the anchor with the cut hole labels and material of the plan
+		ProceduralMesh,
+		// Procedural mesh on an anchor without labels, without holes and with the default material
+		ProceduralMeshUnlabeled,
+		// Actor from the spawn group
+		Actor,
+	};
+
+	EType Type = EType::Actor;
+	// Weak because the anchor may be removed while the steps are executed over multiple frames
+	TWeakObjectPtr<AMRUKAnchor> Anchor;
+	TArray<FMRUKPlaneUV> PlaneUVs;
+	FMRUKSpawnActor SpawnActor;
+};
+
+/**
+ * Everything that needs to be done to spawn the interior of a room. All random choices are made while the
+ * plan is created, so the steps can be executed in any order and over multiple frames and still spawn
+ * the same actors as spawning everything at once.
+ */
+struct MRUTILITYKIT_API FMRUKInteriorSpawnPlan
+{
+	TArray<FMRUKInteriorSpawnStep> Steps;
+	TArray<FString> CutHoleLabels;
+	UMaterialInterface* ProceduralMaterial = nullptr;
+};
+
 UCLASS(ClassGroup = MRUtilityKit, meta = (DisplayName = "MR Utility Kit Room Actor"))
 class MRUTILITYKIT_API AMRUKRoom : public AActor
 {
@@ -168,6 +212,13 @@ public:
 	UPROPERTY(VisibleInstanceOnly, Transient, BlueprintReadOnly, Category = "MR Utility Kit")
 	TArray<TObjectPtr<AMRUKAnchor>> AllAnchors;
 
+	/**
+	 * Acoustic properties of the room. Gets recomputed when the room is loaded or updated.
+	 * The absorption coefficients can be configured in the project settings.
+	 */
+	UPROPERTY(VisibleInstanceOnly, Transient, BlueprintReadOnly, Category = "MR Utility Kit")
+	FMRUKRoomAcousticProfile AcousticProfile;
+
 
 	/**
 	 * Check whether the position is inside the room or not.
@@ -284,6 +335,66 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	AMRUKAnchor* TryGetClosestSeatPose(const FVector& RayOrigin, const FVector& RayDirection, FTransform& OutSeatTransform);
 
+	/**
+	 * Finds the free seat closest to the given position.
+	 * @param Position        The position in world space to search from.
+	 * @param OutSeat         The closest free seat.
+	 * @param FacingDirection If not zero, only seats facing in this direction are considered.
+	 * @param MaxFacingAngle  The maximum angle in degrees between the seat and the facing direction.
+	 * @return                Whether a free seat was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool GetClosestFreeSeat(const FVector& Position, FMRUKSeat& OutSeat, FVector FacingDirection = FVector::ZeroVector, double MaxFacingAngle = 180.0);
+
+	/**
+	 * Finds the free seat closest to the given position and reserves it for the occupant. Finding and reserving
+	 * happens in one step, so two occupants never get the same seat. The occupant gives up any other seat in this room.
+	 * @param Position        The position in world space to search from.
+	 * @param Occupant        The object that takes the seat, e.g. a pawn or a player state.
+	 * @param OutSeat         The reserved seat.
+	 * @param FacingDirection If not zero, only seats facing in this direction are considered.
+	 * @param MaxFacingAngle  The maximum angle in degrees between the seat and the facing direction.
+	 * @return                Whether a seat was reserved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool TryReserveClosestSeat(const FVector& Position, UObject* Occupant, FMRUKSeat& OutSeat, FVector FacingDirection = FVector::ZeroVector, double MaxFacingAngle = 180.0);
+
+	/**
+	 * Reserves a specific seat for the occupant, e.g. to mirror a reservation that was made on the server.
+	 * The occupant gives up any other seat in this room.
+	 * @param Anchor    The anchor the seat belongs to.
+	 * @param SeatIndex The index of the seat in the seat poses of the anchor.
+	 * @param Occupant  The object that takes the seat.
+	 * @return          Whether the seat is reserved for the occupant. False if it is taken by someone else.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool ReserveSeat(AMRUKAnchor* Anchor, int32 SeatIndex, UObject* Occupant);
+
+	/**
+	 * Releases a reserved seat.
+	 * @param Anchor    The anchor the seat belongs to.
+	 * @param SeatIndex The index of the seat in the seat poses of the anchor.
+	 * @return          Whether the seat was reserved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool ReleaseSeat(AMRUKAnchor* Anchor, int32 SeatIndex);
+
+	/**
+	 * Releases all seats of the occupant in this room. Seats of destroyed occupants are released automatically.
+	 * @param Occupant The object that has taken the seats.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void ReleaseSeatsOf(UObject* Occupant);
+
+	/**
+	 * Get the occupant of a seat.
+	 * @param Anchor    The anchor the seat belongs to.
+	 * @param SeatIndex The index of the seat in the seat poses of the anchor.
+	 * @return          The occupant if the seat is reserved. Otherwise, a null pointer.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	UObject* GetSeatOccupant(AMRUKAnchor* Anchor, int32 SeatIndex);
+
 	/**
 	 * Finds all anchors in this room that have the given label attached.
 	 * @param Label The label to search for.
@@ -324,6 +435,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	AMRUKAnchor* GetKeyWall(double Tolerance = 0.1);
 
+	/**
+	 * Get the walls connected to the given wall and the angles of the corners in between.
+	 * The right wall is the one in direction of the walls right vector.
+	 * @param Wall                The wall anchor.
+	 * @param OutLeftWall         The wall connected to the left end if any. Otherwise, a null pointer.
+	 * @param OutRightWall        The wall connected to the right end if any. Otherwise, a null pointer.
+	 * @param OutLeftCornerAngle  The angle inside the room between the left wall and this wall in degrees.
+	 * @param OutRightCornerAngle The angle inside the room between this wall and the right wall in degrees.
+	 * @return                    Whether the anchor is a wall of this room.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool GetWallNeighbors(AMRUKAnchor* Wall, AMRUKAnchor*& OutLeftWall, AMRUKAnchor*& OutRightWall, double& OutLeftCornerAngle, double& OutRightCornerAngle) const;
+
+	/**
+	 * Get the walls in the order in which they go around the room. Each wall shares an edge with the next one.
+	 * @return The wall anchors in perimeter order.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	TArray<AMRUKAnchor*> GetWallsInPerimeterOrder() const;
+
 	/**
 	 * Return the largest surface for a given label.
 	 * @param Label The label of the surfaces to search in.
@@ -424,14 +555,57 @@ public:
 	void LoadFromData(UMRUKRoomData* RoomData);
 
 	void AttachProceduralMeshToWalls(const TArray<FString>& CutHoleLabels, UMaterialInterface* ProceduralMaterial = nullptr);
+
+	/**
+	 * Decides what SpawnInteriorFromStream would spawn on each anchor without spawning anything yet.
+	 * The random stream is advanced in the same way as SpawnInteriorFromStream does.
+	 */
+	void PlanInteriorSpawn(const TMap<FString, FMRUKSpawnGroup>& SpawnGroups, const FRandomStream& RandomStream, const TArray<FString>& CutHoleLabels, UMaterialInterface* ProceduralMaterial, bool ShouldFallbackToProcedural, FMRUKInteriorSpawnPlan& OutPlan);
+
+	/**
+	 * Executes a single step of the plan.
+	 * @return The spawned actor if the step spawns one.
+	 */
+	AActor* ExecuteInteriorSpawnStep(const FMRUKInteriorSpawnPlan& Plan, const FMRUKInteriorSpawnStep& Step);
+
+	/**
+	 * Collects the planes and volume faces positions can be generated on, the same that GenerateRandomPositionOnSurface uses.
+	 * Surfaces that are narrower than twice the min distance to edge are skipped.
+	 */
+	void GetSpawnSurfaces(EMRUKSpawnLocation SpawnLocation, float MinDistanceToEdge, const FMRUKLabelFilter& LabelFilter, TArray<FMRUKSampleSurface>& OutSurfaces) const;
+
 	void UpdateWorldLock(APawn* Pawn, const FVector& HeadWorldPosition) const;
 
 	TSharedRef<FJsonObject> JsonSerialize();
 
 	bool Corresponds(UMRUKRoomData* RoomQuery) const;
 
+	/**
+	 * Connections, corner angles and length ranking of the walls. Gets updated when the room is loaded or updated.
+	 */
+	const FMRUKWallGraph& GetWallGraph() const { return WallGraph; }
+
+	/**
+	 * Marks the seat index for a rebuild, e.g. after the seat poses of an anchor were recalculated.
+	 */
+	void MarkSeatsDirty() { bSeatsDirty = true; }
+
+	/**
+	 * The latest snapshot of the room that can be queried from any thread, see FMRUKRoomSnapshot.
+	 * Only call this on the game thread and pass the snapshot on to the tasks that need it.
+	 * @return The snapshot, nullptr if the room wasn't loaded yet.
+	 */
+	FMRUKRoomSnapshotPtr GetSnapshot() const { return Snapshot; }
+
+	/**
+	 * Publishes a new snapshot of the room. Loading, updating and clearing the room does this already, call it after
+	 * moving the room or its anchors manually.
+	 */
+	void PublishSnapshot();
+
 private:
 	friend class FMRUKSpec;
+	friend class UMRUKBenchmarkCommandlet;
 
 	AMRUKAnchor* SpawnAnchor();
 
@@ -440,6 +614,9 @@ private:
 	void ComputeAnchorHierarchy();
 	void ComputeSeats();
 	void ComputeRoomEdges();
+	void ComputeWallGraph();
+	FMRUKSeatIndex& GetSeatIndex();
+	void ComputeAcousticProfile();
 
 	UFUNCTION(CallInEditor)
 	void AddAnchorToRoom(AMRUKAnchor* Anchor);
@@ -447,23 +624,10 @@ private:
 	class UProceduralMeshComponent* GetOrCreateGlobalMeshProceduralMeshComponent(bool& OutExistedAlready) const;
 	void SetupGlobalMeshProceduralMeshComponent(UProceduralMeshComponent& ProcMeshComponent, bool ExistedAlready, UMaterialInterface* Material) const;
 
-	/**
-	 * Get the list of walls in an order such that each one wall shares an edge with the next
-	 * one in the list.
-	 */
-	TArray<TObjectPtr<AMRUKAnchor>> ComputeConnectedWalls() const;
-
 	FOculusXRRoomLayout RoomLayout;
-	UPROPERTY()
-	AMRUKAnchor* KeyWallAnchor = nullptr;
-
-
-	struct Surface
-	{
-		AMRUKAnchor* Anchor;
-		float UsableArea;
-		bool IsPlane;
-		FBox2D Bounds;
-		EMRUKBoxSide Side;
-	};
+	FMRUKWallGraph WallGraph;
+	FMRUKSeatIndex SeatReservations;
+	bool bSeatsDirty = false;
+	FMRUKRoomSnapshotPtr Snapshot;
+	uint32 SnapshotVersion = 0;
 };
@@ -0,0 +1,177 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Templates/SharedPointer.h"
+#include "MRUtilityKit.h"
+#include "OculusXRAnchorTypes.h"
+
+class AMRUKAnchor;
+class AMRUKRoom;
+
+/**
+ * Copy of the geometry of a single anchor, taken when the room snapshot was published.
+ * Everything is in the same units and spaces as on AMRUKAnchor.
+ */
+struct MRUTILITYKIT_API FMRUKAnchorSnapshot
+{
+	FOculusXRUUID AnchorUUID;
+	TArray<FString> SemanticClassifications;
+
+	/**
+	 * The world transform of the anchor.
+	 */
+	FTransform Transform;
+
+	FBox2D PlaneBounds{ ForceInit };
+	TArray<FVector2D> PlaneBoundary2D;
+	FBox VolumeBounds{ ForceInit };
+
+	/**
+	 * Triangulation of the plane boundary, three indices into PlaneBoundary2D per triangle.
+	 */
+	TArray<int32> PlaneTriangles;
+	TArray<float> PlaneTriangleAreas;
+	float PlaneArea = 0.0f;
+
+	/**
+	 * Index of the parent anchor in the snapshot, INDEX_NONE if the anchor has no parent.
+	 */
+	int32 ParentIndex = INDEX_NONE;
+
+	/**
+	 * Whether this is the global mesh anchor. The global mesh can only be traced by the physics scene, so the
+	 * snapshot queries skip it.
+	 */
+	bool bIsGlobalMesh = false;
+
+	/**
+	 * The anchor actor the snapshot was taken from. Only use it on the game thread.
+	 */
+	TWeakObjectPtr<AMRUKAnchor> Anchor;
+
+	bool HasLabel(const FString& Label) const { return SemanticClassifications.Contains(Label); }
+	bool PassesLabelFilter(const FMRUKLabelFilter& LabelFilter) const { return LabelFilter.PassesFilter(SemanticClassifications); }
+
+	/**
+	 * Same as AMRUKAnchor::IsPositionInBoundary.
+	 */
+	bool IsPositionInBoundary(const FVector2D& Position) const;
+
+	/**
+	 * Same as AMRUKAnchor::Raycast, except for the global mesh which is never hit.
+	 */
+	bool Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, FMRUKHit& OutHit) const;
+
+	/**
+	 * Same as AMRUKAnchor::RaycastAll, except for the global mesh which is never hit.
+	 */
+	bool RaycastAll(const FVector& Origin, const FVector& Direction, float MaxDist, TArray<FMRUKHit>& OutHits) const;
+
+	/**
+	 * Same as AMRUKAnchor::GetClosestSurfacePosition.
+	 */
+	double GetClosestSurfacePosition(const FVector& TestPosition, FVector& OutSurfacePosition) const;
+
+	/**
+	 * Same as AMRUKAnchor::IsPositionInVolumeBounds.
+	 */
+	bool IsPositionInVolumeBounds(const FVector& Position, bool TestVerticalBounds = true, double Tolerance = 0.0) const;
+
+	/**
+	 * Same as AMRUKAnchor::GenerateRandomPositionOnPlaneFromStream, uses the precomputed triangulation.
+	 * @return The position in the local space of the anchor.
+	 */
+	FVector GenerateRandomPositionOnPlane(const FRandomStream& RandomStream) const;
+};
+
+/**
+ * Immutable copy of the geometry of a room that can be queried from any thread.
+ *
+ * The room publishes a new snapshot on the game thread whenever it is loaded, updated or cleared. A snapshot is
+ * never modified after it was published, so it is safe to read from any number of threads without locking.
+ * Grab the current snapshot from AMRUKRoom::GetSnapshot() on the game thread and hand it to the tasks that need it.
+ * A task sees the room exactly as it was when that snapshot was published, for as long as it holds on to it,
+ * even if the room is updated or destroyed in the meantime. Compare the versions to find out if there is a newer one.
+ *
+ * The queries match the ones on AMRUKRoom, but return the index of the anchor in GetAnchors() instead of the actor.
+ * The global mesh is not part of the queries, as it can only be traced by the physics scene.
+ */
+class MRUTILITYKIT_API FMRUKRoomSnapshot
+{
+public:
+	/**
+	 * Copies the current state of the room, has to be called on the game thread.
+	 */
+	static TSharedRef<const FMRUKRoomSnapshot, ESPMode::ThreadSafe> Create(const AMRUKRoom& Room, uint32 Version);
+
+	/**
+	 * Increases every time the room publishes a new snapshot.
+	 */
+	uint32 GetVersion() const { return Version; }
+
+	const FOculusXRUUID& GetRoomUUID() const { return RoomUUID; }
+	const TArray<FMRUKAnchorSnapshot>& GetAnchors() const { return Anchors; }
+	const FBox& GetRoomBounds() const { return RoomBounds; }
+
+	/**
+	 * @return The floor anchor, nullptr if the room doesn't have one.
+	 */
+	const FMRUKAnchorSnapshot* GetFloor() const { return Anchors.IsValidIndex(FloorIndex) ? &Anchors[FloorIndex] : nullptr; }
+
+	/**
+	 * @return The ceiling anchor, nullptr if the room doesn't have one.
+	 */
+	const FMRUKAnchorSnapshot* GetCeiling() const { return Anchors.IsValidIndex(CeilingIndex) ? &Anchors[CeilingIndex] : nullptr; }
+
+	int32 FindAnchor(const FOculusXRUUID& AnchorUUID) const;
+
+	/**
+	 * Same as AMRUKRoom::IsPositionInRoom.
+	 */
+	bool IsPositionInRoom(const FVector& Position, bool TestVerticalBounds = true) const;
+
+	/**
+	 * Same as AMRUKRoom::Raycast.
+	 * @return The index of the anchor that was hit, INDEX_NONE if nothing was hit.
+	 */
+	int32 Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, const FMRUKLabelFilter& LabelFilter, FMRUKHit& OutHit) const;
+
+	/**
+	 * Same as AMRUKRoom::RaycastAll.
+	 * @param OutAnchorIndices For every hit the index of the anchor that was hit.
+	 */
+	bool RaycastAll(const FVector& Origin, const FVector& Direction, float MaxDist, const FMRUKLabelFilter& LabelFilter, TArray<FMRUKHit>& OutHits, TArray<int32>& OutAnchorIndices) const;
+
+	/**
+	 * Same as AMRUKRoom::TryGetClosestSurfacePosition.
+	 * @return The index of the closest anchor, INDEX_NONE if there is none within MaxDistance.
+	 */
+	int32 TryGetClosestSurfacePosition(const FVector& WorldPosition, FVector& OutSurfacePosition, double& OutSurfaceDistance, const FMRUKLabelFilter& LabelFilter, double MaxDistance = 0.0) const;
+
+	/**
+	 * Same as AMRUKRoom::IsPositionInSceneVolume.
+	 * @return The index of the anchor the position is in, INDEX_NONE if it isn't in any volume.
+	 */
+	int32 IsPositionInSceneVolume(const FVector& WorldPosition, bool TestVerticalBounds = true, double Tolerance = 0.0) const;
+
+private:
+	FMRUKRoomSnapshot() = default;
+
+	uint32 Version = 0;
+	FOculusXRUUID RoomUUID;
+	FBox RoomBounds{ ForceInit };
+	TArray<FMRUKAnchorSnapshot> Anchors;
+	int32 FloorIndex = INDEX_NONE;
+	int32 CeilingIndex = INDEX_NONE;
+};
+
+using FMRUKRoomSnapshotPtr = TSharedPtr<const FMRUKRoomSnapshot, ESPMode::ThreadSafe>;
+using FMRUKRoomSnapshotRef = TSharedRef<const FMRUKRoomSnapshot, ESPMode::ThreadSafe>;
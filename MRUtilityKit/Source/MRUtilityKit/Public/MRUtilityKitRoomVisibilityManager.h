@@ -0,0 +1,207 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "MRUtilityKit.h"
+#include "GameFramework/Actor.h"
+#include "MRUtilityKitRoomVisibilityManager.generated.h"
+
+class AMRUKRoom;
+class AMRUKAnchor;
+
+/**
+ * Actors with this tag are never hidden by the room visibility manager.
+ */
+const FName GMRUK_NO_ROOM_CULLING_ACTOR_TAG = TEXT("NoRoomCulling");
+
+/**
+ * Statistics of the last visibility update of the room visibility manager.
+ */
+USTRUCT(BlueprintType)
+struct MRUTILITYKIT_API FMRUKRoomCullingStats
+{
+	GENERATED_BODY()
+
+	/**
+	 * Number of rooms that are visible from the current room, including the current room.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 VisibleRooms = 0;
+
+	/**
+	 * Number of rooms that are hidden.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 CulledRooms = 0;
+
+	/**
+	 * Number of actors that are hidden.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 CulledActors = 0;
+
+	/**
+	 * Number of primitive components that are not rendered because their actor is hidden.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 CulledPrimitives = 0;
+
+	/**
+	 * Estimated number of draw calls saved. Every material slot of a culled mesh counts as one draw call.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 CulledDrawCalls = 0;
+
+	/**
+	 * Number of times the visibility of the rooms changed since BeginPlay.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 VisibilityUpdates = 0;
+};
+
+/**
+ * Hides the actors of rooms that can not be seen from the room the player is in.
+ *
+ * Real walls hide everything outside of the current room, except for what can be seen through door
+ * and window frames. These are treated as portals: a neighbouring room stays visible as long as a portal
+ * leading to it is in the view. The visibility of the actors is only changed when the player enters
+ * another room or when a portal enters or leaves the view.
+ *
+ * Actors owned by a room are the room actor itself, its anchors and everything that is attached to them,
+ * e.g. actors from the anchor actor spawner and procedural meshes. If the player is not inside any room
+ * all rooms are visible.
+ */
+UCLASS(ClassGroup = MRUtilityKit, meta = (DisplayName = "MR Utility Kit Room Visibility Manager"))
+class MRUTILITYKIT_API AMRUKRoomVisibilityManager : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Whether rooms that can not be seen should be hidden.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, BlueprintSetter = SetCullingEnabled, Category = "MR Utility Kit")
+	bool bCullingEnabled = true;
+
+	/**
+	 * Anchors with these labels are treated as portals into neighbouring rooms.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
+	TArray<FString> PortalLabels = { FMRUKLabels::DoorFrame, FMRUKLabels::WindowFrame };
+
+	/**
+	 * How many portals deep rooms are considered visible. 1 means only rooms directly connected to the current room.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "1"))
+	int32 MaxPortalDepth = 2;
+
+	/**
+	 * Distance in world units a portal may be away from the bounds of a room to be considered connected to it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0"))
+	double PortalConnectionTolerance = 20.0;
+
+	/**
+	 * Angle in degrees added to the field of view when testing whether a portal is in the view.
+	 * Larger values keep rooms visible a bit longer when turning the head quickly.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "90.0"))
+	double ViewAngleMargin = 15.0;
+
+	/**
+	 * Portals closer than this distance to the camera are always considered visible.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0"))
+	double PortalNearDistance = 50.0;
+
+	/**
+	 * Enable or disable culling. Disabling it shows all rooms again.
+	 */
+	UFUNCTION(BlueprintSetter, Category = "MR Utility Kit")
+	void SetCullingEnabled(bool bEnabled);
+
+	/**
+	 * Exclude a room from culling. Rooms that are excluded are always visible.
+	 * @param Room     The room.
+	 * @param bEnabled Whether the room may be culled.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void SetRoomCullingEnabled(AMRUKRoom* Room, bool bEnabled);
+
+	/**
+	 * Check whether a room may be culled.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool IsRoomCullingEnabled(AMRUKRoom* Room) const;
+
+	/**
+	 * Check whether a room is currently visible.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool IsRoomVisible(AMRUKRoom* Room) const;
+
+	/**
+	 * Force a visibility update in the next tick. Call this after spawning actors into a room that is currently hidden.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void RefreshVisibility();
+
+	/**
+	 * Statistics of the last visibility update.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	const FMRUKRoomCullingStats& GetCullingStats() const { return CullingStats; }
+
+public:
+	AMRUKRoomVisibilityManager();
+
+	void Tick(float DeltaSeconds) override;
+
+protected:
+	void BeginPlay() override;
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	struct FPortal
+	{
+		TWeakObjectPtr<AMRUKAnchor> Anchor;
+		/** Room the portal is in and the room it leads to */
+		TWeakObjectPtr<AMRUKRoom> FromRoom;
+		TWeakObjectPtr<AMRUKRoom> ToRoom;
+	};
+
+	/** Portals by the room they are in, rebuilt when rooms change */
+	TMap<TWeakObjectPtr<AMRUKRoom>, TArray<FPortal>> Portals;
+
+	UPROPERTY()
+	TSet<TObjectPtr<AMRUKRoom>> ExcludedRooms;
+
+	/** Rooms that are visible, sorted by pointer to make comparing cheap */
+	TArray<TWeakObjectPtr<AMRUKRoom>> VisibleRooms;
+	TArray<TWeakObjectPtr<AMRUKRoom>> NewVisibleRooms;
+
+	/** Actors that were hidden by this manager. Only these get shown again. */
+	TSet<TWeakObjectPtr<AActor>> HiddenActors;
+
+	TWeakObjectPtr<AMRUKRoom> CurrentRoom;
+	bool bPortalsDirty = true;
+	bool bVisibilityDirty = true;
+
+	FMRUKRoomCullingStats CullingStats;
+
+	void RebuildPortals();
+	bool GetView(FVector& OutLocation, FVector& OutDirection, double& OutHalfFOV) const;
+	AMRUKRoom* FindRoomAtPosition(const FVector& Position) const;
+	bool IsPortalInView(const AMRUKAnchor* Anchor, const FVector& ViewLocation, const FVector& ViewDirection, double CosHalfFOV) const;
+	void ComputeVisibleRooms(AMRUKRoom* Room, const FVector& ViewLocation, const FVector& ViewDirection, double HalfFOV, TArray<TWeakObjectPtr<AMRUKRoom>>& OutRooms) const;
+	void ApplyVisibility();
+	void ShowAllRooms();
+
+	UFUNCTION()
+	void OnRoomChanged(AMRUKRoom* Room);
+};
@@ -0,0 +1,81 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MRUtilityKitSceneGenerator.generated.h"
+
+/**
+ * Parameters for generating synthetic scenes. The same settings always produce the same scene.
+ */
+USTRUCT(BlueprintType)
+struct MRUTILITYKIT_API FMRUKSceneGeneratorSettings
+{
+	GENERATED_BODY()
+
+	/**
+	 * Seed of the random stream. Every value produces a different scene.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
+	int32 Seed = 0;
+
+	/**
+	 * Number of rooms. The rooms are laid out next to each other along the X axis.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "1"))
+	int32 RoomCount = 1;
+
+	/**
+	 * Number of walls of every room. The floor outline is a star shaped polygon with one corner per wall.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "3"))
+	int32 WallCount = 4;
+
+	/**
+	 * Minimum and maximum radius of the floor outline in world units.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "50.0"))
+	double MinRoomRadius = 200.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "50.0"))
+	double MaxRoomRadius = 400.0;
+
+	/**
+	 * Distance between floor and ceiling in world units.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "50.0"))
+	double RoomHeight = 260.0;
+
+	/**
+	 * Number of furniture volumes per m² of floor area.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0"))
+	double FurnitureDensity = 0.5;
+
+	/**
+	 * Probability in [0, 1] that a wall has a door, window or wall art anchor on it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	double WallObjectProbability = 0.5;
+
+	/**
+	 * Approximate number of triangles of the global mesh of every room. 0 generates no global mesh.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit", meta = (ClampMin = "0"))
+	int32 GlobalMeshTriangles = 0;
+};
+
+/**
+ * Generate a synthetic scene in the JSON format that UMRUKSubsystem::LoadSceneFromJsonString() accepts.
+ * Scenes can be made arbitrarily large, which makes them useful to benchmark and test the scene queries without a device.
+ * The global mesh, if any, is included in the JSON and can be loaded with AMRUKRoom::LoadGlobalMeshFromJsonString().
+ * @param Settings       Parameters of the scene.
+ * @param WorldToMeters  World units per meter.
+ * @return The scene as JSON string.
+ */
+MRUTILITYKIT_API FString MRUKGenerateSceneJson(const FMRUKSceneGeneratorSettings& Settings, double WorldToMeters = 100.0);
@@ -0,0 +1,111 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "MRUtilityKitSeatIndex.generated.h"
+
+class AMRUKAnchor;
+
+/**
+ * A single seat on a seat anchor.
+ */
+USTRUCT(BlueprintType)
+struct MRUTILITYKIT_API FMRUKSeat
+{
+	GENERATED_BODY()
+
+	/**
+	 * The anchor the seat belongs to.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	TObjectPtr<AMRUKAnchor> Anchor;
+
+	/**
+	 * Index of the seat in the seat poses of the anchors seats component. Together with the anchor
+	 * UUID this identifies the seat across the network.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 SeatIndex = INDEX_NONE;
+
+	/**
+	 * The seat pose, facing in the direction someone sitting on it would look.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	FTransform Pose;
+};
+
+/**
+ * Spatial index over the seats of a room that keeps track of which seats are taken.
+ *
+ * The seats are stored in a k-d tree, every tree node knows how many free seats are below it, so fully
+ * taken parts of the room are skipped and the closest free seat is found in O(log n) on average. A seat
+ * is taken by an occupant, e.g. a pawn or a player state. Finding and reserving a seat happens in a single
+ * call so two avatars never end up on the same seat. Reservations of destroyed occupants are released
+ * automatically. Reservations are kept when the index is rebuilt, as long as the seat still exists.
+ */
+class MRUTILITYKIT_API FMRUKSeatIndex
+{
+public:
+	/**
+	 * Rebuilds the index from the seats components of the given anchors.
+	 */
+	void Build(const TArray<TObjectPtr<AMRUKAnchor>>& SeatAnchors);
+	void Reset();
+
+	const TArray<FMRUKSeat>& GetSeats() const { return Seats; }
+	int32 FindSeat(const AMRUKAnchor* Anchor, int32 SeatIndex) const;
+	int32 GetNumFreeSeats() const { return Nodes.IsEmpty() ? 0 : Nodes[Nodes.Num() / 2].NumFreeSeats; }
+
+	/**
+	 * Finds the free seat closest to the position.
+	 * @param FacingDirection If not zero, only seats facing within MaxFacingAngle degrees of this direction are considered.
+	 * @return The index of the seat, INDEX_NONE if there is no free seat.
+	 */
+	int32 FindClosestFreeSeat(const FVector& Position, const FVector& FacingDirection = FVector::ZeroVector, double MaxFacingAngle = 180.0);
+
+	/**
+	 * Reserves the seat for the occupant. Fails if another occupant has the seat already.
+	 * The occupant gives up any other seat it had in this index.
+	 */
+	bool Reserve(int32 Seat, UObject* Occupant);
+	bool Release(int32 Seat);
+	void ReleaseAll(const UObject* Occupant);
+	UObject* GetOccupant(int32 Seat) const;
+
+private:
+	struct FNode
+	{
+		int32 Seat = INDEX_NONE;
+		int32 Parent = INDEX_NONE;
+		int32 NumFreeSeats = 0;
+		uint8 Axis = 0;
+	};
+
+	struct FQuery
+	{
+		FVector Position;
+		FVector FacingDirection;
+		double MinFacingDot;
+		int32 BestSeat;
+		double BestDistSquared;
+	};
+
+	int32 BuildNodes(TArray<int32>& SeatIndices, int32 Begin, int32 End, int32 Parent);
+	void Search(int32 Begin, int32 End, FQuery& Query) const;
+	void UpdateFreeCount(int32 Seat, int32 Delta);
+	void ReleaseStaleReservations();
+
+	TArray<FMRUKSeat> Seats;
+	// Implicit k-d tree, the node of a range is in its middle
+	TArray<FNode> Nodes;
+	TArray<int32> SeatNodes;
+	TMap<TPair<const AMRUKAnchor*, int32>, int32> SeatLookup;
+	TMap<int32, TWeakObjectPtr<UObject>> Reservations;
+};
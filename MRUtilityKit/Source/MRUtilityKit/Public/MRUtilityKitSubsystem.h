@@ -16,6 +16,7 @@ LICENSE file in the root directory of this source tree.
 #include "MRUtilityKit.h"
 #include "MRUtilityKitData.h"
 #include "OculusXRSceneTypes.h"
+#include "OculusXRWorkloadThrottle.h"
 #include "MRUtilityKitSubsystem.generated.h"
 
 /**
@@ -39,7 +40,7 @@ LICENSE file in the root directory of this source tree.
  * with the same name on the AMRUKRoom.
  */
 UCLASS(ClassGroup = MRUtilityKit)
-class MRUTILITYKIT_API UMRUKSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+class MRUTILITYKIT_API UMRUKSubsystem : public UGameInstanceSubsystem, public FTickableGameObject, public IOculusXRWorkloadThrottleable
 {
 	GENERATED_BODY()
 
@@ -51,6 +52,7 @@ public:
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRoomRemoved, AMRUKRoom*, Room);
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRoomEntered, AMRUKRoom*, Room);
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRoomExited, AMRUKRoom*, Room);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCurrentRoomChanged, AMRUKRoom*, NewRoom, AMRUKRoom*, PreviousRoom);
 
 	/**
 	 * The status of the scene loading. When loading from device this is an asynchronous process
@@ -102,6 +104,14 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "MR Utility Kit")
 	FOnRoomExited OnRoomExited;
 
+	/**
+	 * Event that gets fired when the room returned by GetCurrentRoom() changes.
+	 * Unlike OnRoomEntered this also works with rooms loaded from JSON. Use it to switch
+	 * e.g. reverb settings to the acoustic profile of the new room.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "MR Utility Kit")
+	FOnCurrentRoomChanged OnCurrentRoomChanged;
+
 	/**
 	 * An event that will trigger when the capture flow completed.
 	 * The Success parameter indicates whether the scene was captured successfully or not.
@@ -158,6 +168,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	AMRUKRoom* GetCurrentRoom() const;
 
+	/**
+	 * Return the acoustic profile of the current room. The profile is invalid if no room has been loaded.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	FMRUKRoomAcousticProfile GetCurrentRoomAcousticProfile() const;
+
 	/**
 	 * Save all rooms and anchors to JSON. This JSON representation can than later be used by
 	 * LoadSceneFromJsonString() to load the scene again.
@@ -207,6 +223,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	AMRUKAnchor* TryGetClosestSeatPose(const FVector& RayOrigin, const FVector& RayDirection, FTransform& OutSeatTransform);
 
+	/**
+	 * Finds the free seat closest to the given position in all rooms and reserves it for the occupant. Finding and
+	 * reserving happens in one step, so two occupants never get the same seat. The occupant gives up any other seat.
+	 * Queries and reservations of a specific seat (GetClosestFreeSeat, ReserveSeat, ReleaseSeat, GetSeatOccupant) are on AMRUKRoom.
+	 * @param Position        The position in world space to search from.
+	 * @param Occupant        The object that takes the seat, e.g. a pawn or a player state.
+	 * @param OutSeat         The reserved seat.
+	 * @param FacingDirection If not zero, only seats facing in this direction are considered.
+	 * @param MaxFacingAngle  The maximum angle in degrees between the seat and the facing direction.
+	 * @return                Whether a seat was reserved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool TryReserveClosestSeat(const FVector& Position, UObject* Occupant, FMRUKSeat& OutSeat, FVector FacingDirection = FVector::ZeroVector, double MaxFacingAngle = 180.0);
+
+	/**
+	 * Releases all seats of the occupant in all rooms.
+	 * @param Occupant The object that has taken the seats.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void ReleaseSeatsOf(UObject* Occupant);
+
 	/**
 	 * Get a suggested pose (position & rotation) from a raycast to place objects on surfaces in the scene.
 	 * There are different positioning modes available. Default just uses the position where the raycast
@@ -287,6 +324,7 @@ public:
 public:
 
 	void Initialize(FSubsystemCollectionBase& Collection) override;
+	void Deinitialize() override;
 	TSharedRef<FJsonObject> JsonSerialize();
 	void UnregisterRoom(AMRUKRoom* Room);
 	// Calculate the bounds of an Actor class and return it, the result is saved in a cache for faster lookup.
@@ -306,6 +344,12 @@ private:
 	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
 	// ~FTickableGameObject interface
 
+	// IOculusXRWorkloadThrottleable interface
+	virtual void OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy) override;
+	virtual void OnWorkloadRestored_Implementation() override;
+	// ~IOculusXRWorkloadThrottleable interface
+
+	void SceneRoomDataLoaded(UMRUKRoomData* RoomData);
 	UFUNCTION()
 	void SceneDataLoadedComplete(bool Success);
 	UFUNCTION()
@@ -323,6 +367,9 @@ private:
 	UPROPERTY()
 	mutable AMRUKRoom* CachedCurrentRoom = nullptr;
 	mutable int64 CachedCurrentRoomFrame = 0;
+	TWeakObjectPtr<AMRUKRoom> LastCurrentRoom;
+	/** The world lock is paused while the app workload is throttled, EnableWorldLock is left untouched */
+	bool bWorldLockPausedByWorkloadThrottle = false;
 	UPROPERTY()
 	AActor* PositionGenerator = nullptr;
 
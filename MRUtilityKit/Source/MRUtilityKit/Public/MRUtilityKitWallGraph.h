@@ -0,0 +1,169 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AMRUKAnchor;
+
+/**
+ * A wall of the room together with its connections to the other walls.
+ */
+struct MRUTILITYKIT_API FMRUKWallNode
+{
+	AMRUKAnchor* Wall = nullptr;
+
+	/**
+	 * End points of the wall in world space, at its center height. The end is in direction of the walls right vector.
+	 */
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+
+	/**
+	 * Width of the wall.
+	 */
+	double Length = 0.0;
+
+	/**
+	 * Index of the wall whose end connects to the start of this wall, INDEX_NONE if there is none.
+	 */
+	int32 LeftIndex = INDEX_NONE;
+
+	/**
+	 * Index of the wall whose start connects to the end of this wall, INDEX_NONE if there is none.
+	 */
+	int32 RightIndex = INDEX_NONE;
+
+	/**
+	 * Angle in degrees inside the room between this wall and the right wall. Below 180 for convex corners.
+	 */
+	double RightCornerAngle = 0.0;
+
+	/**
+	 * How far the farthest room corner is along the X axis of the wall, which points out of the room. Key wall candidates
+	 * have no corner beyond them, so this is at most the tolerance of GetKeyWall.
+	 */
+	double MaxCornerOffset = 0.0;
+
+	/**
+	 * Index of the perimeter loop this wall belongs to and its position in the loop.
+	 */
+	int32 LoopIndex = INDEX_NONE;
+	int32 IndexInLoop = INDEX_NONE;
+
+	/**
+	 * Whether the right wall was found within the snap distance or is only the closest wall.
+	 */
+	bool bRightSnapped = false;
+
+	/**
+	 * Wall pose and bounds the node was computed from, used to detect updated walls.
+	 */
+	FTransform SourceTransform;
+	FBox2D SourcePlaneBounds;
+};
+
+/**
+ * Topology of the walls in a room: which walls connect to each other, the corner angles, the perimeter
+ * loops in order and the walls ranked by length. The graph is built once when the room gets loaded and only
+ * the walls that were added, removed or moved are relinked on room updates, so all wall queries are lookups.
+ *
+ * Wall end points are hashed into a grid with the snap distance as cell size to find the connected walls.
+ * Walls that have no neighbour within the snap distance fall back to the closest wall start, like the
+ * room always did.
+ */
+class MRUTILITYKIT_API FMRUKWallGraph
+{
+public:
+	/**
+	 * Distance in world units within which wall end points are considered connected.
+	 */
+	double SnapDistance = 10.0;
+
+	/**
+	 * Synchronizes the graph with the given walls. New walls are added, missing ones removed and walls
+	 * that moved or changed their size updated. Walls that didn't change are left alone.
+	 * @return Whether anything changed.
+	 */
+	bool Update(const TArray<TObjectPtr<AMRUKAnchor>>& Walls);
+
+	/**
+	 * Sets the room corners (floor boundary in world space) used to rank the key wall candidates.
+	 */
+	void SetRoomCorners(const TArray<FVector>& Corners);
+
+	void Reset();
+
+	const TArray<FMRUKWallNode>& GetNodes() const { return Nodes; }
+	const FMRUKWallNode* FindNode(const AMRUKAnchor* Wall) const;
+
+	/**
+	 * Perimeter loops, each a list of node indices where every wall connects to the next one. Walls that don't
+	 * form a closed loop are in open loops starting with the wall that has no left wall.
+	 * The loop of the last wall passed to Update comes first and, if closed, starts with that wall.
+	 */
+	const TArray<TArray<int32>>& GetLoops() const { return Loops; }
+
+	/**
+	 * All walls in perimeter order, loop after loop.
+	 */
+	const TArray<TObjectPtr<AMRUKAnchor>>& GetPerimeterWalls() const { return PerimeterWalls; }
+
+	/**
+	 * Node indices sorted from longest to shortest wall.
+	 */
+	const TArray<int32>& GetWallsByLength() const { return WallsByLength; }
+
+	/**
+	 * The longest wall that has no room corners behind it.
+	 * @param Tolerance Distance a corner may be behind the wall, to compensate for the anchor precision.
+	 */
+	AMRUKAnchor* GetKeyWall(double Tolerance) const;
+
+private:
+	bool AddOrUpdateWall(AMRUKAnchor* Wall);
+	void RemoveWall(int32 Index);
+	static void ComputeGeometry(FMRUKWallNode& Node);
+	FIntPoint GetCell(const FVector& Position) const;
+	void HashNode(int32 Index);
+	void UnhashNode(int32 Index);
+	void FindNodesNear(const TMultiMap<FIntPoint, int32>& Cells, const FVector& Position, TArray<int32>& OutIndices) const;
+	void LinkRight(int32 Index);
+	void ComputeCornerOffset(FMRUKWallNode& Node) const;
+
+	/**
+	 * Relinks the dirty nodes and recomputes everything that is derived from the links: left links, corner angles,
+	 * loops and the ranking.
+	 */
+	void Finalize();
+
+	TArray<FMRUKWallNode> Nodes;
+	TMap<const AMRUKAnchor*, int32> NodeIndices;
+	TMultiMap<FIntPoint, int32> StartCells;
+	TMultiMap<FIntPoint, int32> EndCells;
+	TArray<FVector> RoomCorners;
+
+	TArray<TArray<int32>> Loops;
+	TArray<TObjectPtr<AMRUKAnchor>> PerimeterWalls;
+	TArray<int32> WallsByLength;
+
+	/**
+	 * Nodes that need to be relinked on the next Finalize.
+	 */
+	TSet<int32> DirtyNodes;
+
+	/**
+	 * Whether the walls that only have a fallback connection need to be relinked on the next Finalize.
+	 */
+	bool bRelinkFallbacks = false;
+
+	/**
+	 * The wall the perimeter starts at.
+	 */
+	const AMRUKAnchor* PerimeterStartWall = nullptr;
+};
@@ -10,14 +10,119 @@ LICENSE file in the root directory of this source tree.
 #include "MRUtilityKitSubsystem.h"
 #include "MRUtilityKitAnchor.h"
 #include "MRUtilityKitAnchorActorSpawner.h"
+#include "MRUtilityKitPoissonDisk.h"
+#include "MRUtilityKitData.h"
 #include "Misc/AutomationTest.h"
 #include "Tests/AutomationEditorCommon.h"
 #include "Editor/UnrealEdEngine.h"
 #include "UnrealEdGlobals.h"
+#include "EngineUtils.h"
 #include "TestHelper.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Count.h"
+
+namespace
+{
+	FOculusXRUUID MakeSimulatedUuid(uint32 Id)
+	{
+		FOculusXRUUID Uuid;
+		FMemory::Memzero(Uuid.UUIDBytes);
+		FMemory::Memcpy(Uuid.UUIDBytes, &Id, sizeof(Id));
+		return Uuid;
+	}
+
+	/**
+	 * Scene discovery that only reports results when the test asks for it, to control the order in which queries complete.
+	 */
+	class FSimulatedSceneDiscovery : public IMRUKSceneDiscovery
+	{
+	public:
+		struct FAnchorQuery
+		{
+			TArray<FOculusXRUUID> Uuids;
+			FOculusXRDiscoverAnchorsResultsDelegate OnResults;
+			FOculusXRDiscoverAnchorsCompleteDelegate OnComplete;
+		};
+
+		int32 NumAnchorsPerRoom = 3;
+		TArray<FAnchorQuery> AnchorQueries;
+		int32 MaxAnchorQueriesInFlight = 0;
+
+		bool DiscoverRooms(const FOculusXRDiscoverAnchorsResultsDelegate& OnResults, const FOculusXRDiscoverAnchorsCompleteDelegate& OnComplete) override
+		{
+			OnRoomResults = OnResults;
+			OnRoomsComplete = OnComplete;
+			return true;
+		}
+
+		bool DiscoverAnchors(const TArray<FOculusXRUUID>& Uuids, const FOculusXRDiscoverAnchorsResultsDelegate& OnResults, const FOculusXRDiscoverAnchorsCompleteDelegate& OnComplete) override
+		{
+			AnchorQueries.Add({ Uuids, OnResults, OnComplete });
+			MaxAnchorQueriesInFlight = FMath::Max(MaxAnchorQueriesInFlight, AnchorQueries.Num());
+			return true;
+		}
+
+		bool GetRoomLayout(const FOculusXRAnchorsDiscoverResult& Room, FOculusXRRoomLayout& OutRoomLayout) override
+		{
+			OutRoomLayout.RoomUuid = Room.UUID;
+			for (int32 i = 0; i < NumAnchorsPerRoom; ++i)
+			{
+				OutRoomLayout.RoomObjectUUIDs.Add(MakeSimulatedUuid(static_cast<uint32>(Room.Space.Value * 100 + i + 1)));
+			}
+			return true;
+		}
+
+		void LoadAnchorData(const FOculusXRAnchorsDiscoverResult& Anchor, UMRUKAnchorData* AnchorData) override
+		{
+			AnchorData->SpaceQuery = Anchor;
+			AnchorData->SemanticClassifications = { FMRUKLabels::Other };
+		}
+
+		void DiscoverRoomBatch(int32 FirstRoom, int32 NumRooms)
+		{
+			TArray<FOculusXRAnchorsDiscoverResult> Results;
+			for (int32 Room = FirstRoom; Room < FirstRoom + NumRooms; ++Room)
+			{
+				Results.Emplace(FOculusXRUInt64(Room + 1), MakeSimulatedUuid(Room + 1));
+			}
+			OnRoomResults.ExecuteIfBound(Results);
+		}
+
+		void CompleteRoomDiscovery()
+		{
+			OnRoomsComplete.ExecuteIfBound(EOculusXRAnchorResult::Success);
+		}
+
+		/**
+		 * Completes the oldest anchor query in flight. The anchors are reported one batch per anchor.
+		 */
+		void CompleteAnchorQuery(EOculusXRAnchorResult::Type Result = EOculusXRAnchorResult::Success)
+		{
+			const FAnchorQuery Query = AnchorQueries[0];
+			AnchorQueries.RemoveAt(0);
+			if (Result == EOculusXRAnchorResult::Success)
+			{
+				for (const FOculusXRUUID& Uuid : Query.Uuids)
+				{
+					const TArray<FOculusXRAnchorsDiscoverResult> Batch = { FOculusXRAnchorsDiscoverResult(FOculusXRUInt64(0), Uuid) };
+					Query.OnResults.ExecuteIfBound(Batch);
+				}
+			}
+			Query.OnComplete.ExecuteIfBound(Result);
+		}
+
+	private:
+		FOculusXRDiscoverAnchorsResultsDelegate OnRoomResults;
+		FOculusXRDiscoverAnchorsCompleteDelegate OnRoomsComplete;
+	};
+} // namespace
 
 BEGIN_DEFINE_SPEC(FMRUKSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
 UMRUKSubsystem* ToolkitSubsystem;
+TSharedPtr<FSimulatedSceneDiscovery> SimulatedDiscovery;
+TStrongObjectPtr<UMRUKSceneData> SceneData;
+TArray<UMRUKRoomData*> LoadedRooms;
 
 void SetupMRUKSubsystem();
 void LoadSceneFromJson();
@@ -164,6 +269,56 @@ void FMRUKSpec::Define()
 			TestEqual(TEXT("Couch mesh scale"), CouchMeshActor->GetActorScale(), FVector(0.902, 2.029, 0.566), Tolerance);
 		});
 
+		It(TEXT("Spawns interior over multiple frames"), [this]() {
+			const auto World = GEditor->GetPIEWorldContext()->World();
+			const auto Subsystem = World->GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+			const auto Spawner = *TActorIterator<AMRUKAnchorActorSpawner>(World);
+
+			const auto Room = Subsystem->GetCurrentRoom();
+			if (!TestNotNull(TEXT("Current room is set"), Room) || !TestNotNull(TEXT("Spawner exists"), Spawner))
+			{
+				return;
+			}
+
+			const auto GetSpawnedPoses = [Spawner, Room]() {
+				TArray<AActor*> Actors;
+				Spawner->GetSpawnedActorsByRoom(Room, Actors);
+				TMap<AActor*, FTransform> Poses;
+				for (const auto Actor : Actors)
+				{
+					Poses.Add(Actor->GetAttachParentActor(), Actor->GetActorTransform());
+				}
+				return Poses;
+			};
+			const auto PosesSpawnedAtOnce = GetSpawnedPoses();
+
+			Spawner->SpawnOverMultipleFrames = true;
+			Spawner->SpawnFrameBudgetMs = 0.0f;
+			Spawner->SpawnActors(Room);
+			TestTrue(TEXT("Spawning is in progress"), Spawner->IsSpawning(Room));
+
+			int32 NumFrames = 0;
+			while (Spawner->IsSpawning() && NumFrames < 1000)
+			{
+				Spawner->Tick(0.0f);
+				++NumFrames;
+			}
+			TestFalse(TEXT("Spawning finished"), Spawner->IsSpawning());
+			TestTrue(TEXT("Spawned over multiple frames"), NumFrames > 1);
+
+			// The same seed is used, so the same actors end up on the same anchors
+			const auto Poses = GetSpawnedPoses();
+			TestEqual(TEXT("Number of spawned actors"), Poses.Num(), PosesSpawnedAtOnce.Num());
+			for (const auto& Pose : PosesSpawnedAtOnce)
+			{
+				const FTransform* SpawnedPose = Poses.Find(Pose.Key);
+				if (TestNotNull(TEXT("Anchor has an actor"), SpawnedPose))
+				{
+					TestTrue(TEXT("Actor pose matches"), SpawnedPose->Equals(Pose.Value, 0.01));
+				}
+			}
+		});
+
 		TeardownMRUKSubsystem();
 	});
 
@@ -259,6 +414,77 @@ void FMRUKSpec::Define()
 		TeardownMRUKSubsystem();
 	});
 
+	Describe(TEXT("Pipelined scene loading"), [this]() {
+		BeforeEach([this]() {
+			SimulatedDiscovery = MakeShared<FSimulatedSceneDiscovery>();
+			SceneData.Reset(NewObject<UMRUKSceneData>());
+			LoadedRooms.Empty();
+			SceneData->OnRoomLoaded.AddLambda([this](UMRUKRoomData* RoomData) { LoadedRooms.Add(RoomData); });
+		});
+
+		AfterEach([this]() {
+			SceneData.Reset();
+			SimulatedDiscovery.Reset();
+		});
+
+		It(TEXT("Loads rooms while the discovery is still running"), [this]() {
+			SceneData->LoadFromDevice(64, SimulatedDiscovery);
+			SimulatedDiscovery->DiscoverRoomBatch(0, 1);
+			TestEqual(TEXT("Anchor query started for the first batch"), SimulatedDiscovery->AnchorQueries.Num(), 1);
+
+			SimulatedDiscovery->CompleteAnchorQuery();
+			if (!TestEqual(TEXT("Room loaded before the discovery completed"), LoadedRooms.Num(), 1))
+			{
+				return;
+			}
+			TestEqual(TEXT("All anchor batches received"), LoadedRooms[0]->AnchorsData.Num(), SimulatedDiscovery->NumAnchorsPerRoom);
+			TestEqual(TEXT("Still loading"), SceneData->GetStatus(), EMRUKInitStatus::Busy);
+
+			SimulatedDiscovery->DiscoverRoomBatch(1, 2);
+			SimulatedDiscovery->CompleteRoomDiscovery();
+			TestEqual(TEXT("Waiting for the last rooms"), SceneData->GetStatus(), EMRUKInitStatus::Busy);
+
+			SimulatedDiscovery->CompleteAnchorQuery();
+			SimulatedDiscovery->CompleteAnchorQuery();
+			TestEqual(TEXT("Rooms loaded"), LoadedRooms.Num(), 3);
+			TestEqual(TEXT("Scene loaded"), SceneData->GetStatus(), EMRUKInitStatus::Complete);
+		});
+
+		It(TEXT("Caps the number of concurrent room queries"), [this]() {
+			SceneData->MaxConcurrentRoomQueries = 2;
+			SceneData->LoadFromDevice(64, SimulatedDiscovery);
+			SimulatedDiscovery->DiscoverRoomBatch(0, 5);
+			SimulatedDiscovery->CompleteRoomDiscovery();
+			TestEqual(TEXT("Anchor queries in flight"), SimulatedDiscovery->AnchorQueries.Num(), 2);
+
+			while (!SimulatedDiscovery->AnchorQueries.IsEmpty())
+			{
+				SimulatedDiscovery->CompleteAnchorQuery();
+			}
+			TestEqual(TEXT("Max anchor queries in flight"), SimulatedDiscovery->MaxAnchorQueriesInFlight, 2);
+			TestEqual(TEXT("Rooms loaded"), LoadedRooms.Num(), 5);
+			TestEqual(TEXT("Scene loaded"), SceneData->GetStatus(), EMRUKInitStatus::Complete);
+		});
+
+		It(TEXT("Keeps loading the other rooms when a room fails"), [this]() {
+			SceneData->LoadFromDevice(64, SimulatedDiscovery);
+			SimulatedDiscovery->DiscoverRoomBatch(0, 3);
+			SimulatedDiscovery->CompleteRoomDiscovery();
+
+			SimulatedDiscovery->CompleteAnchorQuery(EOculusXRAnchorResult::Failure);
+			SimulatedDiscovery->CompleteAnchorQuery();
+			SimulatedDiscovery->CompleteAnchorQuery();
+			TestEqual(TEXT("Rooms loaded"), LoadedRooms.Num(), 2);
+			TestEqual(TEXT("Scene failed"), SceneData->GetStatus(), EMRUKInitStatus::Failed);
+		});
+
+		It(TEXT("Fails without rooms"), [this]() {
+			SceneData->LoadFromDevice(64, SimulatedDiscovery);
+			SimulatedDiscovery->CompleteRoomDiscovery();
+			TestEqual(TEXT("Scene failed"), SceneData->GetStatus(), EMRUKInitStatus::Failed);
+		});
+	});
+
 	Describe(TEXT("Update room"), [this]() {
 		SetupMRUKSubsystem();
 		LoadSceneFromJson();
@@ -497,6 +723,51 @@ void FMRUKSpec::Define()
 			}
 		});
 
+		It(TEXT("Reserve seats"), [this]() {
+			auto Room = ToolkitSubsystem->GetCurrentRoom();
+			if (!TestNotNull(TEXT("Current room"), Room))
+			{
+				return;
+			}
+
+			// Any object can occupy a seat, use the walls as stand-ins for avatars
+			UObject* FirstOccupant = Room->WallAnchors[0];
+			UObject* SecondOccupant = Room->WallAnchors[1];
+
+			FMRUKSeat ClosestSeat;
+			if (!TestTrue(TEXT("Has a free seat"), Room->GetClosestFreeSeat(FVector::ZeroVector, ClosestSeat)))
+			{
+				return;
+			}
+
+			FMRUKSeat FirstSeat;
+			TestTrue(TEXT("First occupant reserved a seat"), Room->TryReserveClosestSeat(FVector::ZeroVector, FirstOccupant, FirstSeat));
+			TestEqual(TEXT("First occupant got the closest seat"), FirstSeat.Pose.GetLocation(), ClosestSeat.Pose.GetLocation());
+			TestEqual(TEXT("Seat is occupied"), Room->GetSeatOccupant(FirstSeat.Anchor, FirstSeat.SeatIndex), FirstOccupant);
+			TestFalse(TEXT("Seat can't be taken twice"), Room->ReserveSeat(FirstSeat.Anchor, FirstSeat.SeatIndex, SecondOccupant));
+
+			FMRUKSeat SecondSeat;
+			if (Room->TryReserveClosestSeat(FVector::ZeroVector, SecondOccupant, SecondSeat))
+			{
+				TestFalse(TEXT("Second occupant got another seat"), SecondSeat.Anchor == FirstSeat.Anchor && SecondSeat.SeatIndex == FirstSeat.SeatIndex);
+			}
+
+			// Seats facing away from the requested direction are skipped
+			const FVector SeatForward = ClosestSeat.Pose.GetRotation().GetForwardVector();
+			FMRUKSeat FacingSeat;
+			if (Room->GetClosestFreeSeat(FVector::ZeroVector, FacingSeat, -SeatForward, 45.0))
+			{
+				TestTrue(TEXT("Seat faces the requested direction"), FacingSeat.Pose.GetRotation().GetForwardVector().Dot(-SeatForward) >= FMath::Cos(FMath::DegreesToRadians(45.0)) - UE_KINDA_SMALL_NUMBER);
+			}
+
+			TestTrue(TEXT("Seat released"), Room->ReleaseSeat(FirstSeat.Anchor, FirstSeat.SeatIndex));
+			TestNull(TEXT("Seat is free"), Room->GetSeatOccupant(FirstSeat.Anchor, FirstSeat.SeatIndex));
+			Room->ReleaseSeatsOf(SecondOccupant);
+			FMRUKSeat FreeSeat;
+			Room->GetClosestFreeSeat(FVector::ZeroVector, FreeSeat);
+			TestEqual(TEXT("Closest seat is free again"), FreeSeat.Pose.GetLocation(), ClosestSeat.Pose.GetLocation());
+		});
+
 		It(TEXT("Try get closest point in room"), [this]() {
 			auto Room = ToolkitSubsystem->GetCurrentRoom();
 			if (!TestNotNull(TEXT("Current room"), Room))
@@ -659,6 +930,60 @@ void FMRUKSpec::Define()
 			TestEqual(TEXT("Key wall anchor UUID is correct"), KeyWallAnchor->AnchorUUID, FOculusXRUUID({ 0x93, 0x4C, 0xE7, 0x5D, 0x63, 0xF0, 0x85, 0x6A, 0x94, 0x38, 0xDA, 0xB3, 0xAD, 0xA9, 0x54, 0x09 }));
 		});
 
+		It(TEXT("Wall graph"), [this]() {
+			auto Room = ToolkitSubsystem->GetCurrentRoom();
+			if (!TestNotNull(TEXT("Current room"), Room))
+			{
+				return;
+			}
+
+			const FMRUKWallGraph& WallGraph = Room->GetWallGraph();
+			if (!TestEqual(TEXT("One closed loop"), WallGraph.GetLoops().Num(), 1))
+			{
+				return;
+			}
+			TestEqual(TEXT("All walls in the perimeter"), Room->GetWallsInPerimeterOrder().Num(), Room->WallAnchors.Num());
+			// Same start as the wall UVs always had
+			TestTrue(TEXT("Perimeter starts at the last wall"), Room->GetWallsInPerimeterOrder()[0] == Room->WallAnchors.Last());
+
+			const TArray<FMRUKWallNode>& Nodes = WallGraph.GetNodes();
+			double AngleSum = 0.0;
+			for (int32 i = 0; i < Nodes.Num(); ++i)
+			{
+				TestTrue(TEXT("Walls are snapped"), Nodes[i].bRightSnapped);
+				if (TestNotEqual(TEXT("Has a left wall"), Nodes[i].LeftIndex, INDEX_NONE))
+				{
+					TestEqual(TEXT("Left wall links back"), Nodes[Nodes[i].LeftIndex].RightIndex, i);
+				}
+				AngleSum += Nodes[i].RightCornerAngle;
+			}
+			TestEqual(TEXT("Corner angles of a simple polygon"), AngleSum, (Nodes.Num() - 2) * 180.0, 1.0);
+			const int32 NumConvex = Algo::CountIf(Nodes, [](const FMRUKWallNode& Node) { return Node.RightCornerAngle < 180.0; });
+			TestTrue(TEXT("Mostly convex corners"), NumConvex > Nodes.Num() / 2);
+
+			// Moving a wall only relinks the walls around it, the rest of the graph stays
+			AMRUKAnchor* Wall = Room->WallAnchors[0];
+			AMRUKAnchor* LeftWall = nullptr;
+			AMRUKAnchor* RightWall = nullptr;
+			double LeftAngle = 0.0;
+			double RightAngle = 0.0;
+			TestTrue(TEXT("Is a wall"), Room->GetWallNeighbors(Wall, LeftWall, RightWall, LeftAngle, RightAngle));
+			const FVector Location = Wall->GetActorLocation();
+			Wall->SetActorLocation(Location + Wall->GetActorForwardVector() * 100.0);
+			Room->ComputeWallGraph();
+			AMRUKAnchor* MovedLeftWall = nullptr;
+			AMRUKAnchor* MovedRightWall = nullptr;
+			Room->GetWallNeighbors(Wall, MovedLeftWall, MovedRightWall, LeftAngle, RightAngle);
+			TestFalse(TEXT("Moved wall is disconnected"), WallGraph.FindNode(Wall)->bRightSnapped);
+
+			Wall->SetActorLocation(Location);
+			Room->ComputeWallGraph();
+			Room->GetWallNeighbors(Wall, MovedLeftWall, MovedRightWall, LeftAngle, RightAngle);
+			TestEqual(TEXT("Left wall restored"), MovedLeftWall, LeftWall);
+			TestEqual(TEXT("Right wall restored"), MovedRightWall, RightWall);
+			TestTrue(TEXT("Wall is snapped again"), WallGraph.FindNode(Wall)->bRightSnapped);
+		});
+
 		It(TEXT("Get largest surface"), [this]() {
 			auto Room = ToolkitSubsystem->GetCurrentRoom();
 			if (!TestNotNull(TEXT("Current room"), Room))
@@ -1023,6 +1348,101 @@ void FMRUKSpec::Define()
 			}
 		});
 
+		It(TEXT("Snapshot"), [this]() {
+			auto Room = ToolkitSubsystem->GetCurrentRoom();
+			if (!TestNotNull(TEXT("Current room"), Room))
+			{
+				return;
+			}
+			const FMRUKRoomSnapshotPtr Snapshot = Room->GetSnapshot();
+			if (!TestTrue(TEXT("Snapshot published"), Snapshot.IsValid()))
+			{
+				return;
+			}
+			TestEqual(TEXT("Num anchors"), Snapshot->GetAnchors().Num(), Room->AllAnchors.Num());
+			TestTrue(TEXT("Room bounds"), Snapshot->GetRoomBounds() == Room->RoomBounds);
+			if (TestNotNull(TEXT("Floor"), Snapshot->GetFloor()))
+			{
+				TestTrue(TEXT("Floor anchor"), Snapshot->GetFloor()->Anchor.Get() == Room->FloorAnchor);
+			}
+			for (const auto& AnchorSnapshot : Snapshot->GetAnchors())
+			{
+				const AMRUKAnchor* Anchor = AnchorSnapshot.Anchor.Get();
+				if (AnchorSnapshot.ParentIndex != INDEX_NONE)
+				{
+					TestTrue(TEXT("Parent"), Snapshot->GetAnchors()[AnchorSnapshot.ParentIndex].Anchor.Get() == Anchor->ParentAnchor);
+				}
+				TestEqual(TEXT("Triangulated"), AnchorSnapshot.PlaneTriangles.IsEmpty(), AnchorSnapshot.PlaneBoundary2D.IsEmpty());
+			}
+
+			// The global mesh can only be traced by the physics scene, so it is not part of the snapshot queries
+			FMRUKLabelFilter LabelFilter;
+			LabelFilter.ExcludedLabels.Add(FMRUKLabels::GlobalMesh);
+
+			struct FQuery
+			{
+				FVector Position;
+				FVector Direction;
+				// Results
+				int32 HitIndex = INDEX_NONE;
+				FMRUKHit Hit;
+				int32 ClosestIndex = INDEX_NONE;
+				FVector ClosestPosition;
+				double ClosestDistance = 0.0;
+				bool bInRoom = false;
+				int32 VolumeIndex = INDEX_NONE;
+			};
+			const FRandomStream RandomStream(42);
+			TArray<FQuery> Queries;
+			for (int32 I = 0; I < 256; ++I)
+			{
+				FQuery& Query = Queries.AddDefaulted_GetRef();
+				const FBox Bounds = Room->RoomBounds.ExpandBy(50.0);
+				Query.Position = FVector(RandomStream.FRandRange(Bounds.Min.X, Bounds.Max.X), RandomStream.FRandRange(Bounds.Min.Y, Bounds.Max.Y), RandomStream.FRandRange(Bounds.Min.Z, Bounds.Max.Z));
+				Query.Direction = RandomStream.VRand();
+			}
+
+			// Query from the task graph while the room is owned by the game thread
+			ParallelFor(Queries.Num(), [&Queries, &Snapshot, &LabelFilter](int32 Index) {
+				FQuery& Query = Queries[Index];
+				Query.HitIndex = Snapshot->Raycast(Query.Position, Query.Direction, 0.0f, LabelFilter, Query.Hit);
+				Query.ClosestIndex = Snapshot->TryGetClosestSurfacePosition(Query.Position, Query.ClosestPosition, Query.ClosestDistance, LabelFilter);
+				Query.bInRoom = Snapshot->IsPositionInRoom(Query.Position);
+				Query.VolumeIndex = Snapshot->IsPositionInSceneVolume(Query.Position);
+			});
+
+			const auto GetAnchor = [&Snapshot](int32 Index) -> AMRUKAnchor* {
+				return Index == INDEX_NONE ? nullptr : Snapshot->GetAnchors()[Index].Anchor.Get();
+			};
+			for (const FQuery& Query : Queries)
+			{
+				FMRUKHit Hit;
+				TestEqual(TEXT("Raycast anchor"), GetAnchor(Query.HitIndex), Room->Raycast(Query.Position, Query.Direction, 0.0f, LabelFilter, Hit));
+				if (Query.HitIndex != INDEX_NONE)
+				{
+					TestEqual(TEXT("Raycast position"), Query.Hit.HitPosition, Hit.HitPosition);
+					TestEqual(TEXT("Raycast normal"), Query.Hit.HitNormal, Hit.HitNormal);
+					TestEqual(TEXT("Raycast distance"), Query.Hit.HitDistance, Hit.HitDistance);
+				}
+
+				FVector ClosestPosition;
+				double ClosestDistance = 0.0;
+				TestEqual(TEXT("Closest anchor"), GetAnchor(Query.ClosestIndex), Room->TryGetClosestSurfacePosition(Query.Position, ClosestPosition, ClosestDistance, LabelFilter));
+				TestEqual(TEXT("Closest position"), Query.ClosestPosition, ClosestPosition);
+				TestEqual(TEXT("Closest distance"), Query.ClosestDistance, ClosestDistance);
+
+				TestEqual(TEXT("In room"), Query.bInRoom, Room->IsPositionInRoom(Query.Position));
+				TestEqual(TEXT("In scene volume"), GetAnchor(Query.VolumeIndex), Room->IsPositionInSceneVolume(Query.Position));
+			}
+
+			// Publishing a new snapshot leaves the old one untouched
+			const int32 NumAnchors = Snapshot->GetAnchors().Num();
+			Room->PublishSnapshot();
+			TestTrue(TEXT("New snapshot"), Room->GetSnapshot() != Snapshot);
+			TestEqual(TEXT("New version"), Room->GetSnapshot()->GetVersion(), Snapshot->GetVersion() + 1);
+			TestEqual(TEXT("Old snapshot unchanged"), Snapshot->GetAnchors().Num(), NumAnchors);
+		});
+
 		TeardownMRUKSubsystem();
 	});
 
@@ -1275,5 +1695,58 @@ void FMRUKSpec::Define()
 			Filter.IncludedLabels.Empty();
 			TestTrue(TEXT("BAM Passes Filter"), Filter.PassesFilter({ { TEXT("BAM") } }));
 		});
+
+		It(TEXT("Poisson disk sampler"), [this]() {
+			constexpr double MinSpacing = 20.0;
+			const FRandomStream RandomStream(42);
+			FMRUKPoissonDiskSampler Sampler(MinSpacing, RandomStream);
+
+			FMRUKSampleSurface Surface;
+			Surface.Bounds = FBox2D(FVector2D(-100.0), FVector2D(100.0));
+			Sampler.SampleSurfaces({ Surface }, 10.0f, [](const FVector&, const FVector&) { return true; });
+
+			// A maximal set with this spacing covers the 180x180 area with discs of the spacing as radius
+			const int32 NumPositions = Sampler.GetNumPositions();
+			TestTrue(TEXT("Surface is filled"), NumPositions > 180.0 * 180.0 / (UE_PI * MinSpacing * MinSpacing));
+
+			TArray<FVector> Positions;
+			TArray<FVector> Normals;
+			Sampler.GetRandomPositions(NumPositions, Positions, Normals);
+			bool bKeepsSpacing = true;
+			bool bKeepsDistanceToEdge = true;
+			for (int32 i = 0; i < Positions.Num(); ++i)
+			{
+				bKeepsDistanceToEdge &= FMath::Abs(Positions[i].Y) <= 90.0 && FMath::Abs(Positions[i].Z) <= 90.0;
+				for (int32 j = i + 1; j < Positions.Num(); ++j)
+				{
+					bKeepsSpacing &= FVector::Dist(Positions[i], Positions[j]) >= MinSpacing;
+				}
+			}
+			TestTrue(TEXT("Positions keep the spacing"), bKeepsSpacing);
+			TestTrue(TEXT("Positions keep the distance to the edge"), bKeepsDistanceToEdge);
+
+			TArray<FVector> Subset;
+			Sampler.GetRandomPositions(10, Subset, Normals);
+			TestEqual(TEXT("Picked positions"), Subset.Num(), 10);
+
+			// Rejected positions are not added
+			FMRUKPoissonDiskSampler VolumeSampler(MinSpacing, RandomStream);
+			VolumeSampler.SampleVolume(FBox(FVector(0.0), FVector(100.0)), [](const FVector& Position, const FVector&) { return Position.Z < 50.0; });
+			TArray<FVector> VolumePositions;
+			VolumeSampler.GetRandomPositions(VolumeSampler.GetNumPositions(), VolumePositions, Normals);
+			TestTrue(TEXT("Volume is sampled"), VolumePositions.Num() > 0);
+			TestFalse(TEXT("Constraint is respected"), VolumePositions.ContainsByPredicate([](const FVector& Position) { return Position.Z >= 50.0; }));
+
+			// Sampling stops at the maximum, no matter how many positions would fit
+			FMRUKPoissonDiskSampler LimitedSampler(MinSpacing, RandomStream);
+			LimitedSampler.MaxPositions = 5;
+			int32 NumCandidatesChecked = 0;
+			LimitedSampler.SampleSurfaces({ Surface, Surface }, 10.0f, [&NumCandidatesChecked](const FVector&, const FVector&) {
+				++NumCandidatesChecked;
+				return true;
+			});
+			TestEqual(TEXT("Limited positions"), LimitedSampler.GetNumPositions(), 5);
+			TestEqual(TEXT("No candidates checked after the limit"), NumCandidatesChecked, 5);
+		});
 	});
 }
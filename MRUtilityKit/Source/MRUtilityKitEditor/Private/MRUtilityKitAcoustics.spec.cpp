@@ -0,0 +1,156 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+
+#include "MRUtilityKitAcoustics.h"
+#include "MRUtilityKitSubsystem.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitAnchor.h"
+#include "TestHelper.h"
+#include "UnrealEdGlobals.h"
+#include "Editor/UnrealEdEngine.h"
+#include "Tests/AutomationEditorCommon.h"
+
+BEGIN_DEFINE_SPEC(FMRUKAcousticsSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+AMRUKRoom* LoadRoom(const TCHAR* RoomJson);
+END_DEFINE_SPEC(FMRUKAcousticsSpec)
+
+AMRUKRoom* FMRUKAcousticsSpec::LoadRoom(const TCHAR* RoomJson)
+{
+	const auto World = GEditor->GetPIEWorldContext()->World();
+	UMRUKSubsystem* Subsystem = World->GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+	Subsystem->LoadSceneFromJsonString(RoomJson);
+	if (!TestEqual(TEXT("Room count"), Subsystem->Rooms.Num(), 1))
+	{
+		return nullptr;
+	}
+	return Subsystem->Rooms[0];
+}
+
+void FMRUKAcousticsSpec::Define()
+{
+	// The expected values were computed by hand from the JSON of the recorded rooms:
+	// - Plane areas are the shoelace areas of PlaneBoundary2D, volume areas are the box faces without the bottom one.
+	// - The ceiling height is the Z distance between the floor and ceiling anchors.
+	// - Volume = floor area * ceiling height - sum of the furniture box volumes.
+	// - RT60 = 0.161 * V / sum(area * absorption) with the default absorption coefficients.
+	Describe(TEXT("Acoustic profile"), [this] {
+		BeforeEach([this]() {
+			// Load map
+			const auto ContentDir = FPaths::ProjectContentDir();
+			FAutomationEditorCommonUtils::LoadMap(ContentDir + "/Common/Maps/TestLevel.umap");
+			StartPIE(true);
+		});
+
+		BeforeEach(EAsyncExecution::ThreadPool, []() {
+			while (!GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session starts
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		It(TEXT("Example room"), [this] {
+			const AMRUKRoom* Room = LoadRoom(ExampleRoomJson);
+			if (!Room)
+			{
+				return;
+			}
+			const FMRUKRoomAcousticProfile& Profile = Room->AcousticProfile;
+			TestTrue(TEXT("Profile is valid"), Profile.bIsValid);
+
+			TestEqual(TEXT("Floor area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::Floor), 10.997776, 1e-4);
+			TestEqual(TEXT("Ceiling area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::Ceiling), 10.997775, 1e-4);
+			// 8 walls with 37.509 m² minus door and window
+			TestEqual(TEXT("Wall area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::Wall), 33.971831, 1e-4);
+			TestEqual(TEXT("Window area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::Window), 1.996073, 1e-4);
+			TestEqual(TEXT("Opening area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::Opening), 1.542117, 1e-4);
+			// One couch
+			TestEqual(TEXT("Soft furnishing area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::SoftFurnishing), 5.148486, 1e-4);
+			// Table, two screens and four storage volumes
+			TestEqual(TEXT("Hard furnishing area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::HardFurnishing), 16.006195, 1e-4);
+			TestEqual(TEXT("Total surface area"), Profile.TotalSurfaceArea, 80.660254, 1e-3);
+
+			TestEqual(TEXT("Ceiling height"), Profile.CeilingHeight, 2.630046, 1e-4);
+			// 10.997776 * 2.630046 - 3.177154
+			TestEqual(TEXT("Volume"), Profile.Volume, 25.747501, 1e-3);
+			TestEqual(TEXT("Absorption area"), Profile.AbsorptionArea, 9.952394, 1e-3);
+			TestEqual(TEXT("Decay time"), Profile.DecayTime, 0.416518, 1e-4);
+			TestEqual(TEXT("Mean free path"), Profile.MeanFreePath, 1.276837, 1e-4);
+			// (1.542117 + 1.996073) / 37.510022
+			TestEqual(TEXT("Openness"), Profile.Openness, 0.094327, 1e-5);
+
+			// Floor, ceiling and 8 walls
+			if (TestEqual(TEXT("Early reflections"), Profile.EarlyReflectionDelays.Num(), 10))
+			{
+				TestEqual(TEXT("First reflection"), Profile.EarlyReflectionDelays[0], 0.00326179, 1e-6);
+				// The listener is half way between floor and ceiling: 2 * 1.315023 m / 343 m/s
+				TestEqual(TEXT("Floor reflection"), Profile.EarlyReflectionDelays[2], 0.00766777, 1e-6);
+				TestEqual(TEXT("Ceiling reflection"), Profile.EarlyReflectionDelays[3], 0.00766777, 1e-6);
+				TestEqual(TEXT("Last reflection"), Profile.EarlyReflectionDelays[9], 0.01018582, 1e-6);
+			}
+		});
+
+		It(TEXT("Profile is updated with the room"), [this] {
+			if (!LoadRoom(ExampleRoomJson))
+			{
+				return;
+			}
+			const AMRUKRoom* Room = LoadRoom(ExampleRoomMoreFurnitureAddedJson);
+			if (!Room)
+			{
+				return;
+			}
+			const FMRUKRoomAcousticProfile& Profile = Room->AcousticProfile;
+
+			// Two more couches and a second door
+			TestEqual(TEXT("Soft furnishing area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::SoftFurnishing), 15.445459, 1e-4);
+			TestEqual(TEXT("Opening area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::Opening), 3.084235, 1e-4);
+			TestEqual(TEXT("Wall area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::Wall), 32.429713, 1e-4);
+			TestEqual(TEXT("Volume"), Profile.Volume, 23.675602, 1e-3);
+			TestEqual(TEXT("Decay time"), Profile.DecayTime, 0.223162, 1e-4);
+			TestEqual(TEXT("Openness"), Profile.Openness, 0.135439, 1e-5);
+		});
+
+		It(TEXT("Invisible walls are open boundaries"), [this] {
+			AMRUKRoom* Room = LoadRoom(ExampleRoomJson);
+			if (!Room || !TestTrue(TEXT("Has walls"), Room->WallAnchors.Num() > 0))
+			{
+				return;
+			}
+			const FMRUKRoomAcousticProfile Before = Room->AcousticProfile;
+
+			// Turn one of the walls into an invisible wall, e.g. towards the rest of an open plan space
+			AMRUKAnchor* Wall = Room->WallAnchors.Last();
+			const double InvisibleWallArea = Wall->PlaneBounds.GetArea() / (100.0 * 100.0);
+			Wall->SemanticClassifications = { FMRUKLabels::InvisibleWallFace };
+			const FMRUKRoomAcousticProfile Profile = MRUKComputeRoomAcousticProfile(*Room, FMRUKAcousticAbsorption());
+
+			// Only the wall itself is removed from the wall area, doors and windows are still cut out of the walls
+			TestEqual(TEXT("Wall area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::Wall), Before.GetSurfaceArea(EMRUKAcousticSurface::Wall) - InvisibleWallArea, 1e-4);
+			TestEqual(TEXT("Opening area"), Profile.GetSurfaceArea(EMRUKAcousticSurface::Opening), Before.GetSurfaceArea(EMRUKAcousticSurface::Opening) + InvisibleWallArea, 1e-4);
+			// (1.542117 + 1.996073 + invisible wall) / 37.510022, the invisible wall is still part of the boundary
+			TestEqual(TEXT("Openness"), Profile.Openness, (1.542117 + 1.996073 + InvisibleWallArea) / 37.510022, 1e-5);
+			TestTrue(TEXT("Shorter decay"), Profile.DecayTime < Before.DecayTime);
+		});
+
+		// Caution: Order of these statements is important
+
+		AfterEach(EAsyncExecution::ThreadPool, []() {
+			while (GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session ends
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		AfterEach([]() {
+			// Request end of play session
+			GUnrealEd->RequestEndPlayMap();
+		});
+	});
+}
@@ -0,0 +1,266 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+
+#include "MRUtilityKitBenchmarkCommandlet.h"
+#include "MRUtilityKitEditor.h"
+#include "MRUtilityKitSceneGenerator.h"
+#include "MRUtilityKitSubsystem.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitAnchor.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	class FTimings
+	{
+	public:
+		template <typename TFunc>
+		void Measure(TFunc&& Func)
+		{
+			const uint64 Start = FPlatformTime::Cycles64();
+			const bool bHit = Func();
+			Samples.Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start));
+			Hits += bHit ? 1 : 0;
+		}
+
+		TSharedRef<FJsonObject> ToJson()
+		{
+			TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+			JsonObject->SetNumberField(TEXT("Count"), Samples.Num());
+			JsonObject->SetNumberField(TEXT("Hits"), Hits);
+			if (Samples.IsEmpty())
+			{
+				return JsonObject;
+			}
+
+			Samples.Sort();
+			double Total = 0.0;
+			for (const double Sample : Samples)
+			{
+				Total += Sample;
+			}
+			const auto Percentile = [this](double P) {
+				return Samples[FMath::Min(FMath::FloorToInt32(P * Samples.Num()), Samples.Num() - 1)] * 1e6;
+			};
+			JsonObject->SetNumberField(TEXT("TotalMs"), Total * 1e3);
+			JsonObject->SetNumberField(TEXT("MeanUs"), Total / Samples.Num() * 1e6);
+			JsonObject->SetNumberField(TEXT("MinUs"), Samples[0] * 1e6);
+			JsonObject->SetNumberField(TEXT("MedianUs"), Percentile(0.5));
+			JsonObject->SetNumberField(TEXT("P95Us"), Percentile(0.95));
+			JsonObject->SetNumberField(TEXT("P99Us"), Percentile(0.99));
+			JsonObject->SetNumberField(TEXT("MaxUs"), Samples.Last() * 1e6);
+			return JsonObject;
+		}
+
+	private:
+		TArray<double> Samples;
+		int32 Hits = 0;
+	};
+
+	FVector RandomPointInBox(const FBox& Box, FRandomStream& Stream)
+	{
+		return FVector(
+			Stream.FRandRange(Box.Min.X, Box.Max.X),
+			Stream.FRandRange(Box.Min.Y, Box.Max.Y),
+			Stream.FRandRange(Box.Min.Z, Box.Max.Z));
+	}
+} // namespace
+
+UMRUKBenchmarkCommandlet::UMRUKBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMRUKBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 Seed = 0;
+	int32 Iterations = 1000;
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("MRUK") / TEXT("Benchmark.json");
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	Iterations = FMath::Max(Iterations, 1);
+
+	TArray<TPair<FString, FMRUKSceneGeneratorSettings>> Scenes;
+	const auto AddScene = [&Scenes, Seed](const TCHAR* Name, int32 Rooms, int32 Walls, double FurnitureDensity, int32 GlobalMeshTriangles) {
+		FMRUKSceneGeneratorSettings Settings;
+		Settings.Seed = Seed;
+		Settings.RoomCount = Rooms;
+		Settings.WallCount = Walls;
+		Settings.FurnitureDensity = FurnitureDensity;
+		Settings.GlobalMeshTriangles = GlobalMeshTriangles;
+		Scenes.Emplace(Name, Settings);
+	};
+
+	if (Params.Contains(TEXT("Rooms=")) || Params.Contains(TEXT("Walls=")) || Params.Contains(TEXT("FurnitureDensity=")) || Params.Contains(TEXT("GlobalMeshTriangles=")))
+	{
+		FMRUKSceneGeneratorSettings Settings;
+		Settings.Seed = Seed;
+		FParse::Value(*Params, TEXT("Rooms="), Settings.RoomCount);
+		FParse::Value(*Params, TEXT("Walls="), Settings.WallCount);
+		FParse::Value(*Params, TEXT("FurnitureDensity="), Settings.FurnitureDensity);
+		FParse::Value(*Params, TEXT("GlobalMeshTriangles="), Settings.GlobalMeshTriangles);
+		Scenes.Emplace(TEXT("Custom"), Settings);
+	}
+	else
+	{
+		AddScene(TEXT("Small"), 1, 4, 0.5, 2000);
+		AddScene(TEXT("Medium"), 4, 12, 2.0, 20000);
+		AddScene(TEXT("Large"), 16, 32, 4.0, 100000);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ScenesJson;
+	for (const auto& [Name, Settings] : Scenes)
+	{
+		UE_LOG(LogMRUKEditor, Display, TEXT("Benchmarking scene %s: %d rooms, %d walls, %.2f furniture/m², %d global mesh triangles"),
+			*Name, Settings.RoomCount, Settings.WallCount, Settings.FurnitureDensity, Settings.GlobalMeshTriangles);
+		ScenesJson.Add(MakeShareable(new FJsonValueObject(RunScene(Name, Settings, Iterations))));
+	}
+
+	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	JsonObject->SetNumberField(TEXT("Seed"), Seed);
+	JsonObject->SetNumberField(TEXT("Iterations"), Iterations);
+	JsonObject->SetStringField(TEXT("Platform"), FPlatformProperties::IniPlatformName());
+	JsonObject->SetStringField(TEXT("CPU"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	JsonObject->SetArrayField(TEXT("Scenes"), ScenesJson);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(JsonObject, JsonWriter);
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogMRUKEditor, Error, TEXT("Could not write benchmark results to %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogMRUKEditor, Display, TEXT("Wrote benchmark results to %s"), *OutputPath);
+	return 0;
+}
+
+TSharedRef<FJsonObject> UMRUKBenchmarkCommandlet::RunScene(const FString& Name, const FMRUKSceneGeneratorSettings& Settings, int32 Iterations)
+{
+	TSharedRef<FJsonObject> SceneJson = MakeShareable(new FJsonObject);
+	SceneJson->SetStringField(TEXT("Name"), Name);
+	SceneJson->SetNumberField(TEXT("Rooms"), Settings.RoomCount);
+	SceneJson->SetNumberField(TEXT("Walls"), Settings.WallCount);
+	SceneJson->SetNumberField(TEXT("FurnitureDensity"), Settings.FurnitureDensity);
+	SceneJson->SetNumberField(TEXT("GlobalMeshTriangles"), Settings.GlobalMeshTriangles);
+
+	// A standalone game instance gives us a game world with the MRUK subsystem without starting a play session
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone();
+	UWorld* World = GameInstance->GetWorld();
+	UMRUKSubsystem* Subsystem = GameInstance->GetSubsystem<UMRUKSubsystem>();
+
+	FTimings Generate;
+	FString SceneJsonString;
+	Generate.Measure([&]() {
+		SceneJsonString = MRUKGenerateSceneJson(Settings, World->GetWorldSettings()->WorldToMeters);
+		return !SceneJsonString.IsEmpty();
+	});
+
+	FTimings LoadScene;
+	LoadScene.Measure([&]() {
+		Subsystem->LoadSceneFromJsonString(SceneJsonString);
+		return Subsystem->SceneLoadStatus == EMRUKInitStatus::Complete;
+	});
+
+	FTimings LoadGlobalMesh;
+	int32 NumAnchors = 0;
+	for (AMRUKRoom* Room : Subsystem->Rooms)
+	{
+		NumAnchors += Room->AllAnchors.Num();
+		if (Room->GlobalMeshAnchor)
+		{
+			LoadGlobalMesh.Measure([&]() { return Room->LoadGlobalMeshFromJsonString(SceneJsonString); });
+		}
+	}
+	SceneJson->SetNumberField(TEXT("Anchors"), NumAnchors);
+
+	FTimings Raycast;
+	FTimings ClosestSurface;
+	FTimings SceneVolume;
+	FTimings AnchorHierarchy;
+	FTimings SpawnInterior;
+
+	if (!Subsystem->Rooms.IsEmpty())
+	{
+		// Query positions are spread over the bounds of the rooms and slightly beyond to also cover misses
+		FRandomStream Stream(Settings.Seed);
+		const FMRUKLabelFilter LabelFilter;
+		for (int32 I = 0; I < Iterations; ++I)
+		{
+			AMRUKRoom* Room = Subsystem->Rooms[Stream.RandRange(0, Subsystem->Rooms.Num() - 1)];
+			const FBox Bounds = Room->RoomBounds.ExpandBy(Room->RoomBounds.GetExtent() * 0.1);
+			const FVector Position = RandomPointInBox(Bounds, Stream);
+			const FVector Direction = Stream.GetUnitVector();
+
+			Raycast.Measure([&]() {
+				FMRUKHit Hit;
+				return Room->Raycast(Position, Direction, 0.0f, LabelFilter, Hit) != nullptr;
+			});
+			ClosestSurface.Measure([&]() {
+				FVector SurfacePosition;
+				double SurfaceDistance = 0.0;
+				return Room->TryGetClosestSurfacePosition(Position, SurfacePosition, SurfaceDistance, LabelFilter) != nullptr;
+			});
+			SceneVolume.Measure([&]() {
+				return Room->IsPositionInSceneVolume(Position) != nullptr;
+			});
+		}
+
+		// The hierarchy is rebuilt on every room update, measure it separately from the rest of the room initialization
+		const int32 HierarchyIterations = FMath::Max(Iterations / 10, 1);
+		for (int32 I = 0; I < HierarchyIterations; ++I)
+		{
+			AMRUKRoom* Room = Subsystem->Rooms[I % Subsystem->Rooms.Num()];
+			AnchorHierarchy.Measure([&]() {
+				Room->ComputeAnchorHierarchy();
+				return true;
+			});
+		}
+
+		// Spawning creates actors and components, so it can only be measured once per room. Without spawn groups every
+		// anchor gets a procedural mesh.
+		const TMap<FString, FMRUKSpawnGroup> SpawnGroups;
+		for (AMRUKRoom* Room : Subsystem->Rooms)
+		{
+			SpawnInterior.Measure([&]() {
+				const FRandomStream SpawnStream(Settings.Seed);
+				Room->SpawnInteriorFromStream(SpawnGroups, SpawnStream, {});
+				return true;
+			});
+		}
+	}
+
+	TSharedRef<FJsonObject> QueriesJson = MakeShareable(new FJsonObject);
+	QueriesJson->SetObjectField(TEXT("GenerateScene"), Generate.ToJson());
+	QueriesJson->SetObjectField(TEXT("LoadSceneFromJsonString"), LoadScene.ToJson());
+	QueriesJson->SetObjectField(TEXT("LoadGlobalMeshFromJsonString"), LoadGlobalMesh.ToJson());
+	QueriesJson->SetObjectField(TEXT("Raycast"), Raycast.ToJson());
+	QueriesJson->SetObjectField(TEXT("TryGetClosestSurfacePosition"), ClosestSurface.ToJson());
+	QueriesJson->SetObjectField(TEXT("IsPositionInSceneVolume"), SceneVolume.ToJson());
+	QueriesJson->SetObjectField(TEXT("ComputeAnchorHierarchy"), AnchorHierarchy.ToJson());
+	QueriesJson->SetObjectField(TEXT("SpawnInterior"), SpawnInterior.ToJson());
+	SceneJson->SetObjectField(TEXT("Queries"), QueriesJson);
+
+	Subsystem->ClearScene();
+	GameInstance->Shutdown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return SceneJson;
+}
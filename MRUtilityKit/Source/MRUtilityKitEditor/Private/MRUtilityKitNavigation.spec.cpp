@@ -0,0 +1,335 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+
+#include "MRUtilityKitNavigation.h"
+#include "MRUtilityKitSubsystem.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitAnchor.h"
+#include "TestHelper.h"
+#include "UnrealEdGlobals.h"
+#include "Editor/UnrealEdEngine.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Algo/Count.h"
+
+namespace
+{
+	double PathLength(const TArray<FVector2D>& Path)
+	{
+		double Length = 0.0;
+		for (int32 I = 1; I < Path.Num(); ++I)
+		{
+			Length += FVector2D::Distance(Path[I - 1], Path[I]);
+		}
+		return Length;
+	}
+
+	double DistanceToPolygonEdges(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+	{
+		double Distance = DBL_MAX;
+		for (int32 I = 0; I < Polygon.Num(); ++I)
+		{
+			const FVector2D Closest = FMath::ClosestPointOnSegment2D(Point, Polygon[I], Polygon[(I + 1) % Polygon.Num()]);
+			Distance = FMath::Min(Distance, FVector2D::Distance(Closest, Point));
+		}
+		return Distance;
+	}
+
+	bool IsInsidePolygon(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+	{
+		bool bInside = false;
+		for (int32 I = 0, J = Polygon.Num() - 1; I < Polygon.Num(); J = I++)
+		{
+			if ((Polygon[I].Y > Point.Y) != (Polygon[J].Y > Point.Y) && Point.X < (Polygon[J].X - Polygon[I].X) * (Point.Y - Polygon[I].Y) / (Polygon[J].Y - Polygon[I].Y) + Polygon[I].X)
+			{
+				bInside = !bInside;
+			}
+		}
+		return bInside;
+	}
+
+	/**
+	 * Reference implementation that works like voxel based nav mesh generation: the floor is rasterized into a grid,
+	 * cells closer than the agent radius to a wall or volume are blocked and paths are found on the 8-connected grid.
+	 */
+	struct FGridReference
+	{
+		FVector2D Origin;
+		double CellSize = 5.0;
+		int32 Width = 0;
+		int32 Height = 0;
+		TArray<bool> Free;
+		double BuildTime = 0.0;
+
+		void Build(const TArray<FVector2D>& Boundary, const TArray<TArray<FVector2D>>& Obstacles, double AgentRadius)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			const FBox2D Bounds(Boundary);
+			Origin = Bounds.Min;
+			Width = FMath::CeilToInt32(Bounds.GetSize().X / CellSize) + 1;
+			Height = FMath::CeilToInt32(Bounds.GetSize().Y / CellSize) + 1;
+			Free.SetNumZeroed(Width * Height);
+			for (int32 Y = 0; Y < Height; ++Y)
+			{
+				for (int32 X = 0; X < Width; ++X)
+				{
+					const FVector2D Point = ToPoint(X, Y);
+					bool bFree = IsInsidePolygon(Boundary, Point) && DistanceToPolygonEdges(Boundary, Point) >= AgentRadius;
+					for (int32 I = 0; bFree && I < Obstacles.Num(); ++I)
+					{
+						bFree = !IsInsidePolygon(Obstacles[I], Point) && DistanceToPolygonEdges(Obstacles[I], Point) >= AgentRadius;
+					}
+					Free[Y * Width + X] = bFree;
+				}
+			}
+			BuildTime = FPlatformTime::Seconds() - StartTime;
+		}
+
+		FVector2D ToPoint(int32 X, int32 Y) const
+		{
+			return Origin + FVector2D(X, Y) * CellSize;
+		}
+
+		int32 ToIndex(const FVector2D& Point) const
+		{
+			const int32 X = FMath::RoundToInt32((Point.X - Origin.X) / CellSize);
+			const int32 Y = FMath::RoundToInt32((Point.Y - Origin.Y) / CellSize);
+			return (X >= 0 && X < Width && Y >= 0 && Y < Height) ? Y * Width + X : INDEX_NONE;
+		}
+
+		bool IsFree(const FVector2D& Point) const
+		{
+			const int32 Index = ToIndex(Point);
+			return Index != INDEX_NONE && Free[Index];
+		}
+
+		/** Length of the shortest 8-connected grid path or a negative value if there is none */
+		double FindPathLength(const FVector2D& Start, const FVector2D& End) const
+		{
+			const int32 StartIndex = ToIndex(Start);
+			const int32 EndIndex = ToIndex(End);
+			if (StartIndex == INDEX_NONE || EndIndex == INDEX_NONE || !Free[StartIndex] || !Free[EndIndex])
+			{
+				return -1.0;
+			}
+
+			TArray<double> Cost;
+			Cost.Init(DBL_MAX, Free.Num());
+			Cost[StartIndex] = 0.0;
+			typedef TPair<double, int32> FEntry;
+			const auto Compare = [](const FEntry& A, const FEntry& B) { return A.Key < B.Key; };
+			TArray<FEntry> Open;
+			Open.HeapPush(FEntry(0.0, StartIndex), Compare);
+			while (Open.Num() > 0)
+			{
+				FEntry Entry;
+				Open.HeapPop(Entry, Compare, EAllowShrinking::No);
+				if (Entry.Value == EndIndex)
+				{
+					return Entry.Key + FVector2D::Distance(Start, ToPoint(StartIndex % Width, StartIndex / Width)) + FVector2D::Distance(End, ToPoint(EndIndex % Width, EndIndex / Width));
+				}
+				if (Entry.Key > Cost[Entry.Value])
+				{
+					continue;
+				}
+				const int32 X = Entry.Value % Width;
+				const int32 Y = Entry.Value / Width;
+				for (int32 DY = -1; DY <= 1; ++DY)
+				{
+					for (int32 DX = -1; DX <= 1; ++DX)
+					{
+						const int32 NX = X + DX;
+						const int32 NY = Y + DY;
+						if ((DX == 0 && DY == 0) || NX < 0 || NX >= Width || NY < 0 || NY >= Height || !Free[NY * Width + NX])
+						{
+							continue;
+						}
+						const double NewCost = Entry.Key + CellSize * ((DX != 0 && DY != 0) ? UE_SQRT_2 : 1.0);
+						if (NewCost < Cost[NY * Width + NX])
+						{
+							Cost[NY * Width + NX] = NewCost;
+							Open.HeapPush(FEntry(NewCost, NY * Width + NX), Compare);
+						}
+					}
+				}
+			}
+			return -1.0;
+		}
+	};
+
+	void GetRoomFloorGeometry(const FMRUKNavigationData& Data, const AMRUKRoom* Room, TArray<FVector2D>& OutBoundary, TArray<TArray<FVector2D>>& OutObstacles)
+	{
+		OutBoundary = Room->FloorAnchor->PlaneBoundary2D;
+		for (const AMRUKAnchor* Child : Room->FloorAnchor->ChildAnchors)
+		{
+			if (!Child->VolumeBounds.IsValid)
+			{
+				continue;
+			}
+			const FBox& Bounds = Child->VolumeBounds;
+			TArray<FVector2D>& Footprint = OutObstacles.AddDefaulted_GetRef();
+			for (const FVector2D& Corner : { FVector2D(Bounds.Min.Y, Bounds.Min.Z), FVector2D(Bounds.Max.Y, Bounds.Min.Z), FVector2D(Bounds.Max.Y, Bounds.Max.Z), FVector2D(Bounds.Min.Y, Bounds.Max.Z) })
+			{
+				Footprint.Add(Data.ToLocal(Child->GetTransform().TransformPosition(FVector(0.0, Corner.X, Corner.Y))));
+			}
+		}
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FMRUKNavigationSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+void TestRecordedRoom(const TCHAR* RoomJson);
+END_DEFINE_SPEC(FMRUKNavigationSpec)
+
+void FMRUKNavigationSpec::TestRecordedRoom(const TCHAR* RoomJson)
+{
+	const auto World = GEditor->GetPIEWorldContext()->World();
+	UMRUKSubsystem* Subsystem = World->GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+	Subsystem->LoadSceneFromJsonString(RoomJson);
+	if (!TestEqual(TEXT("Room count"), Subsystem->Rooms.Num(), 1))
+	{
+		return;
+	}
+
+	constexpr double AgentRadius = 20.0;
+	FMRUKNavigationData Data;
+	TestTrue(TEXT("Navigation built"), Data.BuildFromRoom(Subsystem->Rooms[0], AgentRadius));
+
+	TArray<FVector2D> Boundary;
+	TArray<TArray<FVector2D>> Obstacles;
+	GetRoomFloorGeometry(Data, Subsystem->Rooms[0], Boundary, Obstacles);
+	FGridReference Grid;
+	Grid.Build(Boundary, Obstacles, AgentRadius);
+
+	AddInfo(FString::Printf(TEXT("Analytic: %d cells in %.3f ms, grid reference: %d cells in %.3f ms"),
+		Data.GetCells().Num(), Data.GetBuildTime() * 1000.0, Grid.Free.Num(), Grid.BuildTime * 1000.0));
+
+	// The analytic walkable area is slightly smaller than the grid's because corners are mitered instead of rounded
+	const double GridArea = Algo::Count(Grid.Free, true) * Grid.CellSize * Grid.CellSize;
+	TestTrue(TEXT("Walkable area matches grid reference"), Data.GetWalkableArea() <= GridArea * 1.05 && Data.GetWalkableArea() >= GridArea * 0.8);
+
+	FRandomStream RandomStream(1234);
+	const FBox2D Bounds(Boundary);
+	int32 PathsCompared = 0;
+	for (int32 Attempt = 0; Attempt < 200 && PathsCompared < 20; ++Attempt)
+	{
+		const FVector2D Start(RandomStream.FRandRange(Bounds.Min.X, Bounds.Max.X), RandomStream.FRandRange(Bounds.Min.Y, Bounds.Max.Y));
+		const FVector2D End(RandomStream.FRandRange(Bounds.Min.X, Bounds.Max.X), RandomStream.FRandRange(Bounds.Min.Y, Bounds.Max.Y));
+		// Only compare points that are walkable in both, the grid snaps points to its cells
+		if (Data.FindCell(Start) == INDEX_NONE || Data.FindCell(End) == INDEX_NONE || !Grid.IsFree(Start) || !Grid.IsFree(End))
+		{
+			continue;
+		}
+
+		TArray<FVector2D> Path;
+		if (!Data.FindPath(Start, End, Path))
+		{
+			continue;
+		}
+		++PathsCompared;
+
+		// Every point along the path must be walkable
+		for (int32 I = 1; I < Path.Num(); ++I)
+		{
+			for (double T = 0.0; T <= 1.0; T += 0.05)
+			{
+				const FVector2D Point = FMath::Lerp(Path[I - 1], Path[I], T);
+				FVector2D Projected;
+				Data.ProjectPoint(Point, Projected);
+				TestTrue(TEXT("Path stays in walkable area"), FVector2D::Distance(Point, Projected) < 0.1);
+			}
+		}
+
+		const double Length = PathLength(Path);
+		const double GridLength = Grid.FindPathLength(Start, End);
+		TestTrue(TEXT("Grid reference finds a path"), GridLength >= 0.0);
+		TestTrue(TEXT("Path is not shorter than a straight line"), Length >= FVector2D::Distance(Start, End) - UE_KINDA_SMALL_NUMBER);
+		TestTrue(TEXT("Path is not longer than the grid path"), Length <= GridLength * 1.1 + 2.0 * Grid.CellSize);
+	}
+	TestTrue(TEXT("Enough paths compared"), PathsCompared >= 10);
+}
+
+void FMRUKNavigationSpec::Define()
+{
+	Describe(TEXT("Navigation"), [this] {
+		It(TEXT("Path around an obstacle"), [this] {
+			const TArray<FVector2D> Boundary = { FVector2D(0.0, 0.0), FVector2D(400.0, 0.0), FVector2D(400.0, 400.0), FVector2D(0.0, 400.0) };
+			const TArray<TArray<FVector2D>> Obstacles = { { FVector2D(150.0, 150.0), FVector2D(250.0, 150.0), FVector2D(250.0, 250.0), FVector2D(150.0, 250.0) } };
+
+			FMRUKNavigationData Data;
+			TestTrue(TEXT("Navigation built"), Data.Build(Boundary, Obstacles, 0.0));
+			TestEqual(TEXT("Walkable area"), Data.GetWalkableArea(), 400.0 * 400.0 - 100.0 * 100.0, 0.1);
+			TestEqual(TEXT("Obstacle is not walkable"), Data.FindCell(FVector2D(200.0, 200.0)), INDEX_NONE);
+
+			TArray<FVector2D> Path;
+			TestTrue(TEXT("Path found"), Data.FindPath(FVector2D(50.0, 210.0), FVector2D(350.0, 210.0), Path));
+			TestEqual(TEXT("Path points"), Path.Num(), 4);
+			// Goes over the top two corners of the obstacle
+			TestEqual(TEXT("Path length"), PathLength(Path), 2.0 * FMath::Sqrt(100.0 * 100.0 + 40.0 * 40.0) + 100.0, 0.01);
+		});
+
+		It(TEXT("Agent radius erodes the walkable area"), [this] {
+			const TArray<FVector2D> Boundary = { FVector2D(0.0, 0.0), FVector2D(400.0, 0.0), FVector2D(400.0, 400.0), FVector2D(0.0, 400.0) };
+			const TArray<TArray<FVector2D>> Obstacles = { { FVector2D(150.0, 150.0), FVector2D(250.0, 150.0), FVector2D(250.0, 250.0), FVector2D(150.0, 250.0) } };
+
+			FMRUKNavigationData Data;
+			TestTrue(TEXT("Navigation built"), Data.Build(Boundary, Obstacles, 20.0));
+			TestEqual(TEXT("Walkable area"), Data.GetWalkableArea(), 360.0 * 360.0 - 140.0 * 140.0, 0.1);
+			TestEqual(TEXT("Close to wall is not walkable"), Data.FindCell(FVector2D(10.0, 200.0)), INDEX_NONE);
+			TestEqual(TEXT("Close to obstacle is not walkable"), Data.FindCell(FVector2D(140.0, 200.0)), INDEX_NONE);
+		});
+
+		It(TEXT("Disconnected areas have no path"), [this] {
+			const TArray<FVector2D> Boundary = { FVector2D(0.0, 0.0), FVector2D(400.0, 0.0), FVector2D(400.0, 100.0), FVector2D(0.0, 100.0) };
+			const TArray<TArray<FVector2D>> Obstacles = { { FVector2D(180.0, -10.0), FVector2D(220.0, -10.0), FVector2D(220.0, 110.0), FVector2D(180.0, 110.0) } };
+
+			FMRUKNavigationData Data;
+			Data.Build(Boundary, Obstacles, 0.0);
+			TArray<FVector2D> Path;
+			TestFalse(TEXT("No path found"), Data.FindPath(FVector2D(50.0, 50.0), FVector2D(350.0, 50.0), Path));
+		});
+
+		Describe(TEXT("Recorded rooms"), [this] {
+			BeforeEach([this]() {
+				// Load map
+				const auto ContentDir = FPaths::ProjectContentDir();
+				FAutomationEditorCommonUtils::LoadMap(ContentDir + "/Common/Maps/TestLevel.umap");
+				StartPIE(true);
+			});
+
+			BeforeEach(EAsyncExecution::ThreadPool, []() {
+				while (!GEditor->IsPlayingSessionInEditor())
+				{
+					// Wait until play session starts
+					FGenericPlatformProcess::Yield();
+				}
+			});
+
+			It(TEXT("Example room matches grid reference"), [this] {
+				TestRecordedRoom(ExampleRoomJson);
+			});
+
+			It(TEXT("Furnished room matches grid reference"), [this] {
+				TestRecordedRoom(ExampleRoomMoreFurnitureAddedJson);
+			});
+
+			// Caution: Order of these statements is important
+
+			AfterEach(EAsyncExecution::ThreadPool, []() {
+				while (GEditor->IsPlayingSessionInEditor())
+				{
+					// Wait until play session ends
+					FGenericPlatformProcess::Yield();
+				}
+			});
+
+			AfterEach([]() {
+				// Request end of play session
+				GUnrealEd->RequestEndPlayMap();
+			});
+		});
+	});
+}
@@ -0,0 +1,39 @@
+/*
+Copyright (c) Meta Platforms, Inc. and affiliates.
+All rights reserved.
+
+This source code is licensed under the license found in the
+LICENSE file in the root directory of this source tree.
+*/
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "MRUtilityKitBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+struct FMRUKSceneGeneratorSettings;
+
+/**
+ * Generates synthetic scenes of increasing size and measures how long the scene queries and spawn paths of the rooms take.
+ * Runs headless, no device or HMD is required. The results are written as JSON so that they can be compared between runs.
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=MRUKBenchmark [-Seed=0] [-Iterations=1000] [-Output=<File>]
+ *     [-Rooms=<N> -Walls=<N> -FurnitureDensity=<N> -GlobalMeshTriangles=<N>]
+ *
+ * Without any scene parameters a small, a medium and a large scene are measured. Otherwise a single scene with the
+ * given parameters is measured. The results go to Saved/MRUK/Benchmark.json by default.
+ */
+UCLASS()
+class UMRUKBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMRUKBenchmarkCommandlet();
+
+	int32 Main(const FString& Params) override;
+
+private:
+	TSharedRef<FJsonObject> RunScene(const FString& Name, const FMRUKSceneGeneratorSettings& Settings, int32 Iterations);
+};
@@ -5,6 +5,7 @@
 #include "OculusXRHMD.h"
 #include "OculusXRAnchorBPFunctionLibrary.h"
 #include "OculusXRAnchorsPrivate.h"
+#include "OculusXRTickManager.h"
 #include "GameFramework/PlayerController.h"
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
@@ -49,6 +50,23 @@ void UOculusXRAnchorComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 	UpdateAnchorTransform();
 }
 
+void UOculusXRAnchorComponent::RegisterComponentTickFunctions(bool bRegister)
+{
+	static const FOculusXRTickBatchDesc BatchDesc = { TEXT("Anchors"), TG_PostUpdateWork, &UOculusXRAnchorComponent::TickBatch };
+	if (!UOculusXRTickManager::RegisterComponentTick(this, bRegister, BatchDesc))
+	{
+		Super::RegisterComponentTickFunctions(bRegister);
+	}
+}
+
+void UOculusXRAnchorComponent::TickBatch(TArrayView<UActorComponent* const> Components, TArrayView<const float> DeltaTimes)
+{
+	for (UActorComponent* Component : Components)
+	{
+		CastChecked<UOculusXRAnchorComponent>(Component)->UpdateAnchorTransform();
+	}
+}
+
 void UOculusXRAnchorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
@@ -59,6 +59,11 @@ bool UOculusXRRoomLayoutManagerComponent::GetRoomLayout(FOculusXRUInt64 Space, F
 	return UOculusXRAnchorBPFunctionLibrary::GetRoomLayout(Space, RoomLayoutOut, MaxWallsCapacity);
 }
 
+bool UOculusXRRoomLayoutManagerComponent::GetTriangleMesh(FOculusXRUInt64 Space, TArray<FVector>& Vertices, TArray<int32>& Triangles) const
+{
+	return OculusXRAnchors::FOculusXRRoomLayoutManager::GetSpaceTriangleMesh(Space, Vertices, Triangles);
+}
+
 bool UOculusXRRoomLayoutManagerComponent::LoadTriangleMesh(FOculusXRUInt64 Space, UProceduralMeshComponent* Mesh, bool CreateCollision) const
 {
 	ensure(Mesh);
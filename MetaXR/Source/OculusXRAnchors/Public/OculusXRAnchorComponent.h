@@ -41,6 +41,8 @@ public:
 	bool IsSaved() const;
 
 protected:
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
+
 	bool bUpdateHeadSpaceTransform;
 
 private:
@@ -52,5 +54,6 @@ private:
 	class APlayerCameraManager* PlayerCameraManager;
 
 	void UpdateAnchorTransform() const;
+	static void TickBatch(TArrayView<UActorComponent* const> Components, TArrayView<const float> DeltaTimes);
 	bool ToWorldSpacePose(FTransform CameraTransform, FTransform& OutTrackingSpaceTransform) const;
 };
@@ -43,6 +43,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "OculusXR|Room Layout Manager")
 	bool LoadTriangleMesh(FOculusXRUInt64 Space, class UProceduralMeshComponent* Mesh, bool CreateCollision) const;
 
+	// Gets the mesh data (vertices in meters, indices) associated with the space
+	UFUNCTION(BlueprintCallable, Category = "OculusXR|Room Layout Manager")
+	bool GetTriangleMesh(FOculusXRUInt64 Space, TArray<FVector>& Vertices, TArray<int32>& Triangles) const;
+
 protected:
 	UPROPERTY(Transient)
 	TSet<uint64> EntityRequestList;
@@ -25,6 +25,9 @@ public class OculusXREditor : ModuleRules
 				"Core",
 				"OculusXRHMD",
 				"OculusXRMovement",
+				"AnimGraph",
+				"AnimGraphRuntime",
+				"BlueprintGraph",
 				"OculusXRPassthrough",
 				"OVRPluginXR",
 				"OculusXRProjectSetupTool",
@@ -0,0 +1,47 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "OculusXRMovementAnimGraphNodes.h"
+
+#define LOCTEXT_NAMESPACE "OculusXRMovementAnimGraphNodes"
+
+FText UAnimGraphNode_OculusXRBodyTracking::GetTooltipText() const
+{
+	return LOCTEXT("BodyTrackingTooltip", "Applies the body tracking joints to the bones. Runs on the animation worker threads, body tracking has to be started.");
+}
+
+FText UAnimGraphNode_OculusXRBodyTracking::GetControllerDescription() const
+{
+	return LOCTEXT("BodyTracking", "OculusXR Body Tracking");
+}
+
+FText UAnimGraphNode_OculusXREyeTracking::GetTooltipText() const
+{
+	return LOCTEXT("EyeTrackingTooltip", "Applies the eye gazes to the eye bones. Runs on the animation worker threads, eye tracking has to be started.");
+}
+
+FText UAnimGraphNode_OculusXREyeTracking::GetControllerDescription() const
+{
+	return LOCTEXT("EyeTracking", "OculusXR Eye Tracking");
+}
+
+FText UAnimGraphNode_OculusXRFaceTracking::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("FaceTracking", "OculusXR Face Tracking");
+}
+
+FText UAnimGraphNode_OculusXRFaceTracking::GetTooltipText() const
+{
+	return LOCTEXT("FaceTrackingTooltip", "Writes the face expression weights to the curves of the morph targets. Runs on the animation worker threads, face tracking has to be started.");
+}
+
+FString UAnimGraphNode_OculusXRFaceTracking::GetNodeCategory() const
+{
+	return TEXT("OculusXR|Movement");
+}
+
+FLinearColor UAnimGraphNode_OculusXRFaceTracking::GetNodeTitleColor() const
+{
+	return FLinearColor(0.7f, 0.7f, 0.7f);
+}
+
+#undef LOCTEXT_NAMESPACE
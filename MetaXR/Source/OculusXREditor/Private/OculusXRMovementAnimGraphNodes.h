@@ -0,0 +1,59 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimGraphNode_Base.h"
+#include "AnimGraphNode_SkeletalControlBase.h"
+#include "AnimNode_OculusXRBodyTracking.h"
+#include "AnimNode_OculusXREyeTracking.h"
+#include "AnimNode_OculusXRFaceTracking.h"
+
+#include "OculusXRMovementAnimGraphNodes.generated.h"
+
+UCLASS(MinimalAPI)
+class UAnimGraphNode_OculusXRBodyTracking : public UAnimGraphNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = Settings)
+	FAnimNode_OculusXRBodyTracking Node;
+
+	virtual FText GetTooltipText() const override;
+
+protected:
+	virtual FText GetControllerDescription() const override;
+	virtual const FAnimNode_SkeletalControlBase* GetNode() const override { return &Node; }
+};
+
+UCLASS(MinimalAPI)
+class UAnimGraphNode_OculusXREyeTracking : public UAnimGraphNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = Settings)
+	FAnimNode_OculusXREyeTracking Node;
+
+	virtual FText GetTooltipText() const override;
+
+protected:
+	virtual FText GetControllerDescription() const override;
+	virtual const FAnimNode_SkeletalControlBase* GetNode() const override { return &Node; }
+};
+
+UCLASS(MinimalAPI)
+class UAnimGraphNode_OculusXRFaceTracking : public UAnimGraphNode_Base
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = Settings)
+	FAnimNode_OculusXRFaceTracking Node;
+
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetTooltipText() const override;
+	virtual FString GetNodeCategory() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+};
@@ -6,3 +6,5 @@
 FOculusEventDelegates::FOculusDisplayRefreshRateChangedEvent FOculusEventDelegates::OculusDisplayRefreshRateChanged;
 
 FOculusEventDelegates::FOculusEyeTrackingStateChangedEvent FOculusEventDelegates::OculusEyeTrackingStateChanged;
+
+FOculusEventDelegates::FOculusInputFocusChangedEvent FOculusEventDelegates::OculusInputFocusChanged;
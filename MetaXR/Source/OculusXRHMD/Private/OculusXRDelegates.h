@@ -16,4 +16,8 @@ public:
 	/** When the eye tracking status changes */
 	DECLARE_MULTICAST_DELEGATE_OneParam(FOculusEyeTrackingStateChangedEvent, bool /*bIsEyeTrackingOn*/);
 	static FOculusEyeTrackingStateChangedEvent OculusEyeTrackingStateChanged;
+
+	/** When the app gains or loses input focus or a system overlay appears or disappears */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOculusInputFocusChangedEvent, bool /*bHasInputFocus*/, bool /*bSystemOverlayPresent*/);
+	static FOculusInputFocusChangedEvent OculusInputFocusChanged;
 };
@@ -10,6 +10,7 @@ void UOculusXREventComponent::OnRegister()
 
 	FOculusEventDelegates::OculusDisplayRefreshRateChanged.AddUObject(this, &UOculusXREventComponent::OculusDisplayRefreshRateChanged_Handler);
 	FOculusEventDelegates::OculusEyeTrackingStateChanged.AddUObject(this, &UOculusXREventComponent::OculusEyeTrackingStateChanged_Handler);
+	FOculusEventDelegates::OculusInputFocusChanged.AddUObject(this, &UOculusXREventComponent::OculusInputFocusChanged_Handler);
 }
 
 void UOculusXREventComponent::OnUnregister()
@@ -18,4 +19,5 @@ void UOculusXREventComponent::OnUnregister()
 
 	FOculusEventDelegates::OculusDisplayRefreshRateChanged.RemoveAll(this);
 	FOculusEventDelegates::OculusEyeTrackingStateChanged.RemoveAll(this);
+	FOculusEventDelegates::OculusInputFocusChanged.RemoveAll(this);
 }
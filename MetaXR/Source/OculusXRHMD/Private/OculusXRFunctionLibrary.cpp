@@ -570,6 +570,45 @@ void UOculusXRFunctionLibrary::SetColorScaleAndOffset(FLinearColor ColorScale, F
 #endif
 }
 
+void UOculusXRFunctionLibrary::StartColorScaleAndOffsetTransition(FLinearColor ColorScale, FLinearColor ColorOffset, float Duration, EOculusXRColorTransitionCurve Curve, UCurveFloat* CustomCurve, bool bQueue, bool bApplyToAllLayers, int32 LayerId)
+{
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+	OculusXRHMD::FOculusXRHMD* OculusXRHMD = GetOculusXRHMD();
+	if (OculusXRHMD != nullptr)
+	{
+		OculusXRHMD::FColorTransition Transition;
+		Transition.Target = OculusXRHMD::FColorScaleAndOffset{ ColorScale, ColorOffset };
+		Transition.Duration = Duration;
+		Transition.Curve = Curve;
+		Transition.CustomCurve = CustomCurve;
+		OculusXRHMD->StartColorScaleAndOffsetTransition(bApplyToAllLayers ? OculusXRHMD::FColorTransitionController::AllLayers : (uint32)LayerId, Transition, bQueue);
+	}
+#endif
+}
+
+void UOculusXRFunctionLibrary::CancelColorScaleAndOffsetTransitions(bool bApplyToAllLayers, int32 LayerId)
+{
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+	OculusXRHMD::FOculusXRHMD* OculusXRHMD = GetOculusXRHMD();
+	if (OculusXRHMD != nullptr)
+	{
+		OculusXRHMD->CancelColorScaleAndOffsetTransitions(bApplyToAllLayers ? OculusXRHMD::FColorTransitionController::AllLayers : (uint32)LayerId);
+	}
+#endif
+}
+
+bool UOculusXRFunctionLibrary::IsColorScaleAndOffsetTransitioning(bool bApplyToAllLayers, int32 LayerId)
+{
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+	OculusXRHMD::FOculusXRHMD* OculusXRHMD = GetOculusXRHMD();
+	if (OculusXRHMD != nullptr)
+	{
+		return OculusXRHMD->IsColorScaleAndOffsetTransitioning(bApplyToAllLayers ? OculusXRHMD::FColorTransitionController::AllLayers : (uint32)LayerId);
+	}
+#endif
+	return false;
+}
+
 class IStereoLayers* UOculusXRFunctionLibrary::GetStereoLayers()
 {
 #if OCULUS_HMD_SUPPORTED_PLATFORMS
@@ -926,6 +965,39 @@ bool UOculusXRFunctionLibrary::IsEnvironmentDepthStarted()
 	return false;
 }
 
+void UOculusXRFunctionLibrary::AddEnvironmentDepthConsumer(FName ConsumerName)
+{
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+	OculusXRHMD::FOculusXRHMD* OculusXRHMD = GetOculusXRHMD();
+	if (OculusXRHMD != nullptr)
+	{
+		OculusXRHMD->AddEnvironmentDepthConsumer(ConsumerName);
+	}
+#endif
+}
+
+void UOculusXRFunctionLibrary::RemoveEnvironmentDepthConsumer(FName ConsumerName)
+{
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+	OculusXRHMD::FOculusXRHMD* OculusXRHMD = GetOculusXRHMD();
+	if (OculusXRHMD != nullptr)
+	{
+		OculusXRHMD->RemoveEnvironmentDepthConsumer(ConsumerName);
+	}
+#endif
+}
+
+void UOculusXRFunctionLibrary::GetEnvironmentDepthStats(FOculusXREnvironmentDepthStats& EnvironmentDepthStats)
+{
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+	OculusXRHMD::FOculusXRHMD* OculusXRHMD = GetOculusXRHMD();
+	if (OculusXRHMD != nullptr)
+	{
+		EnvironmentDepthStats = OculusXRHMD->GetEnvironmentDepthStats();
+	}
+#endif
+}
+
 void UOculusXRFunctionLibrary::SetEnvironmentDepthHandRemoval(bool RemoveHands)
 {
 #if OCULUS_HMD_SUPPORTED_PLATFORMS
@@ -946,6 +1018,10 @@ void UOculusXRFunctionLibrary::SetXROcclusionsMode(UObject* WorldContextObject,
 		OculusXRHMD->EnableHardOcclusions(Mode == EOculusXROcclusionsMode::HardOcclusions);
 	}
 #if defined(WITH_OCULUS_BRANCH)
+	if (OculusXRHMD != nullptr)
+	{
+		OculusXRHMD->EnableSoftOcclusions(Mode == EOculusXROcclusionsMode::SoftOcclusions);
+	}
 	WorldContextObject->GetWorld()->Scene->SetEnableXRPassthroughSoftOcclusions(Mode == EOculusXROcclusionsMode::SoftOcclusions);
 #else
 	ensureMsgf(Mode != EOculusXROcclusionsMode::SoftOcclusions, TEXT("Soft occlusions are only supported with the Oculus branch of the Unreal Engine"));
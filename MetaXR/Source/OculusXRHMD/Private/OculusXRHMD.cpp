@@ -85,9 +85,40 @@ static TAutoConsoleVariable<int32> CVarOculusEnableSpaceWarpUser(
 	TEXT("r.Mobile.Oculus.SpaceWarp.Enable"),
 	0,
 	TEXT("0 Disable spacewarp at runtime.\n")
-		TEXT("1 Enable spacewarp at runtime.\n"),
+		TEXT("1 Enable spacewarp at runtime.\n")
+			TEXT("2 Enable spacewarp automatically while the app frame time doesn't fit into the refresh rate budget.\n"),
 	ECVF_Scalability | ECVF_RenderThreadSafe);
 
+static TAutoConsoleVariable<float> CVarOculusSpaceWarpAutoEnableHeadroom(
+	TEXT("r.Mobile.Oculus.SpaceWarp.Auto.EnableHeadroom"),
+	0.0f,
+	TEXT("Automatic spacewarp turns on when the fraction of the frame budget left is below this value, e.g. -0.1 for a frame time 10% over budget.\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarOculusSpaceWarpAutoDisableHeadroom(
+	TEXT("r.Mobile.Oculus.SpaceWarp.Auto.DisableHeadroom"),
+	0.25f,
+	TEXT("Automatic spacewarp turns off when the fraction of the frame budget left is above this value. Should be larger than EnableHeadroom.\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarOculusSpaceWarpAutoEnableDelay(
+	TEXT("r.Mobile.Oculus.SpaceWarp.Auto.EnableDelay"),
+	0.5f,
+	TEXT("Seconds the app has to be over the enable threshold before automatic spacewarp turns on.\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarOculusSpaceWarpAutoDisableDelay(
+	TEXT("r.Mobile.Oculus.SpaceWarp.Auto.DisableDelay"),
+	3.0f,
+	TEXT("Seconds the app has to be under the disable threshold before automatic spacewarp turns off.\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarOculusSpaceWarpAutoMaxToggleMotion(
+	TEXT("r.Mobile.Oculus.SpaceWarp.Auto.MaxToggleMotion"),
+	60.0f,
+	TEXT("Automatic spacewarp doesn't toggle while the head rotates faster than this, in degrees per second, unless the app is far over budget. 0 disables the check.\n"),
+	ECVF_Scalability);
+
 static TAutoConsoleVariable<int32> CVarOculusEnableSpaceWarpInternal(
 	TEXT("r.Mobile.Oculus.SpaceWarp.EnableInternal"),
 	0,
@@ -120,6 +151,55 @@ static TAutoConsoleVariable<int32> CVarOculusDynamicFoveatedRendering(
 		TEXT("1 Enable Dynamic Foveated Rendering at runtime.\n"),
 	ECVF_Scalability | ECVF_RenderThreadSafe);
 
+static TAutoConsoleVariable<int32> CVarOculusEyeTrackedFoveationConfidenceGating(
+	TEXT("r.Mobile.Oculus.FoveatedRendering.EyeTracked.ConfidenceGating"),
+	1,
+	TEXT("0 Use eye tracked foveated rendering regardless of the gaze confidence.\n")
+		TEXT("1 Fall back to fixed foveated rendering while the gaze confidence is low.\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarOculusEyeTrackedFoveationDegradeConfidence(
+	TEXT("r.Mobile.Oculus.FoveatedRendering.EyeTracked.DegradeConfidence"),
+	0.5f,
+	TEXT("Eye tracked foveated rendering falls back to fixed foveated rendering while the gaze confidence is below this value.\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarOculusEyeTrackedFoveationRestoreConfidence(
+	TEXT("r.Mobile.Oculus.FoveatedRendering.EyeTracked.RestoreConfidence"),
+	0.75f,
+	TEXT("Eye tracked foveated rendering is restored while the gaze confidence is at or above this value. Should be larger than DegradeConfidence.\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarOculusEyeTrackedFoveationDegradeDelay(
+	TEXT("r.Mobile.Oculus.FoveatedRendering.EyeTracked.DegradeDelay"),
+	0.2f,
+	TEXT("Seconds the gaze confidence has to stay low before falling back to fixed foveated rendering, long enough to ignore blinks.\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarOculusEyeTrackedFoveationRestoreDelay(
+	TEXT("r.Mobile.Oculus.FoveatedRendering.EyeTracked.RestoreDelay"),
+	1.0f,
+	TEXT("Seconds the gaze confidence has to stay high before eye tracked foveated rendering is restored.\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarOculusEyeTrackedFoveationOffsetSmoothing(
+	TEXT("r.Mobile.Oculus.FoveatedRendering.EyeTracked.OffsetSmoothing"),
+	0.08f,
+	TEXT("Time constant in seconds of the smoothing of small foveation center movements. 0 disables the smoothing.\n"),
+	ECVF_Scalability | ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<float> CVarOculusEyeTrackedFoveationOffsetSnapDistance(
+	TEXT("r.Mobile.Oculus.FoveatedRendering.EyeTracked.OffsetSnapDistance"),
+	0.15f,
+	TEXT("Foveation center movements larger than this, as a fraction of the half eye buffer size, aren't smoothed so the foveation follows saccades right away.\n"),
+	ECVF_Scalability | ECVF_RenderThreadSafe);
+
+static TAutoConsoleVariable<float> CVarOculusEyeTrackedFoveationMaxOffset(
+	TEXT("r.Mobile.Oculus.FoveatedRendering.EyeTracked.MaxOffset"),
+	0.9f,
+	TEXT("Foveation centers are clamped to this offset from the eye buffer center, as a fraction of the half eye buffer size.\n"),
+	ECVF_Scalability | ECVF_RenderThreadSafe);
+
 static TAutoConsoleVariable<float> CVarOculusDynamicResolutionPixelDensity(
 	TEXT("r.Oculus.DynamicResolution.PixelDensity"),
 	0,
@@ -127,6 +207,18 @@ static TAutoConsoleVariable<float> CVarOculusDynamicResolutionPixelDensity(
 		TEXT(">0 Manual Pixel Density Override\n"),
 	ECVF_Scalability | ECVF_RenderThreadSafe);
 
+static TAutoConsoleVariable<float> CVarOculusEnvironmentDepthIdleTimeout(
+	TEXT("r.Mobile.Oculus.EnvironmentDepth.IdleTimeout"),
+	1.0f,
+	TEXT("Seconds environment depth keeps running after the last consumer was removed.\n"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarOculusEnvironmentDepthReleaseDelay(
+	TEXT("r.Mobile.Oculus.EnvironmentDepth.ReleaseDelay"),
+	10.0f,
+	TEXT("Seconds the environment depth swapchain is kept after environment depth was suspended, so it can be resumed quickly.\n"),
+	ECVF_Default);
+
 #define OCULUS_PAUSED_IDLE_FPS 10
 
 static const FString USE_SCENE_PERMISSION_NAME("com.oculus.permission.USE_SCENE");
@@ -676,7 +768,7 @@ namespace OculusXRHMD
 		CachedViewportWidget.Reset();
 		CachedWindow.Reset();
 
-		bHardOcclusionsEnabled = false;
+		EnableHardOcclusions(false);
 
 #if WITH_EDITOR
 		// @TODO: add more values here.
@@ -685,8 +777,9 @@ namespace OculusXRHMD
 		{
 			Settings->BaseOrientation = FQuat::Identity;
 			Settings->BaseOffset = FVector::ZeroVector;
-			Settings->ColorScale = ovrpVector4f{ 1, 1, 1, 1 };
-			Settings->ColorOffset = ovrpVector4f{ 0, 0, 0, 0 };
+			ColorTransitions.Reset();
+			Settings->ColorScaleAndOffset = FColorScaleAndOffset();
+			Settings->LayerColorScaleAndOffset.Reset();
 
 			//Settings->WorldToMetersScale = InWorldContext.World()->GetWorldSettings()->WorldToMeters;
 			//Settings->Flags.bWorldToMetersOverride = false;
@@ -1025,6 +1118,11 @@ namespace OculusXRHMD
 			DoSessionShutdown();
 		}
 
+		UpdateEnvironmentDepth_GameThread(FApp::GetDeltaTime());
+		UpdateSpaceWarp_GameThread(FApp::GetDeltaTime());
+		UpdateFoveationArbiter_GameThread(FApp::GetDeltaTime());
+		UpdateColorTransitions_GameThread(FApp::GetDeltaTime());
+
 		if (!InWorldContext.World() || (!(GEnableVREditorHacks && InWorldContext.WorldType == EWorldType::Editor) && !InWorldContext.World()->IsGameWorld())) // @todo vreditor: (Also see OnEndGameFrame()) Kind of a hack here so we can use VR in editor viewports.  We need to consider when running GameWorld viewports inside the editor with VR.
 		{
 			// ignore all non-game worlds
@@ -1179,6 +1277,8 @@ namespace OculusXRHMD
 				}
 			}
 
+			UpdateInputFocus();
+
 			ovrpBool AppShouldQuit;
 			ovrpBool AppShouldRecenter;
 
@@ -1272,6 +1372,10 @@ namespace OculusXRHMD
 			Frame_RenderThread.Reset();
 			Layers_RenderThread.Reset();
 			EyeLayer_RenderThread.Reset();
+#if !UE_VERSION_OLDER_THAN(5, 3, 0)
+			// The generator holds on to the foveation swapchain
+			FoveationImageGenerator.Reset();
+#endif // !UE_VERSION_OLDER_THAN(5, 3, 0)
 
 			DeferredDeletion.HandleLayerDeferredDeletionQueue_RenderThread(true);
 
@@ -1293,6 +1397,9 @@ namespace OculusXRHMD
 			FApp::SetHasVRFocus(false);
 		}
 
+		// Stops the eye tracker if the foveation confidence gating started it
+		FoveationArbiter.Reset();
+
 		ShutdownSession();
 	}
 
@@ -2132,6 +2239,27 @@ namespace OculusXRHMD
 		}
 	}
 
+	void FOculusXRHMD::UpdateInputFocus()
+	{
+		ovrpBool bAppHasInputFocus = ovrpBool_True;
+		ovrpBool bSystemOverlayPresent = ovrpBool_False;
+		if (OVRP_FAILURE(FOculusXRHMDModule::GetPluginWrapper().GetAppHasInputFocus(&bAppHasInputFocus)))
+		{
+			return;
+		}
+		FOculusXRHMDModule::GetPluginWrapper().GetAppHasSystemOverlayPresent(&bSystemOverlayPresent);
+
+		const bool bLostInputFocus = bAppHasInputFocus == ovrpBool_False;
+		const bool bOverlayPresent = bSystemOverlayPresent != ovrpBool_False;
+		if (bLostInputFocus != (bool)OCFlags.AppLostInputFocus || bOverlayPresent != (bool)OCFlags.SystemOverlayPresent)
+		{
+			UE_LOG(LogHMD, Log, TEXT("Input focus changed: HasInputFocus %d, SystemOverlayPresent %d"), !bLostInputFocus, bOverlayPresent);
+			OCFlags.AppLostInputFocus = bLostInputFocus;
+			OCFlags.SystemOverlayPresent = bOverlayPresent;
+			FOculusEventDelegates::OculusInputFocusChanged.Broadcast(!bLostInputFocus, bOverlayPresent);
+		}
+	}
+
 	void FOculusXRHMD::UpdateHMDEvents()
 	{
 		ovrpEventDataBuffer buf;
@@ -2177,6 +2305,7 @@ namespace OculusXRHMD
 			(*LayerFound)->DestroyLayer();
 		}
 		LayerMap.Remove(LayerId);
+		ColorTransitions.RemoveLayer(LayerId);
 	}
 
 	void FOculusXRHMD::SetLayerDesc(uint32 LayerId, const IStereoLayers::FLayerDesc& InLayerDesc)
@@ -2590,6 +2719,11 @@ namespace OculusXRHMD
 		: FHeadMountedDisplayBase(nullptr)
 		, FHMDSceneViewExtension(AutoRegister)
 		, ConsoleCommands(this)
+		, EnvironmentDepthState(EEnvironmentDepthState::Stopped)
+		, EnvironmentDepthCreateFlags(0)
+		, EnvironmentDepthIdleTime(0.0f)
+		, bSoftOcclusionsEnabled(false)
+		, bHardOcclusionsEnabled(false)
 		, InsightInitStatus(FInsightInitStatus::NotInitialized)
 		, bShutdownRequestQueued(false)
 		, bShouldWait_GameThread(true)
@@ -2734,6 +2868,7 @@ namespace OculusXRHMD
 
 		Settings.Reset();
 		LayerMap.Reset();
+		LayerBudget.Reset();
 	}
 
 	void FOculusXRHMD::ApplicationPauseDelegate()
@@ -3244,16 +3379,12 @@ namespace OculusXRHMD
 		ovrpTextureFormat MvDepthFormat = ovrpTextureFormat_D24_S8;
 		int SpaceWarpAllocateFlag = 0;
 
+		// The motion vector swapchains are allocated whenever spacewarp is supported, independent of whether it's
+		// enabled, so the eye layer desc doesn't change and the swapchains are reused when spacewarp is toggled.
+		// Toggling is done per frame in UpdateSpaceWarp_GameThread.
 		if (SupportsSpaceWarp())
 		{
 			SpaceWarpAllocateFlag = ovrpLayerFlag_SpaceWarpDataAllocation | ovrpLayerFlag_SpaceWarpDedicatedDepth;
-
-			bool spaceWarpEnabledByUser = CVarOculusEnableSpaceWarpUser.GetValueOnAnyThread() != 0;
-			bool spaceWarpEnabledInternal = CVarOculusEnableSpaceWarpInternal.GetValueOnAnyThread() != 0;
-			if (spaceWarpEnabledByUser != spaceWarpEnabledInternal)
-			{
-				CVarOculusEnableSpaceWarpInternal->Set(spaceWarpEnabledByUser);
-			}
 		}
 
 		const bool bCompositeDepth = Settings->Flags.bCompositeDepth;
@@ -3393,9 +3524,20 @@ namespace OculusXRHMD
 					bNeedReAllocateFoveationTexture_RenderThread = true;
 				}
 #if !UE_VERSION_OLDER_THAN(5, 3, 0)
-				FoveationImageGenerator = MakeShared<FOculusXRFoveatedRenderingImageGenerator, ESPMode::ThreadSafe>(EyeLayer->GetFoveationSwapChain());
+				// The generator pools the shading rate images of the swapchain, only recreate it for a new swapchain
+				if (!FoveationImageGenerator.IsValid() || FoveationImageGenerator->GetSwapchain() != EyeLayer->GetFoveationSwapChain())
+				{
+					FoveationImageGenerator = MakeShared<FOculusXRFoveatedRenderingImageGenerator, ESPMode::ThreadSafe>(EyeLayer->GetFoveationSwapChain());
+				}
 #endif // !UE_VERSION_OLDER_THAN(5, 3, 0)
 			}
+#if !UE_VERSION_OLDER_THAN(5, 3, 0)
+			else
+			{
+				// The generator holds on to the swapchain
+				FoveationImageGenerator.Reset();
+			}
+#endif // !UE_VERSION_OLDER_THAN(5, 3, 0)
 
 			if (EyeLayer->GetMotionVectorSwapChain().IsValid())
 			{
@@ -3593,6 +3735,18 @@ namespace OculusXRHMD
 				InCanvas->Canvas->DrawShadowedString(X, Y, *Str, Font, TextColor);
 				Y += RowHeight;
 			}
+
+			const FLayerBudget::FStats& LayerBudgetStats = LayerBudget.GetStats();
+			Str = FString::Printf(TEXT("Layers: %d/%d, %lld texels"), LayerBudgetStats.NumSubmittedLayers, LayerBudgetStats.NumVisibleLayers, LayerBudgetStats.UpdatedTexels);
+			InCanvas->Canvas->DrawShadowedString(X, Y, *Str, Font, TextColor);
+			Y += RowHeight;
+
+			for (const FLayerBudget::FDemotedLayer& DemotedLayer : LayerBudgetStats.DemotedLayers)
+			{
+				Str = FString::Printf(TEXT("Layer %u: %s (%s)"), DemotedLayer.LayerId, FLayerBudget::LexToString(DemotedLayer.Demotion), FLayerBudget::LexToString(DemotedLayer.Reason));
+				InCanvas->Canvas->DrawShadowedString(X, Y, *Str, Font, TextColor);
+				Y += RowHeight;
+			}
 		}
 	}
 #endif // #if !UE_BUILD_SHIPPING
@@ -3860,9 +4014,29 @@ namespace OculusXRHMD
 	void FOculusXRHMD::SetColorScaleAndOffset(FLinearColor ColorScale, FLinearColor ColorOffset, bool bApplyToAllLayers)
 	{
 		CheckInGameThread();
-		Settings->bApplyColorScaleAndOffsetToAllLayers = bApplyToAllLayers;
-		Settings->ColorScale = LinearColorToOvrpVector4f(ColorScale);
-		Settings->ColorOffset = LinearColorToOvrpVector4f(ColorOffset);
+		// Either the eye layer or all layers, the other one goes back to the identity
+		const uint32 LayerId = bApplyToAllLayers ? FColorTransitionController::AllLayers : 0;
+		ColorTransitions.Set(LayerId, FColorScaleAndOffset{ ColorScale, ColorOffset });
+		ColorTransitions.Set(bApplyToAllLayers ? 0 : FColorTransitionController::AllLayers, FColorScaleAndOffset());
+		ApplyColorTransitions_GameThread();
+	}
+
+	void FOculusXRHMD::StartColorScaleAndOffsetTransition(uint32 LayerId, const FColorTransition& Transition, bool bQueue)
+	{
+		CheckInGameThread();
+		ColorTransitions.AddTransition(LayerId, Transition, bQueue);
+	}
+
+	void FOculusXRHMD::CancelColorScaleAndOffsetTransitions(uint32 LayerId)
+	{
+		CheckInGameThread();
+		ColorTransitions.Cancel(LayerId);
+	}
+
+	bool FOculusXRHMD::IsColorScaleAndOffsetTransitioning(uint32 LayerId) const
+	{
+		CheckInGameThread();
+		return ColorTransitions.IsTransitioning(LayerId);
 	}
 
 	void FOculusXRHMD::SetEnvironmentDepthHandRemoval(bool RemoveHands)
@@ -3871,7 +4045,215 @@ namespace OculusXRHMD
 		bEnvironmentDepthHandRemovalEnabled = RemoveHands;
 	}
 
+	namespace
+	{
+		// Consumer registered by StartEnvironmentDepth()/StopEnvironmentDepth()
+		const FName ManualEnvironmentDepthConsumer(TEXT("StartEnvironmentDepth"));
+		const FName HardOcclusionsEnvironmentDepthConsumer(TEXT("HardOcclusions"));
+		const FName SoftOcclusionsEnvironmentDepthConsumer(TEXT("SoftOcclusions"));
+	} // namespace
+
 	void FOculusXRHMD::StartEnvironmentDepth(int CreateFlags)
+	{
+		CheckInGameThread();
+
+		EnvironmentDepthCreateFlags = CreateFlags;
+		if (!EnvironmentDepthConsumers.Contains(ManualEnvironmentDepthConsumer))
+		{
+			AddEnvironmentDepthConsumer(ManualEnvironmentDepthConsumer);
+		}
+	}
+
+	void FOculusXRHMD::StopEnvironmentDepth()
+	{
+		CheckInGameThread();
+
+		EnvironmentDepthConsumers.Remove(ManualEnvironmentDepthConsumer);
+
+		// An explicit stop frees the resources right away unless someone else still needs depth
+		if (EnvironmentDepthConsumers.IsEmpty() && EnvironmentDepthState != EEnvironmentDepthState::Stopped)
+		{
+			if (EnvironmentDepthState == EEnvironmentDepthState::Running)
+			{
+				EnvironmentDepthStats.NumStops++;
+			}
+			DestroyEnvironmentDepth();
+		}
+	}
+
+	void FOculusXRHMD::AddEnvironmentDepthConsumer(FName Consumer)
+	{
+		CheckInGameThread();
+
+		EnvironmentDepthConsumers.FindOrAdd(Consumer)++;
+		UE_LOG(LogHMD, Verbose, TEXT("Environment depth consumer added: %s"), *Consumer.ToString());
+
+		// Start right away instead of waiting for the next frame
+		UpdateEnvironmentDepth_GameThread(0.0f);
+	}
+
+	void FOculusXRHMD::RemoveEnvironmentDepthConsumer(FName Consumer)
+	{
+		CheckInGameThread();
+
+		int32* Count = EnvironmentDepthConsumers.Find(Consumer);
+		if (Count == nullptr)
+		{
+			UE_LOG(LogHMD, Warning, TEXT("Environment depth consumer %s was not registered"), *Consumer.ToString());
+			return;
+		}
+
+		if (--(*Count) <= 0)
+		{
+			EnvironmentDepthConsumers.Remove(Consumer);
+		}
+		UE_LOG(LogHMD, Verbose, TEXT("Environment depth consumer removed: %s"), *Consumer.ToString());
+	}
+
+	FOculusXREnvironmentDepthStats FOculusXRHMD::GetEnvironmentDepthStats() const
+	{
+		FOculusXREnvironmentDepthStats Stats = EnvironmentDepthStats;
+		Stats.bIsRunning = EnvironmentDepthState == EEnvironmentDepthState::Running;
+		Stats.NumConsumers = 0;
+		for (const TPair<FName, int32>& Pair : EnvironmentDepthConsumers)
+		{
+			Stats.NumConsumers += Pair.Value;
+		}
+		return Stats;
+	}
+
+	void FOculusXRHMD::UpdateEnvironmentDepth_GameThread(float DeltaTime)
+	{
+		CheckInGameThread();
+
+		if (EnvironmentDepthState == EEnvironmentDepthState::Running)
+		{
+			EnvironmentDepthStats.ActiveTime += DeltaTime;
+		}
+
+		if (!EnvironmentDepthConsumers.IsEmpty())
+		{
+			EnvironmentDepthIdleTime = 0.0f;
+			if (EnvironmentDepthState == EEnvironmentDepthState::Stopped)
+			{
+				UE_LOG(LogHMD, Log, TEXT("Starting environment depth"));
+				CreateEnvironmentDepth(EnvironmentDepthCreateFlags);
+				EnvironmentDepthState = EEnvironmentDepthState::Running;
+				EnvironmentDepthStats.NumStarts++;
+				EnvironmentDepthStats.NumSwapchainCreations++;
+			}
+			else if (EnvironmentDepthState == EEnvironmentDepthState::Suspended)
+			{
+				UE_LOG(LogHMD, Log, TEXT("Resuming environment depth"));
+				ResumeEnvironmentDepth();
+				EnvironmentDepthState = EEnvironmentDepthState::Running;
+				EnvironmentDepthStats.NumStarts++;
+			}
+			return;
+		}
+
+		if (EnvironmentDepthState == EEnvironmentDepthState::Stopped)
+		{
+			return;
+		}
+
+		EnvironmentDepthIdleTime += DeltaTime;
+		if (EnvironmentDepthState == EEnvironmentDepthState::Running && EnvironmentDepthIdleTime >= CVarOculusEnvironmentDepthIdleTimeout.GetValueOnGameThread())
+		{
+			UE_LOG(LogHMD, Log, TEXT("Suspending environment depth, no consumers for %.1f s"), EnvironmentDepthIdleTime);
+			SuspendEnvironmentDepth();
+			EnvironmentDepthState = EEnvironmentDepthState::Suspended;
+			EnvironmentDepthStats.NumStops++;
+			EnvironmentDepthIdleTime = 0.0f;
+		}
+		else if (EnvironmentDepthState == EEnvironmentDepthState::Suspended && EnvironmentDepthIdleTime >= CVarOculusEnvironmentDepthReleaseDelay.GetValueOnGameThread())
+		{
+			UE_LOG(LogHMD, Log, TEXT("Releasing environment depth swapchain"));
+			DestroyEnvironmentDepth();
+		}
+	}
+
+	void FOculusXRHMD::UpdateSpaceWarp_GameThread(float DeltaTime)
+	{
+		CheckInGameThread();
+
+		if (!CustomPresent.IsValid() || !SupportsSpaceWarp())
+		{
+			return;
+		}
+
+		const int32 Mode = CVarOculusEnableSpaceWarpUser.GetValueOnGameThread();
+		bool bEnable = Mode == 1;
+		if (Mode == 2)
+		{
+			FSpaceWarpController::FSettings ControllerSettings = SpaceWarpController.GetSettings();
+			ControllerSettings.EnableHeadroom = CVarOculusSpaceWarpAutoEnableHeadroom.GetValueOnGameThread();
+			ControllerSettings.DisableHeadroom = FMath::Max(CVarOculusSpaceWarpAutoDisableHeadroom.GetValueOnGameThread(), ControllerSettings.EnableHeadroom);
+			ControllerSettings.EnableDelay = CVarOculusSpaceWarpAutoEnableDelay.GetValueOnGameThread();
+			ControllerSettings.DisableDelay = CVarOculusSpaceWarpAutoDisableDelay.GetValueOnGameThread();
+			ControllerSettings.MaxToggleHeadAngularSpeed = CVarOculusSpaceWarpAutoMaxToggleMotion.GetValueOnGameThread();
+			SpaceWarpController.SetSettings(ControllerSettings);
+
+			bEnable = SpaceWarpController.Update(DeltaTime);
+		}
+		else if (SpaceWarpController.IsEnabled() != bEnable)
+		{
+			// Start from the manual state when switching to the automatic mode
+			SpaceWarpController.Reset(bEnable);
+		}
+
+		// Only the submit flag and the velocity pass depend on this, the swapchains stay allocated
+		if (bEnable != (CVarOculusEnableSpaceWarpInternal.GetValueOnGameThread() != 0))
+		{
+			UE_LOG(LogHMD, Log, TEXT("[Mobile SpaceWarp] %s"), bEnable ? TEXT("Enabled") : TEXT("Disabled"));
+			CVarOculusEnableSpaceWarpInternal->Set(bEnable);
+		}
+	}
+
+	void FOculusXRHMD::UpdateColorTransitions_GameThread(float DeltaTime)
+	{
+		CheckInGameThread();
+		ColorTransitions.Update(DeltaTime);
+		ApplyColorTransitions_GameThread();
+	}
+
+	void FOculusXRHMD::ApplyColorTransitions_GameThread()
+	{
+		// The settings are cloned for the frame, so the compositor picks up the values of the frame they were evaluated for
+		Settings->ColorScaleAndOffset = ColorTransitions.GetValue(FColorTransitionController::AllLayers);
+		ColorTransitions.GetLayerValues(Settings->LayerColorScaleAndOffset);
+	}
+
+	void FOculusXRHMD::UpdateFoveationArbiter_GameThread(float DeltaTime)
+	{
+#ifdef WITH_OCULUS_BRANCH
+		CheckInGameThread();
+
+		const EOculusXRFoveatedRenderingMethod Method = CVarOculusFoveatedRenderingMethod.GetValueOnGameThread() >= 0 ? (EOculusXRFoveatedRenderingMethod)CVarOculusFoveatedRenderingMethod.GetValueOnGameThread() : FoveatedRenderingMethod.load();
+		if (Method != EOculusXRFoveatedRenderingMethod::EyeTrackedFoveatedRendering || !CVarOculusEyeTrackedFoveationConfidenceGating.GetValueOnGameThread())
+		{
+			FoveationArbiter.Reset();
+			return;
+		}
+
+		FFoveationArbiter::FModeSettings ArbiterSettings;
+		ArbiterSettings.DegradeConfidence = CVarOculusEyeTrackedFoveationDegradeConfidence.GetValueOnGameThread();
+		ArbiterSettings.RestoreConfidence = FMath::Max(CVarOculusEyeTrackedFoveationRestoreConfidence.GetValueOnGameThread(), ArbiterSettings.DegradeConfidence);
+		ArbiterSettings.DegradeDelay = CVarOculusEyeTrackedFoveationDegradeDelay.GetValueOnGameThread();
+		ArbiterSettings.RestoreDelay = CVarOculusEyeTrackedFoveationRestoreDelay.GetValueOnGameThread();
+		FoveationArbiter.SetModeSettings(ArbiterSettings);
+
+		const bool bWasEyeTracked = FoveationArbiter.IsEyeTracked();
+		if (FoveationArbiter.Update(DeltaTime) != bWasEyeTracked)
+		{
+			// CreateNewGameFrame picks the fixed foveation for the next frames, the app can react to the change the same
+			// way as to the fallback after a failed eye tracked frame
+			FOculusEventDelegates::OculusEyeTrackingStateChanged.Broadcast(!bWasEyeTracked);
+		}
+#endif // WITH_OCULUS_BRANCH
+	}
+
+	void FOculusXRHMD::CreateEnvironmentDepth(int CreateFlags)
 	{
 #if PLATFORM_ANDROID
 		// Check and request scene permissions (this is needed for environment depth to work)
@@ -3887,7 +4269,7 @@ namespace OculusXRHMD
 				if (PermIndex != INDEX_NONE && GrantResults[PermIndex])
 				{
 					UE_LOG(LogHMD, Verbose, TEXT("%s permission granted"), *USE_SCENE_PERMISSION_NAME);
-					StartEnvironmentDepth(CreateFlags);
+					CreateEnvironmentDepth(CreateFlags);
 				}
 				else
 				{
@@ -3955,30 +4337,76 @@ namespace OculusXRHMD
 		});
 	}
 
-	void FOculusXRHMD::StopEnvironmentDepth()
+	void FOculusXRHMD::DestroyEnvironmentDepth()
 	{
+		// Stopping a suspended environment depth fails, it still needs to be destroyed
 		ExecuteOnRenderThread_DoNotWait([this]() {
 			ExecuteOnRHIThread_DoNotWait([this]() {
 				if (!EnvironmentDepthSwapchain.IsEmpty())
 				{
 					EnvironmentDepthSwapchain.Empty();
 				}
-				if (OVRP_SUCCESS(FOculusXRHMDModule::GetPluginWrapper().StopEnvironmentDepth()))
-				{
-					FOculusXRHMDModule::GetPluginWrapper().DestroyEnvironmentDepth();
-				}
+				FOculusXRHMDModule::GetPluginWrapper().StopEnvironmentDepth();
+				FOculusXRHMDModule::GetPluginWrapper().DestroyEnvironmentDepth();
 			});
 		});
+
+		EnvironmentDepthState = EEnvironmentDepthState::Stopped;
+		EnvironmentDepthIdleTime = 0.0f;
+		EnvironmentDepthStats.NumSwapchainReleases++;
+	}
+
+	void FOculusXRHMD::SuspendEnvironmentDepth()
+	{
+		ExecuteOnRenderThread_DoNotWait([this]() {
+			ExecuteOnRHIThread_DoNotWait([this]() {
+				FOculusXRHMDModule::GetPluginWrapper().StopEnvironmentDepth();
+			});
+		});
+	}
+
+	void FOculusXRHMD::ResumeEnvironmentDepth()
+	{
+		ExecuteOnRenderThread_DoNotWait([this]() {
+			FOculusXRHMDModule::GetPluginWrapper().SetEnvironmentDepthHandRemoval(bEnvironmentDepthHandRemovalEnabled);
+			FOculusXRHMDModule::GetPluginWrapper().StartEnvironmentDepth();
+		});
 	}
 
 	bool FOculusXRHMD::IsEnvironmentDepthStarted()
 	{
-		return !EnvironmentDepthSwapchain.IsEmpty();
+		return EnvironmentDepthState == EEnvironmentDepthState::Running && !EnvironmentDepthSwapchain.IsEmpty();
 	}
 
 	void FOculusXRHMD::EnableHardOcclusions(bool bEnable)
 	{
-		bHardOcclusionsEnabled = bEnable;
+		if (bHardOcclusionsEnabled.exchange(bEnable) != bEnable)
+		{
+			if (bEnable)
+			{
+				AddEnvironmentDepthConsumer(HardOcclusionsEnvironmentDepthConsumer);
+			}
+			else
+			{
+				RemoveEnvironmentDepthConsumer(HardOcclusionsEnvironmentDepthConsumer);
+			}
+		}
+	}
+
+	void FOculusXRHMD::EnableSoftOcclusions(bool bEnable)
+	{
+		if (bSoftOcclusionsEnabled != bEnable)
+		{
+			bSoftOcclusionsEnabled = bEnable;
+			if (bEnable)
+			{
+				AddEnvironmentDepthConsumer(SoftOcclusionsEnvironmentDepthConsumer);
+			}
+			else
+			{
+				RemoveEnvironmentDepthConsumer(SoftOcclusionsEnvironmentDepthConsumer);
+			}
+		}
 	}
 
 	bool FOculusXRHMD::DoEnableStereo(bool bStereo)
@@ -4119,8 +4547,13 @@ namespace OculusXRHMD
 		}
 		const FIntPoint SwapChainDimensions = SwapChainTexture->GetSizeXY();
 
+		FFoveationArbiter::FOffsetFilterSettings FilterSettings;
+		FilterSettings.SmoothingTime = CVarOculusEyeTrackedFoveationOffsetSmoothing.GetValueOnRenderThread();
+		FilterSettings.SnapDistance = CVarOculusEyeTrackedFoveationOffsetSnapDistance.GetValueOnRenderThread();
+		FilterSettings.MaxOffset = CVarOculusEyeTrackedFoveationMaxOffset.GetValueOnRenderThread();
+
 		// Enqueue the actual update on the RHI thread, which should execute right before the EndRenderPass call
-		ExecuteOnRHIThread_DoNotWait([this, SwapChainDimensions]() {
+		ExecuteOnRHIThread_DoNotWait([this, SwapChainDimensions, FilterSettings]() {
 			SCOPED_NAMED_EVENT(UpdateFoveationEyeTracked_RHIThread, FColor::Red);
 
 			bool bUseOffsets = false;
@@ -4136,13 +4569,22 @@ namespace OculusXRHMD
 					ovrpResult Result = FOculusXRHMDModule::GetPluginWrapper().GetFoveationEyeTrackedCenter(fovCenter);
 					if (OVRP_SUCCESS(Result))
 					{
-						Offsets[0].X = fovCenter[0].x * SwapChainDimensions.X / 2;
-						Offsets[0].Y = fovCenter[0].y * SwapChainDimensions.Y / 2;
-						Offsets[1].X = fovCenter[1].x * SwapChainDimensions.X / 2;
-						Offsets[1].Y = fovCenter[1].y * SwapChainDimensions.Y / 2;
+						// Smooth the fixation jitter, which makes the foveation edges visibly swim
+						const FVector2f Centers[2] = { FVector2f(fovCenter[0].x, fovCenter[0].y), FVector2f(fovCenter[1].x, fovCenter[1].y) };
+						FVector2f FilteredCenters[2];
+						FoveationArbiter.FilterOffsets(FilterSettings, FPlatformTime::Seconds(), Centers, FilteredCenters);
+
+						Offsets[0].X = FilteredCenters[0].X * SwapChainDimensions.X / 2;
+						Offsets[0].Y = FilteredCenters[0].Y * SwapChainDimensions.Y / 2;
+						Offsets[1].X = FilteredCenters[1].X * SwapChainDimensions.X / 2;
+						Offsets[1].Y = FilteredCenters[1].Y * SwapChainDimensions.Y / 2;
 						bUseOffsets = true;
 					}
-					else if (Result != ovrpFailure_DataIsInvalid)
+					else if (Result == ovrpFailure_DataIsInvalid)
+					{
+						FoveationArbiter.ResetOffsets();
+					}
+					else
 					{
 						// Fall back to dynamic FFR High if OVRPlugin call actually fails, since we're not expecting GFR to work again.
 						// Additional rendering changes can be made by binding the changes to OculusEyeTrackingStateChanged
@@ -4531,6 +4973,13 @@ namespace OculusXRHMD
 		Result->FoveatedRenderingMethod = CVarOculusFoveatedRenderingMethod.GetValueOnAnyThread() >= 0 ? (EOculusXRFoveatedRenderingMethod)CVarOculusFoveatedRenderingMethod.GetValueOnAnyThread() : FoveatedRenderingMethod.load();
 		Result->FoveatedRenderingLevel = CVarOculusFoveatedRenderingLevel.GetValueOnAnyThread() >= 0 ? (EOculusXRFoveatedRenderingLevel)CVarOculusFoveatedRenderingLevel.GetValueOnAnyThread() : FoveatedRenderingLevel.load();
 		Result->bDynamicFoveatedRendering = CVarOculusDynamicFoveatedRendering.GetValueOnAnyThread() >= 0 ? (bool)CVarOculusDynamicFoveatedRendering.GetValueOnAnyThread() : bDynamicFoveatedRendering.load();
+		if (Result->FoveatedRenderingMethod == EOculusXRFoveatedRenderingMethod::EyeTrackedFoveatedRendering && !FoveationArbiter.IsEyeTracked())
+		{
+			// Same settings as EyeTrackedFoveatedRenderingFallback, until the gaze confidence recovered
+			Result->FoveatedRenderingMethod = EOculusXRFoveatedRenderingMethod::FixedFoveatedRendering;
+			Result->FoveatedRenderingLevel = EOculusXRFoveatedRenderingLevel::High;
+			Result->bDynamicFoveatedRendering = true;
+		}
 		Result->Flags.bSplashIsShown = Splash->IsShown();
 		return Result;
 	}
@@ -4617,6 +5066,8 @@ namespace OculusXRHMD
 				NextFrameNumber++;
 			}
 
+			LayerBudget.Update_GameThread(LayerMap);
+
 			FSettingsPtr XSettings = Settings->Clone();
 			FGameFramePtr XFrame = NextFrameToRender->Clone();
 			TArray<FLayerPtr> XLayers;
@@ -4815,7 +5266,7 @@ namespace OculusXRHMD
 				int32 FinalLayerNumber = 0;
 				for (int32 LayerIndex = 0; LayerIndex < LayerNum; LayerIndex++)
 				{
-					if (Layers[LayerIndex]->IsVisible())
+					if (Layers[LayerIndex]->IsVisible() && !Layers[LayerIndex]->IsCulledByBudget())
 					{
 						LayerSubmitPtr[FinalLayerNumber++] = Layers[LayerIndex]->UpdateLayer_RHIThread(Settings_RHIThread.Get(), Frame_RHIThread.Get(), LayerIndex);
 					}
@@ -4833,7 +5284,11 @@ namespace OculusXRHMD
 				{
 					for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); LayerIndex++)
 					{
-						Layers[LayerIndex]->IncrementSwapChainIndex_RHIThread(CustomPresent);
+						// Paused layers keep showing the last image that was copied
+						if (!Layers[LayerIndex]->IsTextureUpdatePaused())
+						{
+							Layers[LayerIndex]->IncrementSwapChainIndex_RHIThread(CustomPresent);
+						}
 					}
 				}
 			}
@@ -4952,6 +5407,48 @@ namespace OculusXRHMD
 		Ar.Logf(TEXT("vr.oculus.Debug.IPD = %f"), GetInterpupillaryDistance());
 	}
 
+	void FOculusXRHMD::LayerBudgetCommandHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		CheckInGameThread();
+
+		LayerBudget.DumpStats(Ar);
+	}
+
+	void FOculusXRHMD::SpaceWarpCommandHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		CheckInGameThread();
+
+		Ar.Logf(TEXT("r.Mobile.Oculus.SpaceWarp.Enable = %d, supported %d"), CVarOculusEnableSpaceWarpUser.GetValueOnGameThread(), CustomPresent.IsValid() && SupportsSpaceWarp());
+		SpaceWarpController.DumpStats(Ar);
+	}
+
+	void FOculusXRHMD::FoveationCommandHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		CheckInGameThread();
+
+		Ar.Logf(TEXT("Foveated rendering method %d, level %d, dynamic %d"), (int32)FoveatedRenderingMethod.load(), (int32)FoveatedRenderingLevel.load(), bDynamicFoveatedRendering.load());
+		FoveationArbiter.DumpStats(Ar);
+
+#if !UE_VERSION_OLDER_THAN(5, 3, 0)
+		// The generator lives on the render thread
+		bool bHasImageGenerator = false;
+		FOculusXRFoveatedRenderingImageGenerator::FPoolStats PoolStats;
+		ENQUEUE_RENDER_COMMAND(OculusFoveationPoolStats)
+		([this, &bHasImageGenerator, &PoolStats](FRHICommandListImmediate&) {
+			if (FoveationImageGenerator.IsValid())
+			{
+				bHasImageGenerator = true;
+				PoolStats = FoveationImageGenerator->GetPoolStats();
+			}
+		});
+		FlushRenderingCommands();
+		if (bHasImageGenerator)
+		{
+			Ar.Logf(TEXT("Shading rate images: %u created, %u reused"), PoolStats.NumCreated, PoolStats.NumReused);
+		}
+#endif // !UE_VERSION_OLDER_THAN(5, 3, 0)
+	}
+
 #endif // !UE_BUILD_SHIPPING
 
 	void FOculusXRHMD::LoadFromSettings()
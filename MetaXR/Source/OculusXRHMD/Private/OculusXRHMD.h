@@ -15,6 +15,10 @@
 #include "OculusXRHMD_SpectatorScreenController.h"
 #include "OculusXRHMD_DynamicResolutionState.h"
 #include "OculusXRHMD_DeferredDeletionQueue.h"
+#include "OculusXRHMD_LayerBudget.h"
+#include "OculusXRHMD_SpaceWarpController.h"
+#include "OculusXRHMD_FoveationArbiter.h"
+#include "OculusXRHMD_ColorTransition.h"
 
 #include "OculusXRAssetManager.h"
 
@@ -460,12 +464,21 @@ namespace OculusXRHMD
 		void SetFoveatedRenderingMethod(EOculusXRFoveatedRenderingMethod InFoveationMethod);
 		void SetFoveatedRenderingLevel(EOculusXRFoveatedRenderingLevel InFoveationLevel, bool isDynamic);
 		void SetColorScaleAndOffset(FLinearColor ColorScale, FLinearColor ColorOffset, bool bApplyToAllLayers);
+		// LayerId is a layer id or FColorTransitionController::AllLayers, 0 is the eye layer
+		void StartColorScaleAndOffsetTransition(uint32 LayerId, const FColorTransition& Transition, bool bQueue);
+		void CancelColorScaleAndOffsetTransitions(uint32 LayerId);
+		bool IsColorScaleAndOffsetTransitioning(uint32 LayerId) const;
 		void SetEnvironmentDepthHandRemoval(bool RemoveHands);
 		void StartEnvironmentDepth(int CreateFlags);
 		void StopEnvironmentDepth();
 		bool IsEnvironmentDepthStarted();
+		// Environment depth runs while at least one consumer is registered. Registrations are reference counted per name.
+		void AddEnvironmentDepthConsumer(FName Consumer);
+		void RemoveEnvironmentDepthConsumer(FName Consumer);
+		FOculusXREnvironmentDepthStats GetEnvironmentDepthStats() const;
 
 		void EnableHardOcclusions(bool bEnable);
+		void EnableSoftOcclusions(bool bEnable);
 
 		OCULUSXRHMD_API void UpdateRTPoses();
 
@@ -485,6 +498,9 @@ namespace OculusXRHMD
 		void StatsCommandHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
 		void ShowSettingsCommandHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
 		void IPDCommandHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
+		void LayerBudgetCommandHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
+		void SpaceWarpCommandHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
+		void FoveationCommandHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar);
 #endif
 
 		void LoadFromSettings();
@@ -496,9 +512,35 @@ namespace OculusXRHMD
 		EHMDWornState::Type HMDWornState = EHMDWornState::Unknown;
 
 		void UpdateHMDEvents();
+		void UpdateInputFocus();
 
 		void EnableInsightPassthrough_RenderThread(bool bEnablePassthrough);
 
+		enum class EEnvironmentDepthState : uint8
+		{
+			Stopped,
+			Running,
+			// The runtime doesn't produce depth, but the swapchain is kept for a quick restart
+			Suspended,
+		};
+
+		void UpdateEnvironmentDepth_GameThread(float DeltaTime);
+		void UpdateSpaceWarp_GameThread(float DeltaTime);
+		void UpdateFoveationArbiter_GameThread(float DeltaTime);
+		void UpdateColorTransitions_GameThread(float DeltaTime);
+		void ApplyColorTransitions_GameThread();
+		void CreateEnvironmentDepth(int CreateFlags);
+		void DestroyEnvironmentDepth();
+		void SuspendEnvironmentDepth();
+		void ResumeEnvironmentDepth();
+
+		TMap<FName, int32> EnvironmentDepthConsumers;
+		EEnvironmentDepthState EnvironmentDepthState;
+		int EnvironmentDepthCreateFlags;
+		float EnvironmentDepthIdleTime;
+		FOculusXREnvironmentDepthStats EnvironmentDepthStats;
+		bool bSoftOcclusionsEnabled;
+
 		void DrawHmdViewMesh(
 			FRHICommandList& RHICmdList,
 			float X,
@@ -545,6 +587,10 @@ namespace OculusXRHMD
 				uint64 DisplayLostDetected : 1;
 				// set to true once new session is created; being handled and reset as soon as session->IsVisible.
 				uint64 NeedSetFocusToGameViewport : 1;
+				// set while the app doesn't have input focus, e.g. while the universal menu is open
+				uint64 AppLostInputFocus : 1;
+				// set while a system overlay is present
+				uint64 SystemOverlayPresent : 1;
 			};
 			uint64 Raw;
 		} OCFlags;
@@ -587,6 +633,11 @@ namespace OculusXRHMD
 		FGameFramePtr LastFrameToRender; // Valid from OnStartGameFrame to BeginRenderViewFamily
 		uint32 NextLayerId;
 		TMap<uint32, FLayerPtr> LayerMap;
+		FLayerBudget LayerBudget;
+		FSpaceWarpController SpaceWarpController;
+		// The mode is game thread only, the offset filter RHI thread only
+		FFoveationArbiter FoveationArbiter;
+		FColorTransitionController ColorTransitions;
 		bool bNeedReAllocateViewportRenderTarget;
 
 		// Render thread
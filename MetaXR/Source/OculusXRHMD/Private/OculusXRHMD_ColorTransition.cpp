@@ -0,0 +1,171 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OculusXRHMD_ColorTransition.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+#include "Curves/CurveFloat.h"
+
+namespace OculusXRHMD
+{
+
+	//-------------------------------------------------------------------------------------------------
+	// FColorScaleAndOffset
+	//-------------------------------------------------------------------------------------------------
+
+	FColorScaleAndOffset FColorScaleAndOffset::Lerp(const FColorScaleAndOffset& A, const FColorScaleAndOffset& B, float Alpha)
+	{
+		// Not clamped, custom curves may overshoot
+		return FColorScaleAndOffset{ A.Scale + (B.Scale - A.Scale) * Alpha, A.Offset + (B.Offset - A.Offset) * Alpha };
+	}
+
+	FColorScaleAndOffset FColorScaleAndOffset::Compose(const FColorScaleAndOffset& Inner, const FColorScaleAndOffset& Outer)
+	{
+		// (Color * InnerScale + InnerOffset) * OuterScale + OuterOffset
+		return FColorScaleAndOffset{ Inner.Scale * Outer.Scale, Inner.Offset * Outer.Scale + Outer.Offset };
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// FColorTransitionController
+	//-------------------------------------------------------------------------------------------------
+
+	float FColorTransitionController::EvaluateCurve(const FColorTransition& Transition, float Alpha)
+	{
+		Alpha = FMath::Clamp(Alpha, 0.0f, 1.0f);
+		if (const UCurveFloat* CustomCurve = Transition.CustomCurve.Get())
+		{
+			return CustomCurve->GetFloatValue(Alpha);
+		}
+
+		switch (Transition.Curve)
+		{
+			case EOculusXRColorTransitionCurve::EaseIn:
+				return FMath::InterpEaseIn(0.0f, 1.0f, Alpha, 2.0f);
+			case EOculusXRColorTransitionCurve::EaseOut:
+				return FMath::InterpEaseOut(0.0f, 1.0f, Alpha, 2.0f);
+			case EOculusXRColorTransitionCurve::EaseInOut:
+				return FMath::InterpEaseInOut(0.0f, 1.0f, Alpha, 2.0f);
+			default:
+				return Alpha;
+		}
+	}
+
+	void FColorTransitionController::Set(uint32 LayerId, const FColorScaleAndOffset& Value)
+	{
+		FChannel& Channel = GetChannel(LayerId);
+		Channel.Queue.Reset();
+		Channel.Value = Value;
+	}
+
+	void FColorTransitionController::AddTransition(uint32 LayerId, const FColorTransition& Transition, bool bQueue)
+	{
+		FChannel& Channel = GetChannel(LayerId);
+		if (!bQueue || Channel.Queue.IsEmpty())
+		{
+			Channel.Queue.Reset();
+			Channel.StartValue = Channel.Value;
+			Channel.Elapsed = 0.0f;
+		}
+
+		FColorTransition& Added = Channel.Queue.Add_GetRef(Transition);
+		Added.Duration = FMath::Max(Added.Duration, 0.0f);
+	}
+
+	void FColorTransitionController::Cancel(uint32 LayerId)
+	{
+		if (LayerId == AllLayers)
+		{
+			AllLayersChannel.Queue.Reset();
+		}
+		else if (FChannel* Channel = LayerChannels.Find(LayerId))
+		{
+			Channel->Queue.Reset();
+		}
+	}
+
+	void FColorTransitionController::RemoveLayer(uint32 LayerId)
+	{
+		LayerChannels.Remove(LayerId);
+	}
+
+	void FColorTransitionController::Reset()
+	{
+		AllLayersChannel = FChannel();
+		LayerChannels.Reset();
+	}
+
+	void FColorTransitionController::Update(float DeltaTime)
+	{
+		AllLayersChannel.Update(DeltaTime);
+		for (auto It = LayerChannels.CreateIterator(); It; ++It)
+		{
+			It->Value.Update(DeltaTime);
+
+			// Finished fades back to the identity don't need to be passed to the compositor anymore
+			if (It->Value.Queue.IsEmpty() && It->Value.Value.IsIdentity())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	FColorScaleAndOffset FColorTransitionController::GetValue(uint32 LayerId) const
+	{
+		const FChannel* Channel = FindChannel(LayerId);
+		return Channel ? Channel->Value : FColorScaleAndOffset();
+	}
+
+	bool FColorTransitionController::IsTransitioning(uint32 LayerId) const
+	{
+		const FChannel* Channel = FindChannel(LayerId);
+		return Channel && !Channel->Queue.IsEmpty();
+	}
+
+	void FColorTransitionController::GetLayerValues(TMap<uint32, FColorScaleAndOffset>& OutValues) const
+	{
+		OutValues.Reset();
+		for (const auto& Pair : LayerChannels)
+		{
+			if (!Pair.Value.Value.IsIdentity())
+			{
+				OutValues.Add(Pair.Key, Pair.Value.Value);
+			}
+		}
+	}
+
+	void FColorTransitionController::FChannel::Update(float DeltaTime)
+	{
+		float Remaining = FMath::Max(DeltaTime, 0.0f);
+		while (!Queue.IsEmpty())
+		{
+			const FColorTransition& Transition = Queue[0];
+			const float TimeLeft = Transition.Duration - Elapsed;
+			if (Remaining < TimeLeft)
+			{
+				Elapsed += Remaining;
+				Value = FColorScaleAndOffset::Lerp(StartValue, Transition.Target, EvaluateCurve(Transition, Elapsed / Transition.Duration));
+				return;
+			}
+
+			// Lands exactly on the target, the next transition starts from there with the time that is left
+			Remaining -= TimeLeft;
+			Value = Transition.Target;
+			StartValue = Value;
+			Elapsed = 0.0f;
+			Queue.RemoveAt(0);
+		}
+	}
+
+	FColorTransitionController::FChannel& FColorTransitionController::GetChannel(uint32 LayerId)
+	{
+		return LayerId == AllLayers ? AllLayersChannel : LayerChannels.FindOrAdd(LayerId);
+	}
+
+	const FColorTransitionController::FChannel* FColorTransitionController::FindChannel(uint32 LayerId) const
+	{
+		return LayerId == AllLayers ? &AllLayersChannel : LayerChannels.Find(LayerId);
+	}
+
+} // namespace OculusXRHMD
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
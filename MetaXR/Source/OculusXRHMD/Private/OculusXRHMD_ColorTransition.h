@@ -0,0 +1,107 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "OculusXRHMDPrivate.h"
+#include "OculusXRHMDTypes.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+
+class UCurveFloat;
+
+namespace OculusXRHMD
+{
+
+	//-------------------------------------------------------------------------------------------------
+	// FColorScaleAndOffset
+	//-------------------------------------------------------------------------------------------------
+
+	// Color scale and offset the compositor applies to a layer: Color * Scale + Offset
+	struct FColorScaleAndOffset
+	{
+		FLinearColor Scale = FLinearColor::White;
+		FLinearColor Offset = FLinearColor::Transparent;
+
+		bool operator==(const FColorScaleAndOffset& Other) const { return Scale == Other.Scale && Offset == Other.Offset; }
+		bool operator!=(const FColorScaleAndOffset& Other) const { return !(*this == Other); }
+
+		bool IsIdentity() const { return *this == FColorScaleAndOffset(); }
+
+		static FColorScaleAndOffset Lerp(const FColorScaleAndOffset& A, const FColorScaleAndOffset& B, float Alpha);
+
+		// Applies Inner first and Outer to the result of Inner
+		static FColorScaleAndOffset Compose(const FColorScaleAndOffset& Inner, const FColorScaleAndOffset& Outer);
+	};
+
+	//-------------------------------------------------------------------------------------------------
+	// FColorTransitionController
+	//-------------------------------------------------------------------------------------------------
+
+	struct FColorTransition
+	{
+		FColorScaleAndOffset Target;
+		// Seconds, transitions without a duration jump to the target on the next update
+		float Duration = 0.0f;
+		EOculusXRColorTransitionCurve Curve = EOculusXRColorTransitionCurve::Linear;
+		// Evaluated over the normalized time in range [0,1] instead of Curve if set, may overshoot
+		TWeakObjectPtr<UCurveFloat> CustomCurve;
+	};
+
+	// Animates the color scale and offset of the layers for fades and tints, so they cost nothing on the GPU.
+	// There is one channel for all layers and one per layer, the layer channel is applied first and the all layers
+	// channel on top, e.g. a tinted layer still fades to black with the rest of the view. Every channel plays its
+	// queue of transitions one after the other, the time left over by a finished transition goes to the next one.
+	// Updated once per frame on the game thread, the values are passed to the compositor through FSettings.
+	class FColorTransitionController
+	{
+	public:
+		// Id of the channel applied to all layers, other ids are layer ids and 0 is the eye layer
+		static constexpr uint32 AllLayers = MAX_uint32;
+
+		static float EvaluateCurve(const FColorTransition& Transition, float Alpha);
+
+		// Jumps to the value and drops the queued transitions of the channel
+		void Set(uint32 LayerId, const FColorScaleAndOffset& Value);
+
+		// Queues the transition after the ones of the channel if bQueue is set, otherwise replaces them and starts
+		// from the current value
+		void AddTransition(uint32 LayerId, const FColorTransition& Transition, bool bQueue);
+
+		// Drops the queued transitions of the channel, which keeps its current value
+		void Cancel(uint32 LayerId);
+
+		// Forgets the channel of a destroyed layer
+		void RemoveLayer(uint32 LayerId);
+
+		void Reset();
+
+		void Update(float DeltaTime);
+
+		FColorScaleAndOffset GetValue(uint32 LayerId) const;
+		bool IsTransitioning(uint32 LayerId) const;
+
+		// Values of all layer channels that are not the identity
+		void GetLayerValues(TMap<uint32, FColorScaleAndOffset>& OutValues) const;
+
+	private:
+		struct FChannel
+		{
+			FColorScaleAndOffset Value;
+			// Value when the first queued transition started
+			FColorScaleAndOffset StartValue;
+			float Elapsed = 0.0f;
+			TArray<FColorTransition> Queue;
+
+			void Update(float DeltaTime);
+		};
+
+		FChannel& GetChannel(uint32 LayerId);
+		const FChannel* FindChannel(uint32 LayerId) const;
+
+		FChannel AllLayersChannel;
+		TMap<uint32, FChannel> LayerChannels;
+	};
+
+} // namespace OculusXRHMD
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
@@ -51,6 +51,15 @@ namespace OculusXRHMD
 		, IPDCommand(TEXT("vr.oculus.Debug.IPD"),
 			  *NSLOCTEXT("OculusRift", "CCommandText_IPD", "Oculus Rift specific extension.\nShows or changes the current interpupillary distance in meters.").ToString(),
 			  FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateRaw(InHMDPtr, &FOculusXRHMD::IPDCommandHandler))
+		, LayerBudgetCommand(TEXT("vr.oculus.Debug.LayerBudget"),
+			  *NSLOCTEXT("OculusRift", "CCommandText_LayerBudget", "Oculus Rift specific extension.\nShows the stereo layers that were demoted by the layer budget and why.").ToString(),
+			  FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateRaw(InHMDPtr, &FOculusXRHMD::LayerBudgetCommandHandler))
+		, SpaceWarpCommand(TEXT("vr.oculus.Debug.SpaceWarp"),
+			  *NSLOCTEXT("OculusRift", "CCommandText_SpaceWarp", "Oculus Rift specific extension.\nShows the state of Application SpaceWarp and the frame time headroom of the automatic mode.").ToString(),
+			  FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateRaw(InHMDPtr, &FOculusXRHMD::SpaceWarpCommandHandler))
+		, FoveationCommand(TEXT("vr.oculus.Debug.Foveation"),
+			  *NSLOCTEXT("OculusRift", "CCommandText_Foveation", "Oculus Rift specific extension.\nShows the foveated rendering settings and how long eye tracked foveation fell back to fixed foveation because of a low gaze confidence.").ToString(),
+			  FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateRaw(InHMDPtr, &FOculusXRHMD::FoveationCommandHandler))
 #endif // !UE_BUILD_SHIPPING
 	{
 	}
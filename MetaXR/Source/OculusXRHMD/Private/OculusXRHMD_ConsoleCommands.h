@@ -37,6 +37,9 @@ namespace OculusXRHMD
 		FAutoConsoleCommand CubemapCommand;
 		FAutoConsoleCommand ShowSettingsCommand;
 		FAutoConsoleCommand IPDCommand;
+		FAutoConsoleCommand LayerBudgetCommand;
+		FAutoConsoleCommand SpaceWarpCommand;
+		FAutoConsoleCommand FoveationCommand;
 #endif // !UE_BUILD_SHIPPING
 	};
 
@@ -11,6 +11,9 @@ FOculusXRFoveatedRenderingImageGenerator::FOculusXRFoveatedRenderingImageGenerat
 	: FoveationSwapchain(Swapchain)
 {
 	GVRSImageManager.RegisterExternalImageGenerator(this);
+
+	// Wrap the texture right away, so rendering doesn't have to allocate anything
+	FindOrAddPooledImage();
 }
 
 FOculusXRFoveatedRenderingImageGenerator::~FOculusXRFoveatedRenderingImageGenerator()
@@ -19,21 +22,52 @@ FOculusXRFoveatedRenderingImageGenerator::~FOculusXRFoveatedRenderingImageGenera
 }
 
 FRDGTextureRef FOculusXRFoveatedRenderingImageGenerator::GetImage(FRDGBuilder& GraphBuilder, const FViewInfo& ViewInfo, FVariableRateShadingImageManager::EVRSImageType ImageType, bool bGetSoftwareImage)
+{
+	if (const TRefCountPtr<IPooledRenderTarget>* PooledRenderTarget = FindOrAddPooledImage())
+	{
+		return GraphBuilder.RegisterExternalTexture(*PooledRenderTarget, ERDGTextureFlags::SkipTracking);
+	}
+	return nullptr;
+}
+
+const TRefCountPtr<IPooledRenderTarget>* FOculusXRFoveatedRenderingImageGenerator::FindOrAddPooledImage()
 {
 	if (!FoveationSwapchain.IsValid())
 	{
 		return nullptr;
 	}
 
-	FTexture2DRHIRef SwapchainTexture = FoveationSwapchain->GetTexture2DArray() ? FoveationSwapchain->GetTexture2DArray() : FoveationSwapchain->GetTexture2D();
-	FIntPoint TexSize = SwapchainTexture->GetSizeXY();
-	// Only set texture and return true if we have a valid texture of compatible size
-	if (SwapchainTexture->IsValid() && TexSize.X > 0 && TexSize.Y > 0)
+	FRHITexture* SwapchainTexture = FoveationSwapchain->GetTexture2DArray() ? FoveationSwapchain->GetTexture2DArray() : FoveationSwapchain->GetTexture2D();
+	if (!SwapchainTexture)
 	{
-		TRefCountPtr<IPooledRenderTarget> PooledRenderTarget = CreateRenderTarget(SwapchainTexture, *SwapchainTexture->GetName().ToString());
-		return GraphBuilder.RegisterExternalTexture(PooledRenderTarget, *SwapchainTexture->GetName().ToString(), ERDGTextureFlags::SkipTracking);
+		return nullptr;
 	}
-	return nullptr;
+
+	// The swapchain hands out the texture of its current image, so the pool is keyed by texture
+	for (const FPooledImage& PooledImage : PooledImages)
+	{
+		if (PooledImage.Texture == SwapchainTexture)
+		{
+			++PoolStats.NumReused;
+			return &PooledImage.RenderTarget;
+		}
+	}
+
+	// Only use textures of compatible size
+	const FIntPoint TexSize = SwapchainTexture->GetSizeXY();
+	if (!SwapchainTexture->IsValid() || TexSize.X <= 0 || TexSize.Y <= 0)
+	{
+		return nullptr;
+	}
+
+	FPooledImage& PooledImage = PooledImages.AddDefaulted_GetRef();
+	PooledImage.Texture = SwapchainTexture;
+	// The pooled render target keeps the name pointer, so the name has to live as long as the pool entry
+	PooledImage.Name = SwapchainTexture->GetName().ToString();
+	PooledImage.RenderTarget = CreateRenderTarget(SwapchainTexture, *PooledImage.Name);
+	++PoolStats.NumCreated;
+	UE_LOG(LogHMD, Verbose, TEXT("Created pooled foveation image %d for %s (%d x %d)"), PooledImages.Num() - 1, *PooledImage.Name, TexSize.X, TexSize.Y);
+	return &PooledImage.RenderTarget;
 }
 
 void FOculusXRFoveatedRenderingImageGenerator::PrepareImages(FRDGBuilder& GraphBuilder, const FSceneViewFamily& ViewFamily, const FMinimalSceneTextures& SceneTextures, bool bPrepareHardwareImages, bool bPrepareSoftwareImages)
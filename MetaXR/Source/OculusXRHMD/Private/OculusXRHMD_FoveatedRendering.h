@@ -5,13 +5,21 @@
 
 #include "Misc/EngineVersionComparison.h"
 
-#if !UE_VERSION_OLDER_THAN(5, 4, 0)
+#if !UE_VERSION_OLDER_THAN(5, 3, 0)
 #include "VariableRateShadingImageManager.h"
 #include "XRSwapchain.h"
 
 class FOculusXRFoveatedRenderingImageGenerator : public IVariableRateShadingImageGenerator
 {
 public:
+	struct FPoolStats
+	{
+		// Pooled render targets created for swapchain textures
+		uint32 NumCreated = 0;
+		// Requests served by an existing pooled render target
+		uint32 NumReused = 0;
+	};
+
 	FOculusXRFoveatedRenderingImageGenerator(const FXRSwapChainPtr& Swapchain);
 	virtual ~FOculusXRFoveatedRenderingImageGenerator() override;
 
@@ -25,7 +33,25 @@ public:
 		return FVariableRateShadingImageManager::EVRSSourceType::FixedFoveation;
 	}
 
+	const FXRSwapChainPtr& GetSwapchain() const { return FoveationSwapchain; }
+
+	// Returns the pooled render target wrapping the current swapchain texture, nullptr if the swapchain has no usable texture.
+	// The pooled render target is created the first time a swapchain texture is seen and looked up afterwards.
+	const TRefCountPtr<IPooledRenderTarget>* FindOrAddPooledImage();
+
+	const FPoolStats& GetPoolStats() const { return PoolStats; }
+
 private:
-	const FXRSwapChainPtr& FoveationSwapchain;
+	struct FPooledImage
+	{
+		FRHITexture* Texture;
+		FString Name;
+		TRefCountPtr<IPooledRenderTarget> RenderTarget;
+	};
+
+	FXRSwapChainPtr FoveationSwapchain;
+	// One entry per texture the swapchain handed out, which is one per swapchain image at most
+	TArray<FPooledImage, TInlineAllocator<3>> PooledImages;
+	FPoolStats PoolStats;
 };
 #endif // !UE_VERSION_OLDER_THAN(5, 3, 0)
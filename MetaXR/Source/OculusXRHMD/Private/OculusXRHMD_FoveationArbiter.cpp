@@ -0,0 +1,184 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OculusXRHMD_FoveationArbiter.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+#include "OculusXRHMDModule.h"
+
+namespace OculusXRHMD
+{
+
+	//-------------------------------------------------------------------------------------------------
+	// FOvrpFoveationGazeSource
+	//-------------------------------------------------------------------------------------------------
+
+	bool FOvrpFoveationGazeSource::Start()
+	{
+		ovrpBool IsEnabled = ovrpBool_False;
+		if (OVRP_SUCCESS(FOculusXRHMDModule::GetPluginWrapper().GetEyeTrackingEnabled(&IsEnabled)) && IsEnabled == ovrpBool_True)
+		{
+			return true;
+		}
+
+		bStartedEyeTracking = OVRP_SUCCESS(FOculusXRHMDModule::GetPluginWrapper().StartEyeTracking());
+		return bStartedEyeTracking;
+	}
+
+	void FOvrpFoveationGazeSource::Stop()
+	{
+		if (bStartedEyeTracking)
+		{
+			FOculusXRHMDModule::GetPluginWrapper().StopEyeTracking();
+			bStartedEyeTracking = false;
+		}
+	}
+
+	bool FOvrpFoveationGazeSource::GetGazeSample(FFoveationGazeSample& OutSample)
+	{
+		ovrpEyeGazesState OVREyeGazesState;
+		if (OVRP_FAILURE(FOculusXRHMDModule::GetPluginWrapper().GetEyeGazesState(ovrpStep_Render, OVRP_CURRENT_FRAMEINDEX, &OVREyeGazesState)))
+		{
+			return false;
+		}
+
+		const ovrpEyeGazeState& LeftEyeGaze = OVREyeGazesState.EyeGazes[ovrpEye_Left];
+		const ovrpEyeGazeState& RightEyeGaze = OVREyeGazesState.EyeGazes[ovrpEye_Right];
+		OutSample.bIsValid = LeftEyeGaze.IsValid == ovrpBool_True && RightEyeGaze.IsValid == ovrpBool_True;
+		OutSample.Confidence = FMath::Min(LeftEyeGaze.Confidence, RightEyeGaze.Confidence);
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// FFoveationArbiter
+	//-------------------------------------------------------------------------------------------------
+
+	FFoveationArbiter::FFoveationArbiter(TSharedPtr<IFoveationGazeSource> InGazeSource)
+		: bEyeTracked(true)
+		, PendingTime(0.0f)
+		, bGazeSourceStarted(false)
+		, bLoggedGazeSourceStartFailure(false)
+		, bHasFilteredCenters(false)
+		, LastFilterTime(0.0)
+	{
+		SetGazeSource(InGazeSource);
+	}
+
+	void FFoveationArbiter::SetGazeSource(TSharedPtr<IFoveationGazeSource> InGazeSource)
+	{
+		if (bGazeSourceStarted)
+		{
+			GazeSource->Stop();
+			bGazeSourceStarted = false;
+		}
+		GazeSource = InGazeSource.IsValid() ? InGazeSource : MakeShared<FOvrpFoveationGazeSource>();
+	}
+
+	bool FFoveationArbiter::Update(float DeltaTime)
+	{
+		Stats.CurrentDwellTime += DeltaTime;
+		if (bEyeTracked)
+		{
+			Stats.EyeTrackedTime += DeltaTime;
+		}
+		else
+		{
+			Stats.FixedTime += DeltaTime;
+			Stats.LongestFixedDwellTime = FMath::Max(Stats.LongestFixedDwellTime, Stats.CurrentDwellTime);
+		}
+
+		if (!bGazeSourceStarted)
+		{
+			bGazeSourceStarted = true;
+			if (!GazeSource->Start() && !bLoggedGazeSourceStartFailure)
+			{
+				UE_LOG(LogHMD, Warning, TEXT("Eye tracked foveation confidence gating is inactive, the eye tracker couldn't be started"));
+				bLoggedGazeSourceStartFailure = true;
+			}
+		}
+
+		// Keep the mode while the eye gazes aren't available at all, e.g. while the eye tracker isn't started
+		FFoveationGazeSample Sample;
+		if (!GazeSource->GetGazeSample(Sample))
+		{
+			PendingTime = 0.0f;
+			return bEyeTracked;
+		}
+
+		const float Confidence = Sample.bIsValid ? Sample.Confidence : 0.0f;
+		const bool bPastThreshold = bEyeTracked ? Confidence < ModeSettings.DegradeConfidence : Confidence >= ModeSettings.RestoreConfidence;
+		if (!bPastThreshold)
+		{
+			PendingTime = 0.0f;
+			return bEyeTracked;
+		}
+
+		PendingTime += DeltaTime;
+		if (PendingTime < (bEyeTracked ? ModeSettings.DegradeDelay : ModeSettings.RestoreDelay))
+		{
+			return bEyeTracked;
+		}
+
+		UE_LOG(LogHMD, Log, TEXT("Eye tracked foveation %s after %.2f s, gaze confidence %.2f"), bEyeTracked ? TEXT("degraded to fixed foveation") : TEXT("restored"), Stats.CurrentDwellTime, Confidence);
+		bEyeTracked = !bEyeTracked;
+		if (bEyeTracked)
+		{
+			++Stats.NumRestores;
+		}
+		else
+		{
+			++Stats.NumDegrades;
+		}
+		Stats.CurrentDwellTime = 0.0f;
+		PendingTime = 0.0f;
+		return bEyeTracked;
+	}
+
+	void FFoveationArbiter::Reset()
+	{
+		if (bGazeSourceStarted)
+		{
+			GazeSource->Stop();
+			bGazeSourceStarted = false;
+		}
+		bEyeTracked = true;
+		PendingTime = 0.0f;
+		Stats.CurrentDwellTime = 0.0f;
+	}
+
+	void FFoveationArbiter::DumpStats(FOutputDevice& Ar) const
+	{
+		Ar.Logf(TEXT("Foveation %s for %.1f s"), bEyeTracked ? TEXT("eye tracked") : TEXT("fixed (degraded)"), Stats.CurrentDwellTime);
+		Ar.Logf(TEXT("  eye tracked %.1f s, fixed %.1f s, longest fixed %.1f s"), Stats.EyeTrackedTime, Stats.FixedTime, Stats.LongestFixedDwellTime);
+		Ar.Logf(TEXT("  %d degrades, %d restores"), Stats.NumDegrades, Stats.NumRestores);
+	}
+
+	void FFoveationArbiter::FilterOffsets(const FOffsetFilterSettings& FilterSettings, double Time, const FVector2f InCenters[2], FVector2f OutCenters[2])
+	{
+		const float DeltaTime = bHasFilteredCenters ? static_cast<float>(FMath::Max(Time - LastFilterTime, 0.0)) : 0.0f;
+		const float Alpha = FilterSettings.SmoothingTime > 0.0f ? 1.0f - FMath::Exp(-DeltaTime / FilterSettings.SmoothingTime) : 1.0f;
+
+		for (int32 Eye = 0; Eye < 2; ++Eye)
+		{
+			const FVector2f Center = FVector2f(
+				FMath::Clamp(InCenters[Eye].X, -FilterSettings.MaxOffset, FilterSettings.MaxOffset),
+				FMath::Clamp(InCenters[Eye].Y, -FilterSettings.MaxOffset, FilterSettings.MaxOffset));
+
+			if (!bHasFilteredCenters || FVector2f::Distance(Center, FilteredCenters[Eye]) > FilterSettings.SnapDistance)
+			{
+				FilteredCenters[Eye] = Center;
+			}
+			else
+			{
+				FilteredCenters[Eye] = FMath::Lerp(FilteredCenters[Eye], Center, Alpha);
+			}
+			OutCenters[Eye] = FilteredCenters[Eye];
+		}
+
+		bHasFilteredCenters = true;
+		LastFilterTime = Time;
+	}
+
+} // namespace OculusXRHMD
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
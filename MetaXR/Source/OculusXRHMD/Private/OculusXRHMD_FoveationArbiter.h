@@ -0,0 +1,145 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "OculusXRHMDPrivate.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+
+namespace OculusXRHMD
+{
+
+	//-------------------------------------------------------------------------------------------------
+	// IFoveationGazeSource
+	//-------------------------------------------------------------------------------------------------
+
+	struct FFoveationGazeSample
+	{
+		// Whether both eyes are tracked
+		bool bIsValid = false;
+		// Lower confidence of both eyes, in range [0,1]
+		float Confidence = 0.0f;
+	};
+
+	// Provides the gaze samples to FFoveationArbiter, can be replaced by recorded traces in tests
+	class IFoveationGazeSource
+	{
+	public:
+		virtual ~IFoveationGazeSource() {}
+
+		// Called before the first sample is read, returns false if the source can't produce samples
+		virtual bool Start() { return true; }
+		// Called when no more samples are needed
+		virtual void Stop() {}
+
+		// Returns false if no sample is available for this frame
+		virtual bool GetGazeSample(FFoveationGazeSample& OutSample) = 0;
+	};
+
+	// Reads the eye gazes from OVRPlugin, same as FOculusXREyeTracker. Starts the eye tracker unless it already runs,
+	// e.g. for an eye tracking component, and only stops it if it was started here.
+	class FOvrpFoveationGazeSource : public IFoveationGazeSource
+	{
+	public:
+		virtual bool Start() override;
+		virtual void Stop() override;
+		virtual bool GetGazeSample(FFoveationGazeSample& OutSample) override;
+
+	private:
+		bool bStartedEyeTracking = false;
+	};
+
+	//-------------------------------------------------------------------------------------------------
+	// FFoveationArbiter
+	//-------------------------------------------------------------------------------------------------
+
+	// Decides between eye tracked and fixed foveated rendering while the app asks for eye tracked foveation.
+	// Eye tracked foveation degrades to fixed once the gaze confidence stayed low for a while, e.g. when the
+	// headset slipped, and is restored once the confidence stayed high for a longer while, so the foveation
+	// doesn't flip back and forth. The mode is decided on the game thread.
+	//
+	// The per eye foveation centers are filtered on the RHI thread: small movements (fixation jitter) are smoothed,
+	// large movements (saccades) snap right away, and the centers are clamped to a maximum offset.
+	class FFoveationArbiter
+	{
+	public:
+		struct FModeSettings
+		{
+			// Eye tracked foveation degrades while the confidence is below this value
+			float DegradeConfidence = 0.5f;
+			// Eye tracked foveation is restored while the confidence is at or above this value
+			float RestoreConfidence = 0.75f;
+			// Seconds the confidence has to stay low before degrading
+			float DegradeDelay = 0.2f;
+			// Seconds the confidence has to stay high before restoring
+			float RestoreDelay = 1.0f;
+		};
+
+		struct FOffsetFilterSettings
+		{
+			// Time constant of the smoothing in seconds, 0 disables the smoothing
+			float SmoothingTime = 0.08f;
+			// Movements larger than this, in normalized eye buffer units, snap without smoothing
+			float SnapDistance = 0.15f;
+			// Centers are clamped to this offset from the eye buffer center, in normalized units
+			float MaxOffset = 0.9f;
+		};
+
+		struct FStats
+		{
+			// Total seconds spent per mode
+			double EyeTrackedTime = 0.0;
+			double FixedTime = 0.0;
+			// Seconds since the last mode change
+			float CurrentDwellTime = 0.0f;
+			// Longest continuous time in fixed foveation after a degrade
+			float LongestFixedDwellTime = 0.0f;
+			int32 NumDegrades = 0;
+			int32 NumRestores = 0;
+		};
+
+		// Uses the OVRPlugin gaze source if none is given
+		explicit FFoveationArbiter(TSharedPtr<IFoveationGazeSource> InGazeSource = nullptr);
+
+		void SetGazeSource(TSharedPtr<IFoveationGazeSource> InGazeSource);
+		void SetModeSettings(const FModeSettings& InSettings) { ModeSettings = InSettings; }
+		const FModeSettings& GetModeSettings() const { return ModeSettings; }
+
+		// Samples the gaze source and returns whether eye tracked foveation should be used. Game thread.
+		bool Update(float DeltaTime);
+
+		// Goes back to eye tracked foveation and stops the gaze source, e.g. when the app switches the foveation
+		// method. Game thread.
+		void Reset();
+
+		bool IsEyeTracked() const { return bEyeTracked; }
+		const FStats& GetStats() const { return Stats; }
+		void DumpStats(FOutputDevice& Ar) const;
+
+		// Filters the normalized per eye foveation centers of the frame. RHI thread.
+		void FilterOffsets(const FOffsetFilterSettings& FilterSettings, double Time, const FVector2f InCenters[2], FVector2f OutCenters[2]);
+
+		// Drops the filter state, the next centers are used as they are. RHI thread.
+		void ResetOffsets() { bHasFilteredCenters = false; }
+
+	private:
+		// Game thread
+		TSharedPtr<IFoveationGazeSource> GazeSource;
+		FModeSettings ModeSettings;
+		FStats Stats;
+		bool bEyeTracked;
+		float PendingTime;
+		// Whether the gaze source was started since the last reset
+		bool bGazeSourceStarted;
+		// Whether the gaze source failed to start, only logged once
+		bool bLoggedGazeSourceStartFailure;
+
+		// RHI thread
+		bool bHasFilteredCenters;
+		double LastFilterTime;
+		FVector2f FilteredCenters[2];
+	};
+
+} // namespace OculusXRHMD
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
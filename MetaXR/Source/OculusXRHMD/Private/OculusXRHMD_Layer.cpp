@@ -62,6 +62,7 @@ namespace OculusXRHMD
 		, bInvertY(false)
 		, bHasDepth(false)
 		, bSupportDepthComposite(false)
+		, BudgetDemotion(ELayerBudgetDemotion::None)
 		, PokeAHoleComponentPtr(nullptr)
 		, PokeAHoleActor(nullptr)
 	{
@@ -87,6 +88,7 @@ namespace OculusXRHMD
 		, bInvertY(Layer.bInvertY)
 		, bHasDepth(Layer.bHasDepth)
 		, bSupportDepthComposite(Layer.bSupportDepthComposite)
+		, BudgetDemotion(Layer.BudgetDemotion)
 		, PokeAHoleComponentPtr(Layer.PokeAHoleComponentPtr)
 		, PokeAHoleActor(Layer.PokeAHoleActor)
 		, UserDefinedGeometryMap(Layer.UserDefinedGeometryMap)
@@ -849,9 +851,14 @@ namespace OculusXRHMD
 			}
 		}
 
-		if ((Desc.Flags & IStereoLayers::LAYER_FLAG_TEX_CONTINUOUS_UPDATE) && Desc.Texture.IsValid() && IsVisible())
+		if ((Desc.Flags & IStereoLayers::LAYER_FLAG_TEX_CONTINUOUS_UPDATE) && Desc.Texture.IsValid() && IsVisible() && !IsCulledByBudget())
 		{
-			bUpdateTexture = true;
+			// The first frame of a pause still gets copied, the swap chain index is frozen on that image afterwards
+			const bool bWasPaused = InLayer && InLayer->IsTextureUpdatePaused() && CanReuseResources(InLayer);
+			if (!IsTextureUpdatePaused() || !bWasPaused)
+			{
+				bUpdateTexture = true;
+			}
 		}
 
 		return true;
@@ -1133,9 +1140,10 @@ namespace OculusXRHMD
 		OvrpLayerSubmit.LayerId = OvrpLayerId;
 		OvrpLayerSubmit.TextureStage = SwapChain.IsValid() ? SwapChain->GetSwapChainIndex_RHIThread() : 0;
 
-		bool injectColorScale = Id == 0 || Settings->bApplyColorScaleAndOffsetToAllLayers;
-		OvrpLayerSubmit.ColorOffset = injectColorScale ? Settings->ColorOffset : ovrpVector4f{ 0, 0, 0, 0 };
-		OvrpLayerSubmit.ColorScale = injectColorScale ? Settings->ColorScale : ovrpVector4f{ 1, 1, 1, 1 };
+		const FColorScaleAndOffset* LayerColorScaleAndOffset = Settings->LayerColorScaleAndOffset.Find(Id);
+		const FColorScaleAndOffset ColorScaleAndOffset = LayerColorScaleAndOffset ? FColorScaleAndOffset::Compose(*LayerColorScaleAndOffset, Settings->ColorScaleAndOffset) : Settings->ColorScaleAndOffset;
+		OvrpLayerSubmit.ColorOffset = LinearColorToOvrpVector4f(ColorScaleAndOffset.Offset);
+		OvrpLayerSubmit.ColorScale = LinearColorToOvrpVector4f(ColorScaleAndOffset.Scale);
 
 		if (OvrpLayerDesc.Shape == ovrpShape_Equirect)
 		{
@@ -33,6 +33,19 @@ namespace OculusXRHMD
 
 	typedef TSharedPtr<FOvrpLayer, ESPMode::ThreadSafe> FOvrpLayerPtr;
 
+	//-------------------------------------------------------------------------------------------------
+	// ELayerBudgetDemotion
+	//-------------------------------------------------------------------------------------------------
+
+	enum class ELayerBudgetDemotion : uint8
+	{
+		None,
+		// Still submitted to the compositor, but the texture is no longer copied into the swap chain
+		PausedUpdates,
+		// Not submitted to the compositor at all
+		Culled,
+	};
+
 	//-------------------------------------------------------------------------------------------------
 	// FLayer
 	//-------------------------------------------------------------------------------------------------
@@ -77,6 +90,10 @@ namespace OculusXRHMD
 		void IncrementSwapChainIndex_RHIThread(FCustomPresent* CustomPresent);
 		void ReleaseResources_RHIThread();
 		bool IsVisible() { return (Desc.Flags & IStereoLayers::LAYER_FLAG_HIDDEN) == 0; }
+		void SetBudgetDemotion(ELayerBudgetDemotion InDemotion) { BudgetDemotion = InDemotion; }
+		ELayerBudgetDemotion GetBudgetDemotion() const { return BudgetDemotion; }
+		bool IsCulledByBudget() const { return BudgetDemotion == ELayerBudgetDemotion::Culled; }
+		bool IsTextureUpdatePaused() const { return BudgetDemotion == ELayerBudgetDemotion::PausedUpdates; }
 
 		bool bNeedsTexSrgbCreate;
 
@@ -135,6 +152,7 @@ namespace OculusXRHMD
 		bool bInvertY;
 		bool bHasDepth;
 		bool bSupportDepthComposite;
+		ELayerBudgetDemotion BudgetDemotion;
 
 		UProceduralMeshComponent* PokeAHoleComponentPtr;
 		AActor* PokeAHoleActor;
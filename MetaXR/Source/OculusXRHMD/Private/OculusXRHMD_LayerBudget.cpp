@@ -0,0 +1,198 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OculusXRHMD_LayerBudget.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+#include "HeadMountedDisplayTypes.h" // for LogHMD
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarOculusLayerBudgetMaxLayers(
+	TEXT("r.Mobile.Oculus.LayerBudget.MaxLayers"),
+	0,
+	TEXT("Maximum number of layers submitted to the compositor, including the eye layer. Lowest priority layers over the limit are culled.\n")
+		TEXT("0: No limit (Default)\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<int32> CVarOculusLayerBudgetMaxTexels(
+	TEXT("r.Mobile.Oculus.LayerBudget.MaxTexels"),
+	0,
+	TEXT("Maximum number of texels copied into the swap chains of continuously updated layers per frame. Lowest priority layers over the budget stop updating their texture.\n")
+		TEXT("0: No limit (Default)\n"),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<int32> CVarOculusLayerBudgetHysteresisFrames(
+	TEXT("r.Mobile.Oculus.LayerBudget.HysteresisFrames"),
+	30,
+	TEXT("Number of consecutive frames a demoted layer has to fit into the budget before it is restored.\n"),
+	ECVF_Scalability);
+
+namespace OculusXRHMD
+{
+
+	//-------------------------------------------------------------------------------------------------
+	// FLayerBudget
+	//-------------------------------------------------------------------------------------------------
+
+	void FLayerBudget::Update_GameThread(const TMap<uint32, FLayerPtr>& LayerMap)
+	{
+		CheckInGameThread();
+
+		const int32 MaxLayers = CVarOculusLayerBudgetMaxLayers.GetValueOnGameThread();
+		const int64 MaxTexels = CVarOculusLayerBudgetMaxTexels.GetValueOnGameThread();
+		const int32 HysteresisFrames = FMath::Max(CVarOculusLayerBudgetHysteresisFrames.GetValueOnGameThread(), 0);
+
+		Stats.NumVisibleLayers = 0;
+		Stats.NumSubmittedLayers = 0;
+		Stats.UpdatedTexels = 0;
+		Stats.DemotedLayers.Reset();
+
+		// Layers that are exempt from the budget are always submitted and take their share of it first
+		SortedLayers.Reset();
+		for (const TPair<uint32, FLayerPtr>& Pair : LayerMap)
+		{
+			const FLayerPtr& Layer = Pair.Value;
+			if (!Layer->IsVisible())
+			{
+				Layer->SetBudgetDemotion(ELayerBudgetDemotion::None);
+				continue;
+			}
+
+			Stats.NumVisibleLayers++;
+			const IStereoLayers::FLayerDesc& Desc = Layer->GetDesc();
+			if (Layer->GetId() == 0 || Desc.HasShape<FReconstructedLayer>() || Desc.HasShape<FUserDefinedLayer>())
+			{
+				Layer->SetBudgetDemotion(ELayerBudgetDemotion::None);
+				Stats.NumSubmittedLayers++;
+				continue;
+			}
+
+			SortedLayers.Add(Layer);
+		}
+
+		SortedLayers.Sort([](const FLayerPtr& A, const FLayerPtr& B) {
+			if (A->GetDesc().Priority != B->GetDesc().Priority)
+			{
+				return A->GetDesc().Priority > B->GetDesc().Priority;
+			}
+			return A->GetId() < B->GetId();
+		});
+
+		TMap<uint32, FLayerState> NewLayerStates;
+		NewLayerStates.Reserve(SortedLayers.Num());
+
+		for (const FLayerPtr& Layer : SortedLayers)
+		{
+			const IStereoLayers::FLayerDesc& Desc = Layer->GetDesc();
+
+			int64 Texels = 0;
+			if ((Desc.Flags & IStereoLayers::LAYER_FLAG_TEX_CONTINUOUS_UPDATE) && Desc.Texture.IsValid())
+			{
+				const FIntPoint Size = Desc.Texture->GetSizeXY();
+				Texels = (int64)Size.X * Size.Y * (Desc.LeftTexture.IsValid() ? 2 : 1);
+			}
+
+			// Where the layer would end up without hysteresis
+			ELayerBudgetDemotion Wanted = ELayerBudgetDemotion::None;
+			EReason WantedReason = EReason::None;
+			// Culling a poke-a-hole layer would leave the hole in the scene
+			if (MaxLayers > 0 && Stats.NumSubmittedLayers >= MaxLayers && !Layer->NeedsPokeAHole())
+			{
+				Wanted = ELayerBudgetDemotion::Culled;
+				WantedReason = EReason::MaxLayers;
+			}
+			else if (MaxTexels > 0 && Texels > 0 && Stats.UpdatedTexels + Texels > MaxTexels)
+			{
+				Wanted = ELayerBudgetDemotion::PausedUpdates;
+				WantedReason = EReason::MaxTexels;
+			}
+
+			FLayerState State = LayerStates.FindRef(Layer->GetId());
+			if (Wanted >= State.Demotion)
+			{
+				if (Wanted != State.Demotion)
+				{
+					UE_LOG(LogHMD, Log, TEXT("Layer %u (priority %d) demoted: %s (%s)"), Layer->GetId(), Desc.Priority, LexToString(Wanted), LexToString(WantedReason));
+				}
+				State.Demotion = Wanted;
+				State.Reason = WantedReason;
+				State.FramesWithinBudget = 0;
+			}
+			else if (++State.FramesWithinBudget >= HysteresisFrames)
+			{
+				UE_LOG(LogHMD, Log, TEXT("Layer %u (priority %d) restored: %s"), Layer->GetId(), Desc.Priority, LexToString(Wanted));
+				State.Demotion = Wanted;
+				State.Reason = WantedReason;
+				State.FramesWithinBudget = 0;
+			}
+
+			Layer->SetBudgetDemotion(State.Demotion);
+			NewLayerStates.Add(Layer->GetId(), State);
+
+			if (State.Demotion != ELayerBudgetDemotion::Culled)
+			{
+				Stats.NumSubmittedLayers++;
+			}
+			if (State.Demotion == ELayerBudgetDemotion::None)
+			{
+				Stats.UpdatedTexels += Texels;
+			}
+			else
+			{
+				Stats.DemotedLayers.Add({ Layer->GetId(), Desc.Priority, Texels, State.Demotion, State.Reason });
+			}
+		}
+
+		// Drops the state of destroyed and hidden layers
+		LayerStates = MoveTemp(NewLayerStates);
+		SortedLayers.Reset();
+	}
+
+	void FLayerBudget::Reset()
+	{
+		LayerStates.Reset();
+		SortedLayers.Reset();
+		Stats = FStats();
+	}
+
+	void FLayerBudget::DumpStats(FOutputDevice& Ar) const
+	{
+		Ar.Logf(TEXT("Layers: %d visible, %d submitted (max %d)"), Stats.NumVisibleLayers, Stats.NumSubmittedLayers, CVarOculusLayerBudgetMaxLayers.GetValueOnAnyThread());
+		Ar.Logf(TEXT("Updated texels: %lld (max %d)"), Stats.UpdatedTexels, CVarOculusLayerBudgetMaxTexels.GetValueOnAnyThread());
+		for (const FDemotedLayer& Layer : Stats.DemotedLayers)
+		{
+			Ar.Logf(TEXT("  Layer %u priority %d texels %lld: %s (%s)"), Layer.LayerId, Layer.Priority, Layer.Texels, LexToString(Layer.Demotion), LexToString(Layer.Reason));
+		}
+	}
+
+	const TCHAR* FLayerBudget::LexToString(ELayerBudgetDemotion Demotion)
+	{
+		switch (Demotion)
+		{
+			case ELayerBudgetDemotion::None:
+				return TEXT("none");
+			case ELayerBudgetDemotion::PausedUpdates:
+				return TEXT("paused updates");
+			case ELayerBudgetDemotion::Culled:
+				return TEXT("culled");
+		}
+		return TEXT("unknown");
+	}
+
+	const TCHAR* FLayerBudget::LexToString(EReason Reason)
+	{
+		switch (Reason)
+		{
+			case EReason::None:
+				return TEXT("within budget");
+			case EReason::MaxLayers:
+				return TEXT("over layer count");
+			case EReason::MaxTexels:
+				return TEXT("over texel budget");
+		}
+		return TEXT("unknown");
+	}
+
+} // namespace OculusXRHMD
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
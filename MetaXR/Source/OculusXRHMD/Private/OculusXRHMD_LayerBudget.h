@@ -0,0 +1,76 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "OculusXRHMDPrivate.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+#include "OculusXRHMD_Layer.h"
+
+namespace OculusXRHMD
+{
+
+	//-------------------------------------------------------------------------------------------------
+	// FLayerBudget
+	//-------------------------------------------------------------------------------------------------
+
+	// Keeps the stereo layers within a maximum layer count and a budget of texels that are copied into the layer
+	// swap chains every frame. Layers are ranked by priority (higher first, then by creation order). Layers that
+	// don't fit anymore are culled (layer count) or have their texture updates paused (texels). A demoted layer is
+	// only restored after it fit into the budget for a number of consecutive frames, so it doesn't flicker.
+	// The eye layer and passthrough layers are never demoted.
+	class FLayerBudget
+	{
+	public:
+		enum class EReason : uint8
+		{
+			None,
+			MaxLayers,
+			MaxTexels,
+		};
+
+		struct FDemotedLayer
+		{
+			uint32 LayerId;
+			int32 Priority;
+			int64 Texels;
+			ELayerBudgetDemotion Demotion;
+			EReason Reason;
+		};
+
+		struct FStats
+		{
+			// Visible layers including the eye layer
+			int32 NumVisibleLayers = 0;
+			// Layers that are submitted to the compositor
+			int32 NumSubmittedLayers = 0;
+			// Texels copied into swap chains of continuously updated layers
+			int64 UpdatedTexels = 0;
+			TArray<FDemotedLayer> DemotedLayers;
+		};
+
+		void Update_GameThread(const TMap<uint32, FLayerPtr>& LayerMap);
+		void Reset();
+
+		const FStats& GetStats() const { return Stats; }
+		void DumpStats(FOutputDevice& Ar) const;
+
+		static const TCHAR* LexToString(ELayerBudgetDemotion Demotion);
+		static const TCHAR* LexToString(EReason Reason);
+
+	private:
+		struct FLayerState
+		{
+			ELayerBudgetDemotion Demotion = ELayerBudgetDemotion::None;
+			EReason Reason = EReason::None;
+			int32 FramesWithinBudget = 0;
+		};
+
+		TMap<uint32, FLayerState> LayerStates;
+		TArray<FLayerPtr> SortedLayers;
+		FStats Stats;
+	};
+
+} // namespace OculusXRHMD
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
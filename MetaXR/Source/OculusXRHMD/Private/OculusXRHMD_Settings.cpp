@@ -33,9 +33,6 @@ namespace OculusXRHMD
 		, HandTrackingSupport(EOculusXRHandTrackingSupport::ControllersOnly)
 		, HandTrackingFrequency(EOculusXRHandTrackingFrequency::LOW)
 		, HandTrackingVersion(EOculusXRHandTrackingVersion::Default)
-		, ColorScale(ovrpVector4f{ 1, 1, 1, 1 })
-		, ColorOffset(ovrpVector4f{ 0, 0, 0, 0 })
-		, bApplyColorScaleAndOffsetToAllLayers(false)
 		, CurrentFeatureLevel(GMaxRHIFeatureLevel)
 		, bLateLatching(false)
 		, bSupportExperimentalFeatures(false)
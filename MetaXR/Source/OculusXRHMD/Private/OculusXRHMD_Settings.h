@@ -3,6 +3,7 @@
 
 #pragma once
 #include "OculusXRHMDPrivate.h"
+#include "OculusXRHMD_ColorTransition.h"
 
 #if OCULUS_HMD_SUPPORTED_PLATFORMS
 
@@ -140,8 +141,10 @@ namespace OculusXRHMD
 		EOculusXRHandTrackingFrequency HandTrackingFrequency;
 		EOculusXRHandTrackingVersion HandTrackingVersion;
 
-		ovrpVector4f ColorScale, ColorOffset;
-		bool bApplyColorScaleAndOffsetToAllLayers;
+		// Applied to all layers, on top of the layer specific ones
+		FColorScaleAndOffset ColorScaleAndOffset;
+		// Layer specific values by layer id, layers without a value aren't changed
+		TMap<uint32, FColorScaleAndOffset> LayerColorScaleAndOffset;
 
 		FStaticFeatureLevel CurrentFeatureLevel;
 		EShaderPlatform CurrentShaderPlatform;
@@ -0,0 +1,148 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OculusXRHMD_SpaceWarpController.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+#include "OculusXRHMDModule.h"
+
+namespace OculusXRHMD
+{
+
+	//-------------------------------------------------------------------------------------------------
+	// FOvrpSpaceWarpTimingSource
+	//-------------------------------------------------------------------------------------------------
+
+	bool FOvrpSpaceWarpTimingSource::GetFrameTiming(FSpaceWarpFrameTiming& OutTiming)
+	{
+		OculusPluginWrapper& PluginWrapper = FOculusXRHMDModule::GetPluginWrapper();
+		if (!PluginWrapper.GetInitialized())
+		{
+			return false;
+		}
+
+		float CpuTime = 0.0f;
+		float GpuTime = 0.0f;
+		ovrpBool bIsSupported = ovrpBool_False;
+		const bool bHasCpuTime = OVRP_SUCCESS(PluginWrapper.IsPerfMetricsSupported(ovrpPerfMetrics_App_CpuTime_Float, &bIsSupported)) && bIsSupported == ovrpBool_True
+			&& OVRP_SUCCESS(PluginWrapper.GetPerfMetricsFloat(ovrpPerfMetrics_App_CpuTime_Float, &CpuTime));
+		const bool bHasGpuTime = OVRP_SUCCESS(PluginWrapper.IsPerfMetricsSupported(ovrpPerfMetrics_App_GpuTime_Float, &bIsSupported)) && bIsSupported == ovrpBool_True
+			&& OVRP_SUCCESS(PluginWrapper.GetPerfMetricsFloat(ovrpPerfMetrics_App_GpuTime_Float, &GpuTime));
+		if (!bHasCpuTime && !bHasGpuTime)
+		{
+			return false;
+		}
+
+		if (OVRP_FAILURE(PluginWrapper.GetSystemDisplayFrequency2(&OutTiming.DisplayFrequency)))
+		{
+			return false;
+		}
+
+		OutTiming.FrameTime = FMath::Max(CpuTime, GpuTime) * 1000.0f;
+
+		ovrpPoseStatef HeadState;
+		OutTiming.HeadAngularSpeed = OVRP_SUCCESS(PluginWrapper.GetNodePoseState3(ovrpStep_Render, OVRP_CURRENT_FRAMEINDEX, ovrpNode_Head, &HeadState))
+			? FMath::RadiansToDegrees(ToFVector(HeadState.AngularVelocity).Size())
+			: 0.0f;
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------------
+	// FSpaceWarpController
+	//-------------------------------------------------------------------------------------------------
+
+	FSpaceWarpController::FSpaceWarpController(TSharedPtr<ISpaceWarpTimingSource> InTimingSource)
+		: bEnabled(false)
+		, bHasFrameTime(false)
+		, bToggleDeferred(false)
+		, PendingTime(0.0f)
+	{
+		SetTimingSource(InTimingSource);
+	}
+
+	void FSpaceWarpController::SetTimingSource(TSharedPtr<ISpaceWarpTimingSource> InTimingSource)
+	{
+		TimingSource = InTimingSource.IsValid() ? InTimingSource : MakeShared<FOvrpSpaceWarpTimingSource>();
+		bHasFrameTime = false;
+	}
+
+	bool FSpaceWarpController::Update(float DeltaTime)
+	{
+		FSpaceWarpFrameTiming Timing;
+		if (!TimingSource->GetFrameTiming(Timing) || Timing.DisplayFrequency <= 0.0f || Timing.FrameTime <= 0.0f)
+		{
+			return bEnabled;
+		}
+
+		if (bHasFrameTime && Settings.SmoothingTime > 0.0f)
+		{
+			const float Alpha = 1.0f - FMath::Exp(-DeltaTime / Settings.SmoothingTime);
+			Stats.SmoothedFrameTime = FMath::Lerp(Stats.SmoothedFrameTime, Timing.FrameTime, Alpha);
+		}
+		else
+		{
+			Stats.SmoothedFrameTime = Timing.FrameTime;
+			bHasFrameTime = true;
+		}
+		Stats.FrameBudget = 1000.0f / Timing.DisplayFrequency;
+		Stats.Headroom = 1.0f - Stats.SmoothedFrameTime / Stats.FrameBudget;
+
+		const bool bPastThreshold = bEnabled ? Stats.Headroom > Settings.DisableHeadroom : Stats.Headroom < Settings.EnableHeadroom;
+		if (!bPastThreshold)
+		{
+			PendingTime = 0.0f;
+			bToggleDeferred = false;
+			return bEnabled;
+		}
+
+		PendingTime += DeltaTime;
+		if (PendingTime < (bEnabled ? Settings.DisableDelay : Settings.EnableDelay))
+		{
+			return bEnabled;
+		}
+
+		const bool bCritical = !bEnabled && Stats.Headroom < Settings.CriticalHeadroom;
+		const bool bFastMotion = Settings.MaxToggleHeadAngularSpeed > 0.0f && Timing.HeadAngularSpeed > Settings.MaxToggleHeadAngularSpeed;
+		if (bFastMotion && !bCritical)
+		{
+			if (!bToggleDeferred)
+			{
+				bToggleDeferred = true;
+				++Stats.NumDeferredToggles;
+			}
+			return bEnabled;
+		}
+
+		bEnabled = !bEnabled;
+		if (bEnabled)
+		{
+			++Stats.NumEnables;
+		}
+		else
+		{
+			++Stats.NumDisables;
+		}
+		PendingTime = 0.0f;
+		bToggleDeferred = false;
+
+		UE_LOG(LogHMD, Log, TEXT("[Mobile SpaceWarp] Automatically %s, frame time %.2f ms, budget %.2f ms"), bEnabled ? TEXT("enabled") : TEXT("disabled"), Stats.SmoothedFrameTime, Stats.FrameBudget);
+		return bEnabled;
+	}
+
+	void FSpaceWarpController::Reset(bool bInEnabled)
+	{
+		bEnabled = bInEnabled;
+		bHasFrameTime = false;
+		bToggleDeferred = false;
+		PendingTime = 0.0f;
+	}
+
+	void FSpaceWarpController::DumpStats(FOutputDevice& Ar) const
+	{
+		Ar.Logf(TEXT("SpaceWarp %s, frame time %.2f ms, budget %.2f ms, headroom %.1f%%"), bEnabled ? TEXT("enabled") : TEXT("disabled"), Stats.SmoothedFrameTime, Stats.FrameBudget, Stats.Headroom * 100.0f);
+		Ar.Logf(TEXT("  %d enables, %d disables, %d toggles deferred by head motion"), Stats.NumEnables, Stats.NumDisables, Stats.NumDeferredToggles);
+	}
+
+} // namespace OculusXRHMD
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
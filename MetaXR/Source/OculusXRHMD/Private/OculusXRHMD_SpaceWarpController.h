@@ -0,0 +1,115 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "OculusXRHMDPrivate.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+
+namespace OculusXRHMD
+{
+
+	//-------------------------------------------------------------------------------------------------
+	// ISpaceWarpTimingSource
+	//-------------------------------------------------------------------------------------------------
+
+	struct FSpaceWarpFrameTiming
+	{
+		// Frame time of the app in milliseconds, the longer of the CPU and the GPU time
+		float FrameTime = 0.0f;
+		// Refresh rate of the display in Hz
+		float DisplayFrequency = 0.0f;
+		// Angular speed of the head in degrees per second, used as a measure of the scene motion
+		float HeadAngularSpeed = 0.0f;
+	};
+
+	// Provides the frame timing to FSpaceWarpController, can be replaced by a simulated source in tests
+	class ISpaceWarpTimingSource
+	{
+	public:
+		virtual ~ISpaceWarpTimingSource() {}
+
+		// Returns false if no timing is available for this frame
+		virtual bool GetFrameTiming(FSpaceWarpFrameTiming& OutTiming) = 0;
+	};
+
+	// Reads the app frame times from the OVRPlugin performance metrics and the head motion from the tracking state
+	class FOvrpSpaceWarpTimingSource : public ISpaceWarpTimingSource
+	{
+	public:
+		virtual bool GetFrameTiming(FSpaceWarpFrameTiming& OutTiming) override;
+	};
+
+	//-------------------------------------------------------------------------------------------------
+	// FSpaceWarpController
+	//-------------------------------------------------------------------------------------------------
+
+	// Turns Application SpaceWarp on when the app frame time doesn't fit into the refresh rate budget anymore, and
+	// off again once there is enough headroom to render at full rate. The headroom is the fraction of the budget
+	// left, e.g. 0.2 for a 11.1 ms budget and a 8.9 ms frame time. The thresholds are apart and have to be exceeded
+	// for a while, so SpaceWarp doesn't toggle back and forth. Toggles are deferred while the head moves fast,
+	// switching the frame rate during fast motion is visible, unless the app is far over budget.
+	// The frame time is measured per rendered frame, so it is compared to the full rate budget while SpaceWarp is on.
+	class FSpaceWarpController
+	{
+	public:
+		struct FSettings
+		{
+			// SpaceWarp turns on while the headroom is below this value
+			float EnableHeadroom = 0.0f;
+			// SpaceWarp turns off while the headroom is above this value
+			float DisableHeadroom = 0.25f;
+			// Seconds the headroom has to stay below EnableHeadroom before SpaceWarp turns on
+			float EnableDelay = 0.5f;
+			// Seconds the headroom has to stay above DisableHeadroom before SpaceWarp turns off
+			float DisableDelay = 3.0f;
+			// SpaceWarp turns on right away, regardless of the head motion, while the headroom is below this value
+			float CriticalHeadroom = -0.3f;
+			// Toggles are deferred while the head rotates faster than this, in degrees per second. 0 disables the check.
+			float MaxToggleHeadAngularSpeed = 60.0f;
+			// Time constant of the frame time smoothing in seconds
+			float SmoothingTime = 0.25f;
+		};
+
+		struct FStats
+		{
+			float SmoothedFrameTime = 0.0f;
+			float FrameBudget = 0.0f;
+			float Headroom = 0.0f;
+			int32 NumEnables = 0;
+			int32 NumDisables = 0;
+			// Toggles that were deferred because of the head motion, counted once per deferred toggle
+			int32 NumDeferredToggles = 0;
+		};
+
+		// Uses the OVRPlugin timing source if none is given
+		explicit FSpaceWarpController(TSharedPtr<ISpaceWarpTimingSource> InTimingSource = nullptr);
+
+		void SetTimingSource(TSharedPtr<ISpaceWarpTimingSource> InTimingSource);
+		void SetSettings(const FSettings& InSettings) { Settings = InSettings; }
+		const FSettings& GetSettings() const { return Settings; }
+
+		// Samples the timing source and returns whether SpaceWarp should be enabled
+		bool Update(float DeltaTime);
+
+		// Forgets the measurements and sets the state, e.g. when the automatic mode is turned on or off
+		void Reset(bool bInEnabled);
+
+		bool IsEnabled() const { return bEnabled; }
+		const FStats& GetStats() const { return Stats; }
+		void DumpStats(FOutputDevice& Ar) const;
+
+	private:
+		TSharedPtr<ISpaceWarpTimingSource> TimingSource;
+		FSettings Settings;
+		FStats Stats;
+		bool bEnabled;
+		bool bHasFrameTime;
+		bool bToggleDeferred;
+		// Time the headroom has been past the threshold of the next toggle
+		float PendingTime;
+	};
+
+} // namespace OculusXRHMD
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
@@ -0,0 +1,302 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OculusXRTickManager.h"
+#include "OculusXRHMDPrivate.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+static int32 GOculusBatchedTickRateLimitsSerial = 0;
+
+static TAutoConsoleVariable<int32> CVarOculusBatchedTick(
+	TEXT("r.Mobile.Oculus.BatchedTick"),
+	1,
+	TEXT("Update the XR tracking components in one batch per component type instead of ticking them one by one. Applies to components registered afterwards.\n")
+		TEXT("0: Components tick themselves\n")
+		TEXT("1: Batched (Default)\n"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<FString> CVarOculusBatchedTickMaxRates(
+	TEXT("r.Mobile.Oculus.BatchedTick.MaxRates"),
+	TEXT(""),
+	TEXT("Comma separated maximum update rates in Hz per batch, e.g. \"Anchors=30,FaceTracking=30\". Batches that aren't listed update every frame.\n"),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*) { ++GOculusBatchedTickRateLimitsSerial; }),
+	ECVF_Scalability);
+
+static void OculusBatchedTickStatsCmdHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	if (const UOculusXRTickManager* TickManager = World ? World->GetSubsystem<UOculusXRTickManager>() : nullptr)
+	{
+		TickManager->DumpStats(Ar);
+	}
+}
+
+static FAutoConsoleCommand COculusBatchedTickStatsCmd(
+	TEXT("vr.oculus.BatchedTick.Stats"),
+	*NSLOCTEXT("OculusRift", "CCommandText_BatchedTickStats", "Lists the batches of the XR tick manager with their component count, rate limit and update times.\n Usage: vr.oculus.BatchedTick.Stats").ToString(),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(OculusBatchedTickStatsCmdHandler));
+
+//-------------------------------------------------------------------------------------------------
+// FOculusXRTickBatchTickFunction
+//-------------------------------------------------------------------------------------------------
+
+void FOculusXRTickBatchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	// Same rule as for the component tick functions
+	if (Manager && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Manager->UpdateBatch(BatchName, DeltaTime);
+	}
+}
+
+FString FOculusXRTickBatchTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("UOculusXRTickManager[%s]"), *BatchName.ToString());
+}
+
+FName FOculusXRTickBatchTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return BatchName;
+}
+
+//-------------------------------------------------------------------------------------------------
+// UOculusXRTickManager
+//-------------------------------------------------------------------------------------------------
+
+bool UOculusXRTickManager::RegisterComponentTick(UActorComponent* Component, bool bRegister, const FOculusXRTickBatchDesc& Batch)
+{
+	UWorld* World = Component ? Component->GetWorld() : nullptr;
+	UOculusXRTickManager* TickManager = World ? World->GetSubsystem<UOculusXRTickManager>() : nullptr;
+	if (!TickManager)
+	{
+		return false;
+	}
+
+	if (!bRegister)
+	{
+		return TickManager->RemoveComponent(Component, Batch.Name);
+	}
+
+	if (!CVarOculusBatchedTick.GetValueOnGameThread() || !Component->PrimaryComponentTick.bCanEverTick || Component->IsTemplate())
+	{
+		return false;
+	}
+
+	// The batch only runs the native update, a blueprint Tick event needs the component's own tick function
+	static const FName ReceiveTickName(TEXT("ReceiveTick"));
+	if (Component->GetClass()->IsFunctionImplementedInScript(ReceiveTickName) || NeedsOwnTickFunction(Component, Batch))
+	{
+		return false;
+	}
+
+	return TickManager->AddComponent(Component, Batch);
+}
+
+void UOculusXRTickManager::SetBatchMaxRate(FName BatchName, float MaxRate)
+{
+	MaxRateOverrides.Add(BatchName, FMath::Max(MaxRate, 0.0f));
+	if (TUniquePtr<FBatch>* Batch = Batches.Find(BatchName))
+	{
+		ApplyMaxRate(**Batch);
+	}
+}
+
+FOculusXRTickBatchStats UOculusXRTickManager::GetBatchStats(FName BatchName) const
+{
+	FOculusXRTickBatchStats Stats;
+	if (const TUniquePtr<FBatch>* BatchPtr = Batches.Find(BatchName))
+	{
+		const FBatch& Batch = **BatchPtr;
+		Stats.NumComponents = Batch.Components.Num();
+		Stats.NumUpdates = Batch.NumUpdates;
+		Stats.MaxRate = Batch.TickFunction.TickInterval > 0.0f ? 1.0f / Batch.TickFunction.TickInterval : 0.0f;
+		Stats.LastUpdateTime = Batch.LastUpdateTime * 1000.0;
+		Stats.AverageUpdateTime = Batch.NumUpdates > 0 ? Batch.TotalUpdateTime * 1000.0 / Batch.NumUpdates : 0.0;
+		Stats.MaxUpdateTime = Batch.MaxUpdateTime * 1000.0;
+	}
+	return Stats;
+}
+
+TArray<FName> UOculusXRTickManager::GetBatchNames() const
+{
+	TArray<FName> BatchNames;
+	Batches.GetKeys(BatchNames);
+	return BatchNames;
+}
+
+void UOculusXRTickManager::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Batched tick: %s"), CVarOculusBatchedTick.GetValueOnGameThread() ? TEXT("enabled") : TEXT("disabled"));
+	for (const TPair<FName, TUniquePtr<FBatch>>& Pair : Batches)
+	{
+		const FOculusXRTickBatchStats Stats = GetBatchStats(Pair.Key);
+		Ar.Logf(TEXT("  %s: %d components, %d updates, max rate %.1f Hz, last %.3f ms, average %.3f ms, max %.3f ms"),
+			*Pair.Key.ToString(), Stats.NumComponents, Stats.NumUpdates, Stats.MaxRate, Stats.LastUpdateTime, Stats.AverageUpdateTime, Stats.MaxUpdateTime);
+	}
+}
+
+void UOculusXRTickManager::Deinitialize()
+{
+	for (TPair<FName, TUniquePtr<FBatch>>& Pair : Batches)
+	{
+		Pair.Value->TickFunction.UnRegisterTickFunction();
+	}
+	Batches.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UOculusXRTickManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UOculusXRTickManager::NeedsOwnTickFunction(const UActorComponent* Component, const FOculusXRTickBatchDesc& Desc)
+{
+	// The batch has a single tick group and no dependencies, only the tick interval is handled per component
+	const FActorComponentTickFunction& TickFunction = Component->PrimaryComponentTick;
+	return TickFunction.TickGroup != Desc.TickGroup || TickFunction.bTickEvenWhenPaused || TickFunction.GetPrerequisites().Num() > 0;
+}
+
+bool UOculusXRTickManager::AddComponent(UActorComponent* Component, const FOculusXRTickBatchDesc& Desc)
+{
+	TUniquePtr<FBatch>& Batch = Batches.FindOrAdd(Desc.Name);
+	if (!Batch)
+	{
+		ULevel* PersistentLevel = GetWorld()->PersistentLevel;
+		if (!PersistentLevel)
+		{
+			Batches.Remove(Desc.Name);
+			return false;
+		}
+
+		Batch = MakeUnique<FBatch>();
+		Batch->Desc = Desc;
+		Batch->ProfilerName = FString::Printf(TEXT("OculusXRTickBatch_%s"), *Desc.Name.ToString());
+		Batch->TickFunction.Manager = this;
+		Batch->TickFunction.BatchName = Desc.Name;
+		Batch->TickFunction.TickGroup = Desc.TickGroup;
+		Batch->TickFunction.bCanEverTick = true;
+		Batch->TickFunction.bAllowTickOnDedicatedServer = false;
+		ApplyMaxRate(*Batch);
+		Batch->TickFunction.RegisterTickFunction(PersistentLevel);
+	}
+	checkf(Batch->Desc.Function == Desc.Function, TEXT("Tick batch %s is used by different component types"), *Desc.Name.ToString());
+
+	if (!Batch->Components.ContainsByPredicate([Component](const FBatchedComponent& Batched) { return Batched.Component == Component; }))
+	{
+		Batch->Components.Add({ Component });
+	}
+	return true;
+}
+
+bool UOculusXRTickManager::RemoveComponent(UActorComponent* Component, FName BatchName)
+{
+	TUniquePtr<FBatch>* Batch = Batches.Find(BatchName);
+	return Batch && (*Batch)->Components.RemoveAll([Component](const FBatchedComponent& Batched) { return Batched.Component == Component; }) > 0;
+}
+
+void UOculusXRTickManager::UpdateBatch(FName BatchName, float DeltaTime)
+{
+	TUniquePtr<FBatch>* BatchPtr = Batches.Find(BatchName);
+	if (!BatchPtr)
+	{
+		return;
+	}
+	FBatch& Batch = **BatchPtr;
+
+	if (Batch.RateLimitsSerial != GOculusBatchedTickRateLimitsSerial)
+	{
+		ApplyMaxRate(Batch);
+	}
+
+	Batch.Components.RemoveAll([](const FBatchedComponent& Batched) { return !Batched.Component.IsValid(); });
+
+	Batch.UpdateScratch.Reset();
+	Batch.DeltaTimeScratch.Reset();
+	TArray<UActorComponent*, TInlineAllocator<4>> ComponentsToUnbatch;
+	for (FBatchedComponent& Batched : Batch.Components)
+	{
+		UActorComponent* Component = Batched.Component.Get();
+		if (!Component->HasBegunPlay() || !Component->IsComponentTickEnabled() || Component->IsBeingDestroyed())
+		{
+			Batched.TimeSinceUpdate = 0.0f;
+			continue;
+		}
+		if (NeedsOwnTickFunction(Component, Batch.Desc))
+		{
+			ComponentsToUnbatch.Add(Component);
+			continue;
+		}
+
+		// Same as the tick interval of the component's own tick function
+		Batched.TimeSinceUpdate += DeltaTime;
+		if (Batched.TimeSinceUpdate < Component->GetComponentTickInterval())
+		{
+			continue;
+		}
+		Batch.UpdateScratch.Add(Component);
+		Batch.DeltaTimeScratch.Add(Batched.TimeSinceUpdate);
+		Batched.TimeSinceUpdate = 0.0f;
+	}
+
+	for (UActorComponent* Component : ComponentsToUnbatch)
+	{
+		UE_LOG(LogHMD, Verbose, TEXT("%s got tick prerequisites or a custom tick group, it leaves the %s batch and ticks itself"), *Component->GetPathName(), *BatchName.ToString());
+		// RegisterComponentTick refuses it now, so the component registers its own tick function
+		Component->RegisterAllComponentTickFunctions(false);
+		Component->RegisterAllComponentTickFunctions(true);
+	}
+
+	if (Batch.UpdateScratch.IsEmpty())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Batch.ProfilerName);
+	const double StartTime = FPlatformTime::Seconds();
+
+	Batch.Desc.Function(Batch.UpdateScratch, Batch.DeltaTimeScratch);
+
+	Batch.LastUpdateTime = FPlatformTime::Seconds() - StartTime;
+	Batch.TotalUpdateTime += Batch.LastUpdateTime;
+	Batch.MaxUpdateTime = FMath::Max(Batch.MaxUpdateTime, Batch.LastUpdateTime);
+	++Batch.NumUpdates;
+}
+
+void UOculusXRTickManager::ApplyMaxRate(FBatch& Batch)
+{
+	Batch.RateLimitsSerial = GOculusBatchedTickRateLimitsSerial;
+
+	float MaxRate = 0.0f;
+	if (const float* Override = MaxRateOverrides.Find(Batch.Desc.Name))
+	{
+		MaxRate = *Override;
+	}
+	else
+	{
+		TArray<FString> Entries;
+		CVarOculusBatchedTickMaxRates.GetValueOnGameThread().ParseIntoArray(Entries, TEXT(","));
+		for (const FString& Entry : Entries)
+		{
+			FString Name, Rate;
+			if (Entry.Split(TEXT("="), &Name, &Rate) && FName(*Name.TrimStartAndEnd()) == Batch.Desc.Name)
+			{
+				MaxRate = FMath::Max(FCString::Atof(*Rate), 0.0f);
+			}
+		}
+	}
+
+	const float TickInterval = MaxRate > 0.0f ? 1.0f / MaxRate : 0.0f;
+	if (Batch.TickFunction.IsTickFunctionRegistered())
+	{
+		Batch.TickFunction.UpdateTickIntervalAndCoolDown(TickInterval);
+	}
+	else
+	{
+		Batch.TickFunction.TickInterval = TickInterval;
+	}
+}
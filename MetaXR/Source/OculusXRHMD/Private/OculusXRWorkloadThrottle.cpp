@@ -0,0 +1,252 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OculusXRWorkloadThrottle.h"
+#include "OculusXRHMDPrivate.h"
+#include "OculusXRHMDRuntimeSettings.h"
+#include "OculusXRDelegates.h"
+#include "Engine/Engine.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/ActorComponent.h"
+#include "UObject/UObjectGlobals.h"
+
+//-------------------------------------------------------------------------------------------------
+// UOculusXRWorkloadThrottleSubsystem
+//-------------------------------------------------------------------------------------------------
+
+void UOculusXRWorkloadThrottleSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	FOculusEventDelegates::OculusInputFocusChanged.AddUObject(this, &UOculusXRWorkloadThrottleSubsystem::OnInputFocusChanged);
+}
+
+void UOculusXRWorkloadThrottleSubsystem::Deinitialize()
+{
+	FOculusEventDelegates::OculusInputFocusChanged.RemoveAll(this);
+	if (bIsThrottled)
+	{
+		Restore();
+	}
+	Super::Deinitialize();
+}
+
+void UOculusXRWorkloadThrottleSubsystem::RegisterThrottleable(UObject* Object)
+{
+	if (!Object || !Object->Implements<UOculusXRWorkloadThrottleable>())
+	{
+		UE_LOG(LogHMD, Warning, TEXT("RegisterThrottleable: %s doesn't implement IOculusXRWorkloadThrottleable"), *GetNameSafe(Object));
+		return;
+	}
+	if (Throttleables.Contains(Object))
+	{
+		return;
+	}
+	Throttleables.Add(Object);
+	if (bIsThrottled)
+	{
+		IOculusXRWorkloadThrottleable::Execute_OnWorkloadThrottled(Object, ActivePolicy);
+	}
+}
+
+void UOculusXRWorkloadThrottleSubsystem::UnregisterThrottleable(UObject* Object)
+{
+	if (Throttleables.Remove(Object) > 0 && bIsThrottled)
+	{
+		// Don't leave the object in the reduced mode
+		IOculusXRWorkloadThrottleable::Execute_OnWorkloadRestored(Object);
+	}
+}
+
+void UOculusXRWorkloadThrottleSubsystem::RegisterTickThrottling(UObject* ActorOrComponent)
+{
+	if (!Cast<AActor>(ActorOrComponent) && !Cast<UActorComponent>(ActorOrComponent))
+	{
+		UE_LOG(LogHMD, Warning, TEXT("RegisterTickThrottling: %s is neither an actor nor an actor component"), *GetNameSafe(ActorOrComponent));
+		return;
+	}
+	if (TickThrottled.Contains(ActorOrComponent))
+	{
+		return;
+	}
+	TickThrottled.Add(ActorOrComponent);
+	if (bIsThrottled)
+	{
+		ThrottleTick(ActorOrComponent);
+	}
+}
+
+void UOculusXRWorkloadThrottleSubsystem::UnregisterTickThrottling(UObject* ActorOrComponent)
+{
+	TickThrottled.Remove(ActorOrComponent);
+	float TickInterval;
+	if (SavedTickIntervals.RemoveAndCopyValue(ActorOrComponent, TickInterval))
+	{
+		RestoreTick(ActorOrComponent, TickInterval);
+	}
+}
+
+FOculusXRWorkloadThrottleStats UOculusXRWorkloadThrottleSubsystem::GetStats() const
+{
+	FOculusXRWorkloadThrottleStats Stats;
+	Stats.bIsThrottled = bIsThrottled;
+	Stats.NumThrottles = NumThrottles;
+	Stats.ThrottledTime = ThrottledTime + (bIsThrottled ? FPlatformTime::Seconds() - ThrottleStartTime : 0.0);
+	Stats.NumThrottleables = Throttleables.Num();
+	Stats.NumTickThrottled = TickThrottled.Num();
+	return Stats;
+}
+
+void UOculusXRWorkloadThrottleSubsystem::OnInputFocusChanged(bool bHasInputFocus, bool bSystemOverlayPresent)
+{
+	const FOculusXRWorkloadThrottlePolicy& Policy = GetDefault<UOculusXRHMDRuntimeSettings>()->WorkloadThrottlePolicy;
+	const bool bFocusLost = !bHasInputFocus && Policy.bThrottleOnInputFocusLoss;
+	const bool bOverlay = bSystemOverlayPresent && Policy.bThrottleOnSystemOverlay;
+
+	if ((bFocusLost || bOverlay) && !bIsThrottled)
+	{
+		Throttle(bFocusLost ? TEXT("input focus lost") : TEXT("system overlay present"));
+	}
+	else if (!bFocusLost && !bOverlay && bIsThrottled)
+	{
+		Restore();
+	}
+}
+
+void UOculusXRWorkloadThrottleSubsystem::Throttle(const TCHAR* Reason)
+{
+	ActivePolicy = GetDefault<UOculusXRHMDRuntimeSettings>()->WorkloadThrottlePolicy;
+	bIsThrottled = true;
+	ThrottleStartTime = FPlatformTime::Seconds();
+	++NumThrottles;
+
+	Throttleables.RemoveAll([](const TWeakObjectPtr<UObject>& Object) { return !Object.IsValid(); });
+	TickThrottled.RemoveAll([](const TWeakObjectPtr<UObject>& Object) { return !Object.IsValid(); });
+
+	for (const TWeakObjectPtr<UObject>& Object : TickThrottled)
+	{
+		ThrottleTick(Object.Get());
+	}
+
+	if (ActivePolicy.bStopHaptics || ActivePolicy.bPauseGame)
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			UWorld* World = Context.World();
+			if (!World || !World->IsGameWorld())
+			{
+				continue;
+			}
+			for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+			{
+				APlayerController* PlayerController = Iterator->Get();
+				if (!PlayerController || !PlayerController->IsLocalController())
+				{
+					continue;
+				}
+				if (ActivePolicy.bStopHaptics)
+				{
+					PlayerController->StopHapticEffect(EControllerHand::Left);
+					PlayerController->StopHapticEffect(EControllerHand::Right);
+				}
+				if (ActivePolicy.bPauseGame && !PlayerController->IsPaused() && PlayerController->SetPause(true))
+				{
+					PausedPlayerControllers.Add(PlayerController);
+				}
+			}
+		}
+	}
+
+	if (ActivePolicy.bSuspendAsyncLoading && !IsAsyncLoadingSuspended())
+	{
+		SuspendAsyncLoading();
+		bSuspendedAsyncLoading = true;
+	}
+
+	// Iterate over a copy, the objects may register or unregister throttleables from their callbacks
+	const TArray<TWeakObjectPtr<UObject>> ThrottleablesToNotify = Throttleables;
+	for (const TWeakObjectPtr<UObject>& Object : ThrottleablesToNotify)
+	{
+		if (Object.IsValid())
+		{
+			IOculusXRWorkloadThrottleable::Execute_OnWorkloadThrottled(Object.Get(), ActivePolicy);
+		}
+	}
+
+	UE_LOG(LogHMD, Log, TEXT("Workload throttled (%s): %d throttleables, %d tick throttled, %d paused player controllers, battery level %d"),
+		Reason, Throttleables.Num(), TickThrottled.Num(), PausedPlayerControllers.Num(), FPlatformMisc::GetBatteryLevel());
+
+	OnWorkloadThrottleChanged.Broadcast(true);
+}
+
+void UOculusXRWorkloadThrottleSubsystem::Restore()
+{
+	bIsThrottled = false;
+	const double Duration = FPlatformTime::Seconds() - ThrottleStartTime;
+	ThrottledTime += Duration;
+
+	const TArray<TWeakObjectPtr<UObject>> ThrottleablesToNotify = Throttleables;
+	for (const TWeakObjectPtr<UObject>& Object : ThrottleablesToNotify)
+	{
+		if (Object.IsValid())
+		{
+			IOculusXRWorkloadThrottleable::Execute_OnWorkloadRestored(Object.Get());
+		}
+	}
+
+	if (bSuspendedAsyncLoading)
+	{
+		ResumeAsyncLoading();
+		bSuspendedAsyncLoading = false;
+	}
+
+	for (const TWeakObjectPtr<APlayerController>& PlayerController : PausedPlayerControllers)
+	{
+		if (PlayerController.IsValid())
+		{
+			PlayerController->SetPause(false);
+		}
+	}
+	PausedPlayerControllers.Empty();
+
+	for (const TPair<TWeakObjectPtr<UObject>, float>& Saved : SavedTickIntervals)
+	{
+		RestoreTick(Saved.Key.Get(), Saved.Value);
+	}
+	SavedTickIntervals.Empty();
+
+	UE_LOG(LogHMD, Log, TEXT("Workload restored after %.1f s (%d throttles, %.1f s throttled in total), battery level %d"),
+		Duration, NumThrottles, ThrottledTime, FPlatformMisc::GetBatteryLevel());
+
+	OnWorkloadThrottleChanged.Broadcast(false);
+}
+
+void UOculusXRWorkloadThrottleSubsystem::ThrottleTick(UObject* Object)
+{
+	if (ActivePolicy.ThrottledTickInterval <= 0.0f)
+	{
+		return;
+	}
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		SavedTickIntervals.Add(Object, Actor->GetActorTickInterval());
+		Actor->SetActorTickInterval(FMath::Max(Actor->GetActorTickInterval(), ActivePolicy.ThrottledTickInterval));
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		SavedTickIntervals.Add(Object, Component->GetComponentTickInterval());
+		Component->SetComponentTickInterval(FMath::Max(Component->GetComponentTickInterval(), ActivePolicy.ThrottledTickInterval));
+	}
+}
+
+void UOculusXRWorkloadThrottleSubsystem::RestoreTick(UObject* Object, float TickInterval)
+{
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		Actor->SetActorTickInterval(TickInterval);
+	}
+	else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		Component->SetComponentTickInterval(TickInterval);
+	}
+}
@@ -0,0 +1,150 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "OculusXRHMD_ColorTransition.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+#include "Curves/CurveFloat.h"
+
+namespace
+{
+	using namespace OculusXRHMD;
+
+	const FColorScaleAndOffset Black{ FLinearColor::Black, FLinearColor::Transparent };
+	const FColorScaleAndOffset Red{ FLinearColor::Red, FLinearColor::Transparent };
+
+	FColorTransition MakeTransition(const FColorScaleAndOffset& Target, float Duration, EOculusXRColorTransitionCurve Curve = EOculusXRColorTransitionCurve::Linear)
+	{
+		FColorTransition Transition;
+		Transition.Target = Target;
+		Transition.Duration = Duration;
+		Transition.Curve = Curve;
+		return Transition;
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FOculusXRColorTransitionSpec, TEXT("OculusXR Color Transition"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+FColorTransitionController Controller;
+END_DEFINE_SPEC(FOculusXRColorTransitionSpec)
+
+void FOculusXRColorTransitionSpec::Define()
+{
+	BeforeEach([this]() {
+		Controller.Reset();
+	});
+
+	Describe("Curves", [this]() {
+		It("should start at 0 and end at 1", [this]() {
+			for (const EOculusXRColorTransitionCurve Curve : { EOculusXRColorTransitionCurve::Linear, EOculusXRColorTransitionCurve::EaseIn, EOculusXRColorTransitionCurve::EaseOut, EOculusXRColorTransitionCurve::EaseInOut })
+			{
+				const FColorTransition Transition = MakeTransition(Black, 1.0f, Curve);
+				TestEqual("Start", FColorTransitionController::EvaluateCurve(Transition, 0.0f), 0.0f);
+				TestEqual("End", FColorTransitionController::EvaluateCurve(Transition, 1.0f), 1.0f);
+			}
+		});
+
+		It("should ease", [this]() {
+			TestEqual("Linear", FColorTransitionController::EvaluateCurve(MakeTransition(Black, 1.0f), 0.25f), 0.25f);
+			TestTrue("Ease in is slower at the start", FColorTransitionController::EvaluateCurve(MakeTransition(Black, 1.0f, EOculusXRColorTransitionCurve::EaseIn), 0.25f) < 0.25f);
+			TestTrue("Ease out is faster at the start", FColorTransitionController::EvaluateCurve(MakeTransition(Black, 1.0f, EOculusXRColorTransitionCurve::EaseOut), 0.25f) > 0.25f);
+			TestEqual("Ease in out is symmetric", FColorTransitionController::EvaluateCurve(MakeTransition(Black, 1.0f, EOculusXRColorTransitionCurve::EaseInOut), 0.5f), 0.5f);
+		});
+
+		It("should prefer the custom curve", [this]() {
+			UCurveFloat* CustomCurve = NewObject<UCurveFloat>();
+			CustomCurve->FloatCurve.AddKey(0.0f, 0.0f);
+			CustomCurve->FloatCurve.AddKey(0.5f, 1.2f);
+			CustomCurve->FloatCurve.AddKey(1.0f, 1.0f);
+
+			FColorTransition Transition = MakeTransition(Black, 1.0f);
+			Transition.CustomCurve = CustomCurve;
+			TestEqual("Overshoot", FColorTransitionController::EvaluateCurve(Transition, 0.5f), 1.2f);
+		});
+	});
+
+	Describe("Transitions", [this]() {
+		It("should fade to the target over the duration", [this]() {
+			Controller.AddTransition(FColorTransitionController::AllLayers, MakeTransition(Black, 1.0f), false);
+			Controller.Update(0.5f);
+			TestEqual("Half way", Controller.GetValue(FColorTransitionController::AllLayers).Scale.R, 0.5f, UE_KINDA_SMALL_NUMBER);
+			TestTrue("Transitioning", Controller.IsTransitioning(FColorTransitionController::AllLayers));
+			Controller.Update(0.5f);
+			TestTrue("At the target", Controller.GetValue(FColorTransitionController::AllLayers) == Black);
+			TestFalse("Finished", Controller.IsTransitioning(FColorTransitionController::AllLayers));
+		});
+
+		It("should jump to the target without a duration", [this]() {
+			Controller.AddTransition(0, MakeTransition(Red, 0.0f), false);
+			Controller.Update(0.0f);
+			TestTrue("At the target", Controller.GetValue(0) == Red);
+		});
+
+		It("should play queued transitions one after the other", [this]() {
+			Controller.AddTransition(FColorTransitionController::AllLayers, MakeTransition(Black, 1.0f), true);
+			Controller.AddTransition(FColorTransitionController::AllLayers, MakeTransition(FColorScaleAndOffset(), 1.0f), true);
+
+			// The time left over by the first transition goes to the second one
+			Controller.Update(1.25f);
+			TestEqual("Fading back in", Controller.GetValue(FColorTransitionController::AllLayers).Scale.R, 0.25f, UE_KINDA_SMALL_NUMBER);
+			Controller.Update(1.0f);
+			TestTrue("Back at the identity", Controller.GetValue(FColorTransitionController::AllLayers).IsIdentity());
+		});
+
+		It("should start replacing transitions from the current value", [this]() {
+			Controller.AddTransition(FColorTransitionController::AllLayers, MakeTransition(Black, 1.0f), false);
+			Controller.Update(0.5f);
+			Controller.AddTransition(FColorTransitionController::AllLayers, MakeTransition(FColorScaleAndOffset(), 1.0f), false);
+			Controller.Update(0.0f);
+			TestEqual("No jump", Controller.GetValue(FColorTransitionController::AllLayers).Scale.R, 0.5f, UE_KINDA_SMALL_NUMBER);
+			Controller.Update(0.5f);
+			TestEqual("Half way back", Controller.GetValue(FColorTransitionController::AllLayers).Scale.R, 0.75f, UE_KINDA_SMALL_NUMBER);
+		});
+
+		It("should keep the current value when cancelled", [this]() {
+			Controller.AddTransition(FColorTransitionController::AllLayers, MakeTransition(Black, 1.0f), false);
+			Controller.Update(0.5f);
+			Controller.Cancel(FColorTransitionController::AllLayers);
+			Controller.Update(0.5f);
+			TestEqual("Stopped", Controller.GetValue(FColorTransitionController::AllLayers).Scale.R, 0.5f, UE_KINDA_SMALL_NUMBER);
+		});
+	});
+
+	Describe("Layers", [this]() {
+		It("should transition the layers independently", [this]() {
+			Controller.AddTransition(0, MakeTransition(Red, 1.0f), false);
+			Controller.AddTransition(FColorTransitionController::AllLayers, MakeTransition(Black, 2.0f), false);
+			Controller.Update(1.0f);
+			TestTrue("Eye layer at the target", Controller.GetValue(0) == Red);
+			TestTrue("All layers still transitioning", Controller.IsTransitioning(FColorTransitionController::AllLayers));
+			TestTrue("Other layers unchanged", Controller.GetValue(1).IsIdentity());
+		});
+
+		It("should only report the layers that are changed", [this]() {
+			Controller.Set(1, Red);
+			Controller.AddTransition(2, MakeTransition(FColorScaleAndOffset(), 1.0f), false);
+			Controller.Update(0.5f);
+
+			TMap<uint32, FColorScaleAndOffset> Values;
+			Controller.GetLayerValues(Values);
+			TestEqual("Num layers", Values.Num(), 1);
+			TestTrue("Layer 1", Values.Contains(1));
+
+			Controller.RemoveLayer(1);
+			Controller.GetLayerValues(Values);
+			TestEqual("Num layers after removing", Values.Num(), 0);
+		});
+
+		It("should apply the layer color before the all layers color", [this]() {
+			const FColorScaleAndOffset Layer{ FLinearColor(0.5f, 0.5f, 0.5f, 1.0f), FLinearColor(0.2f, 0.2f, 0.2f, 0.0f) };
+			const FColorScaleAndOffset All{ FLinearColor(0.5f, 0.5f, 0.5f, 1.0f), FLinearColor(0.1f, 0.1f, 0.1f, 0.0f) };
+			const FColorScaleAndOffset Composed = FColorScaleAndOffset::Compose(Layer, All);
+
+			// (1 * 0.5 + 0.2) * 0.5 + 0.1
+			const float Color = 1.0f;
+			TestEqual("Composed", Color * Composed.Scale.R + Composed.Offset.R, 0.45f, UE_KINDA_SMALL_NUMBER);
+		});
+	});
+}
+
+#endif // OCULUS_HMD_SUPPORTED_PLATFORMS
@@ -0,0 +1,103 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "OculusXRHMD_FoveatedRendering.h"
+
+#if !UE_VERSION_OLDER_THAN(5, 3, 0)
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "RenderGraphResources.h"
+
+namespace
+{
+	constexpr int32 NumSwapchainImages = 3;
+
+	// Creates a foveation swapchain like the eye layer does, runs on the render thread
+	FXRSwapChainPtr CreateFoveationSwapchain(FRHICommandListImmediate& RHICmdList, const TCHAR* Name)
+	{
+		const FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2DArray(Name, 32, 32, 2, PF_R8G8)
+											   .SetFlags(ETextureCreateFlags::Foveation | ETextureCreateFlags::ShaderResource);
+		TArray<FTextureRHIRef> Textures;
+		for (int32 Index = 0; Index < NumSwapchainImages; ++Index)
+		{
+			Textures.Add(RHICreateTexture(Desc));
+		}
+		FTextureRHIRef Texture = Textures[0];
+		return CreateXRSwapChain(MoveTemp(Textures), Texture);
+	}
+
+	template <typename FunctionType>
+	void RunOnRenderThread(FunctionType&& Function)
+	{
+		ENQUEUE_RENDER_COMMAND(OculusFoveatedRenderingTest)
+		([Function = MoveTemp(Function)](FRHICommandListImmediate& RHICmdList) { Function(RHICmdList); });
+		FlushRenderingCommands();
+	}
+} // namespace
+
+// Runs on any RHI, including NullRHI, as it only wraps the swapchain textures and doesn't render
+BEGIN_DEFINE_SPEC(FOculusXRFoveatedRenderingSpec, TEXT("OculusXR Foveated Rendering"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FOculusXRFoveatedRenderingSpec)
+
+void FOculusXRFoveatedRenderingSpec::Define()
+{
+	Describe("Shading rate image pool", [this]() {
+		It("should wrap the swapchain texture when the generator is created", [this]() {
+			RunOnRenderThread([this](FRHICommandListImmediate& RHICmdList) {
+				const FOculusXRFoveatedRenderingImageGenerator Generator(CreateFoveationSwapchain(RHICmdList, TEXT("FoveationTest")));
+				TestEqual("Created", Generator.GetPoolStats().NumCreated, 1u);
+				TestEqual("Reused", Generator.GetPoolStats().NumReused, 0u);
+			});
+		});
+
+		It("should not allocate in the steady state", [this]() {
+			RunOnRenderThread([this](FRHICommandListImmediate& RHICmdList) {
+				FOculusXRFoveatedRenderingImageGenerator Generator(CreateFoveationSwapchain(RHICmdList, TEXT("FoveationTest")));
+				const TRefCountPtr<IPooledRenderTarget>* First = Generator.FindOrAddPooledImage();
+				if (!TestNotNull("Pooled image", First))
+				{
+					return;
+				}
+				const IPooledRenderTarget* FirstRenderTarget = First->GetReference();
+
+				// Two views per frame for a few hundred frames
+				constexpr uint32 NumRequests = 2 * 300;
+				bool bSameRenderTarget = true;
+				for (uint32 Request = 0; Request < NumRequests; ++Request)
+				{
+					const TRefCountPtr<IPooledRenderTarget>* PooledImage = Generator.FindOrAddPooledImage();
+					bSameRenderTarget &= PooledImage && PooledImage->GetReference() == FirstRenderTarget;
+				}
+
+				TestTrue("Same render target", bSameRenderTarget);
+				TestEqual("Created", Generator.GetPoolStats().NumCreated, 1u);
+				TestEqual("Reused", Generator.GetPoolStats().NumReused, NumRequests + 1);
+			});
+		});
+
+		It("should create a new pool for a new swapchain", [this]() {
+			RunOnRenderThread([this](FRHICommandListImmediate& RHICmdList) {
+				FOculusXRFoveatedRenderingImageGenerator Generator(CreateFoveationSwapchain(RHICmdList, TEXT("FoveationTest")));
+				FOculusXRFoveatedRenderingImageGenerator ReallocatedGenerator(CreateFoveationSwapchain(RHICmdList, TEXT("FoveationTestReallocated")));
+				const TRefCountPtr<IPooledRenderTarget>* PooledImage = Generator.FindOrAddPooledImage();
+				const TRefCountPtr<IPooledRenderTarget>* ReallocatedPooledImage = ReallocatedGenerator.FindOrAddPooledImage();
+				if (TestNotNull("Pooled image", PooledImage) && TestNotNull("Reallocated pooled image", ReallocatedPooledImage))
+				{
+					TestNotEqual("Render target", PooledImage->GetReference(), ReallocatedPooledImage->GetReference());
+				}
+				TestEqual("Created", ReallocatedGenerator.GetPoolStats().NumCreated, 1u);
+			});
+		});
+
+		It("should not create images without a swapchain", [this]() {
+			RunOnRenderThread([this](FRHICommandListImmediate&) {
+				FOculusXRFoveatedRenderingImageGenerator Generator(nullptr);
+				TestNull("Pooled image", Generator.FindOrAddPooledImage());
+				TestEqual("Created", Generator.GetPoolStats().NumCreated, 0u);
+			});
+		});
+	});
+}
+
+#endif // !UE_VERSION_OLDER_THAN(5, 3, 0)
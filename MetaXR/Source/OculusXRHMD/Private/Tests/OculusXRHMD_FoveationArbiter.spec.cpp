@@ -0,0 +1,252 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "OculusXRHMD_FoveationArbiter.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+
+namespace
+{
+	using namespace OculusXRHMD;
+
+	// Plays back a recorded confidence trace, one sample per frame, and repeats the last sample at the end
+	class FRecordedGazeSource : public IFoveationGazeSource
+	{
+	public:
+		TArray<FFoveationGazeSample> Trace;
+		int32 NextSample = 0;
+		int32 NumStarts = 0;
+		int32 NumStops = 0;
+
+		void Record(float Confidence, int32 NumFrames, bool bIsValid = true)
+		{
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Trace.Add({ bIsValid, Confidence });
+			}
+		}
+
+		virtual bool Start() override
+		{
+			++NumStarts;
+			return true;
+		}
+
+		virtual void Stop() override { ++NumStops; }
+
+		virtual bool GetGazeSample(FFoveationGazeSample& OutSample) override
+		{
+			if (Trace.IsEmpty())
+			{
+				return false;
+			}
+			OutSample = Trace[FMath::Min(NextSample++, Trace.Num() - 1)];
+			return true;
+		}
+	};
+
+	constexpr float FrameDelta = 1.0f / 72.0f;
+
+	int32 Frames(float Seconds)
+	{
+		return FMath::CeilToInt(Seconds / FrameDelta);
+	}
+
+	// Plays back the whole recorded trace, returns the mode after the last frame
+	bool Play(FFoveationArbiter& Arbiter, FRecordedGazeSource& Source)
+	{
+		bool bEyeTracked = Arbiter.IsEyeTracked();
+		while (Source.NextSample < Source.Trace.Num())
+		{
+			bEyeTracked = Arbiter.Update(FrameDelta);
+		}
+		return bEyeTracked;
+	}
+
+	void Filter(FFoveationArbiter& Arbiter, const FFoveationArbiter::FOffsetFilterSettings& Settings, double Time, FVector2f Center, FVector2f OutCenters[2])
+	{
+		const FVector2f InCenters[2] = { Center, Center };
+		Arbiter.FilterOffsets(Settings, Time, InCenters, OutCenters);
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FOculusXRFoveationArbiterSpec, TEXT("OculusXR Foveation Arbiter"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TSharedPtr<FRecordedGazeSource> Source;
+TUniquePtr<FFoveationArbiter> Arbiter;
+END_DEFINE_SPEC(FOculusXRFoveationArbiterSpec)
+
+void FOculusXRFoveationArbiterSpec::Define()
+{
+	BeforeEach([this]() {
+		Source = MakeShared<FRecordedGazeSource>();
+		Arbiter = MakeUnique<FFoveationArbiter>(Source);
+
+		FFoveationArbiter::FModeSettings Settings;
+		Settings.DegradeConfidence = 0.5f;
+		Settings.RestoreConfidence = 0.75f;
+		Settings.DegradeDelay = 0.2f;
+		Settings.RestoreDelay = 1.0f;
+		Arbiter->SetModeSettings(Settings);
+	});
+
+	Describe("Mode", [this]() {
+		It("should stay eye tracked while the confidence is high", [this]() {
+			Source->Record(0.9f, Frames(5.0f));
+			TestTrue("Eye tracked", Play(*Arbiter, *Source));
+			TestEqual("No degrades", Arbiter->GetStats().NumDegrades, 0);
+		});
+
+		It("should degrade once the confidence stayed low for the degrade delay", [this]() {
+			Source->Record(0.9f, Frames(1.0f));
+			Source->Record(0.2f, Frames(0.1f));
+			TestTrue("Eye tracked before the delay", Play(*Arbiter, *Source));
+			Source->Record(0.2f, Frames(0.15f));
+			TestFalse("Fixed after the delay", Play(*Arbiter, *Source));
+			TestEqual("One degrade", Arbiter->GetStats().NumDegrades, 1);
+		});
+
+		It("should treat invalid gazes as low confidence", [this]() {
+			Source->Record(0.9f, Frames(0.5f), false);
+			TestFalse("Fixed", Play(*Arbiter, *Source));
+		});
+
+		It("should ignore blinks shorter than the degrade delay", [this]() {
+			for (int32 Blink = 0; Blink < 20; ++Blink)
+			{
+				Source->Record(0.9f, Frames(2.0f));
+				Source->Record(0.0f, Frames(0.15f), false);
+			}
+			TestTrue("Eye tracked", Play(*Arbiter, *Source));
+		});
+
+		It("should keep its mode while no samples are available", [this]() {
+			for (int32 Frame = 0; Frame < Frames(1.0f); ++Frame)
+			{
+				Arbiter->Update(FrameDelta);
+			}
+			TestTrue("Eye tracked", Arbiter->IsEyeTracked());
+		});
+
+		It("should stay fixed between the thresholds", [this]() {
+			Source->Record(0.2f, Frames(0.5f));
+			Source->Record(0.6f, Frames(5.0f));
+			TestFalse("Fixed", Play(*Arbiter, *Source));
+		});
+
+		It("should restore once the confidence stayed high for the restore delay", [this]() {
+			Source->Record(0.2f, Frames(0.5f));
+			Source->Record(0.9f, Frames(0.8f));
+			TestFalse("Fixed before the delay", Play(*Arbiter, *Source));
+			Source->Record(0.9f, Frames(0.3f));
+			TestTrue("Eye tracked after the delay", Play(*Arbiter, *Source));
+			TestEqual("One restore", Arbiter->GetStats().NumRestores, 1);
+		});
+
+		It("should not oscillate on a noisy trace around the degrade threshold", [this]() {
+			for (int32 Frame = 0; Frame < Frames(10.0f); ++Frame)
+			{
+				Source->Record(Frame % 4 == 0 ? 0.4f : 0.6f, 1);
+			}
+			TestTrue("Eye tracked", Play(*Arbiter, *Source));
+			TestEqual("No degrades", Arbiter->GetStats().NumDegrades, 0);
+		});
+
+		It("should keep eye tracked foveation after a reset", [this]() {
+			Source->Record(0.2f, Frames(0.5f));
+			Play(*Arbiter, *Source);
+			Arbiter->Reset();
+			TestTrue("Eye tracked", Arbiter->IsEyeTracked());
+		});
+
+		It("should start the gaze source while gating and stop it on reset", [this]() {
+			Arbiter->Reset();
+			TestEqual("Not started before the first update", Source->NumStarts, 0);
+			TestEqual("Nothing to stop", Source->NumStops, 0);
+
+			Source->Record(0.9f, Frames(1.0f));
+			Play(*Arbiter, *Source);
+			TestEqual("Started once", Source->NumStarts, 1);
+
+			Arbiter->Reset();
+			Arbiter->Reset();
+			TestEqual("Stopped once", Source->NumStops, 1);
+
+			Arbiter->Update(FrameDelta);
+			TestEqual("Started again", Source->NumStarts, 2);
+		});
+	});
+
+	Describe("Stats", [this]() {
+		It("should accumulate the dwell times per mode", [this]() {
+			Source->Record(0.9f, Frames(2.0f));
+			Source->Record(0.2f, Frames(3.0f));
+			Source->Record(0.9f, Frames(2.0f));
+			Play(*Arbiter, *Source);
+
+			const FFoveationArbiter::FStats& Stats = Arbiter->GetStats();
+			TestEqual("Degrades", Stats.NumDegrades, 1);
+			TestEqual("Restores", Stats.NumRestores, 1);
+			// Degrades 0.2 s into the low confidence and restores 1 s into the high confidence
+			TestEqual("Fixed time", Stats.FixedTime, 3.8, 0.05);
+			TestEqual("Eye tracked time", Stats.EyeTrackedTime, 3.2, 0.05);
+			TestEqual("Longest fixed dwell", Stats.LongestFixedDwellTime, 3.8f, 0.05f);
+			TestEqual("Current dwell", Stats.CurrentDwellTime, 1.0f, 0.05f);
+		});
+	});
+
+	Describe("Offsets", [this]() {
+		It("should smooth small movements", [this]() {
+			FFoveationArbiter::FOffsetFilterSettings Settings;
+			FVector2f Centers[2];
+			Filter(*Arbiter, Settings, 0.0, FVector2f(0.0f, 0.0f), Centers);
+			Filter(*Arbiter, Settings, FrameDelta, FVector2f(0.1f, 0.0f), Centers);
+			TestTrue("Moved towards the target", Centers[0].X > 0.0f && Centers[0].X < 0.1f);
+			TestEqual("Both eyes", Centers[1].X, Centers[0].X);
+		});
+
+		It("should settle on jitter around a fixation", [this]() {
+			FFoveationArbiter::FOffsetFilterSettings Settings;
+			FVector2f Centers[2];
+			float MaxStep = 0.0f;
+			float Previous = 0.0f;
+			for (int32 Frame = 0; Frame < Frames(2.0f); ++Frame)
+			{
+				Filter(*Arbiter, Settings, Frame * FrameDelta, FVector2f(Frame % 2 ? 0.04f : -0.04f, 0.0f), Centers);
+				if (Frame > Frames(1.0f))
+				{
+					MaxStep = FMath::Max(MaxStep, FMath::Abs(Centers[0].X - Previous));
+				}
+				Previous = Centers[0].X;
+			}
+			TestTrue("Jitter suppressed", MaxStep < 0.02f);
+		});
+
+		It("should snap on saccades", [this]() {
+			FFoveationArbiter::FOffsetFilterSettings Settings;
+			FVector2f Centers[2];
+			Filter(*Arbiter, Settings, 0.0, FVector2f(0.0f, 0.0f), Centers);
+			Filter(*Arbiter, Settings, FrameDelta, FVector2f(0.5f, 0.2f), Centers);
+			TestTrue("Snapped", Centers[0].Equals(FVector2f(0.5f, 0.2f)));
+		});
+
+		It("should clamp to the max offset", [this]() {
+			FFoveationArbiter::FOffsetFilterSettings Settings;
+			Settings.MaxOffset = 0.5f;
+			FVector2f Centers[2];
+			Filter(*Arbiter, Settings, 0.0, FVector2f(0.9f, -1.0f), Centers);
+			TestTrue("Clamped", Centers[0].Equals(FVector2f(0.5f, -0.5f)));
+		});
+
+		It("should pass the centers through without smoothing", [this]() {
+			FFoveationArbiter::FOffsetFilterSettings Settings;
+			Settings.SmoothingTime = 0.0f;
+			FVector2f Centers[2];
+			Filter(*Arbiter, Settings, 0.0, FVector2f(0.0f, 0.0f), Centers);
+			Filter(*Arbiter, Settings, FrameDelta, FVector2f(0.1f, 0.0f), Centers);
+			TestTrue("Unfiltered", Centers[0].Equals(FVector2f(0.1f, 0.0f)));
+		});
+	});
+}
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
@@ -0,0 +1,129 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "OculusXRHMD_SpaceWarpController.h"
+
+#if OCULUS_HMD_SUPPORTED_PLATFORMS
+
+namespace
+{
+	using namespace OculusXRHMD;
+
+	// 90 Hz display, the budget is 11.1 ms
+	class FSimulatedTimingSource : public ISpaceWarpTimingSource
+	{
+	public:
+		FSpaceWarpFrameTiming Timing{ 8.0f, 90.0f, 0.0f };
+		bool bAvailable = true;
+
+		virtual bool GetFrameTiming(FSpaceWarpFrameTiming& OutTiming) override
+		{
+			OutTiming = Timing;
+			return bAvailable;
+		}
+	};
+
+	constexpr float FrameDelta = 1.0f / 90.0f;
+
+	// Runs the controller for the given time with a constant frame time, returns the state after the last frame
+	bool Run(FSpaceWarpController& Controller, FSimulatedTimingSource& Source, float FrameTime, float Seconds, float HeadAngularSpeed = 0.0f)
+	{
+		Source.Timing.FrameTime = FrameTime;
+		Source.Timing.HeadAngularSpeed = HeadAngularSpeed;
+		bool bEnabled = Controller.IsEnabled();
+		for (float Time = 0.0f; Time < Seconds; Time += FrameDelta)
+		{
+			bEnabled = Controller.Update(FrameDelta);
+		}
+		return bEnabled;
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FOculusXRSpaceWarpControllerSpec, TEXT("OculusXR SpaceWarp Controller"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TSharedPtr<FSimulatedTimingSource> Source;
+TUniquePtr<FSpaceWarpController> Controller;
+END_DEFINE_SPEC(FOculusXRSpaceWarpControllerSpec)
+
+void FOculusXRSpaceWarpControllerSpec::Define()
+{
+	BeforeEach([this]() {
+		Source = MakeShared<FSimulatedTimingSource>();
+		Controller = MakeUnique<FSpaceWarpController>(Source);
+
+		FSpaceWarpController::FSettings Settings;
+		Settings.EnableHeadroom = 0.0f;
+		Settings.DisableHeadroom = 0.25f;
+		Settings.EnableDelay = 0.5f;
+		Settings.DisableDelay = 2.0f;
+		Settings.CriticalHeadroom = -0.3f;
+		Settings.MaxToggleHeadAngularSpeed = 60.0f;
+		Settings.SmoothingTime = 0.0f;
+		Controller->SetSettings(Settings);
+	});
+
+	Describe("Headroom", [this]() {
+		It("should stay off while the frame fits into the budget", [this]() {
+			TestFalse("Disabled", Run(*Controller, *Source, 10.5f, 5.0f));
+			TestEqual("Budget", Controller->GetStats().FrameBudget, 1000.0f / 90.0f, 0.001f);
+		});
+
+		It("should turn on once the frame time exceeded the budget for the enable delay", [this]() {
+			TestFalse("Disabled before the delay", Run(*Controller, *Source, 12.0f, 0.4f));
+			TestTrue("Enabled after the delay", Run(*Controller, *Source, 12.0f, 0.2f));
+			TestEqual("One enable", Controller->GetStats().NumEnables, 1);
+		});
+
+		It("should ignore spikes shorter than the enable delay", [this]() {
+			for (int32 Spike = 0; Spike < 10; ++Spike)
+			{
+				Run(*Controller, *Source, 14.0f, 0.3f);
+				Run(*Controller, *Source, 9.0f, 0.1f);
+			}
+			TestFalse("Disabled", Controller->IsEnabled());
+		});
+
+		It("should stay on between the thresholds", [this]() {
+			Run(*Controller, *Source, 12.0f, 1.0f);
+			TestTrue("Enabled", Controller->IsEnabled());
+
+			// 10 ms is within budget but leaves less than 25% headroom
+			TestTrue("Still enabled", Run(*Controller, *Source, 10.0f, 10.0f));
+		});
+
+		It("should turn off once there was enough headroom for the disable delay", [this]() {
+			Run(*Controller, *Source, 12.0f, 1.0f);
+			TestTrue("Still enabled before the delay", Run(*Controller, *Source, 7.0f, 1.5f));
+			TestFalse("Disabled after the delay", Run(*Controller, *Source, 7.0f, 1.0f));
+			TestEqual("One disable", Controller->GetStats().NumDisables, 1);
+		});
+
+		It("should keep its state while no timing is available", [this]() {
+			Run(*Controller, *Source, 12.0f, 1.0f);
+			Source->bAvailable = false;
+			TestTrue("Enabled", Run(*Controller, *Source, 7.0f, 10.0f));
+		});
+	});
+
+	Describe("Motion", [this]() {
+		It("should defer toggles while the head moves fast", [this]() {
+			TestFalse("Deferred", Run(*Controller, *Source, 12.0f, 2.0f, 120.0f));
+			TestEqual("One deferred toggle", Controller->GetStats().NumDeferredToggles, 1);
+			TestTrue("Enabled once the motion settled", Run(*Controller, *Source, 12.0f, FrameDelta, 10.0f));
+		});
+
+		It("should turn on during fast motion when far over budget", [this]() {
+			TestTrue("Enabled", Run(*Controller, *Source, 15.0f, 1.0f, 120.0f));
+		});
+	});
+
+	Describe("Reset", [this]() {
+		It("should start from the given state", [this]() {
+			Controller->Reset(true);
+			TestTrue("Enabled", Controller->IsEnabled());
+			TestTrue("Still enabled within the disable delay", Run(*Controller, *Source, 7.0f, 1.0f));
+		});
+	});
+}
+
+#endif //OCULUS_HMD_SUPPORTED_PLATFORMS
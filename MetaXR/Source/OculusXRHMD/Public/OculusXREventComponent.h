@@ -17,6 +17,7 @@ class OCULUSXRHMD_API UOculusXREventComponent : public UActorComponent
 public:
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOculusDisplayRefreshRateChangedEventDelegate, float, fromRefreshRate, float, toRefreshRate);
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOculusEyeTrackingStateChangedEventDelegate, bool, bEyeTrackingOn);
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOculusInputFocusChangedEventDelegate, bool, bHasInputFocus, bool, bSystemOverlayPresent);
 
 	UPROPERTY(BlueprintAssignable)
 	FOculusDisplayRefreshRateChangedEventDelegate OculusDisplayRefreshRateChanged;
@@ -24,6 +25,9 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FOculusEyeTrackingStateChangedEventDelegate OculusEyeTrackingStateChanged;
 
+	UPROPERTY(BlueprintAssignable)
+	FOculusInputFocusChangedEventDelegate OculusInputFocusChanged;
+
 	void OnRegister() override;
 	void OnUnregister() override;
 
@@ -31,4 +35,5 @@ private:
 	/** Native handlers that get registered with the actual FCoreDelegates, and then proceed to broadcast to the delegates above */
 	void OculusDisplayRefreshRateChanged_Handler(float fromRefresh, float toRefresh) { OculusDisplayRefreshRateChanged.Broadcast(fromRefresh, toRefresh); }
 	void OculusEyeTrackingStateChanged_Handler(bool bEyeTrackingOn) { OculusEyeTrackingStateChanged.Broadcast(bEyeTrackingOn); }
+	void OculusInputFocusChanged_Handler(bool bHasInputFocus, bool bSystemOverlayPresent) { OculusInputFocusChanged.Broadcast(bHasInputFocus, bSystemOverlayPresent); }
 };
@@ -14,6 +14,8 @@ namespace OculusXRHMD
 	class FOculusXRHMD;
 }
 
+class UCurveFloat;
+
 UCLASS()
 class OCULUSXRHMD_API UOculusXRFunctionLibrary : public UBlueprintFunctionLibrary
 {
@@ -268,6 +270,31 @@ class OCULUSXRHMD_API UOculusXRFunctionLibrary : public UBlueprintFunctionLibrar
 	UFUNCTION(BlueprintCallable, Category = "OculusLibrary")
 	static void SetColorScaleAndOffset(FLinearColor ColorScale, FLinearColor ColorOffset, bool bApplyToAllLayers = false);
 
+	/**
+	* Transitions the Color Scale/Offset over time, e.g. to fade to black or tint the view. The compositor applies the
+	* color, so fades don't cost any GPU time. Transitions are evaluated once per frame.
+	* @param Duration			Seconds the transition takes, 0 jumps to the target on the next frame
+	* @param Curve				Easing of the transition
+	* @param CustomCurve		Easing evaluated over the normalized time in range [0,1] instead of Curve if set
+	* @param bQueue				Starts the transition after the ones already running for the same layers, otherwise replaces them
+	* @param bApplyToAllLayers	Targets all layers, the layer specific colors are applied first
+	* @param LayerId			Id of the stereo layer to target if not applied to all layers, 0 is the eye layer
+	*/
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary", meta = (AdvancedDisplay = "CustomCurve,LayerId"))
+	static void StartColorScaleAndOffsetTransition(FLinearColor ColorScale, FLinearColor ColorOffset, float Duration, EOculusXRColorTransitionCurve Curve = EOculusXRColorTransitionCurve::Linear, UCurveFloat* CustomCurve = nullptr, bool bQueue = false, bool bApplyToAllLayers = false, int32 LayerId = 0);
+
+	/**
+	* Stops the running and queued Color Scale/Offset transitions, the current color is kept
+	*/
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary", meta = (AdvancedDisplay = "LayerId"))
+	static void CancelColorScaleAndOffsetTransitions(bool bApplyToAllLayers = false, int32 LayerId = 0);
+
+	/**
+	* Returns true while Color Scale/Offset transitions are running or queued
+	*/
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary", meta = (AdvancedDisplay = "LayerId"))
+	static bool IsColorScaleAndOffsetTransitioning(bool bApplyToAllLayers = false, int32 LayerId = 0);
+
 	/**
 	* Returns true if system headset is in 3dof mode
 	*/
@@ -307,6 +334,7 @@ class OCULUSXRHMD_API UOculusXRFunctionLibrary : public UBlueprintFunctionLibrar
 	/**
 	* Create the environment depth texture swap chain and start receiving
 	* depth texture every frame until stopped.
+	* This registers a consumer of environment depth, see AddEnvironmentDepthConsumer().
 	*/
 	UFUNCTION(BlueprintCallable, Category = "OculusLibrary")
 	static void StartEnvironmentDepth();
@@ -315,6 +343,7 @@ class OCULUSXRHMD_API UOculusXRFunctionLibrary : public UBlueprintFunctionLibrar
 	* Destroy the environment depth texture swap chain and stop receiving
 	* new depth textures every frame. Call this when environment depth is
 	* no longer needed to free up resources.
+	* Environment depth keeps running while other consumers are registered.
 	*/
 	UFUNCTION(BlueprintCallable, Category = "OculusLibrary")
 	static void StopEnvironmentDepth();
@@ -326,6 +355,28 @@ class OCULUSXRHMD_API UOculusXRFunctionLibrary : public UBlueprintFunctionLibrar
 	UFUNCTION(BlueprintPure, Category = "OculusLibrary")
 	static bool IsEnvironmentDepthStarted();
 
+	/**
+	* Register interest in environment depth. Environment depth is started when the first consumer
+	* is added and stopped a while after the last consumer is removed (r.Mobile.Oculus.EnvironmentDepth.IdleTimeout).
+	* Occlusions register themselves. Registrations are counted, every add needs a matching remove.
+	* @param ConsumerName	Name of the consumer, for logging.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary")
+	static void AddEnvironmentDepthConsumer(FName ConsumerName);
+
+	/**
+	* Remove a consumer added with AddEnvironmentDepthConsumer().
+	* @param ConsumerName	Name of the consumer.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary")
+	static void RemoveEnvironmentDepthConsumer(FName ConsumerName);
+
+	/**
+	* Returns how long environment depth has been running and how often it was started and stopped.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary")
+	static void GetEnvironmentDepthStats(FOculusXREnvironmentDepthStats& EnvironmentDepthStats);
+
 	/**
 	* When hands removal is enabled and hand tracking is active, the region
 	* of the depth texture which contains the hands will be replaced with
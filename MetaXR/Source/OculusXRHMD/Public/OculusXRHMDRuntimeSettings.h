@@ -210,6 +210,10 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = Mobile, meta = (DisplayName = "Tile Turn Off", EditCondition = "false"))
 	bool bTileTurnOffEnabled;
 
+	/** How the app reduces its workload while the universal menu or a system dialog takes the input focus away. See UOculusXRWorkloadThrottleSubsystem. */
+	UPROPERTY(config, EditAnywhere, Category = "Mobile|Workload Throttling")
+	FOculusXRWorkloadThrottlePolicy WorkloadThrottlePolicy;
+
 private:
 #if WITH_EDITOR
 	virtual bool CanEditChange(const FProperty* InProperty) const override;
@@ -125,6 +125,17 @@ enum class EOculusXRColorSpace : uint8
 	Adobe_RGB = 8,
 };
 
+UENUM(BlueprintType)
+enum class EOculusXRColorTransitionCurve : uint8
+{
+	Linear,
+	/// Starts slow and speeds up
+	EaseIn,
+	/// Starts fast and slows down
+	EaseOut,
+	EaseInOut,
+};
+
 /*
 * Hand tracking settings. Please check https://developer.oculus.com/documentation/unreal/unreal-hand-tracking/
 * for detailed information.
@@ -419,6 +430,142 @@ struct FOculusXRPerformanceMetrics
 	}
 };
 
+USTRUCT(BlueprintType, meta = (DisplayName = "Oculus Environment Depth Stats"))
+struct FOculusXREnvironmentDepthStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Whether the runtime is currently producing environment depth */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Environment Depth")
+	bool bIsRunning;
+
+	/** Number of registered consumers */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Environment Depth")
+	int NumConsumers;
+
+	/** Total time in seconds environment depth has been running */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Environment Depth")
+	float ActiveTime;
+
+	/** Number of times environment depth was started or resumed */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Environment Depth")
+	int NumStarts;
+
+	/** Number of times environment depth was stopped or suspended */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Environment Depth")
+	int NumStops;
+
+	/** Number of times the depth swapchain was created */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Environment Depth")
+	int NumSwapchainCreations;
+
+	/** Number of times the depth swapchain was released */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Environment Depth")
+	int NumSwapchainReleases;
+
+	FOculusXREnvironmentDepthStats()
+		: bIsRunning(false)
+		, NumConsumers(0)
+		, ActiveTime(0.f)
+		, NumStarts(0)
+		, NumStops(0)
+		, NumSwapchainCreations(0)
+		, NumSwapchainReleases(0)
+	{
+	}
+};
+
+/** What the app does while a system overlay such as the universal menu takes the input focus away */
+USTRUCT(BlueprintType, meta = (DisplayName = "Oculus Workload Throttle Policy"))
+struct FOculusXRWorkloadThrottlePolicy
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Throttle the workload when the app loses input focus */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	bool bThrottleOnInputFocusLoss;
+
+	/** Throttle the workload while a system overlay is present, even if the app keeps the input focus */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	bool bThrottleOnSystemOverlay;
+
+	/** Tick interval in seconds of the actors and components registered for tick throttling. 0 keeps their tick rate. */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling", meta = (ClampMin = "0.0"))
+	float ThrottledTickInterval;
+
+	/** Pause the body, face and eye tracking components while throttled. Other throttleable objects can use it as a hint too. */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	bool bPauseTrackingConsumers;
+
+	/** Pause the MR Utility Kit world lock while throttled, the pawn isn't moved while the head pose may be stale */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	bool bPauseWorldLock;
+
+	/** Stop updating the passthrough layer components while throttled. The layers keep their current style and geometry. */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	bool bPausePassthroughUpdates;
+
+	/** Stop the haptic effects of all local player controllers */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	bool bStopHaptics;
+
+	/** Pause the game of all local player controllers. Only games that aren't paused already get unpaused again. */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	bool bPauseGame;
+
+	/** Suspend async package loading. Code that flushes async loading while throttled will stall until the focus returns. */
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	bool bSuspendAsyncLoading;
+
+	FOculusXRWorkloadThrottlePolicy()
+		: bThrottleOnInputFocusLoss(true)
+		, bThrottleOnSystemOverlay(true)
+		, ThrottledTickInterval(0.1f)
+		, bPauseTrackingConsumers(true)
+		, bPauseWorldLock(true)
+		, bPausePassthroughUpdates(true)
+		, bStopHaptics(true)
+		, bPauseGame(false)
+		, bSuspendAsyncLoading(false)
+	{
+	}
+};
+
+USTRUCT(BlueprintType, meta = (DisplayName = "Oculus Workload Throttle Stats"))
+struct FOculusXRWorkloadThrottleStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Whether the workload is currently throttled */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	bool bIsThrottled;
+
+	/** Number of times the workload was throttled */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	int NumThrottles;
+
+	/** Total time in seconds the workload has been throttled */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	float ThrottledTime;
+
+	/** Number of registered throttleable objects */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	int NumThrottleables;
+
+	/** Number of actors and components registered for tick throttling */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Workload Throttling")
+	int NumTickThrottled;
+
+	FOculusXRWorkloadThrottleStats()
+		: bIsThrottled(false)
+		, NumThrottles(0)
+		, ThrottledTime(0.f)
+		, NumThrottleables(0)
+		, NumTickThrottled(0)
+	{
+	}
+};
+
 UENUM(BlueprintType)
 enum class EOculusXRMPPoseRestoreType : uint8
 {
@@ -0,0 +1,170 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OculusXRTickManager.generated.h"
+
+class UOculusXRTickManager;
+
+/**
+ * Updates the components of one batch that are due. Components in the view are alive, have begun play and have their tick
+ * enabled. DeltaTimes holds the time since the last update of each component, it differs between components with a tick interval.
+ */
+using FOculusXRTickBatchFunction = void (*)(TArrayView<UActorComponent* const> Components, TArrayView<const float> DeltaTimes);
+
+/** Describes a batch of components of the same type, typically a static in the component's translation unit */
+struct FOculusXRTickBatchDesc
+{
+	/** Name of the batch, used for the rate limits, the stats and the profiler scopes */
+	FName Name;
+	ETickingGroup TickGroup;
+	FOculusXRTickBatchFunction Function;
+};
+
+USTRUCT(BlueprintType)
+struct FOculusXRTickBatchStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Number of components in the batch */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|Tick Manager")
+	int32 NumComponents;
+
+	/** Number of batched updates run so far */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|Tick Manager")
+	int32 NumUpdates;
+
+	/** Maximum update rate of the batch in Hz, 0 if the batch updates every frame */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|Tick Manager")
+	float MaxRate;
+
+	/** Duration of the last update in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|Tick Manager")
+	float LastUpdateTime;
+
+	/** Average duration of the updates in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|Tick Manager")
+	float AverageUpdateTime;
+
+	/** Longest update in milliseconds */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|Tick Manager")
+	float MaxUpdateTime;
+
+	FOculusXRTickBatchStats()
+		: NumComponents(0)
+		, NumUpdates(0)
+		, MaxRate(0.0f)
+		, LastUpdateTime(0.0f)
+		, AverageUpdateTime(0.0f)
+		, MaxUpdateTime(0.0f)
+	{
+	}
+};
+
+/** Tick function of one batch, registered with the persistent level of the world */
+USTRUCT()
+struct FOculusXRTickBatchTickFunction : public FTickFunction
+{
+	GENERATED_USTRUCT_BODY()
+
+	UOculusXRTickManager* Manager = nullptr;
+	FName BatchName;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FOculusXRTickBatchTickFunction> : public TStructOpsTypeTraitsBase2<FOculusXRTickBatchTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Runs one update per component type and frame instead of one tick per component. This saves the per component tick
+ * overhead and lets the batch share runtime queries (e.g. the body state) between all of its components.
+ *
+ * Components opt in by overriding RegisterComponentTickFunctions and calling RegisterComponentTick. The component keeps
+ * its tick enabled state and tick interval, SetComponentTickEnabled and SetComponentTickInterval work as before, but its
+ * own tick function is not registered. Components that need more than that keep ticking themselves: blueprint subclasses
+ * that implement the Tick event, and components with tick prerequisites, a tick group other than the one of the batch or
+ * bTickEvenWhenPaused. Components that get one of those after they were batched move back to their own tick function.
+ *
+ * Batches can be rate limited with SetBatchMaxRate or r.Mobile.Oculus.BatchedTick.MaxRates, e.g. "Anchors=30,FaceTracking=30".
+ */
+UCLASS()
+class OCULUSXRHMD_API UOculusXRTickManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Adds or removes the component to or from the batch. Call it from RegisterComponentTickFunctions instead of the super
+	 * implementation. Returns false if the component isn't batched and has to register its own tick function.
+	 */
+	static bool RegisterComponentTick(UActorComponent* Component, bool bRegister, const FOculusXRTickBatchDesc& Batch);
+
+	/** Limits the update rate of the batch. 0 updates it every frame. Overrides r.Mobile.Oculus.BatchedTick.MaxRates. */
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary|Tick Manager")
+	void SetBatchMaxRate(FName BatchName, float MaxRate);
+
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary|Tick Manager")
+	FOculusXRTickBatchStats GetBatchStats(FName BatchName) const;
+
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary|Tick Manager")
+	TArray<FName> GetBatchNames() const;
+
+	void DumpStats(FOutputDevice& Ar) const;
+
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	friend struct FOculusXRTickBatchTickFunction;
+
+	struct FBatchedComponent
+	{
+		TWeakObjectPtr<UActorComponent> Component;
+		/** Time since the component was last updated, used for its tick interval */
+		float TimeSinceUpdate = 0.0f;
+	};
+
+	struct FBatch
+	{
+		FOculusXRTickBatchDesc Desc;
+		FOculusXRTickBatchTickFunction TickFunction;
+		FString ProfilerName;
+		TArray<FBatchedComponent> Components;
+		/** Components and delta times passed to the batch function, kept to avoid an allocation per update */
+		TArray<UActorComponent*> UpdateScratch;
+		TArray<float> DeltaTimeScratch;
+		int32 RateLimitsSerial = -1;
+		int32 NumUpdates = 0;
+		double LastUpdateTime = 0.0;
+		double TotalUpdateTime = 0.0;
+		double MaxUpdateTime = 0.0;
+	};
+
+	/** Whether the component's tick settings can't be honoured by the batch and it has to tick itself */
+	static bool NeedsOwnTickFunction(const UActorComponent* Component, const FOculusXRTickBatchDesc& Desc);
+
+	bool AddComponent(UActorComponent* Component, const FOculusXRTickBatchDesc& Desc);
+	bool RemoveComponent(UActorComponent* Component, FName BatchName);
+	void UpdateBatch(FName BatchName, float DeltaTime);
+	void ApplyMaxRate(FBatch& Batch);
+
+	/** Batches are heap allocated since the engine keeps pointers to their tick functions */
+	TMap<FName, TUniquePtr<FBatch>> Batches;
+	/** Rates set by SetBatchMaxRate, they take precedence over the console variable */
+	TMap<FName, float> MaxRateOverrides;
+};
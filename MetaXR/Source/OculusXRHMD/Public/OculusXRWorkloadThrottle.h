@@ -0,0 +1,98 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "OculusXRHMDTypes.h"
+#include "OculusXRWorkloadThrottle.generated.h"
+
+UINTERFACE(MinimalAPI, Blueprintable)
+class UOculusXRWorkloadThrottleable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implement this interface and register with UOculusXRWorkloadThrottleSubsystem to be told when the app should reduce
+ * its workload, e.g. to pause tracking consumers, stop retargeting or suspend streaming.
+ */
+class OCULUSXRHMD_API IOculusXRWorkloadThrottleable
+{
+	GENERATED_BODY()
+
+public:
+	/** Called when the app lost input focus or a system overlay appeared */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "OculusLibrary|Workload Throttling")
+	void OnWorkloadThrottled(const FOculusXRWorkloadThrottlePolicy& Policy);
+
+	/** Called when the app got the input focus back */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "OculusLibrary|Workload Throttling")
+	void OnWorkloadRestored();
+};
+
+/**
+ * Reduces the workload of the app while the universal menu or a system dialog is open, and restores it on return.
+ * The policy comes from the project settings (WorkloadThrottlePolicy). Objects opt in by registering themselves, the
+ * body, face and eye tracking components, the passthrough layer components and the MR Utility Kit subsystem (world lock)
+ * do so. Actors and components registered for tick throttling tick slower, batched components included.
+ */
+UCLASS()
+class OCULUSXRHMD_API UOculusXRWorkloadThrottleSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOculusXRWorkloadThrottleChangedDelegate, bool, bIsThrottled);
+
+	/** Broadcast after the workload was throttled or restored */
+	UPROPERTY(BlueprintAssignable, Category = "OculusLibrary|Workload Throttling")
+	FOculusXRWorkloadThrottleChangedDelegate OnWorkloadThrottleChanged;
+
+	/** Register an object implementing IOculusXRWorkloadThrottleable. It is throttled right away if the workload currently is. */
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary|Workload Throttling")
+	void RegisterThrottleable(UObject* Object);
+
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary|Workload Throttling")
+	void UnregisterThrottleable(UObject* Object);
+
+	/** Register an actor or actor component to tick with the ThrottledTickInterval of the policy while throttled */
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary|Workload Throttling")
+	void RegisterTickThrottling(UObject* ActorOrComponent);
+
+	UFUNCTION(BlueprintCallable, Category = "OculusLibrary|Workload Throttling")
+	void UnregisterTickThrottling(UObject* ActorOrComponent);
+
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary|Workload Throttling")
+	bool IsThrottled() const { return bIsThrottled; }
+
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary|Workload Throttling")
+	FOculusXRWorkloadThrottleStats GetStats() const;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	void OnInputFocusChanged(bool bHasInputFocus, bool bSystemOverlayPresent);
+	void Throttle(const TCHAR* Reason);
+	void Restore();
+	void ThrottleTick(UObject* Object);
+	void RestoreTick(UObject* Object, float TickInterval);
+
+	TArray<TWeakObjectPtr<UObject>> Throttleables;
+	TArray<TWeakObjectPtr<UObject>> TickThrottled;
+	/** Tick intervals of the throttled actors and components before they were throttled */
+	TMap<TWeakObjectPtr<UObject>, float> SavedTickIntervals;
+	/** Player controllers that were paused by the throttling */
+	TArray<TWeakObjectPtr<class APlayerController>> PausedPlayerControllers;
+
+	/** The policy the workload was throttled with, restoring undoes exactly that */
+	FOculusXRWorkloadThrottlePolicy ActivePolicy;
+	bool bIsThrottled = false;
+	bool bSuspendedAsyncLoading = false;
+	int32 NumThrottles = 0;
+	double ThrottleStartTime = 0.0;
+	double ThrottledTime = 0.0;
+};
@@ -0,0 +1,90 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OculusXRBakedHapticClip.h"
+#include "OculusXRHapticsClipCache.h"
+#include "Haptics/HapticFeedbackEffect_Base.h"
+#include "UObject/ObjectSaveContext.h"
+
+namespace
+{
+	// Sample rate of the Touch controller PCM haptics
+	const int32 DefaultHapticsSampleRate = 320;
+} // namespace
+
+UOculusXRBakedHapticClip::UOculusXRBakedHapticClip()
+{
+	SampleRates.Add(DefaultHapticsSampleRate);
+}
+
+void UOculusXRBakedHapticClip::Bake()
+{
+	BakedSamples.Reset();
+	if (SourceEffect == nullptr)
+	{
+		return;
+	}
+
+	FHapticFeedbackBuffer HapticBuffer;
+	SourceEffect->Initialize(HapticBuffer);
+	for (const int32 SampleRate : SampleRates)
+	{
+		if (SampleRate > 0)
+		{
+			FOculusXRBakedHapticSamples& Baked = BakedSamples.AddDefaulted_GetRef();
+			Baked.SampleRate = SampleRate;
+			OculusXRInput::FOculusXRHapticsClipCache::ResampleBuffer(HapticBuffer, SampleRate, Baked.Samples);
+		}
+	}
+
+	RegisterBakedSamples();
+}
+
+void UOculusXRBakedHapticClip::RegisterBakedSamples()
+{
+	OculusXRInput::FOculusXRHapticsClipCache& ClipCache = OculusXRInput::FOculusXRHapticsClipCache::Get();
+	if (RegisteredEffect != FObjectKey())
+	{
+		ClipCache.UnregisterBakedClips(RegisteredEffect);
+	}
+
+	RegisteredEffect = FObjectKey(SourceEffect);
+	if (SourceEffect != nullptr)
+	{
+		for (const FOculusXRBakedHapticSamples& Baked : BakedSamples)
+		{
+			ClipCache.RegisterBakedClip(SourceEffect, Baked.SampleRate, Baked.Samples);
+		}
+	}
+}
+
+void UOculusXRBakedHapticClip::PostLoad()
+{
+	Super::PostLoad();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		RegisterBakedSamples();
+	}
+}
+
+void UOculusXRBakedHapticClip::BeginDestroy()
+{
+	if (RegisteredEffect != FObjectKey())
+	{
+		OculusXRInput::FOculusXRHapticsClipCache::Get().UnregisterBakedClips(RegisteredEffect);
+		RegisteredEffect = FObjectKey();
+	}
+
+	Super::BeginDestroy();
+}
+
+#if WITH_EDITOR
+void UOculusXRBakedHapticClip::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	// Bake on save and cook so the samples stored with the asset always match the source effect
+	Bake();
+}
+#endif
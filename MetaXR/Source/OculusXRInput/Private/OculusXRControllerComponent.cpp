@@ -7,6 +7,7 @@
 #include "OculusXRInput.h"
 #include "Components/StaticMeshComponent.h"
 #include "OculusXRHandTracking.h"
+#include "OculusXRTickManager.h"
 #include <OculusXRInputModule.h>
 
 UOculusXRControllerComponent::UOculusXRControllerComponent()
@@ -63,7 +64,29 @@ void UOculusXRControllerComponent::BeginPlay()
 void UOculusXRControllerComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	UpdateController(UOculusXRInputFunctionLibrary::IsHandTrackingEnabled());
+}
+
+void UOculusXRControllerComponent::RegisterComponentTickFunctions(bool bRegister)
+{
+	static const FOculusXRTickBatchDesc BatchDesc = { TEXT("Controllers"), TG_DuringPhysics, &UOculusXRControllerComponent::TickBatch };
+	if (!UOculusXRTickManager::RegisterComponentTick(this, bRegister, BatchDesc))
+	{
+		Super::RegisterComponentTickFunctions(bRegister);
+	}
+}
 
+void UOculusXRControllerComponent::TickBatch(TArrayView<UActorComponent* const> Components, TArrayView<const float> DeltaTimes)
+{
+	const bool bIsHandTrackingEnabled = UOculusXRInputFunctionLibrary::IsHandTrackingEnabled();
+	for (UActorComponent* Component : Components)
+	{
+		CastChecked<UOculusXRControllerComponent>(Component)->UpdateController(bIsHandTrackingEnabled);
+	}
+}
+
+void UOculusXRControllerComponent::UpdateController(bool bIsHandTrackingEnabled)
+{
 	// If we're in a capsense mode, we need to offset the controller position so that it's correct / consistent with the hand position.
 	if (_cachedControllerHandType != OculusXRInput::FOculusHandTracking::ControllerDrivenHandType)
 	{
@@ -76,8 +99,7 @@ void UOculusXRControllerComponent::TickComponent(float DeltaTime, enum ELevelTic
 		SetRelativeRotation(FQuat::MakeFromEuler(rotationOffset));
 	}
 
-	bool isHandTrackingEnabled = UOculusXRInputFunctionLibrary::IsHandTrackingEnabled();
-	bool shouldHide = isHandTrackingEnabled && !(RenderWhenUsingControllerDrivenHands && OculusXRInput::FOculusHandTracking::ControllerDrivenHandType == EOculusXRControllerDrivenHandPoseTypes::Controller);
+	bool shouldHide = bIsHandTrackingEnabled && !(RenderWhenUsingControllerDrivenHands && OculusXRInput::FOculusHandTracking::ControllerDrivenHandType == EOculusXRControllerDrivenHandPoseTypes::Controller);
 	if (shouldHide && !bHiddenInGame)
 	{
 		SetHiddenInGame(true, false);
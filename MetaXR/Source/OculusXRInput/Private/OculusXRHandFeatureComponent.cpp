@@ -0,0 +1,104 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+#include "OculusXRHandFeatureComponent.h"
+#include "OculusXRHandTracking.h"
+
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+
+namespace
+{
+	// Interval in seconds between the rest pose queries while the hands are tracked but the skeleton isn't available yet
+	constexpr float RestPoseRetryInterval = 1.0f;
+} // namespace
+
+UOculusXRHandFeatureComponent::UOculusXRHandFeatureComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+
+	bAutoActivate = true;
+}
+
+void UOculusXRHandFeatureComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Extractor = FOculusXRHandFeatureExtractor(HandType);
+	InitializeRestPose();
+}
+
+void UOculusXRHandFeatureComponent::InitializeRestPose()
+{
+	const UWorld* World = GetWorld();
+	const float WorldToMeters = World && World->GetWorldSettings() ? World->GetWorldSettings()->WorldToMeters : 100.f;
+
+	FOculusXRHandRestPose RestPose;
+	if (OculusXRInput::FOculusHandTracking::GetHandRestPose(HandType, RestPose, WorldToMeters))
+	{
+		Extractor.SetRestPose(RestPose);
+	}
+}
+
+void UOculusXRHandFeatureComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	FOculusXRHandBoneSnapshot Snapshot;
+	OculusXRInput::FOculusHandTracking::GetHandBoneSnapshot(0, HandType, Snapshot);
+
+	// The skeleton is not available until the runtime starts tracking hands
+	if (!Extractor.GetRestPose().bIsValid && Snapshot.bIsTracked)
+	{
+		RestPoseRetryTimer -= DeltaTime;
+		if (RestPoseRetryTimer <= 0.0f)
+		{
+			RestPoseRetryTimer = RestPoseRetryInterval;
+			InitializeRestPose();
+		}
+	}
+	Snapshot.RootTransform = GetComponentTransform();
+	Snapshot.Time = GetWorld()->GetTimeSeconds();
+
+	Extractor.SetThresholds(Thresholds);
+
+	PendingEvents.Reset();
+	Extractor.Update(Snapshot, PendingEvents);
+
+	for (const FOculusXRHandGestureEvent& Event : PendingEvents)
+	{
+		if (Event.bStarted)
+		{
+			OnGestureStarted.Broadcast(HandType, Event.Gesture);
+		}
+		else
+		{
+			OnGestureEnded.Broadcast(HandType, Event.Gesture);
+		}
+	}
+}
+
+FVector UOculusXRHandFeatureComponent::GetFingertipPosition(EOculusXRFinger Finger) const
+{
+	const FOculusXRHandFeatures& Features = Extractor.GetFeatures();
+	return Features.FingertipPositions.IsValidIndex((int32)Finger) ? Features.FingertipPositions[(int32)Finger] : FVector::ZeroVector;
+}
+
+float UOculusXRHandFeatureComponent::GetFingerCurl(EOculusXRFinger Finger) const
+{
+	const FOculusXRHandFeatures& Features = Extractor.GetFeatures();
+	return Features.FingerCurls.IsValidIndex((int32)Finger) ? Features.FingerCurls[(int32)Finger] : 0.0f;
+}
+
+float UOculusXRHandFeatureComponent::GetPinchDistance(EOculusXRFinger Finger) const
+{
+	const FOculusXRHandFeatures& Features = Extractor.GetFeatures();
+	return Features.PinchDistances.IsValidIndex((int32)Finger) ? Features.PinchDistances[(int32)Finger] : 0.0f;
+}
+
+bool UOculusXRHandFeatureComponent::IsGestureActive(EOculusXRHandGesture Gesture) const
+{
+	return Gesture < EOculusXRHandGesture::Gesture_Count && Extractor.IsGestureActive(Gesture);
+}
@@ -0,0 +1,274 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OculusXRHandFeatures.h"
+#include "OculusXRHandComponent.h"
+
+namespace
+{
+	// Parent of every bone in the runtime hand skeleton, indexed by EOculusXRBone
+	const int32 DefaultHandBoneParents[(int32)EOculusXRBone::Bone_Max] = {
+		-1,								// Wrist_Root
+		(int32)EOculusXRBone::Wrist_Root, // Forearm_Stub
+		(int32)EOculusXRBone::Wrist_Root, // Thumb_0
+		(int32)EOculusXRBone::Thumb_0,	// Thumb_1
+		(int32)EOculusXRBone::Thumb_1,	// Thumb_2
+		(int32)EOculusXRBone::Thumb_2,	// Thumb_3
+		(int32)EOculusXRBone::Wrist_Root, // Index_1
+		(int32)EOculusXRBone::Index_1,	// Index_2
+		(int32)EOculusXRBone::Index_2,	// Index_3
+		(int32)EOculusXRBone::Wrist_Root, // Middle_1
+		(int32)EOculusXRBone::Middle_1,	// Middle_2
+		(int32)EOculusXRBone::Middle_2,	// Middle_3
+		(int32)EOculusXRBone::Wrist_Root, // Ring_1
+		(int32)EOculusXRBone::Ring_1,		// Ring_2
+		(int32)EOculusXRBone::Ring_2,		// Ring_3
+		(int32)EOculusXRBone::Wrist_Root, // Pinky_0
+		(int32)EOculusXRBone::Pinky_0,	// Pinky_1
+		(int32)EOculusXRBone::Pinky_1,	// Pinky_2
+		(int32)EOculusXRBone::Pinky_2,	// Pinky_3
+		(int32)EOculusXRBone::Thumb_3,	// Thumb_Tip
+		(int32)EOculusXRBone::Index_3,	// Index_Tip
+		(int32)EOculusXRBone::Middle_3,	// Middle_Tip
+		(int32)EOculusXRBone::Ring_3,		// Ring_Tip
+		(int32)EOculusXRBone::Pinky_3,	// Pinky_Tip
+	};
+
+	// Joint chain used to measure the flexion of each finger, starting at the wrist and ending at the tip
+	const EOculusXRBone FingerChains[OculusXRHandFingerCount][5] = {
+		{ EOculusXRBone::Thumb_1, EOculusXRBone::Thumb_2, EOculusXRBone::Thumb_3, EOculusXRBone::Thumb_Tip, EOculusXRBone::Invalid },
+		{ EOculusXRBone::Wrist_Root, EOculusXRBone::Index_1, EOculusXRBone::Index_2, EOculusXRBone::Index_3, EOculusXRBone::Index_Tip },
+		{ EOculusXRBone::Wrist_Root, EOculusXRBone::Middle_1, EOculusXRBone::Middle_2, EOculusXRBone::Middle_3, EOculusXRBone::Middle_Tip },
+		{ EOculusXRBone::Wrist_Root, EOculusXRBone::Ring_1, EOculusXRBone::Ring_2, EOculusXRBone::Ring_3, EOculusXRBone::Ring_Tip },
+		{ EOculusXRBone::Pinky_1, EOculusXRBone::Pinky_2, EOculusXRBone::Pinky_3, EOculusXRBone::Pinky_Tip, EOculusXRBone::Invalid },
+	};
+
+	const EOculusXRBone FingerTips[OculusXRHandFingerCount] = {
+		EOculusXRBone::Thumb_Tip,
+		EOculusXRBone::Index_Tip,
+		EOculusXRBone::Middle_Tip,
+		EOculusXRBone::Ring_Tip,
+		EOculusXRBone::Pinky_Tip,
+	};
+
+	// Sum of the joint angles of a fully curled finger, used to normalize the curl
+	const float MaxThumbFlexRadians = FMath::DegreesToRadians(150.0f);
+	const float MaxFingerFlexRadians = FMath::DegreesToRadians(270.0f);
+} // namespace
+
+FOculusXRHandFeatures::FOculusXRHandFeatures()
+{
+	FingertipPositions.Init(FVector::ZeroVector, OculusXRHandFingerCount);
+	FingerCurls.Init(0.0f, OculusXRHandFingerCount);
+	PinchDistances.Init(0.0f, OculusXRHandFingerCount);
+}
+
+FOculusXRHandBoneSnapshot::FOculusXRHandBoneSnapshot()
+{
+	for (int32 i = 0; i < (int32)EOculusXRBone::Bone_Max; i++)
+	{
+		BoneRotations[i] = FQuat::Identity;
+	}
+}
+
+FOculusXRHandRestPose::FOculusXRHandRestPose()
+{
+	for (int32 i = 0; i < (int32)EOculusXRBone::Bone_Max; i++)
+	{
+		BoneOffsets[i] = FVector::ZeroVector;
+		BoneParents[i] = DefaultHandBoneParents[i];
+	}
+}
+
+FOculusXRHandFeatureExtractor::FOculusXRHandFeatureExtractor(EOculusXRHandType InHand)
+	: Hand(InHand)
+{
+}
+
+void FOculusXRHandFeatureExtractor::Reset()
+{
+	bHasPreviousSample = false;
+	for (FGestureState& State : GestureStates)
+	{
+		State = FGestureState();
+	}
+	Features = FOculusXRHandFeatures();
+}
+
+void FOculusXRHandFeatureExtractor::Update(const FOculusXRHandBoneSnapshot& Snapshot, TArray<FOculusXRHandGestureEvent>& OutEvents)
+{
+	const bool bUsable = Snapshot.bIsTracked && RestPose.bIsValid && (!Thresholds.bRequireHighConfidence || Snapshot.Confidence == EOculusXRTrackingConfidence::High);
+	if (!bUsable)
+	{
+		// Losing the hand ends every gesture right away, debouncing only applies to tracked samples
+		for (int32 GestureIndex = 0; GestureIndex < (int32)EOculusXRHandGesture::Gesture_Count; GestureIndex++)
+		{
+			FGestureState& State = GestureStates[GestureIndex];
+			if (State.bActive)
+			{
+				OutEvents.Add({ (EOculusXRHandGesture)GestureIndex, false });
+			}
+			State = FGestureState();
+		}
+		Features.bIsValid = false;
+		Features.Confidence = Snapshot.Confidence;
+		Features.PalmVelocity = FVector::ZeroVector;
+		Features.PalmAngularVelocity = FVector::ZeroVector;
+		bHasPreviousSample = false;
+		return;
+	}
+
+	ComputeBoneTransforms(Snapshot);
+	ComputeFeatures(Snapshot);
+
+	const float DeltaTime = bHasPreviousSample ? FMath::Max(0.0f, (float)(Snapshot.Time - PreviousTime)) : 0.0f;
+	bHasPreviousSample = true;
+	PreviousTime = Snapshot.Time;
+	PreviousPalmTransform = Features.PalmTransform;
+
+	for (int32 GestureIndex = 0; GestureIndex < (int32)EOculusXRHandGesture::Gesture_Count; GestureIndex++)
+	{
+		const EOculusXRHandGesture Gesture = (EOculusXRHandGesture)GestureIndex;
+		FGestureState& State = GestureStates[GestureIndex];
+		if (EvaluateGesture(Gesture, State.bActive) == State.bActive)
+		{
+			State.PendingTime = 0.0f;
+			continue;
+		}
+
+		State.PendingTime += DeltaTime;
+		if (State.PendingTime >= Thresholds.DebounceTime)
+		{
+			State.bActive = !State.bActive;
+			State.PendingTime = 0.0f;
+			OutEvents.Add({ Gesture, State.bActive });
+		}
+	}
+}
+
+void FOculusXRHandFeatureExtractor::ComputeBoneTransforms(const FOculusXRHandBoneSnapshot& Snapshot)
+{
+	FTransform RootTransform = Snapshot.RootTransform;
+	RootTransform.MultiplyScale3D(FVector(Snapshot.HandScale));
+
+	// Bones are ordered so that parents always come before their children
+	for (int32 BoneIndex = 0; BoneIndex < (int32)EOculusXRBone::Bone_Max; BoneIndex++)
+	{
+		FQuat LocalRotation = Snapshot.BoneRotations[BoneIndex];
+		if (BoneIndex == (int32)EOculusXRBone::Wrist_Root)
+		{
+			// Matches the root bone setup of UOculusXRHandComponent
+			LocalRotation *= HandRootFixupRotation;
+			LocalRotation.Normalize();
+		}
+		const FTransform LocalTransform(LocalRotation, RestPose.BoneOffsets[BoneIndex]);
+
+		const int32 ParentIndex = RestPose.BoneParents[BoneIndex];
+		const FTransform& ParentTransform = (ParentIndex >= 0 && ParentIndex < BoneIndex) ? BoneTransforms[ParentIndex] : RootTransform;
+		BoneTransforms[BoneIndex] = LocalTransform * ParentTransform;
+	}
+}
+
+void FOculusXRHandFeatureExtractor::ComputeFeatures(const FOculusXRHandBoneSnapshot& Snapshot)
+{
+	Features.bIsValid = true;
+	Features.Confidence = Snapshot.Confidence;
+
+	const FVector ThumbTip = BoneTransforms[(int32)EOculusXRBone::Thumb_Tip].GetLocation();
+	float ApertureSum = 0.0f;
+	for (int32 Finger = 0; Finger < OculusXRHandFingerCount; Finger++)
+	{
+		const FVector Tip = BoneTransforms[(int32)FingerTips[Finger]].GetLocation();
+		Features.FingertipPositions[Finger] = Tip;
+		Features.FingerCurls[Finger] = ComputeFingerCurl((EOculusXRFinger)Finger);
+		Features.PinchDistances[Finger] = Finger == (int32)EOculusXRFinger::Thumb ? 0.0f : FVector::Dist(ThumbTip, Tip);
+		ApertureSum += Features.PinchDistances[Finger];
+	}
+	Features.GrabAperture = ApertureSum / (OculusXRHandFingerCount - 1);
+
+	const FVector Wrist = BoneTransforms[(int32)EOculusXRBone::Wrist_Root].GetLocation();
+	const FVector IndexKnuckle = BoneTransforms[(int32)EOculusXRBone::Index_1].GetLocation();
+	const FVector MiddleKnuckle = BoneTransforms[(int32)EOculusXRBone::Middle_1].GetLocation();
+	const FVector PinkyKnuckle = BoneTransforms[(int32)EOculusXRBone::Pinky_1].GetLocation();
+
+	const FVector PalmForward = (MiddleKnuckle - Wrist).GetSafeNormal();
+	const FVector PalmSide = (IndexKnuckle - PinkyKnuckle).GetSafeNormal();
+	// The knuckles are mirrored between the hands, flip the left normal so it always points out of the palm
+	FVector PalmNormal = (PalmForward ^ PalmSide).GetSafeNormal();
+	if (Hand == EOculusXRHandType::HandLeft)
+	{
+		PalmNormal = -PalmNormal;
+	}
+	Features.PalmNormal = PalmNormal;
+	Features.PalmTransform = FTransform(FRotationMatrix::MakeFromXZ(PalmForward, PalmNormal).ToQuat(), (Wrist + MiddleKnuckle) * 0.5f);
+
+	const float DeltaTime = bHasPreviousSample ? (float)(Snapshot.Time - PreviousTime) : 0.0f;
+	if (DeltaTime > UE_KINDA_SMALL_NUMBER)
+	{
+		Features.PalmVelocity = (Features.PalmTransform.GetLocation() - PreviousPalmTransform.GetLocation()) / DeltaTime;
+
+		FQuat DeltaRotation = Features.PalmTransform.GetRotation() * PreviousPalmTransform.GetRotation().Inverse();
+		DeltaRotation.EnforceShortestArcWith(FQuat::Identity);
+		FVector Axis;
+		float Angle;
+		DeltaRotation.ToAxisAndAngle(Axis, Angle);
+		Features.PalmAngularVelocity = Axis * (Angle / DeltaTime);
+	}
+	else
+	{
+		Features.PalmVelocity = FVector::ZeroVector;
+		Features.PalmAngularVelocity = FVector::ZeroVector;
+	}
+}
+
+float FOculusXRHandFeatureExtractor::ComputeFingerCurl(EOculusXRFinger Finger) const
+{
+	const EOculusXRBone* Chain = FingerChains[(int32)Finger];
+
+	float FlexSum = 0.0f;
+	FVector PreviousSegment = FVector::ZeroVector;
+	for (int32 i = 1; i < 5 && Chain[i] != EOculusXRBone::Invalid; i++)
+	{
+		const FVector Segment = (BoneTransforms[(int32)Chain[i]].GetLocation() - BoneTransforms[(int32)Chain[i - 1]].GetLocation()).GetSafeNormal();
+		if (i > 1)
+		{
+			FlexSum += FMath::Acos(FMath::Clamp(PreviousSegment | Segment, -1.0f, 1.0f));
+		}
+		PreviousSegment = Segment;
+	}
+
+	const float MaxFlex = Finger == EOculusXRFinger::Thumb ? MaxThumbFlexRadians : MaxFingerFlexRadians;
+	return FMath::Clamp(FlexSum / MaxFlex, 0.0f, 1.0f);
+}
+
+bool FOculusXRHandFeatureExtractor::EvaluateGesture(EOculusXRHandGesture Gesture, bool bActive) const
+{
+	const TArray<float>& Curls = Features.FingerCurls;
+	const float IndexCurl = Curls[(int32)EOculusXRFinger::Index];
+	const float OtherCurlMin = FMath::Min3(Curls[(int32)EOculusXRFinger::Middle], Curls[(int32)EOculusXRFinger::Ring], Curls[(int32)EOculusXRFinger::Pinky]);
+	const float OtherCurlMax = FMath::Max3(Curls[(int32)EOculusXRFinger::Middle], Curls[(int32)EOculusXRFinger::Ring], Curls[(int32)EOculusXRFinger::Pinky]);
+
+	// Active gestures are checked against the release thresholds so they don't flicker around a single value
+	const float PinchThreshold = bActive ? Thresholds.PinchEndDistance : Thresholds.PinchStartDistance;
+	const float ExtendedThreshold = bActive ? Thresholds.FoldedCurl : Thresholds.ExtendedCurl;
+	const float FoldedThreshold = bActive ? Thresholds.ExtendedCurl : Thresholds.FoldedCurl;
+
+	switch (Gesture)
+	{
+		case EOculusXRHandGesture::IndexPinch:
+			return Features.PinchDistances[(int32)EOculusXRFinger::Index] < PinchThreshold;
+		case EOculusXRHandGesture::MiddlePinch:
+			return Features.PinchDistances[(int32)EOculusXRFinger::Middle] < PinchThreshold;
+		case EOculusXRHandGesture::Grab:
+		{
+			const float AverageCurl = (Curls[(int32)EOculusXRFinger::Middle] + Curls[(int32)EOculusXRFinger::Ring] + Curls[(int32)EOculusXRFinger::Pinky]) / 3.0f;
+			return AverageCurl > (bActive ? Thresholds.GrabEndCurl : Thresholds.GrabStartCurl);
+		}
+		case EOculusXRHandGesture::Point:
+			return IndexCurl < ExtendedThreshold && OtherCurlMin > FoldedThreshold;
+		case EOculusXRHandGesture::OpenPalm:
+			return IndexCurl < ExtendedThreshold && OtherCurlMax < ExtendedThreshold && Curls[(int32)EOculusXRFinger::Thumb] < ExtendedThreshold;
+		default:
+			return false;
+	}
+}
@@ -244,6 +244,65 @@ namespace OculusXRInput
 		return false;
 	}
 
+	bool FOculusHandTracking::GetHandBoneSnapshot(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, FOculusXRHandBoneSnapshot& OutSnapshot)
+	{
+#if OCULUS_INPUT_SUPPORTED_PLATFORMS
+		TSharedPtr<FOculusXRInput> OculusXRInputModule = StaticCastSharedPtr<FOculusXRInput>(IOculusXRInputModule::Get().GetInputDevice());
+		if (OculusXRInputModule.IsValid() && DeviceHand != EOculusXRHandType::None)
+		{
+			const FInputDeviceId InDeviceId = GetDeviceID(ControllerIndex);
+			// Read everything from a single controller state instead of looking it up per bone
+			for (const FOculusControllerPair& HandPair : OculusXRInputModule.Get()->ControllerPairs)
+			{
+				if (HandPair.DeviceId == InDeviceId)
+				{
+					ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
+					const FOculusHandControllerState& HandState = HandPair.HandControllerStates[Hand];
+					FMemory::Memcpy(OutSnapshot.BoneRotations, HandState.BoneRotations, sizeof(OutSnapshot.BoneRotations));
+					OutSnapshot.HandScale = HandState.HandScale;
+					OutSnapshot.Confidence = HandState.TrackingConfidence;
+					OutSnapshot.bIsTracked = HandState.bIsPositionValid && IsHandTrackingEnabled();
+					return true;
+				}
+			}
+		}
+#endif
+		OutSnapshot.bIsTracked = false;
+		return false;
+	}
+
+	bool FOculusHandTracking::GetHandRestPose(const EOculusXRHandType SkeletonType, FOculusXRHandRestPose& OutRestPose, const float WorldToMeters)
+	{
+#if OCULUS_INPUT_SUPPORTED_PLATFORMS
+		check(IsInGameThread());
+		// Callers retry until the hands are tracked, reuse the skeleton between the attempts
+		static TUniquePtr<ovrpSkeleton2> OvrSkeleton = MakeUnique<ovrpSkeleton2>();
+		ovrpSkeletonType OvrSkeletonType = (ovrpSkeletonType)((int32)SkeletonType - 1);
+		if (FOculusXRHMDModule::GetPluginWrapper().GetSkeleton2(OvrSkeletonType, OvrSkeleton.Get()) != ovrpSuccess)
+		{
+			// Expected until the runtime starts tracking hands
+			UE_LOG(LogOcHandTracking, Verbose, TEXT("Failed to get skeleton data from Oculus runtime."));
+			return false;
+		}
+
+		const uint32 NumBones = FMath::Min<uint32>(OvrSkeleton->NumBones, (uint32)EOculusXRBone::Bone_Max);
+		for (uint32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			OutRestPose.BoneOffsets[BoneIndex] = OvrBoneVectorToFVector(OvrSkeleton->Bones[BoneIndex].Pose.Position, WorldToMeters);
+			if (BoneIndex > 0)
+			{
+				const ovrpBoneId ParentBoneIndex = (ovrpBoneId)OvrSkeleton->Bones[BoneIndex].ParentBoneIndex;
+				OutRestPose.BoneParents[BoneIndex] = ParentBoneIndex == ovrpBoneId_Invalid ? 0 : (int32)ParentBoneIndex;
+			}
+		}
+		OutRestPose.bIsValid = NumBones == (uint32)EOculusXRBone::Bone_Max;
+
+		return OutRestPose.bIsValid;
+#else
+		return false;
+#endif
+	}
+
 	bool FOculusHandTracking::GetHandSkeletalMesh(USkeletalMesh* HandSkeletalMesh, const EOculusXRHandType SkeletonType, const EOculusXRHandType MeshType, const float WorldToMeters)
 	{
 #if OCULUS_INPUT_SUPPORTED_PLATFORMS
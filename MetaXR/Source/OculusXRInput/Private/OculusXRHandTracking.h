@@ -8,6 +8,7 @@
 #include "Components/CapsuleComponent.h"
 
 #include "OculusXRInputFunctionLibrary.h"
+#include "OculusXRHandFeatures.h"
 
 #define LOCTEXT_NAMESPACE "OculusHandTracking"
 
@@ -36,6 +37,10 @@ namespace OculusXRInput
 		static bool IsHandPositionValid(int32 ControllerIndex, EOculusXRHandType DeviceHand);
 		static void SetControllerDrivenHandPoses(const EOculusXRControllerDrivenHandPoseTypes Type);
 
+		// Hand feature extraction
+		static bool GetHandBoneSnapshot(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, FOculusXRHandBoneSnapshot& OutSnapshot);
+		static bool GetHandRestPose(const EOculusXRHandType SkeletonType, FOculusXRHandRestPose& OutRestPose, const float WorldToMeters = 100.f);
+
 		// Helper functions
 		static ovrpBoneId ToOvrBone(EOculusXRBone Bone);
 		static FString GetBoneName(uint8 Bone);
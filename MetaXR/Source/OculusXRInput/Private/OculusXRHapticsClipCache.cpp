@@ -0,0 +1,208 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "OculusXRHapticsClipCache.h"
+#include "Haptics/HapticFeedbackEffect_Base.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarOculusHapticsClipCacheBudget(
+	TEXT("r.Mobile.Oculus.HapticsClipCacheBudgetKB"),
+	256,
+	TEXT("Memory budget in KB for haptic clips resampled at runtime. Least recently played clips are evicted first. Baked clips do not count against the budget.\n"),
+	ECVF_Default);
+
+namespace OculusXRInput
+{
+	namespace
+	{
+		const int32 MaxCachedClips = 1024;
+		const int32 MaxFirstPlayResamplesTracked = 32;
+
+		int64 GetClipBytes(const FHapticsClipSamplesPtr& Samples)
+		{
+			return Samples.IsValid() ? Samples->GetAllocatedSize() : 0;
+		}
+	} // namespace
+
+	FOculusXRHapticsClipCache& FOculusXRHapticsClipCache::Get()
+	{
+		static FOculusXRHapticsClipCache Instance;
+		return Instance;
+	}
+
+	FOculusXRHapticsClipCache::FOculusXRHapticsClipCache()
+		: ResampledClips(MaxCachedClips)
+	{
+	}
+
+	FHapticsClipSamplesPtr FOculusXRHapticsClipCache::FindOrResample(const UHapticFeedbackEffect_Base* HapticEffect, const FHapticFeedbackBuffer& HapticBuffer, int32 TargetSampleRate)
+	{
+		const FClipKey Key{ FObjectKey(HapticEffect), TargetSampleRate };
+		{
+			FScopeLock Lock(&CriticalSection);
+			if (const FHapticsClipSamplesPtr* Baked = BakedClips.Find(Key))
+			{
+				Stats.BakedHits++;
+				return *Baked;
+			}
+			if (const FHapticsClipSamplesPtr* Cached = ResampledClips.FindAndTouch(Key))
+			{
+				Stats.Hits++;
+				return *Cached;
+			}
+		}
+
+		// Resample outside of the lock, the source buffer is owned by the caller
+		TSharedRef<TArray<uint8>, ESPMode::ThreadSafe> Samples = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+		ResampleBuffer(HapticBuffer, TargetSampleRate, *Samples);
+		FHapticsClipSamplesPtr Result = Samples;
+
+		FScopeLock Lock(&CriticalSection);
+		Stats.Misses++;
+		if (Stats.FirstPlayResamples.Num() >= MaxFirstPlayResamplesTracked)
+		{
+			Stats.FirstPlayResamples.RemoveAt(0);
+		}
+		Stats.FirstPlayResamples.Add(FString::Printf(TEXT("%s @ %d Hz"), HapticEffect ? *HapticEffect->GetPathName() : TEXT("<none>"), TargetSampleRate));
+
+		if (const FHapticsClipSamplesPtr* Existing = ResampledClips.Find(Key))
+		{
+			Stats.BytesHeld -= GetClipBytes(*Existing);
+			ResampledClips.Remove(Key);
+		}
+		if (ResampledClips.Num() == ResampledClips.Max())
+		{
+			Stats.BytesHeld -= GetClipBytes(ResampledClips.RemoveLeastRecent());
+			Stats.Evictions++;
+		}
+		ResampledClips.Add(Key, Result);
+		Stats.BytesHeld += GetClipBytes(Result);
+
+		// Clips still in use by a playing effect stay alive through their shared pointer
+		TrimToBudget((int64)FMath::Max(0, CVarOculusHapticsClipCacheBudget.GetValueOnAnyThread()) * 1024);
+		return Result;
+	}
+
+	void FOculusXRHapticsClipCache::TrimToBudget(int64 BudgetBytes)
+	{
+		while (Stats.BytesHeld > BudgetBytes && ResampledClips.Num() > 1)
+		{
+			Stats.BytesHeld -= GetClipBytes(ResampledClips.RemoveLeastRecent());
+			Stats.Evictions++;
+		}
+	}
+
+	void FOculusXRHapticsClipCache::RegisterBakedClip(const UHapticFeedbackEffect_Base* HapticEffect, int32 SampleRate, const TArray<uint8>& Samples)
+	{
+		const FClipKey Key{ FObjectKey(HapticEffect), SampleRate };
+		FHapticsClipSamplesPtr BakedSamples = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(Samples);
+
+		FScopeLock Lock(&CriticalSection);
+		if (const FHapticsClipSamplesPtr* Existing = BakedClips.Find(Key))
+		{
+			Stats.BakedBytes -= GetClipBytes(*Existing);
+		}
+		Stats.BakedBytes += GetClipBytes(BakedSamples);
+		BakedClips.Add(Key, BakedSamples);
+
+		// A runtime copy of the same clip is redundant now
+		if (const FHapticsClipSamplesPtr* Cached = ResampledClips.Find(Key))
+		{
+			Stats.BytesHeld -= GetClipBytes(*Cached);
+			ResampledClips.Remove(Key);
+		}
+	}
+
+	void FOculusXRHapticsClipCache::UnregisterBakedClips(const FObjectKey& EffectKey)
+	{
+		FScopeLock Lock(&CriticalSection);
+		for (auto It = BakedClips.CreateIterator(); It; ++It)
+		{
+			if (It.Key().Effect == EffectKey)
+			{
+				Stats.BakedBytes -= GetClipBytes(It.Value());
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	void FOculusXRHapticsClipCache::Empty()
+	{
+		FScopeLock Lock(&CriticalSection);
+		ResampledClips.Empty(MaxCachedClips);
+		Stats.BytesHeld = 0;
+	}
+
+	FOculusXRHapticsClipCache::FStats FOculusXRHapticsClipCache::GetStats() const
+	{
+		FScopeLock Lock(&CriticalSection);
+		FStats Result = Stats;
+		Result.NumEntries = ResampledClips.Num();
+		Result.NumBakedEntries = BakedClips.Num();
+		return Result;
+	}
+
+	void FOculusXRHapticsClipCache::DumpStats(FOutputDevice& Ar) const
+	{
+		const FStats CurrentStats = GetStats();
+		const uint64 Lookups = CurrentStats.Hits + CurrentStats.BakedHits + CurrentStats.Misses;
+		const double HitRate = Lookups > 0 ? 100.0 * (CurrentStats.Hits + CurrentStats.BakedHits) / Lookups : 0.0;
+
+		Ar.Logf(TEXT("Haptics clip cache: %llu lookups, %.1f%% hit rate (%llu cached, %llu baked, %llu resampled), %llu evictions"),
+			Lookups, HitRate, CurrentStats.Hits, CurrentStats.BakedHits, CurrentStats.Misses, CurrentStats.Evictions);
+		Ar.Logf(TEXT("  Runtime clips: %d, %lld bytes (budget %d KB)"), CurrentStats.NumEntries, CurrentStats.BytesHeld, CVarOculusHapticsClipCacheBudget.GetValueOnAnyThread());
+		Ar.Logf(TEXT("  Baked clips: %d, %lld bytes"), CurrentStats.NumBakedEntries, CurrentStats.BakedBytes);
+		if (CurrentStats.FirstPlayResamples.Num() > 0)
+		{
+			Ar.Logf(TEXT("  First play resamples:"));
+			for (const FString& Resample : CurrentStats.FirstPlayResamples)
+			{
+				Ar.Logf(TEXT("    %s"), *Resample);
+			}
+		}
+	}
+
+	void FOculusXRHapticsClipCache::ResampleBuffer(const FHapticFeedbackBuffer& HapticBuffer, int32 TargetSampleRate, TArray<uint8>& OutSamples)
+	{
+		const int32 SampleRate = HapticBuffer.SamplingRate;
+		if (SampleRate <= 0 || TargetSampleRate <= 0 || HapticBuffer.RawData == nullptr)
+		{
+			OutSamples.Reset();
+			return;
+		}
+
+		const int32 TargetBufferSize = (int32)(((int64)HapticBuffer.BufferLength * TargetSampleRate) / (SampleRate * 2) + 1); // 2 because we're only using half of the 16bit source PCM buffer
+		OutSamples.SetNumZeroed(TargetBufferSize);
+
+		const uint8* PCMData = HapticBuffer.RawData;
+
+		int32 PreviousTargetIndex = -1;
+		for (int32 i = 1; i < HapticBuffer.BufferLength; i += 2)
+		{
+			const int32 TargetIndex = (int32)(((int64)i * TargetSampleRate) / (SampleRate * 2));
+			int32 Value = PCMData[i];
+			if (Value & 0x80)
+			{
+				Value = ~Value & 0xFF;
+			}
+
+			if (TargetIndex != PreviousTargetIndex && OutSamples.IsValidIndex(TargetIndex))
+			{
+				OutSamples[TargetIndex] = (uint8)(Value * 2);
+				PreviousTargetIndex = TargetIndex;
+			}
+		}
+	}
+
+	static void HapticsClipCacheStatsCmdHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		FOculusXRHapticsClipCache::Get().DumpStats(Ar);
+	}
+
+	static FAutoConsoleCommand CHapticsClipCacheStatsCmd(
+		TEXT("vr.oculus.Haptics.CacheStats"),
+		*NSLOCTEXT("OculusXRInput", "CCommandText_HapticsCacheStats", "Lists the hit rate and memory of the haptic clip cache, and the clips that were resampled on first play.\n Usage: vr.oculus.Haptics.CacheStats").ToString(),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(HapticsClipCacheStatsCmdHandler));
+
+} // namespace OculusXRInput
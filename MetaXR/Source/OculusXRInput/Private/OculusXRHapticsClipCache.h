@@ -0,0 +1,78 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Containers/LruCache.h"
+#include "HAL/CriticalSection.h"
+
+class UHapticFeedbackEffect_Base;
+struct FHapticFeedbackBuffer;
+
+namespace OculusXRInput
+{
+	typedef TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> FHapticsClipSamplesPtr;
+
+	//-------------------------------------------------------------------------------------------------
+	// FOculusXRHapticsClipCache - Resampled haptic clips keyed by effect asset and sample rate
+	//-------------------------------------------------------------------------------------------------
+
+	class FOculusXRHapticsClipCache
+	{
+	public:
+		struct FStats
+		{
+			uint64 Hits = 0;
+			uint64 BakedHits = 0;
+			uint64 Misses = 0;
+			uint64 Evictions = 0;
+			int64 BytesHeld = 0;
+			int64 BakedBytes = 0;
+			int32 NumEntries = 0;
+			int32 NumBakedEntries = 0;
+			/** Names of the effects that had to be resampled on first play, most recent last */
+			TArray<FString> FirstPlayResamples;
+		};
+
+		static FOculusXRHapticsClipCache& Get();
+
+		/**
+		 * Returns the samples of HapticBuffer at TargetSampleRate. Baked clips are used when available,
+		 * otherwise the buffer is resampled once and kept in the LRU cache until the memory budget is exceeded.
+		 */
+		FHapticsClipSamplesPtr FindOrResample(const UHapticFeedbackEffect_Base* HapticEffect, const FHapticFeedbackBuffer& HapticBuffer, int32 TargetSampleRate);
+
+		/** Baked clips are owned by their asset and are not subject to the memory budget */
+		void RegisterBakedClip(const UHapticFeedbackEffect_Base* HapticEffect, int32 SampleRate, const TArray<uint8>& Samples);
+		void UnregisterBakedClips(const FObjectKey& EffectKey);
+
+		void Empty();
+
+		FStats GetStats() const;
+		void DumpStats(FOutputDevice& Ar) const;
+
+		/** Converts 16 bit PCM haptic data to 8 bit amplitudes at TargetSampleRate */
+		static void ResampleBuffer(const FHapticFeedbackBuffer& HapticBuffer, int32 TargetSampleRate, TArray<uint8>& OutSamples);
+
+	private:
+		struct FClipKey
+		{
+			FObjectKey Effect;
+			int32 SampleRate = 0;
+
+			bool operator==(const FClipKey& Other) const { return Effect == Other.Effect && SampleRate == Other.SampleRate; }
+			friend uint32 GetTypeHash(const FClipKey& Key) { return HashCombine(GetTypeHash(Key.Effect), ::GetTypeHash(Key.SampleRate)); }
+		};
+
+		FOculusXRHapticsClipCache();
+
+		void TrimToBudget(int64 BudgetBytes);
+
+		mutable FCriticalSection CriticalSection;
+		TLruCache<FClipKey, FHapticsClipSamplesPtr> ResampledClips;
+		TMap<FClipKey, FHapticsClipSamplesPtr> BakedClips;
+		FStats Stats;
+	};
+
+} // namespace OculusXRInput
@@ -1381,7 +1381,7 @@ namespace OculusXRInput
 		SetHapticFeedbackValues(ControllerId, Hand, Values, nullptr);
 	}
 
-	void FOculusXRInput::SetHapticFeedbackValues(int32 ControllerId, int32 Hand, const FHapticFeedbackValues& Values, TSharedPtr<FOculusXRHapticsDesc> HapticsDesc)
+	void FOculusXRInput::SetHapticFeedbackValues(int32 ControllerId, int32 Hand, const FHapticFeedbackValues& Values, TSharedPtr<FOculusXRHapticsDesc> HapticsDesc, const UHapticFeedbackEffect_Base* HapticEffect)
 	{
 		IPlatformInputDeviceMapper& DeviceMapper = IPlatformInputDeviceMapper::Get();
 		FPlatformUserId InPlatformUser = FGenericPlatformMisc::GetPlatformUserForUserIndex(ControllerId);
@@ -1412,6 +1412,14 @@ namespace OculusXRInput
 							// Buffered haptics is currently only supported on Touch
 							FHapticFeedbackBuffer* HapticBuffer = Values.HapticBuffer;
 							bool bHapticBuffer = (HapticBuffer && HapticBuffer->BufferLength > 0);
+							// Effects are converted to 8 bit amplitudes at the controller sample rate once and served from the clip cache afterwards
+							if (bHapticBuffer && HapticEffect && OvrpHapticsDesc.SampleSizeInBytes == 1 && OvrpHapticsDesc.SampleRateHz > 0)
+							{
+								if (ControllerState.ResampleHapticBufferData(HapticEffect, *HapticBuffer, OvrpHapticsDesc.SampleRateHz, FOculusXRHapticsClipCache::Get()))
+								{
+									HapticBuffer = &ControllerState.ResampledHapticBuffer;
+								}
+							}
 							if ((OvrpControllerState.ConnectedControllerTypes & (ovrpController_Touch)) && bHapticBuffer)
 							{
 								const ovrpController OvrpController = (EControllerHand(Hand) == EControllerHand::Left) ? ovrpController_LTouch : ovrpController_RTouch;
@@ -1522,6 +1530,10 @@ namespace OculusXRInput
 
 										HapticBuffer->CurrentPtr += (SamplesSent * OvrpHapticsDesc.SampleSizeInBytes);
 										HapticBuffer->SamplesSent += SamplesSent;
+										if (HapticBuffer != Values.HapticBuffer)
+										{
+											ControllerState.MirrorResampledProgress(*Values.HapticBuffer, OvrpHapticsDesc.SampleSizeInBytes);
+										}
 
 										ControllerState.bPlayingHapticEffect = true;
 									}
@@ -1707,68 +1719,52 @@ namespace OculusXRInput
 		// Haptic Updates
 		if (bLeftHapticsNeedUpdate)
 		{
-			SetHapticFeedbackValues(0, (int32)(EControllerHand::Left), LeftHaptics, HapticsDesc_Left);
+			SetHapticFeedbackValues(0, (int32)(EControllerHand::Left), LeftHaptics, HapticsDesc_Left, ActiveHapticEffect_Left.IsValid() ? ActiveHapticEffect_Left->HapticEffect : nullptr);
 		}
 		if (bRightHapticsNeedUpdate)
 		{
-			SetHapticFeedbackValues(0, (int32)(EControllerHand::Right), RightHaptics, HapticsDesc_Right);
+			SetHapticFeedbackValues(0, (int32)(EControllerHand::Right), RightHaptics, HapticsDesc_Right, ActiveHapticEffect_Right.IsValid() ? ActiveHapticEffect_Right->HapticEffect : nullptr);
 		}
 	}
 
-	void FOculusTouchControllerState::ResampleHapticBufferData(const FHapticFeedbackBuffer& HapticBuffer, TMap<const uint8*, TSharedPtr<TArray<uint8>>>& ResampledRawDataCache)
+	bool FOculusTouchControllerState::ResampleHapticBufferData(const UHapticFeedbackEffect_Base* HapticEffect, const FHapticFeedbackBuffer& HapticBuffer, int32 TargetSampleRate, FOculusXRHapticsClipCache& ClipCache)
 	{
-		const uint8* OriginalRawData = HapticBuffer.RawData;
-		TSharedPtr<TArray<uint8>>* ResampledRawDataSharedPtrPtr = ResampledRawDataCache.Find(OriginalRawData);
-		if (ResampledRawDataSharedPtrPtr == nullptr)
+		// The engine resets the source buffer when an effect starts or loops, the progress is mirrored back to it while playing.
+		// Until the first samples were sent there is no progress to reset, so that isn't a restart.
+		const bool bRestarted = bResampledProgressMirrored && HapticBuffer.SamplesSent == 0 && !HapticBuffer.bFinishedPlaying;
+		if (!bRestarted && ResampledRawData.IsValid() && ResampledEffect == FObjectKey(HapticEffect) && ResampledHapticBuffer.SamplingRate == TargetSampleRate)
 		{
-			// We need to resample and cache the resampled data.
-
-			ResampledHapticBuffer = HapticBuffer;
-
-			int32 SampleRate = HapticBuffer.SamplingRate;
-			int TargetFrequency = 320;
-			int TargetBufferSize = (HapticBuffer.BufferLength * TargetFrequency) / (SampleRate * 2) + 1; //2 because we're only using half of the 16bit source PCM buffer
-			ResampledHapticBuffer.BufferLength = TargetBufferSize;
-			ResampledHapticBuffer.CurrentPtr = 0;
-			ResampledHapticBuffer.SamplingRate = TargetFrequency;
-
-			TSharedPtr<TArray<uint8>>& NewResampledRawDataSharedPtr = ResampledRawDataCache.Add(OriginalRawData);
-			NewResampledRawDataSharedPtr = MakeShared<TArray<uint8>>();
-			ResampledRawDataSharedPtrPtr = &NewResampledRawDataSharedPtr;
-			TArray<uint8>& ResampledRawData = *NewResampledRawDataSharedPtr;
-			ResampledRawData.SetNum(TargetBufferSize);
-
-			const uint8* PCMData = HapticBuffer.RawData;
-
-			int previousTargetIndex = -1;
-			int currentMin = 0;
-			for (int i = 1; i < HapticBuffer.BufferLength; i += 2)
-			{
-				int targetIndex = i * TargetFrequency / (SampleRate * 2);
-				int val = PCMData[i];
-				if (val & 0x80)
-				{
-					val = ~val;
-				}
-				currentMin = FMath::Min(currentMin, val);
-
-				if (targetIndex != previousTargetIndex)
-				{
-
-					ResampledRawData[targetIndex] = val * 2; // *Scale;
-					previousTargetIndex = targetIndex;
-					currentMin = 0;
-				}
-			}
-
-			ResampledHapticBuffer.RawData = ResampledRawData.GetData();
+			return true;
 		}
-		else if (ResampledHapticBuffer.RawData != (*ResampledRawDataSharedPtrPtr)->GetData())
+
+		// Baked clips and previously played effects are served from the cache, only the first play of an unbaked effect resamples
+		FHapticsClipSamplesPtr Samples = ClipCache.FindOrResample(HapticEffect, HapticBuffer, TargetSampleRate);
+		if (!Samples.IsValid() || Samples->IsEmpty())
 		{
-			// If this a cached effect, but not the same one we played last so we need to copy the new one's buffer and reference its cached resampled data.
-			ResampledHapticBuffer = HapticBuffer;
-			ResampledHapticBuffer.RawData = (*ResampledRawDataSharedPtrPtr)->GetData();
+			return false;
 		}
+
+		ResampledHapticBuffer = HapticBuffer;
+		ResampledHapticBuffer.RawData = Samples->GetData();
+		ResampledHapticBuffer.BufferLength = Samples->Num();
+		ResampledHapticBuffer.CurrentPtr = 0;
+		ResampledHapticBuffer.SamplesSent = 0;
+		ResampledHapticBuffer.bFinishedPlaying = false;
+		ResampledHapticBuffer.SamplingRate = TargetSampleRate;
+		ResampledRawData = MoveTemp(Samples);
+		ResampledEffect = FObjectKey(HapticEffect);
+		bResampledProgressMirrored = false;
+		return true;
+	}
+
+	void FOculusTouchControllerState::MirrorResampledProgress(FHapticFeedbackBuffer& SourceBuffer, int32 SampleSizeInBytes)
+	{
+		const double Progress = ResampledHapticBuffer.BufferLength > 0 ? (double)ResampledHapticBuffer.CurrentPtr / ResampledHapticBuffer.BufferLength : 0.0;
+		const int32 SourceSamples = SampleSizeInBytes > 0 ? SourceBuffer.BufferLength / SampleSizeInBytes : 0;
+		// Rounded up, any progress has to show up in the source buffer to detect a restart
+		SourceBuffer.SamplesSent = FMath::Min(FMath::CeilToInt(Progress * SourceSamples), SourceSamples);
+		SourceBuffer.CurrentPtr = SourceBuffer.SamplesSent * SampleSizeInBytes;
+		bResampledProgressMirrored |= SourceBuffer.SamplesSent > 0;
 	}
 
 	void FOculusXRInput::GetHapticFrequencyRange(float& MinFrequency, float& MaxFrequency) const
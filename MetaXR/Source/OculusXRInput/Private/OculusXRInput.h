@@ -98,7 +98,7 @@ namespace OculusXRInput
 		bool OnControllerButtonPressed(const FOculusButtonState& ButtonState, FPlatformUserId UserId, FInputDeviceId DeviceId, bool IsRepeat);
 		bool OnControllerButtonReleased(const FOculusButtonState& ButtonState, FPlatformUserId UserId, FInputDeviceId DeviceId, bool IsRepeat);
 
-		void SetHapticFeedbackValues(int32 ControllerId, int32 Hand, const FHapticFeedbackValues& Values, TSharedPtr<FOculusXRHapticsDesc> HapticsDesc);
+		void SetHapticFeedbackValues(int32 ControllerId, int32 Hand, const FHapticFeedbackValues& Values, TSharedPtr<FOculusXRHapticsDesc> HapticsDesc, const UHapticFeedbackEffect_Base* HapticEffect = nullptr);
 		ovrpHapticsLocation GetOVRPHapticsLocation(EOculusXRHandHapticsLocation InLocation);
 
 		void ProcessHaptics(const float DeltaTime);
@@ -117,10 +117,6 @@ namespace OculusXRInput
 
 		int LocalTrackingSpaceRecenterCount;
 
-		// Maintain a cache of resampled raw data so we don't resample it on every play.  This is a map of OriginalRawData pointers, used only as a key, to ResampledRawData buffers.
-		// The values are pointers because the map could be reallocated and we cache raw pointers to the uint8 array data elsewhere.
-		TMap<const uint8*, TSharedPtr<TArray<uint8>>> ResampledRawDataCache;
-
 		TSharedPtr<FActiveHapticFeedbackEffect> ActiveHapticEffect_Left;
 		TSharedPtr<FActiveHapticFeedbackEffect> ActiveHapticEffect_Right;
 		TSharedPtr<FOculusXRHapticsDesc> HapticsDesc_Left;
@@ -9,6 +9,7 @@
 #include "InputCoreTypes.h"
 #include "OculusXRInputFunctionLibrary.h"
 #include "GenericPlatform/GenericApplicationMessageHandler.h"
+#include "OculusXRHapticsClipCache.h"
 
 namespace OculusXRInput
 {
@@ -359,7 +360,25 @@ namespace OculusXRInput
 
 	public:
 		FHapticFeedbackBuffer ResampledHapticBuffer;
-		void ResampleHapticBufferData(const FHapticFeedbackBuffer& HapticBuffer, TMap<const uint8*, TSharedPtr<TArray<uint8>>>& ResampledRawDataCache);
+		/** Keeps the samples referenced by ResampledHapticBuffer alive while they might be evicted from the clip cache */
+		FHapticsClipSamplesPtr ResampledRawData;
+		FObjectKey ResampledEffect;
+		/** Set once progress of the current play was mirrored to the source buffer, the engine resetting it afterwards means a restart */
+		bool bResampledProgressMirrored = false;
+
+		/**
+		 * Points ResampledHapticBuffer at the samples of the effect at TargetSampleRate. The clip cache is only queried when
+		 * a play starts or loops, the progress of the play is kept in ResampledHapticBuffer until then.
+		 * @return False if the effect has no samples to play.
+		 */
+		bool ResampleHapticBufferData(const UHapticFeedbackEffect_Base* HapticEffect, const FHapticFeedbackBuffer& HapticBuffer, int32 TargetSampleRate, FOculusXRHapticsClipCache& ClipCache);
+
+		/**
+		 * Writes the progress of ResampledHapticBuffer back to the source buffer of the effect, converted to the samples of
+		 * the source buffer. Keeps CurrentPtr and SamplesSent of the source consistent in case the play continues without
+		 * resampling, and lets ResampleHapticBufferData tell a play in progress from a restarted one.
+		 */
+		void MirrorResampledProgress(FHapticFeedbackBuffer& SourceBuffer, int32 SampleSizeInBytes);
 
 		/** Explicit constructor sets up sensible defaults */
 		FOculusTouchControllerState(const EControllerHand Hand)
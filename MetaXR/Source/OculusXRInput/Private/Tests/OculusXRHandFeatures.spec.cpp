@@ -0,0 +1,104 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "OculusXRHandFeatures.h"
+
+namespace
+{
+	// Flat hand with straight fingers along X. The thumb starts ThumbOffset units to the side of the index finger.
+	FOculusXRHandRestPose MakeRestPose(float ThumbOffset)
+	{
+		FOculusXRHandRestPose RestPose;
+		for (int32 BoneIndex = 1; BoneIndex < (int32)EOculusXRBone::Bone_Max; BoneIndex++)
+		{
+			RestPose.BoneOffsets[BoneIndex] = FVector(1.0f, 0.0f, 0.0f);
+		}
+		RestPose.BoneOffsets[(int32)EOculusXRBone::Thumb_0] = FVector(0.0f, ThumbOffset, 0.0f);
+		RestPose.BoneOffsets[(int32)EOculusXRBone::Middle_1] = FVector(1.0f, -3.0f, 0.0f);
+		RestPose.BoneOffsets[(int32)EOculusXRBone::Ring_1] = FVector(1.0f, -6.0f, 0.0f);
+		RestPose.BoneOffsets[(int32)EOculusXRBone::Pinky_0] = FVector(0.0f, -9.0f, 0.0f);
+		RestPose.bIsValid = true;
+		return RestPose;
+	}
+
+	FOculusXRHandBoneSnapshot MakeSnapshot(double Time, bool bIsTracked = true)
+	{
+		FOculusXRHandBoneSnapshot Snapshot;
+		Snapshot.Time = Time;
+		Snapshot.bIsTracked = bIsTracked;
+		Snapshot.Confidence = EOculusXRTrackingConfidence::High;
+		return Snapshot;
+	}
+
+	bool ContainsEvent(const TArray<FOculusXRHandGestureEvent>& Events, EOculusXRHandGesture Gesture, bool bStarted)
+	{
+		return Events.ContainsByPredicate([Gesture, bStarted](const FOculusXRHandGestureEvent& Event) {
+			return Event.Gesture == Gesture && Event.bStarted == bStarted;
+		});
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FOculusXRHandFeaturesSpec, TEXT("OculusXR Hand Features"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+FOculusXRHandFeatureExtractor Extractor;
+TArray<FOculusXRHandGestureEvent> Events;
+END_DEFINE_SPEC(FOculusXRHandFeaturesSpec)
+
+void FOculusXRHandFeaturesSpec::Define()
+{
+	BeforeEach([this]() {
+		Extractor = FOculusXRHandFeatureExtractor(EOculusXRHandType::HandRight);
+		Events.Reset();
+	});
+
+	Describe("Features", [this]() {
+		It("should measure pinch distances and curls of a flat hand", [this]() {
+			Extractor.SetRestPose(MakeRestPose(1.0f));
+			Extractor.Update(MakeSnapshot(0.0), Events);
+
+			const FOculusXRHandFeatures& Features = Extractor.GetFeatures();
+			TestTrue("Features are valid", Features.bIsValid);
+			TestEqual("Index pinch distance", Features.PinchDistances[(int32)EOculusXRFinger::Index], 1.0f, 0.001f);
+			TestEqual("Middle pinch distance", Features.PinchDistances[(int32)EOculusXRFinger::Middle], 4.0f, 0.001f);
+			TestEqual("Index curl", Features.FingerCurls[(int32)EOculusXRFinger::Index], 0.0f, 0.001f);
+		});
+	});
+
+	Describe("Gestures", [this]() {
+		It("should start a pinch once it held for the debounce time", [this]() {
+			Extractor.SetRestPose(MakeRestPose(1.0f));
+			Extractor.Update(MakeSnapshot(0.0), Events);
+			Extractor.Update(MakeSnapshot(0.02), Events);
+			TestFalse("Pinch is debounced", Extractor.IsGestureActive(EOculusXRHandGesture::IndexPinch));
+
+			Extractor.Update(MakeSnapshot(0.06), Events);
+			TestTrue("Pinch is active", Extractor.IsGestureActive(EOculusXRHandGesture::IndexPinch));
+			TestTrue("Pinch started event", ContainsEvent(Events, EOculusXRHandGesture::IndexPinch, true));
+			TestFalse("Middle pinch is not active", Extractor.IsGestureActive(EOculusXRHandGesture::MiddlePinch));
+		});
+
+		It("should ignore pinches shorter than the debounce time", [this]() {
+			Extractor.SetRestPose(MakeRestPose(5.0f));
+			Extractor.Update(MakeSnapshot(0.0), Events);
+			Extractor.SetRestPose(MakeRestPose(1.0f));
+			Extractor.Update(MakeSnapshot(0.02), Events);
+			Extractor.SetRestPose(MakeRestPose(5.0f));
+			Extractor.Update(MakeSnapshot(0.04), Events);
+			Extractor.Update(MakeSnapshot(0.2), Events);
+			TestFalse("No pinch event", ContainsEvent(Events, EOculusXRHandGesture::IndexPinch, true));
+		});
+
+		It("should end all gestures when tracking is lost", [this]() {
+			Extractor.SetRestPose(MakeRestPose(1.0f));
+			Extractor.Update(MakeSnapshot(0.0), Events);
+			Extractor.Update(MakeSnapshot(0.1), Events);
+			TestTrue("Pinch is active", Extractor.IsGestureActive(EOculusXRHandGesture::IndexPinch));
+
+			Events.Reset();
+			Extractor.Update(MakeSnapshot(0.11, false), Events);
+			TestFalse("Pinch is not active", Extractor.IsGestureActive(EOculusXRHandGesture::IndexPinch));
+			TestTrue("Pinch ended event", ContainsEvent(Events, EOculusXRHandGesture::IndexPinch, false));
+			TestFalse("Features are invalid", Extractor.GetFeatures().bIsValid);
+		});
+	});
+}
@@ -0,0 +1,155 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "OculusXRInputState.h"
+#include "Haptics/HapticFeedbackEffect_Curve.h"
+
+namespace
+{
+	using namespace OculusXRInput;
+
+	constexpr int32 SourceSampleRate = 8000;
+	constexpr int32 ControllerSampleRate = 320;
+
+	// A source buffer as the engine hands it out at the start of a play
+	FHapticFeedbackBuffer MakeSourceBuffer(const TArray<uint8>& PCMData)
+	{
+		FHapticFeedbackBuffer Buffer;
+		Buffer.RawData = PCMData.GetData();
+		Buffer.BufferLength = PCMData.Num();
+		Buffer.CurrentPtr = 0;
+		Buffer.SamplesSent = 0;
+		Buffer.bFinishedPlaying = false;
+		Buffer.SamplingRate = SourceSampleRate;
+		Buffer.ScaleFactor = 1.0f;
+		return Buffer;
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FOculusXRHapticsClipCacheSpec, TEXT("OculusXR Haptics Clip Cache"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TArray<uint8> PCMData;
+END_DEFINE_SPEC(FOculusXRHapticsClipCacheSpec)
+
+void FOculusXRHapticsClipCacheSpec::Define()
+{
+	BeforeEach([this]() {
+		// 100 ms of 16 bit PCM
+		PCMData.SetNum(SourceSampleRate / 10 * 2);
+		for (int32 Index = 0; Index < PCMData.Num(); ++Index)
+		{
+			PCMData[Index] = (uint8)(Index % 128);
+		}
+	});
+
+	Describe("Playback", [this]() {
+		It("should resample on the first play and hit the cache on the second", [this]() {
+			FOculusXRHapticsClipCache& ClipCache = FOculusXRHapticsClipCache::Get();
+			const UHapticFeedbackEffect_Base* Effect = NewObject<UHapticFeedbackEffect_Curve>();
+			FOculusTouchControllerState ControllerState(EControllerHand::Left);
+
+			const FOculusXRHapticsClipCache::FStats Before = ClipCache.GetStats();
+			FHapticFeedbackBuffer FirstPlay = MakeSourceBuffer(PCMData);
+			if (!TestTrue("First play", ControllerState.ResampleHapticBufferData(Effect, FirstPlay, ControllerSampleRate, ClipCache)))
+			{
+				return;
+			}
+			const uint8* ResampledData = ControllerState.ResampledHapticBuffer.RawData;
+			TestEqual("Sample rate", ControllerState.ResampledHapticBuffer.SamplingRate, ControllerSampleRate);
+			TestTrue("Resampled", ClipCache.GetStats().Misses == Before.Misses + 1);
+
+			// Part of the clip was sent before the next play started
+			ControllerState.ResampledHapticBuffer.CurrentPtr = 10;
+			ControllerState.ResampledHapticBuffer.SamplesSent = 10;
+			ControllerState.MirrorResampledProgress(FirstPlay, 1);
+
+			FHapticFeedbackBuffer SecondPlay = MakeSourceBuffer(PCMData);
+			TestTrue("Second play", ControllerState.ResampleHapticBufferData(Effect, SecondPlay, ControllerSampleRate, ClipCache));
+			TestTrue("Not resampled again", ClipCache.GetStats().Misses == Before.Misses + 1);
+			TestTrue("Cache hit", ClipCache.GetStats().Hits == Before.Hits + 1);
+			TestTrue("Same samples", ControllerState.ResampledHapticBuffer.RawData == ResampledData);
+			TestEqual("Restarted", ControllerState.ResampledHapticBuffer.SamplesSent, 0);
+		});
+
+		It("should keep the progress while playing", [this]() {
+			FOculusXRHapticsClipCache& ClipCache = FOculusXRHapticsClipCache::Get();
+			const UHapticFeedbackEffect_Base* Effect = NewObject<UHapticFeedbackEffect_Curve>();
+			FOculusTouchControllerState ControllerState(EControllerHand::Right);
+
+			FHapticFeedbackBuffer Play = MakeSourceBuffer(PCMData);
+			ControllerState.ResampleHapticBufferData(Effect, Play, ControllerSampleRate, ClipCache);
+			ControllerState.ResampledHapticBuffer.CurrentPtr = 10;
+			ControllerState.ResampledHapticBuffer.SamplesSent = 10;
+			// SetHapticFeedbackValues mirrors the progress to the source buffer
+			ControllerState.MirrorResampledProgress(Play, 1);
+
+			const FOculusXRHapticsClipCache::FStats Before = ClipCache.GetStats();
+			TestTrue("Playing", ControllerState.ResampleHapticBufferData(Effect, Play, ControllerSampleRate, ClipCache));
+			TestTrue("No lookup", ClipCache.GetStats().Hits == Before.Hits);
+			TestEqual("Progress", ControllerState.ResampledHapticBuffer.SamplesSent, 10);
+		});
+
+		It("should not look up the clip again before the first samples were sent", [this]() {
+			FOculusXRHapticsClipCache& ClipCache = FOculusXRHapticsClipCache::Get();
+			const UHapticFeedbackEffect_Base* Effect = NewObject<UHapticFeedbackEffect_Curve>();
+			FOculusTouchControllerState ControllerState(EControllerHand::Left);
+
+			FHapticFeedbackBuffer Play = MakeSourceBuffer(PCMData);
+			ControllerState.ResampleHapticBufferData(Effect, Play, ControllerSampleRate, ClipCache);
+
+			// The controller queue was full, nothing was sent in the previous frames
+			const FOculusXRHapticsClipCache::FStats Before = ClipCache.GetStats();
+			TestTrue("Waiting", ControllerState.ResampleHapticBufferData(Effect, Play, ControllerSampleRate, ClipCache));
+			TestTrue("Still waiting", ControllerState.ResampleHapticBufferData(Effect, Play, ControllerSampleRate, ClipCache));
+			TestTrue("No lookup", ClipCache.GetStats().Hits == Before.Hits && ClipCache.GetStats().Misses == Before.Misses);
+		});
+
+		It("should mirror the progress in the samples of the source buffer", [this]() {
+			FOculusXRHapticsClipCache& ClipCache = FOculusXRHapticsClipCache::Get();
+			const UHapticFeedbackEffect_Base* Effect = NewObject<UHapticFeedbackEffect_Curve>();
+			FOculusTouchControllerState ControllerState(EControllerHand::Right);
+
+			FHapticFeedbackBuffer Play = MakeSourceBuffer(PCMData);
+			if (!TestTrue("Play", ControllerState.ResampleHapticBufferData(Effect, Play, ControllerSampleRate, ClipCache)))
+			{
+				return;
+			}
+
+			// Nothing sent yet, then the whole resampled clip
+			FHapticFeedbackBuffer& Resampled = ControllerState.ResampledHapticBuffer;
+			ControllerState.MirrorResampledProgress(Play, 2);
+			TestEqual("Nothing sent", Play.SamplesSent, 0);
+			TestEqual("At the start", Play.CurrentPtr, 0);
+
+			Resampled.CurrentPtr = Resampled.SamplesSent = Resampled.BufferLength;
+			ControllerState.MirrorResampledProgress(Play, 2);
+			TestEqual("All samples sent", Play.SamplesSent, Play.BufferLength / 2);
+			TestEqual("At the end", Play.CurrentPtr, Play.BufferLength);
+		});
+
+		It("should share the samples between controllers", [this]() {
+			FOculusXRHapticsClipCache& ClipCache = FOculusXRHapticsClipCache::Get();
+			const UHapticFeedbackEffect_Base* Effect = NewObject<UHapticFeedbackEffect_Curve>();
+			FOculusTouchControllerState LeftState(EControllerHand::Left);
+			FOculusTouchControllerState RightState(EControllerHand::Right);
+
+			FHapticFeedbackBuffer LeftPlay = MakeSourceBuffer(PCMData);
+			FHapticFeedbackBuffer RightPlay = MakeSourceBuffer(PCMData);
+			LeftState.ResampleHapticBufferData(Effect, LeftPlay, ControllerSampleRate, ClipCache);
+			const FOculusXRHapticsClipCache::FStats Before = ClipCache.GetStats();
+			RightState.ResampleHapticBufferData(Effect, RightPlay, ControllerSampleRate, ClipCache);
+			TestTrue("Cache hit", ClipCache.GetStats().Hits == Before.Hits + 1);
+			TestTrue("Same samples", RightState.ResampledHapticBuffer.RawData == LeftState.ResampledHapticBuffer.RawData);
+		});
+
+		It("should not play effects without samples", [this]() {
+			FOculusXRHapticsClipCache& ClipCache = FOculusXRHapticsClipCache::Get();
+			const UHapticFeedbackEffect_Base* Effect = NewObject<UHapticFeedbackEffect_Curve>();
+			FOculusTouchControllerState ControllerState(EControllerHand::Left);
+
+			FHapticFeedbackBuffer Play = MakeSourceBuffer(PCMData);
+			Play.RawData = nullptr;
+			TestFalse("Nothing to play", ControllerState.ResampleHapticBufferData(Effect, Play, ControllerSampleRate, ClipCache));
+		});
+	});
+}
@@ -0,0 +1,63 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "UObject/ObjectKey.h"
+#include "OculusXRBakedHapticClip.generated.h"
+
+class UHapticFeedbackEffect_Base;
+
+USTRUCT()
+struct FOculusXRBakedHapticSamples
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Haptics")
+	int32 SampleRate = 0;
+
+	UPROPERTY()
+	TArray<uint8> Samples;
+};
+
+/**
+ * Haptic effect resampled to the controller sample rates when the asset is saved or cooked.
+ * While the asset is loaded, playing SourceEffect uses the baked samples instead of resampling at runtime.
+ */
+UCLASS(BlueprintType)
+class OCULUSXRINPUT_API UOculusXRBakedHapticClip : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UOculusXRBakedHapticClip();
+
+	/** Sound wave or buffer effect to bake */
+	UPROPERTY(EditAnywhere, Category = "Haptics")
+	TObjectPtr<UHapticFeedbackEffect_Base> SourceEffect;
+
+	/** Controller sample rates to bake the effect for */
+	UPROPERTY(EditAnywhere, Category = "Haptics")
+	TArray<int32> SampleRates;
+
+	/** Resampled data, one entry per sample rate */
+	UPROPERTY(VisibleAnywhere, Category = "Haptics")
+	TArray<FOculusXRBakedHapticSamples> BakedSamples;
+
+	/** Resample SourceEffect for every sample rate. Done automatically on save. */
+	UFUNCTION(CallInEditor, Category = "Haptics")
+	void Bake();
+
+	virtual void PostLoad() override;
+	virtual void BeginDestroy() override;
+#if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#endif
+
+private:
+	void RegisterBakedSamples();
+
+	/** Effect the baked samples were registered for, so they can be removed even if SourceEffect changes */
+	FObjectKey RegisteredEffect;
+};
@@ -32,6 +32,9 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Properties")
 	bool RenderWhenUsingControllerDrivenHands;
 
+protected:
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
+
 private:
 	enum MeshLoadingState
 	{
@@ -49,6 +52,8 @@ private:
 	EOculusXRControllerDrivenHandPoseTypes _cachedControllerHandType;
 
 	void InitializeMesh();
+	void UpdateController(bool bIsHandTrackingEnabled);
+	static void TickBatch(TArrayView<UActorComponent* const> Components, TArrayView<const float> DeltaTimes);
 	void MeshLoaded();
 	EOculusXRControllerType GetControllerType();
 
@@ -0,0 +1,67 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "OculusXRHandFeatures.h"
+#include "Components/SceneComponent.h"
+#include "OculusXRHandFeatureComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOculusXRHandGestureDelegate, EOculusXRHandType, Hand, EOculusXRHandGesture, Gesture);
+
+/**
+ * Extracts the hand feature vector once per frame and raises debounced gesture events.
+ * Attach it to the same motion controller as the hand component so that features are in the same space as the rendered hand.
+ */
+UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent), ClassGroup = OculusHand)
+class OCULUSXRINPUT_API UOculusXRHandFeatureComponent : public USceneComponent
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	virtual void BeginPlay() override;
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** The hand the features are computed for */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "HandProperties")
+	EOculusXRHandType HandType = EOculusXRHandType::HandLeft;
+
+	/** Thresholds used to detect gestures */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HandProperties")
+	FOculusXRHandGestureThresholds Thresholds;
+
+	/** Called when a gesture becomes active */
+	UPROPERTY(BlueprintAssignable, Category = "OculusLibrary|HandTracking")
+	FOculusXRHandGestureDelegate OnGestureStarted;
+
+	/** Called when a gesture is no longer active */
+	UPROPERTY(BlueprintAssignable, Category = "OculusLibrary|HandTracking")
+	FOculusXRHandGestureDelegate OnGestureEnded;
+
+	/** Features computed in the current frame */
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary|HandTracking")
+	const FOculusXRHandFeatures& GetHandFeatures() const { return Extractor.GetFeatures(); }
+
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary|HandTracking")
+	FVector GetFingertipPosition(EOculusXRFinger Finger) const;
+
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary|HandTracking")
+	float GetFingerCurl(EOculusXRFinger Finger) const;
+
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary|HandTracking")
+	float GetPinchDistance(EOculusXRFinger Finger) const;
+
+	UFUNCTION(BlueprintPure, Category = "OculusLibrary|HandTracking")
+	bool IsGestureActive(EOculusXRHandGesture Gesture) const;
+
+private:
+	FOculusXRHandFeatureExtractor Extractor;
+
+	/** Reused every frame to avoid allocations */
+	TArray<FOculusXRHandGestureEvent> PendingEvents;
+
+	/** Time until the rest pose is queried again while it isn't available */
+	float RestPoseRetryTimer = 0.0f;
+
+	void InitializeRestPose();
+};
@@ -0,0 +1,211 @@
+// @lint-ignore-every LICENSELINT
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#include "CoreMinimal.h"
+#include "OculusXRInputFunctionLibrary.h"
+
+#include "OculusXRHandFeatures.generated.h"
+
+const int OculusXRHandFingerCount = 5;
+
+/** Gestures derived from the per-frame hand features */
+UENUM(BlueprintType)
+enum class EOculusXRHandGesture : uint8
+{
+	IndexPinch,
+	MiddlePinch,
+	Grab,
+	Point,
+	OpenPalm,
+
+	Gesture_Count UMETA(Hidden, DisplayName = "<INVALID>"),
+};
+
+/** Thresholds used to turn hand features into debounced gestures. Distances are in world units. */
+USTRUCT(BlueprintType)
+struct OCULUSXRINPUT_API FOculusXRHandGestureThresholds
+{
+	GENERATED_BODY()
+
+	/** Thumb tip to finger tip distance below which a pinch starts */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusLibrary|HandTracking")
+	float PinchStartDistance = 1.5f;
+
+	/** Thumb tip to finger tip distance above which a pinch ends. Should be larger than PinchStartDistance. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusLibrary|HandTracking")
+	float PinchEndDistance = 2.5f;
+
+	/** Average curl of the middle, ring and pinky fingers above which a grab starts */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusLibrary|HandTracking", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float GrabStartCurl = 0.65f;
+
+	/** Average curl of the middle, ring and pinky fingers below which a grab ends. Should be smaller than GrabStartCurl. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusLibrary|HandTracking", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float GrabEndCurl = 0.45f;
+
+	/** Index finger curl below which the index is considered extended for pointing */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusLibrary|HandTracking", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float ExtendedCurl = 0.25f;
+
+	/** Finger curl above which a finger is considered folded for pointing */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusLibrary|HandTracking", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float FoldedCurl = 0.55f;
+
+	/** Time in seconds a gesture condition has to hold before the gesture state changes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusLibrary|HandTracking", meta = (ClampMin = "0.0"))
+	float DebounceTime = 0.05f;
+
+	/** Whether low confidence samples should end all active gestures */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusLibrary|HandTracking")
+	bool bRequireHighConfidence = true;
+};
+
+/**
+ * Standard feature vector of a tracked hand, computed once per hand per frame.
+ * Positions and directions are in world space.
+ */
+USTRUCT(BlueprintType)
+struct OCULUSXRINPUT_API FOculusXRHandFeatures
+{
+	GENERATED_BODY()
+
+	/** Whether the features were computed from a tracked hand */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	bool bIsValid = false;
+
+	/** Tracking confidence of the hand when the features were computed */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	EOculusXRTrackingConfidence Confidence = EOculusXRTrackingConfidence::Low;
+
+	/** Tip positions indexed by EOculusXRFinger */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	TArray<FVector> FingertipPositions;
+
+	/** Normalized flexion in [0, 1] indexed by EOculusXRFinger, 0 is fully extended */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	TArray<float> FingerCurls;
+
+	/** Thumb tip to finger tip distance indexed by EOculusXRFinger, the thumb entry is always zero */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	TArray<float> PinchDistances;
+
+	/** Palm frame, X points towards the fingers and Z along the palm normal */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	FTransform PalmTransform;
+
+	/** Direction the inside of the palm is facing */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	FVector PalmNormal = FVector::ZeroVector;
+
+	/** Linear velocity of the palm center */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	FVector PalmVelocity = FVector::ZeroVector;
+
+	/** Angular velocity of the palm frame in radians per second */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	FVector PalmAngularVelocity = FVector::ZeroVector;
+
+	/** Average distance between the finger tips and the thumb tip */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusLibrary|HandTracking")
+	float GrabAperture = 0.0f;
+
+	FOculusXRHandFeatures();
+};
+
+/**
+ * A single frame of hand tracking data. This is all the extractor needs, which allows it to
+ * be fed from the runtime or from a recorded bone stream.
+ */
+struct OCULUSXRINPUT_API FOculusXRHandBoneSnapshot
+{
+	/** World transform of the hand root, i.e. the component the hand skeleton is attached to */
+	FTransform RootTransform = FTransform::Identity;
+
+	/** Local bone rotations as reported by the runtime, indexed by EOculusXRBone */
+	FQuat BoneRotations[(int32)EOculusXRBone::Bone_Max];
+
+	/** Uniform scale of the hand */
+	float HandScale = 1.0f;
+
+	/** Time stamp of the sample in seconds */
+	double Time = 0.0;
+
+	bool bIsTracked = false;
+
+	EOculusXRTrackingConfidence Confidence = EOculusXRTrackingConfidence::Low;
+
+	FOculusXRHandBoneSnapshot();
+};
+
+/**
+ * Reference pose of the hand skeleton. Bone offsets are local translations relative to the parent
+ * bone in world units, indexed by EOculusXRBone.
+ */
+struct OCULUSXRINPUT_API FOculusXRHandRestPose
+{
+	FVector BoneOffsets[(int32)EOculusXRBone::Bone_Max];
+	int32 BoneParents[(int32)EOculusXRBone::Bone_Max];
+
+	/** Whether the offsets were filled in from a skeleton */
+	bool bIsValid = false;
+
+	FOculusXRHandRestPose();
+};
+
+struct FOculusXRHandGestureEvent
+{
+	EOculusXRHandGesture Gesture;
+	bool bStarted;
+};
+
+/**
+ * Computes FOculusXRHandFeatures from bone snapshots and tracks debounced gesture states.
+ * Does not touch the runtime, so it can be driven from recorded bone streams.
+ */
+class OCULUSXRINPUT_API FOculusXRHandFeatureExtractor
+{
+public:
+	FOculusXRHandFeatureExtractor(EOculusXRHandType InHand = EOculusXRHandType::None);
+
+	void SetRestPose(const FOculusXRHandRestPose& InRestPose) { RestPose = InRestPose; }
+	const FOculusXRHandRestPose& GetRestPose() const { return RestPose; }
+
+	void SetThresholds(const FOculusXRHandGestureThresholds& InThresholds) { Thresholds = InThresholds; }
+	const FOculusXRHandGestureThresholds& GetThresholds() const { return Thresholds; }
+
+	/** Compute the features for a new snapshot and update the gesture states. Gesture transitions are appended to OutEvents. */
+	void Update(const FOculusXRHandBoneSnapshot& Snapshot, TArray<FOculusXRHandGestureEvent>& OutEvents);
+
+	/** Forget the previous sample and end all gestures without emitting events */
+	void Reset();
+
+	const FOculusXRHandFeatures& GetFeatures() const { return Features; }
+	bool IsGestureActive(EOculusXRHandGesture Gesture) const { return GestureStates[(int32)Gesture].bActive; }
+
+	/** World space transforms of all bones from the last update, indexed by EOculusXRBone */
+	const FTransform& GetBoneTransform(EOculusXRBone Bone) const { return BoneTransforms[(int32)Bone]; }
+
+private:
+	struct FGestureState
+	{
+		bool bActive = false;
+		float PendingTime = 0.0f;
+	};
+
+	void ComputeBoneTransforms(const FOculusXRHandBoneSnapshot& Snapshot);
+	void ComputeFeatures(const FOculusXRHandBoneSnapshot& Snapshot);
+	bool EvaluateGesture(EOculusXRHandGesture Gesture, bool bActive) const;
+	float ComputeFingerCurl(EOculusXRFinger Finger) const;
+
+	EOculusXRHandType Hand;
+	FOculusXRHandRestPose RestPose;
+	FOculusXRHandGestureThresholds Thresholds;
+	FOculusXRHandFeatures Features;
+	FTransform BoneTransforms[(int32)EOculusXRBone::Bone_Max];
+	FGestureState GestureStates[(int32)EOculusXRHandGesture::Gesture_Count];
+
+	bool bHasPreviousSample = false;
+	double PreviousTime = 0.0;
+	FTransform PreviousPalmTransform;
+};
@@ -13,6 +13,8 @@ namespace UnrealBuildTool.Rules
 				new string[] {
 					"LiveLinkInterface",
 					"LiveLinkAnimationCore",
+					"AnimGraphRuntime",
+					"OculusXRHMD",
 				});
 
 			PrivateDependencyModuleNames.AddRange(
@@ -26,7 +28,6 @@ namespace UnrealBuildTool.Rules
 					"LiveLink",
 					"HeadMountedDisplay",
 					"OVRPluginXR",
-					"OculusXRHMD",
 				});
 
 			PrivateIncludePaths.AddRange(
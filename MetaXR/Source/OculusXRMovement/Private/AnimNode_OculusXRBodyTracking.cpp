@@ -0,0 +1,115 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "AnimNode_OculusXRBodyTracking.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "OculusXRHMDPrivate.h"
+#include "OculusXRMovementLatchedState.h"
+
+void FAnimNode_OculusXRBodyTracking::PreUpdate(const UAnimInstance* InAnimInstance)
+{
+	OculusXRHMD::GetUnitScaleFactorFromSettings(InAnimInstance->GetWorld(), WorldToMeters);
+	BodyState = OculusXRMovement::LatchBodyState(WorldToMeters);
+}
+
+void FAnimNode_OculusXRBodyTracking::GatherDebugData(FNodeDebugData& DebugData)
+{
+	FString DebugLine = DebugData.GetNodeName(this);
+	DebugLine += FString::Printf(TEXT("(Bound joints: %d, Body state: %s, Confidence: %.2f)"),
+		JointBindings.Num(),
+		BodyState.IsValid() && BodyState->IsActive ? TEXT("active") : TEXT("inactive"),
+		BodyState.IsValid() ? BodyState->Confidence : 0.0f);
+	DebugData.AddDebugItem(DebugLine);
+
+	ComponentPose.GatherDebugData(DebugData);
+}
+
+void FAnimNode_OculusXRBodyTracking::EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms)
+{
+	SCOPE_CYCLE_COUNTER(STAT_OculusXRBodyTrackingAnimNode);
+
+	// Walk the bones parent first up to the last bound one, so that a bone that is only rotated keeps the position
+	// its parent gives it. That's the behavior of the component, which sets the joints one by one.
+	const FCompactPose& LocalPose = Output.Pose.GetPose();
+	const int32 NumBones = JointBindings.Last().BoneIndex.GetInt() + 1;
+	ComponentSpaceScratch.SetNumUninitialized(NumBones);
+
+	int32 BindingIndex = 0;
+	for (FCompactPoseBoneIndex BoneIndex(0); BoneIndex.GetInt() < NumBones; ++BoneIndex)
+	{
+		const FCompactPoseBoneIndex ParentIndex = LocalPose.GetParentBoneIndex(BoneIndex);
+		FTransform& Transform = ComponentSpaceScratch[BoneIndex.GetInt()];
+		Transform = ParentIndex.IsValid() ? LocalPose[BoneIndex] * ComponentSpaceScratch[ParentIndex.GetInt()] : LocalPose[BoneIndex];
+
+		bool bBound = false;
+		for (; BindingIndex < JointBindings.Num() && JointBindings[BindingIndex].BoneIndex == BoneIndex; ++BindingIndex)
+		{
+			const int32 JointIndex = JointBindings[BindingIndex].JointIndex;
+			if (!BodyState->Joints.IsValidIndex(JointIndex) || !BodyState->Joints[JointIndex].bIsValid)
+			{
+				continue;
+			}
+
+			const FOculusXRBodyJoint& Joint = BodyState->Joints[JointIndex];
+			if (BodyTrackingMode == EOculusXRBodyTrackingMode::PositionAndRotation)
+			{
+				Transform = FTransform(Joint.Orientation, Joint.Position);
+			}
+			else
+			{
+				Transform.SetRotation(Joint.Orientation.Quaternion());
+			}
+			bBound = true;
+		}
+
+		if (bBound)
+		{
+			OutBoneTransforms.Add(FBoneTransform(BoneIndex, Transform));
+		}
+	}
+}
+
+bool FAnimNode_OculusXRBodyTracking::IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones)
+{
+	return BodyTrackingMode != EOculusXRBodyTrackingMode::NoTracking
+		&& !JointBindings.IsEmpty()
+		&& BodyState.IsValid()
+		&& BodyState->IsActive
+		&& BodyState->Confidence > ConfidenceThreshold;
+}
+
+void FAnimNode_OculusXRBodyTracking::InitializeBoneReferences(const FBoneContainer& RequiredBones)
+{
+	JointBindings.Reset();
+
+	const UEnum* BoneIdEnum = StaticEnum<EOculusXRBoneID>();
+	for (int32 JointIndex = 0; JointIndex < static_cast<int32>(EOculusXRBoneID::COUNT); ++JointIndex)
+	{
+		FName BoneName;
+		if (const FName* MappedBoneName = BoneNames.Find(static_cast<EOculusXRBoneID>(JointIndex)))
+		{
+			BoneName = *MappedBoneName;
+		}
+		else
+		{
+			FString DefaultBoneName = BoneIdEnum->GetNameStringByValue(JointIndex);
+			DefaultBoneName.RemoveFromStart(TEXT("Body"));
+			BoneName = FName(*DefaultBoneName);
+		}
+
+		const int32 MeshBoneIndex = BoneName != NAME_None ? RequiredBones.GetPoseBoneIndexForBoneName(BoneName) : INDEX_NONE;
+		if (MeshBoneIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		// Bones that were removed by the LOD aren't part of the compact pose
+		const FCompactPoseBoneIndex BoneIndex = RequiredBones.MakeCompactPoseIndex(FMeshPoseBoneIndex(MeshBoneIndex));
+		if (BoneIndex.IsValid())
+		{
+			JointBindings.Add({ JointIndex, BoneIndex });
+		}
+	}
+
+	JointBindings.Sort([](const FJointBinding& A, const FJointBinding& B) { return A.BoneIndex.GetInt() < B.BoneIndex.GetInt(); });
+}
@@ -0,0 +1,86 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "AnimNode_OculusXREyeTracking.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "AnimationRuntime.h"
+#include "OculusXRHMDPrivate.h"
+#include "OculusXRMovementLatchedState.h"
+
+FAnimNode_OculusXREyeTracking::FAnimNode_OculusXREyeTracking()
+{
+	EyeToBone.Add(EOculusXREye::Left, "LeftEye");
+	EyeToBone.Add(EOculusXREye::Right, "RightEye");
+}
+
+void FAnimNode_OculusXREyeTracking::PreUpdate(const UAnimInstance* InAnimInstance)
+{
+	OculusXRHMD::GetUnitScaleFactorFromSettings(InAnimInstance->GetWorld(), WorldToMeters);
+	EyeGazesState = OculusXRMovement::LatchEyeGazesState(WorldToMeters);
+}
+
+void FAnimNode_OculusXREyeTracking::GatherDebugData(FNodeDebugData& DebugData)
+{
+	FString DebugLine = DebugData.GetNodeName(this);
+	DebugLine += FString::Printf(TEXT("(Bound eyes: %d, Eye gazes: %s)"), EyeBindings.Num(), EyeGazesState.IsValid() ? TEXT("valid") : TEXT("invalid"));
+	DebugData.AddDebugItem(DebugLine);
+
+	ComponentPose.GatherDebugData(DebugData);
+}
+
+void FAnimNode_OculusXREyeTracking::EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms)
+{
+	SCOPE_CYCLE_COUNTER(STAT_OculusXREyeTrackingAnimNode);
+
+	for (const FEyeBinding& Binding : EyeBindings)
+	{
+		if (!EyeGazesState->EyeGazes.IsValidIndex(Binding.EyeIndex))
+		{
+			continue;
+		}
+
+		const FOculusXREyeGazeState& EyeGaze = EyeGazesState->EyeGazes[Binding.EyeIndex];
+		if ((bAcceptInvalid || EyeGaze.bIsValid) && (EyeGaze.Confidence >= ConfidenceThreshold))
+		{
+			FTransform Transform = Output.Pose.GetComponentSpaceTransform(Binding.BoneIndex);
+			if (bUpdatePosition)
+			{
+				Transform.SetLocation(EyeGaze.Position);
+			}
+			if (bUpdateRotation)
+			{
+				Transform.SetRotation(EyeGaze.Orientation.Quaternion() * Binding.InitialRotation);
+			}
+			OutBoneTransforms.Add(FBoneTransform(Binding.BoneIndex, Transform));
+		}
+	}
+}
+
+bool FAnimNode_OculusXREyeTracking::IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones)
+{
+	return (bUpdatePosition || bUpdateRotation) && !EyeBindings.IsEmpty() && EyeGazesState.IsValid();
+}
+
+void FAnimNode_OculusXREyeTracking::InitializeBoneReferences(const FBoneContainer& RequiredBones)
+{
+	EyeBindings.Reset();
+
+	for (const TPair<EOculusXREye, FName>& Pair : EyeToBone)
+	{
+		const int32 MeshBoneIndex = RequiredBones.GetPoseBoneIndexForBoneName(Pair.Value);
+		if (MeshBoneIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		// Bones that were removed by the LOD aren't part of the compact pose
+		const FCompactPoseBoneIndex BoneIndex = RequiredBones.MakeCompactPoseIndex(FMeshPoseBoneIndex(MeshBoneIndex));
+		if (BoneIndex.IsValid())
+		{
+			const FQuat InitialRotation = FAnimationRuntime::GetComponentSpaceTransformRefPose(RequiredBones.GetReferenceSkeleton(), MeshBoneIndex).GetRotation();
+			EyeBindings.Add({ static_cast<int32>(Pair.Key), BoneIndex, InitialRotation });
+		}
+	}
+
+	EyeBindings.Sort([](const FEyeBinding& A, const FEyeBinding& B) { return A.BoneIndex.GetInt() < B.BoneIndex.GetInt(); });
+}
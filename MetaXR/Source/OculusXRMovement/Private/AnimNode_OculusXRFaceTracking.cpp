@@ -0,0 +1,128 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "AnimNode_OculusXRFaceTracking.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Animation/Skeleton.h"
+#include "OculusXRFaceTrackingComponent.h"
+#include "OculusXRMovementLatchedState.h"
+
+void FAnimNode_OculusXRFaceTracking::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	FAnimNode_Base::Initialize_AnyThread(Context);
+	Source.Initialize(Context);
+
+	bHasWeights = false;
+	bApplyWeights = false;
+	InvalidFaceStateTime = 0.0f;
+}
+
+void FAnimNode_OculusXRFaceTracking::CacheBones_AnyThread(const FAnimationCacheBonesContext& Context)
+{
+	Source.CacheBones(Context);
+}
+
+void FAnimNode_OculusXRFaceTracking::PreUpdate(const UAnimInstance* InAnimInstance)
+{
+	FaceState = OculusXRMovement::LatchFaceState();
+}
+
+void FAnimNode_OculusXRFaceTracking::OnInitializeAnimInstance(const FAnimInstanceProxy* InProxy, const UAnimInstance* InAnimInstance)
+{
+	const UOculusXRFaceTrackingComponent* Defaults = GetDefault<UOculusXRFaceTrackingComponent>();
+
+	CurveBindings.Reset();
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+	const USkeleton* Skeleton = InAnimInstance->CurrentSkeleton;
+#endif
+	for (const TPair<EOculusXRFaceExpression, FName>& Pair : ExpressionNames.IsEmpty() ? Defaults->ExpressionNames : ExpressionNames)
+	{
+		if (Pair.Key < EOculusXRFaceExpression::COUNT && Pair.Value != NAME_None)
+		{
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+			const SmartName::UID_Type UID = IsValid(Skeleton) ? Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, Pair.Value) : SmartName::MaxUID;
+			if (UID != SmartName::MaxUID)
+			{
+				CurveBindings.Add({ static_cast<int32>(Pair.Key), UID });
+			}
+#else
+			CurveBindings.Add({ static_cast<int32>(Pair.Key), Pair.Value });
+#endif
+		}
+	}
+
+	ActiveModifiers.Reset();
+	if (bUseModifiers)
+	{
+		ActiveModifiers = ExpressionModifiers.IsEmpty() ? Defaults->ExpressionModifiers : ExpressionModifiers;
+	}
+}
+
+void FAnimNode_OculusXRFaceTracking::Update_AnyThread(const FAnimationUpdateContext& Context)
+{
+	GetEvaluateGraphExposedInputs().Execute(Context);
+	Source.Update(Context);
+
+	if (!IsLODEnabled(Context.AnimInstanceProxy))
+	{
+		bApplyWeights = false;
+		return;
+	}
+
+	if (!FaceState.IsValid())
+	{
+		InvalidFaceStateTime += Context.GetDeltaTime();
+		bApplyWeights = bHasWeights && InvalidFaceStateTime < InvalidFaceDataResetTime;
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_OculusXRFaceTrackingAnimNode);
+
+	InvalidFaceStateTime = 0.0f;
+	for (int32 ExpressionIndex = 0; ExpressionIndex < static_cast<int32>(EOculusXRFaceExpression::COUNT); ++ExpressionIndex)
+	{
+		Weights[ExpressionIndex] = FaceState->ExpressionWeights.IsValidIndex(ExpressionIndex) ? FaceState->ExpressionWeights[ExpressionIndex] : 0.0f;
+	}
+
+	for (const FOculusXRFaceExpressionModifier& Modifier : ActiveModifiers)
+	{
+		for (const EOculusXRFaceExpression Expression : Modifier.FaceExpressions)
+		{
+			if (Expression < EOculusXRFaceExpression::COUNT)
+			{
+				float& Weight = Weights[static_cast<int32>(Expression)];
+				Weight = FMath::Clamp(Weight * Modifier.Multiplier, Modifier.MinValue, Modifier.MaxValue);
+			}
+		}
+	}
+
+	bHasWeights = true;
+	bApplyWeights = true;
+}
+
+void FAnimNode_OculusXRFaceTracking::Evaluate_AnyThread(FPoseContext& Output)
+{
+	Source.Evaluate(Output);
+
+	if (bApplyWeights)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_OculusXRFaceTrackingAnimNode);
+		for (const FCurveBinding& Binding : CurveBindings)
+		{
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+			Output.Curve.Set(Binding.CurveUID, Weights[Binding.ExpressionIndex]);
+#else
+			Output.Curve.Set(Binding.CurveName, Weights[Binding.ExpressionIndex]);
+#endif
+		}
+	}
+}
+
+void FAnimNode_OculusXRFaceTracking::GatherDebugData(FNodeDebugData& DebugData)
+{
+	FString DebugLine = DebugData.GetNodeName(this);
+	DebugLine += FString::Printf(TEXT("(Curves: %d, Face state: %s)"), CurveBindings.Num(), FaceState.IsValid() ? TEXT("valid") : TEXT("invalid"));
+	DebugData.AddDebugItem(DebugLine);
+
+	Source.GatherDebugData(DebugData);
+}
@@ -0,0 +1,219 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "OculusXRAvatarSignificance.h"
+
+#include "Animation/AnimInstance.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "OculusXRMovementLog.h"
+
+static TAutoConsoleVariable<int32> CVarOVRAvatarSignificance(
+	TEXT("ovr.AvatarSignificance"),
+	1,
+	TEXT("Enables or disables the significance based update rate of the tracked avatars.\n")
+		TEXT("<=0: disabled (all avatars at full detail)\n")
+			TEXT("  1: enabled\n"));
+
+static void OVRAvatarSignificanceStatsCmdHandler(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	if (const UOculusXRAvatarSignificanceSubsystem* Subsystem = World ? World->GetSubsystem<UOculusXRAvatarSignificanceSubsystem>() : nullptr)
+	{
+		Subsystem->DumpStats(Ar);
+	}
+}
+
+static FAutoConsoleCommand COVRAvatarSignificanceStatsCmd(
+	TEXT("ovr.AvatarSignificance.Stats"),
+	TEXT("Lists the number of tracked avatars per LOD tier and the tier of each avatar."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(OVRAvatarSignificanceStatsCmdHandler));
+
+FOculusXRAvatarLODTierSettings::FOculusXRAvatarLODTierSettings()
+	: MinScreenSize(0.f)
+	, MaxAvatars(0)
+	, UpdateRate(0.f)
+	, bUpdateFace(true)
+	, bUpdateFingers(true)
+{
+}
+
+FOculusXRAvatarLODTierSettings::FOculusXRAvatarLODTierSettings(float InMinScreenSize, int32 InMaxAvatars, float InUpdateRate, bool bInUpdateFace, bool bInUpdateFingers)
+	: MinScreenSize(InMinScreenSize)
+	, MaxAvatars(InMaxAvatars)
+	, UpdateRate(InUpdateRate)
+	, bUpdateFace(bInUpdateFace)
+	, bUpdateFingers(bInUpdateFingers)
+{
+}
+
+UOculusXRAvatarSignificanceSubsystem::UOculusXRAvatarSignificanceSubsystem()
+	: OffscreenScreenSizeScale(0.f)
+	, NumAvatarsPerTier(InPlace, 0)
+{
+	Tiers.Emplace(0.25f, 4, 0.f, true, true);
+	Tiers.Emplace(0.1f, 8, 30.f, true, false);
+	Tiers.Emplace(0.03f, 0, 15.f, false, false);
+	Tiers.Emplace(0.f, 0, 5.f, false, false);
+}
+
+TSharedPtr<FOculusXRAvatarSignificanceState, ESPMode::ThreadSafe> UOculusXRAvatarSignificanceSubsystem::RegisterAvatar(USkinnedMeshComponent* Mesh)
+{
+	FScopeLock Lock(&AvatarsLock);
+
+	if (const FAvatar* Avatar = Avatars.FindByPredicate([Mesh](const FAvatar& Avatar) { return Avatar.Mesh == Mesh; }))
+	{
+		return Avatar->State;
+	}
+
+	FAvatar& Avatar = Avatars.AddDefaulted_GetRef();
+	Avatar.Mesh = Mesh;
+	Avatar.State = MakeShared<FOculusXRAvatarSignificanceState, ESPMode::ThreadSafe>();
+	return Avatar.State;
+}
+
+void UOculusXRAvatarSignificanceSubsystem::SetAvatarIsLocal(USkinnedMeshComponent* Mesh, bool bIsLocal)
+{
+	RegisterAvatar(Mesh);
+
+	FScopeLock Lock(&AvatarsLock);
+	if (FAvatar* Avatar = Avatars.FindByPredicate([Mesh](const FAvatar& Avatar) { return Avatar.Mesh == Mesh; }))
+	{
+		Avatar->bIsLocalOverride = bIsLocal;
+	}
+}
+
+EOculusXRAvatarLODTier UOculusXRAvatarSignificanceSubsystem::GetAvatarTier(USkinnedMeshComponent* Mesh) const
+{
+	FScopeLock Lock(&AvatarsLock);
+	const FAvatar* Avatar = Avatars.FindByPredicate([Mesh](const FAvatar& Avatar) { return Avatar.Mesh == Mesh; });
+	return Avatar ? Avatar->State->Tier.load() : EOculusXRAvatarLODTier::Full;
+}
+
+FOculusXRAvatarSignificanceStats UOculusXRAvatarSignificanceSubsystem::GetStats() const
+{
+	FOculusXRAvatarSignificanceStats Stats;
+	FScopeLock Lock(&AvatarsLock);
+	Stats.NumAvatars = Avatars.Num();
+	Stats.NumAvatarsPerTier = TArray<int32>(NumAvatarsPerTier.GetData(), NumAvatarsPerTier.Num());
+	return Stats;
+}
+
+void UOculusXRAvatarSignificanceSubsystem::DumpStats(FOutputDevice& Ar) const
+{
+	FScopeLock Lock(&AvatarsLock);
+	const UEnum* TierEnum = StaticEnum<EOculusXRAvatarLODTier>();
+
+	Ar.Logf(TEXT("%d tracked avatars"), Avatars.Num());
+	for (int32 Tier = 0; Tier < NumAvatarsPerTier.Num(); ++Tier)
+	{
+		Ar.Logf(TEXT("  %s: %d"), *TierEnum->GetNameStringByIndex(Tier), NumAvatarsPerTier[Tier]);
+	}
+	for (const FAvatar& Avatar : Avatars)
+	{
+		Ar.Logf(TEXT("  %s: %s, score %.3f"), *GetPathNameSafe(Avatar.Mesh.Get()), *TierEnum->GetNameStringByValue(static_cast<int64>(Avatar.State->Tier.load())), Avatar.Score);
+	}
+}
+
+TSharedPtr<FOculusXRAvatarSignificanceState, ESPMode::ThreadSafe> UOculusXRAvatarSignificanceSubsystem::RegisterRetargetAsset(const UObject* RetargetAsset)
+{
+	// LiveLink creates an instance of the retarget asset per anim instance
+	const UAnimInstance* AnimInstance = RetargetAsset ? Cast<UAnimInstance>(RetargetAsset->GetOuter()) : nullptr;
+	USkinnedMeshComponent* Mesh = AnimInstance ? AnimInstance->GetOwningComponent() : nullptr;
+	UWorld* World = Mesh ? Mesh->GetWorld() : nullptr;
+	UOculusXRAvatarSignificanceSubsystem* Subsystem = World ? World->GetSubsystem<UOculusXRAvatarSignificanceSubsystem>() : nullptr;
+	return Subsystem ? Subsystem->RegisterAvatar(Mesh) : nullptr;
+}
+
+void UOculusXRAvatarSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FScopeLock Lock(&AvatarsLock);
+
+	Avatars.RemoveAll([](const FAvatar& Avatar) { return !Avatar.Mesh.IsValid(); });
+	for (int32& Count : NumAvatarsPerTier)
+	{
+		Count = 0;
+	}
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const APlayerCameraManager* CameraManager = PlayerController ? PlayerController->PlayerCameraManager.Get() : nullptr;
+	if (!CVarOVRAvatarSignificance.GetValueOnGameThread() || !CameraManager || Tiers.IsEmpty())
+	{
+		for (FAvatar& Avatar : Avatars)
+		{
+			Avatar.Score = 1.0f;
+			ApplyTier(Avatar, EOculusXRAvatarLODTier::Full);
+			++NumAvatarsPerTier[0];
+		}
+		return;
+	}
+
+	const FVector ViewLocation = CameraManager->GetCameraLocation();
+	const double TanHalfFOV = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(CameraManager->GetFOVAngle(), 1.0f, 170.0f) * 0.5));
+
+	for (FAvatar& Avatar : Avatars)
+	{
+		const USkinnedMeshComponent* Mesh = Avatar.Mesh.Get();
+		const APawn* Pawn = Cast<APawn>(Mesh->GetOwner());
+		const bool bIsLocal = Avatar.bIsLocalOverride.Get(Pawn && Pawn->IsLocallyControlled());
+		if (bIsLocal)
+		{
+			Avatar.Score = MAX_flt;
+			continue;
+		}
+
+		// Bounds radius relative to the half screen, this covers the distance and the size of the avatar
+		const double Distance = FVector::Dist(Mesh->Bounds.Origin, ViewLocation);
+		float ScreenSize = Mesh->Bounds.SphereRadius / FMath::Max(Distance * TanHalfFOV, 1.0);
+		if (!Mesh->WasRecentlyRendered(0.2f))
+		{
+			ScreenSize *= OffscreenScreenSizeScale;
+		}
+		Avatar.Score = ScreenSize;
+	}
+
+	Avatars.Sort([](const FAvatar& A, const FAvatar& B) { return A.Score > B.Score; });
+
+	const int32 NumTiers = FMath::Min(Tiers.Num(), static_cast<int32>(EOculusXRAvatarLODTier::COUNT));
+	for (FAvatar& Avatar : Avatars)
+	{
+		int32 Tier = 0;
+		while (Tier < NumTiers - 1 && Avatar.Score < Tiers[Tier].MinScreenSize)
+		{
+			++Tier;
+		}
+		// Demote the avatar while the budget of its tier is used up, most significant avatars come first
+		while (Tier < NumTiers - 1 && Tiers[Tier].MaxAvatars > 0 && NumAvatarsPerTier[Tier] >= Tiers[Tier].MaxAvatars)
+		{
+			++Tier;
+		}
+
+		ApplyTier(Avatar, static_cast<EOculusXRAvatarLODTier>(Tier));
+		++NumAvatarsPerTier[Tier];
+	}
+}
+
+bool UOculusXRAvatarSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UOculusXRAvatarSignificanceSubsystem::ApplyTier(FAvatar& Avatar, EOculusXRAvatarLODTier Tier) const
+{
+	const int32 TierIndex = static_cast<int32>(Tier);
+	const FOculusXRAvatarLODTierSettings Settings = Tiers.IsValidIndex(TierIndex) ? Tiers[TierIndex] : FOculusXRAvatarLODTierSettings();
+
+	FOculusXRAvatarSignificanceState& State = *Avatar.State;
+	if (State.Tier.load() != Tier)
+	{
+		UE_LOG(LogOculusXRMovement, Verbose, TEXT("Avatar %s changed to LOD tier %d (score %.3f)"), *GetNameSafe(Avatar.Mesh.Get()), TierIndex, Avatar.Score);
+	}
+	State.Tier = Tier;
+	State.UpdateInterval = Settings.UpdateRate > 0.f ? 1.f / Settings.UpdateRate : 0.f;
+	State.bUpdateFace = Settings.bUpdateFace;
+	State.bUpdateFingers = Settings.bUpdateFingers;
+}
@@ -7,8 +7,10 @@
 #include "OculusXRHMD.h"
 #include "OculusXRPluginWrapper.h"
 #include "OculusXRMovementFunctionLibrary.h"
+#include "OculusXRMovementLatchedState.h"
 #include "OculusXRMovementLog.h"
 #include "OculusXRTelemetryMovementEvents.h"
+#include "Engine/Engine.h"
 
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 static TAutoConsoleVariable<int32> CVarOVRBodyDebugDraw(
@@ -149,10 +151,21 @@ void UOculusXRBodyTrackingComponent::BeginPlay()
 		return;
 	}
 	++TrackingInstanceCount;
+
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->RegisterThrottleable(this);
+	}
 }
 
 void UOculusXRBodyTrackingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	// Unpauses the tick if the workload is throttled, so that the tracker gets stopped below
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->UnregisterThrottleable(this);
+	}
+
 	if (IsComponentTickEnabled())
 	{
 		if (--TrackingInstanceCount == 0)
@@ -171,6 +184,9 @@ void UOculusXRBodyTrackingComponent::TickComponent(float DeltaTime, enum ELevelT
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	// Only the tracking part, the base class ticks the mesh
+	SCOPE_CYCLE_COUNTER(STAT_OculusXRBodyTrackingComponent);
+
 	if (UOculusXRMovementFunctionLibrary::TryGetBodyState(BodyState, WorldToMeters))
 	{
 		if (BodyState.IsActive && BodyState.Confidence > ConfidenceThreshold)
@@ -224,6 +240,24 @@ void UOculusXRBodyTrackingComponent::TickComponent(float DeltaTime, enum ELevelT
 	}
 }
 
+void UOculusXRBodyTrackingComponent::OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy)
+{
+	if (Policy.bPauseTrackingConsumers && IsComponentTickEnabled())
+	{
+		SetComponentTickEnabled(false);
+		bPausedByWorkloadThrottle = true;
+	}
+}
+
+void UOculusXRBodyTrackingComponent::OnWorkloadRestored_Implementation()
+{
+	if (bPausedByWorkloadThrottle)
+	{
+		SetComponentTickEnabled(true);
+		bPausedByWorkloadThrottle = false;
+	}
+}
+
 void UOculusXRBodyTrackingComponent::ResetAllBoneTransforms()
 {
 	for (int i = 0; i < BodyState.Joints.Num(); ++i)
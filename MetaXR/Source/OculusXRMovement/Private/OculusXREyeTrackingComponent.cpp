@@ -8,8 +8,11 @@
 #include "OculusXRPluginWrapper.h"
 #include "OculusXRMovementFunctionLibrary.h"
 #include "OculusXRMovementHelpers.h"
+#include "OculusXRMovementLatchedState.h"
 #include "OculusXRMovementLog.h"
 #include "OculusXRTelemetryMovementEvents.h"
+#include "Engine/Engine.h"
+#include "OculusXRTickManager.h"
 
 int UOculusXREyeTrackingComponent::TrackingInstanceCount = 0;
 
@@ -56,10 +59,21 @@ void UOculusXREyeTrackingComponent::BeginPlay()
 		return;
 	}
 	++TrackingInstanceCount;
+
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->RegisterThrottleable(this);
+	}
 }
 
 void UOculusXREyeTrackingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	// Unpauses the tick if the workload is throttled, so that the tracker gets stopped below
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->UnregisterThrottleable(this);
+	}
+
 	if (IsComponentTickEnabled())
 	{
 		if (--TrackingInstanceCount == 0)
@@ -76,6 +90,8 @@ void UOculusXREyeTrackingComponent::EndPlay(const EEndPlayReason::Type EndPlayRe
 
 void UOculusXREyeTrackingComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	SCOPE_CYCLE_COUNTER(STAT_OculusXREyeTrackingComponent);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (!IsValid(TargetPoseableMeshComponent))
@@ -89,36 +105,106 @@ void UOculusXREyeTrackingComponent::TickComponent(float DeltaTime, enum ELevelTi
 
 	if (UOculusXRMovementFunctionLibrary::TryGetEyeGazesState(EyeGazesState, WorldToMeters))
 	{
-		for (uint8 i = 0u; i < static_cast<uint8>(EOculusXREye::COUNT); ++i)
+		UpdateEyes(EyeGazesState);
+	}
+	else
+	{
+		UE_LOG(LogOculusXRMovement, VeryVerbose, TEXT("Failed to get Eye state from EyeTrackingComponent. (%s:%s)"), *GetOwner()->GetName(), *GetName());
+	}
+}
+
+void UOculusXREyeTrackingComponent::OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy)
+{
+	if (Policy.bPauseTrackingConsumers && IsComponentTickEnabled())
+	{
+		SetComponentTickEnabled(false);
+		bPausedByWorkloadThrottle = true;
+	}
+}
+
+void UOculusXREyeTrackingComponent::OnWorkloadRestored_Implementation()
+{
+	if (bPausedByWorkloadThrottle)
+	{
+		SetComponentTickEnabled(true);
+		bPausedByWorkloadThrottle = false;
+	}
+}
+
+void UOculusXREyeTrackingComponent::RegisterComponentTickFunctions(bool bRegister)
+{
+	static const FOculusXRTickBatchDesc BatchDesc = { TEXT("EyeTracking"), TG_DuringPhysics, &UOculusXREyeTrackingComponent::TickBatch };
+	if (!UOculusXRTickManager::RegisterComponentTick(this, bRegister, BatchDesc))
+	{
+		Super::RegisterComponentTickFunctions(bRegister);
+	}
+}
+
+void UOculusXREyeTrackingComponent::TickBatch(TArrayView<UActorComponent* const> Components, TArrayView<const float> DeltaTimes)
+{
+	SCOPE_CYCLE_COUNTER(STAT_OculusXREyeTrackingComponent);
+
+	// The eye gazes are queried once per world scale, usually all the components share the same one
+	FOculusXREyeGazesState SharedEyeGazesState;
+	float SharedWorldToMeters = 0.0f;
+	bool bQueried = false;
+	bool bEyeGazesStateValid = false;
+
+	for (UActorComponent* Component : Components)
+	{
+		UOculusXREyeTrackingComponent* EyeTracking = CastChecked<UOculusXREyeTrackingComponent>(Component);
+		if (!IsValid(EyeTracking->TargetPoseableMeshComponent))
 		{
-			if (PerEyeData[i].EyeIsMapped)
-			{
-				const auto& Bone = PerEyeData[i].MappedBoneName;
-				const auto& EyeGaze = EyeGazesState.EyeGazes[i];
-				if ((bAcceptInvalid || EyeGaze.bIsValid) && (EyeGaze.Confidence >= ConfidenceThreshold))
-				{
-					int32 BoneIndex = TargetPoseableMeshComponent->GetBoneIndex(Bone);
-					FTransform CurrentTransform = TargetPoseableMeshComponent->GetBoneTransformByName(Bone, EBoneSpaces::ComponentSpace);
+			UE_LOG(LogOculusXRMovement, VeryVerbose, TEXT("No target mesh specified. (%s:%s)"), *EyeTracking->GetOwner()->GetName(), *EyeTracking->GetName());
+			EyeTracking->SetComponentTickEnabled(false);
+			continue;
+		}
 
-					if (bUpdatePosition)
-					{
-						CurrentTransform.SetLocation(EyeGaze.Position);
-					}
+		if (!bQueried || SharedWorldToMeters != EyeTracking->WorldToMeters)
+		{
+			SharedWorldToMeters = EyeTracking->WorldToMeters;
+			bEyeGazesStateValid = UOculusXRMovementFunctionLibrary::TryGetEyeGazesState(SharedEyeGazesState, SharedWorldToMeters);
+			bQueried = true;
+		}
 
-					if (bUpdateRotation)
-					{
-						CurrentTransform.SetRotation(EyeGaze.Orientation.Quaternion() * PerEyeData[i].InitialRotation);
-					}
+		if (bEyeGazesStateValid)
+		{
+			EyeTracking->UpdateEyes(SharedEyeGazesState);
+		}
+		else
+		{
+			UE_LOG(LogOculusXRMovement, VeryVerbose, TEXT("Failed to get Eye state from EyeTrackingComponent. (%s:%s)"), *EyeTracking->GetOwner()->GetName(), *EyeTracking->GetName());
+		}
+	}
+}
 
-					TargetPoseableMeshComponent->SetBoneTransformByName(Bone, CurrentTransform, EBoneSpaces::ComponentSpace);
+void UOculusXREyeTrackingComponent::UpdateEyes(const FOculusXREyeGazesState& EyeGazesState)
+{
+	for (uint8 i = 0u; i < static_cast<uint8>(EOculusXREye::COUNT); ++i)
+	{
+		if (PerEyeData[i].EyeIsMapped)
+		{
+			const auto& Bone = PerEyeData[i].MappedBoneName;
+			const auto& EyeGaze = EyeGazesState.EyeGazes[i];
+			if ((bAcceptInvalid || EyeGaze.bIsValid) && (EyeGaze.Confidence >= ConfidenceThreshold))
+			{
+				int32 BoneIndex = TargetPoseableMeshComponent->GetBoneIndex(Bone);
+				FTransform CurrentTransform = TargetPoseableMeshComponent->GetBoneTransformByName(Bone, EBoneSpaces::ComponentSpace);
+
+				if (bUpdatePosition)
+				{
+					CurrentTransform.SetLocation(EyeGaze.Position);
 				}
+
+				if (bUpdateRotation)
+				{
+					CurrentTransform.SetRotation(EyeGaze.Orientation.Quaternion() * PerEyeData[i].InitialRotation);
+				}
+
+				TargetPoseableMeshComponent->SetBoneTransformByName(Bone, CurrentTransform, EBoneSpaces::ComponentSpace);
 			}
 		}
 	}
-	else
-	{
-		UE_LOG(LogOculusXRMovement, VeryVerbose, TEXT("Failed to get Eye state from EyeTrackingComponent. (%s:%s)"), *GetOwner()->GetName(), *GetName());
-	}
 }
 
 void UOculusXREyeTrackingComponent::ClearRotationValues()
@@ -5,8 +5,11 @@
 #include "OculusXRPluginWrapper.h"
 #include "OculusXRMovementFunctionLibrary.h"
 #include "OculusXRMovementHelpers.h"
+#include "OculusXRMovementLatchedState.h"
 #include "OculusXRMovementLog.h"
 #include "OculusXRTelemetryMovementEvents.h"
+#include "Engine/Engine.h"
+#include "OculusXRTickManager.h"
 
 #include "Engine/SkeletalMesh.h"
 #include "Components/SkeletalMeshComponent.h"
@@ -166,10 +169,21 @@ void UOculusXRFaceTrackingComponent::BeginPlay()
 		return;
 	}
 	++TrackingInstanceCount;
+
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->RegisterThrottleable(this);
+	}
 }
 
 void UOculusXRFaceTrackingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	// Unpauses the tick if the workload is throttled, so that the tracker gets stopped below
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->UnregisterThrottleable(this);
+	}
+
 	if (IsComponentTickEnabled())
 	{
 		if (--TrackingInstanceCount == 0)
@@ -186,6 +200,8 @@ void UOculusXRFaceTrackingComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 
 void UOculusXRFaceTrackingComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	SCOPE_CYCLE_COUNTER(STAT_OculusXRFaceTrackingComponent);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (!IsValid(TargetMeshComponent))
@@ -194,7 +210,70 @@ void UOculusXRFaceTrackingComponent::TickComponent(float DeltaTime, enum ELevelT
 		return;
 	}
 
-	if (UOculusXRMovementFunctionLibrary::TryGetFaceState(FaceState) && bUpdateFace)
+	UpdateFace(DeltaTime, UOculusXRMovementFunctionLibrary::TryGetFaceState(FaceState));
+}
+
+void UOculusXRFaceTrackingComponent::OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy)
+{
+	if (Policy.bPauseTrackingConsumers && IsComponentTickEnabled())
+	{
+		SetComponentTickEnabled(false);
+		bPausedByWorkloadThrottle = true;
+	}
+}
+
+void UOculusXRFaceTrackingComponent::OnWorkloadRestored_Implementation()
+{
+	if (bPausedByWorkloadThrottle)
+	{
+		SetComponentTickEnabled(true);
+		bPausedByWorkloadThrottle = false;
+	}
+}
+
+void UOculusXRFaceTrackingComponent::RegisterComponentTickFunctions(bool bRegister)
+{
+	static const FOculusXRTickBatchDesc BatchDesc = { TEXT("FaceTracking"), TG_DuringPhysics, &UOculusXRFaceTrackingComponent::TickBatch };
+	if (!UOculusXRTickManager::RegisterComponentTick(this, bRegister, BatchDesc))
+	{
+		Super::RegisterComponentTickFunctions(bRegister);
+	}
+}
+
+void UOculusXRFaceTrackingComponent::TickBatch(TArrayView<UActorComponent* const> Components, TArrayView<const float> DeltaTimes)
+{
+	SCOPE_CYCLE_COUNTER(STAT_OculusXRFaceTrackingComponent);
+
+	// There is a single face state per frame, query it once for all the components
+	FOculusXRFaceState SharedFaceState;
+	bool bQueried = false;
+	bool bFaceStateValid = false;
+
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		UOculusXRFaceTrackingComponent* FaceTracking = CastChecked<UOculusXRFaceTrackingComponent>(Components[Index]);
+		if (!IsValid(FaceTracking->TargetMeshComponent))
+		{
+			UE_LOG(LogOculusXRMovement, VeryVerbose, TEXT("No target mesh specified. (%s:%s)"), *FaceTracking->GetOwner()->GetName(), *FaceTracking->GetName());
+			continue;
+		}
+
+		if (!bQueried)
+		{
+			bFaceStateValid = UOculusXRMovementFunctionLibrary::TryGetFaceState(SharedFaceState);
+			bQueried = true;
+		}
+		if (bFaceStateValid)
+		{
+			FaceTracking->FaceState = SharedFaceState;
+		}
+		FaceTracking->UpdateFace(DeltaTimes[Index], bFaceStateValid);
+	}
+}
+
+void UOculusXRFaceTrackingComponent::UpdateFace(float DeltaTime, bool bFaceStateValid)
+{
+	if (bFaceStateValid && bUpdateFace)
 	{
 		InvalidFaceStateTimer = 0.0f;
 
@@ -9,6 +9,7 @@
 #include "BonePose.h"
 
 #include "OculusXRHMDPrivate.h"
+#include "OculusXRAvatarSignificance.h"
 #include "OculusXRMovementLog.h"
 #include "OculusXRMovement.h"
 
@@ -23,10 +24,16 @@ namespace
 		Dir[IndexOfDir % 3] = Sign * 1.0;
 		return FTransform(Dir.ToOrientationQuat());
 	}
+
+	bool IsFingerBone(uint8 BoneId)
+	{
+		return (BoneId >= static_cast<uint8>(EOculusXRBoneID::BodyLeftHandThumbMetacarpal) && BoneId <= static_cast<uint8>(EOculusXRBoneID::BodyLeftHandLittleTip))
+			|| (BoneId >= static_cast<uint8>(EOculusXRBoneID::BodyRightHandThumbMetacarpal) && BoneId <= static_cast<uint8>(EOculusXRBoneID::BodyRightHandLittleTip));
+	}
 } // namespace
 
 UOculusXRLiveLinkRetargetBodyAsset::UOculusXRLiveLinkRetargetBodyAsset(const FObjectInitializer& ObjectInitializer)
-	: Super(ObjectInitializer), RetargetingMode(EOculusXRRetargetingMode::Full), ForwardMesh(EOculusXRAxis::X), Scale(100.f), TrackingSpaceToMeshSpace(FTransform::Identity), BoneNames(InPlace, NAME_None), LastBoneContainerSerialNumber(0)
+	: Super(ObjectInitializer), RetargetingMode(EOculusXRRetargetingMode::Full), ForwardMesh(EOculusXRAxis::X), Scale(100.f), TrackingSpaceToMeshSpace(FTransform::Identity), BoneNames(InPlace, NAME_None), LastBoneContainerSerialNumber(0), TimeSinceUpdate(0.f), bHasRetargetedPoses(false)
 {
 }
 
@@ -65,6 +72,12 @@ void UOculusXRLiveLinkRetargetBodyAsset::Initialize()
 
 	LastBoneContainerSerialNumber = 0;
 	Algo::ForEach(LastSkeletonBoneRemapping, [](FCompactPoseBoneIndex& BoneIndex) { BoneIndex = FCompactPoseBoneIndex(INDEX_NONE); });
+	bHasRetargetedPoses = false;
+
+	if (!SignificanceState.IsValid())
+	{
+		SignificanceState = UOculusXRAvatarSignificanceSubsystem::RegisterRetargetAsset(this);
+	}
 }
 
 void UOculusXRLiveLinkRetargetBodyAsset::BuildPoseFromAnimationData(float DeltaTime, const FLiveLinkSkeletonStaticData* InSkeletonData, const FLiveLinkAnimationFrameData* InFrameData, FCompactPose& OutPose)
@@ -81,10 +94,57 @@ void UOculusXRLiveLinkRetargetBodyAsset::BuildPoseFromAnimationData(float DeltaT
 		OnBoneContainerChanged(OutPose.GetBoneContainer());
 	}
 
+	const float UpdateInterval = SignificanceState.IsValid() ? SignificanceState->UpdateInterval.load() : 0.f;
+	const bool bRetargetFingers = !SignificanceState.IsValid() || SignificanceState->bUpdateFingers.load();
+
+	if (UpdateInterval <= 0.f)
+	{
+		RetargetPose(InFrameData, bRetargetFingers, OutPose);
+		bHasRetargetedPoses = false;
+		return;
+	}
+
+	TimeSinceUpdate += DeltaTime;
+	if (!bHasRetargetedPoses || TimeSinceUpdate >= UpdateInterval)
+	{
+		RetargetPose(InFrameData, bRetargetFingers, OutPose);
+
+		for (uint8 BoneId = 0; BoneId < static_cast<uint8>(EOculusXRBoneID::COUNT); ++BoneId)
+		{
+			if (const FCompactPoseBoneIndex& BoneIndex = LastSkeletonBoneRemapping[BoneId]; BoneIndex != INDEX_NONE)
+			{
+				PreviousLocalPoses[BoneId] = bHasRetargetedPoses ? CurrentLocalPoses[BoneId] : OutPose[BoneIndex];
+				CurrentLocalPoses[BoneId] = OutPose[BoneIndex];
+			}
+		}
+		bHasRetargetedPoses = true;
+		TimeSinceUpdate = 0.f;
+	}
+
+	// Less significant avatars are retargeted at a lower rate, in between the two last retargets are interpolated.
+	// This delays the pose by up to one update interval, the update frame itself outputs the previous retarget so the
+	// blend continues from there on the next frames.
+	const float Alpha = FMath::Clamp(TimeSinceUpdate / UpdateInterval, 0.f, 1.f);
+	for (uint8 BoneId = 0; BoneId < static_cast<uint8>(EOculusXRBoneID::COUNT); ++BoneId)
+	{
+		if (const FCompactPoseBoneIndex& BoneIndex = LastSkeletonBoneRemapping[BoneId]; BoneIndex != INDEX_NONE)
+		{
+			OutPose[BoneIndex].Blend(PreviousLocalPoses[BoneId], CurrentLocalPoses[BoneId], Alpha);
+		}
+	}
+}
+
+void UOculusXRLiveLinkRetargetBodyAsset::RetargetPose(const FLiveLinkAnimationFrameData* InFrameData, bool bRetargetFingers, FCompactPose& OutPose)
+{
 	FCSPose<FCompactPose> MeshPoses;
 	MeshPoses.InitPose(OutPose);
 	for (uint8 BoneId = 0; BoneId < static_cast<uint8>(EOculusXRBoneID::COUNT); ++BoneId)
 	{
+		if (!bRetargetFingers && IsFingerBone(BoneId))
+		{
+			continue;
+		}
+
 		if (const FCompactPoseBoneIndex& BoneIndex = LastSkeletonBoneRemapping[BoneId]; BoneIndex != INDEX_NONE)
 		{
 			FTransform BoneTransform = InFrameData->Transforms[BoneId];
@@ -154,4 +214,5 @@ void UOculusXRLiveLinkRetargetBodyAsset::OnBoneContainerChanged(const FBoneConta
 	}
 
 	LastBoneContainerSerialNumber = BoneContainer.GetSerialNumber();
+	bHasRetargetedPoses = false;
 }
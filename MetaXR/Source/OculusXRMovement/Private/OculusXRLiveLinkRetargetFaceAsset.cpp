@@ -7,6 +7,7 @@
 #include "Animation/AnimCurveTypes.h"
 #include "BonePose.h"
 #include "OculusXRMovement.h"
+#include "OculusXRAvatarSignificance.h"
 #include "OculusXRMovementLog.h"
 
 UOculusXRLiveLinkRetargetFaceAsset::UOculusXRLiveLinkRetargetFaceAsset(const FObjectInitializer& ObjectInitializer)
@@ -22,6 +23,11 @@ void UOculusXRLiveLinkRetargetFaceAsset::Initialize()
 #else
 	Algo::ForEach(RemappingForLastSkeleton, [](TArray<FName>& Arr) { Arr.Reset(); });
 #endif
+
+	if (!SignificanceState.IsValid())
+	{
+		SignificanceState = UOculusXRAvatarSignificanceSubsystem::RegisterRetargetAsset(this);
+	}
 }
 
 void UOculusXRLiveLinkRetargetFaceAsset::BuildPoseAndCurveFromBaseData(float DeltaTime, const FLiveLinkBaseStaticData* InBaseStaticData, const FLiveLinkBaseFrameData* InBaseFrameData, FCompactPose& OutPose, FBlendedCurve& OutCurve)
@@ -43,17 +49,47 @@ void UOculusXRLiveLinkRetargetFaceAsset::BuildPoseAndCurveFromBaseData(float Del
 		OnSkeletonChanged(Skeleton);
 	}
 
+	// Less significant avatars skip the face or update it at a lower rate, in between the two last updates are interpolated
+	const float UpdateInterval = SignificanceState.IsValid() ? SignificanceState->UpdateInterval.load() : 0.f;
+	if (SignificanceState.IsValid() && !SignificanceState->bUpdateFace.load())
+	{
+		bHasWeights = false;
+		return;
+	}
+
+	float Alpha = 1.f;
+	if (UpdateInterval <= 0.f)
+	{
+		bHasWeights = false;
+	}
+	else
+	{
+		TimeSinceUpdate += DeltaTime;
+		if (!bHasWeights || TimeSinceUpdate >= UpdateInterval)
+		{
+			for (uint8 ExpressionId = 0; ExpressionId < static_cast<uint8>(EOculusXRFaceExpression::COUNT); ++ExpressionId)
+			{
+				PreviousWeights[ExpressionId] = bHasWeights ? CurrentWeights[ExpressionId] : InBaseFrameData->PropertyValues[ExpressionId];
+				CurrentWeights[ExpressionId] = InBaseFrameData->PropertyValues[ExpressionId];
+			}
+			bHasWeights = true;
+			TimeSinceUpdate = 0.f;
+		}
+		Alpha = FMath::Clamp(TimeSinceUpdate / UpdateInterval, 0.f, 1.f);
+	}
+
 	for (uint8 ExpressionId = 0; ExpressionId < static_cast<uint8>(EOculusXRFaceExpression::COUNT); ++ExpressionId)
 	{
+		const float Weight = bHasWeights ? FMath::Lerp(PreviousWeights[ExpressionId], CurrentWeights[ExpressionId], Alpha) : InBaseFrameData->PropertyValues[ExpressionId];
 #if UE_VERSION_OLDER_THAN(5, 3, 0)
 		for (const SmartName::UID_Type UID : RemappingForLastSkeleton[ExpressionId])
 		{
-			OutCurve.Set(UID, InBaseFrameData->PropertyValues[ExpressionId]);
+			OutCurve.Set(UID, Weight);
 		}
 #else
 		for (const FName Name : RemappingForLastSkeleton[ExpressionId])
 		{
-			OutCurve.Set(Name, InBaseFrameData->PropertyValues[ExpressionId]);
+			OutCurve.Set(Name, Weight);
 		}
 #endif
 	}
@@ -42,6 +42,7 @@ bool OculusXRMovement::GetBodyState(FOculusXRBodyState& outOculusXRBodyState, fl
 		outOculusXRBodyState.Confidence = OVRBodyState.Confidence;
 		outOculusXRBodyState.SkeletonChangedCount = OVRBodyState.SkeletonChangedCount;
 		outOculusXRBodyState.Time = static_cast<float>(OVRBodyState.Time);
+		outOculusXRBodyState.PreciseTime = OVRBodyState.Time;
 
 		for (int i = 0; i < AvailableJoints; ++i)
 		{
@@ -193,6 +194,7 @@ bool OculusXRMovement::GetFaceState(FOculusXRFaceState& outOculusXRFaceState)
 		outOculusXRFaceState.bIsValid = (OVRFaceState.Status.IsValid == ovrpBool_True);
 		outOculusXRFaceState.bIsEyeFollowingBlendshapesValid = (OVRFaceState.Status.IsEyeFollowingBlendshapesValid == ovrpBool_True);
 		outOculusXRFaceState.Time = static_cast<float>(OVRFaceState.Time);
+		outOculusXRFaceState.PreciseTime = OVRFaceState.Time;
 
 		for (int i = 0; i < blendShapeCount; ++i)
 		{
@@ -276,6 +278,7 @@ bool OculusXRMovement::GetEyeGazesState(FOculusXREyeGazesState& outOculusXREyeGa
 	if (OVRP_SUCCESS(OVREyeGazesStateResult))
 	{
 		outOculusXREyeGazesState.Time = static_cast<float>(OVREyeGazesState.Time);
+		outOculusXREyeGazesState.PreciseTime = OVREyeGazesState.Time;
 		for (int i = 0; i < ovrpEye_Count; ++i)
 		{
 			const auto& EyeGazePose = OVREyeGazesState.EyeGazes[i].Pose;
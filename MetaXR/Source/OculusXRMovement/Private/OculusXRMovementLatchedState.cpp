@@ -0,0 +1,65 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "OculusXRMovementLatchedState.h"
+#include "OculusXRMovementFunctionLibrary.h"
+
+DEFINE_STAT(STAT_OculusXRBodyTrackingComponent);
+DEFINE_STAT(STAT_OculusXREyeTrackingComponent);
+DEFINE_STAT(STAT_OculusXRFaceTrackingComponent);
+DEFINE_STAT(STAT_OculusXRLatchTrackingState);
+DEFINE_STAT(STAT_OculusXRBodyTrackingAnimNode);
+DEFINE_STAT(STAT_OculusXREyeTrackingAnimNode);
+DEFINE_STAT(STAT_OculusXRFaceTrackingAnimNode);
+
+namespace OculusXRMovement
+{
+	template <typename TState>
+	struct TLatchedState
+	{
+		uint64 FrameNumber = MAX_uint64;
+		float WorldToMeters = 0.0f;
+		TSharedPtr<const TState, ESPMode::ThreadSafe> State;
+
+		template <typename TQuery>
+		TSharedPtr<const TState, ESPMode::ThreadSafe> Get(float InWorldToMeters, TQuery Query)
+		{
+			check(IsInGameThread());
+			if (FrameNumber != GFrameCounter || WorldToMeters != InWorldToMeters)
+			{
+				SCOPE_CYCLE_COUNTER(STAT_OculusXRLatchTrackingState);
+
+				FrameNumber = GFrameCounter;
+				WorldToMeters = InWorldToMeters;
+
+				// A new state every frame, the previous one may still be read by the animation of the last frame
+				TSharedRef<TState, ESPMode::ThreadSafe> NewState = MakeShared<TState, ESPMode::ThreadSafe>();
+				State = Query(NewState.Get()) ? TSharedPtr<const TState, ESPMode::ThreadSafe>(NewState) : nullptr;
+			}
+			return State;
+		}
+	};
+
+	TSharedPtr<const FOculusXRBodyState, ESPMode::ThreadSafe> LatchBodyState(float WorldToMeters)
+	{
+		static TLatchedState<FOculusXRBodyState> Latched;
+		return Latched.Get(WorldToMeters, [WorldToMeters](FOculusXRBodyState& State) {
+			return UOculusXRMovementFunctionLibrary::TryGetBodyState(State, WorldToMeters);
+		});
+	}
+
+	TSharedPtr<const FOculusXRFaceState, ESPMode::ThreadSafe> LatchFaceState()
+	{
+		static TLatchedState<FOculusXRFaceState> Latched;
+		return Latched.Get(0.0f, [](FOculusXRFaceState& State) {
+			return UOculusXRMovementFunctionLibrary::TryGetFaceState(State);
+		});
+	}
+
+	TSharedPtr<const FOculusXREyeGazesState, ESPMode::ThreadSafe> LatchEyeGazesState(float WorldToMeters)
+	{
+		static TLatchedState<FOculusXREyeGazesState> Latched;
+		return Latched.Get(WorldToMeters, [WorldToMeters](FOculusXREyeGazesState& State) {
+			return UOculusXRMovementFunctionLibrary::TryGetEyeGazesState(State, WorldToMeters);
+		});
+	}
+} // namespace OculusXRMovement
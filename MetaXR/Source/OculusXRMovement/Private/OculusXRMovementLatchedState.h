@@ -0,0 +1,31 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "OculusXRMovementTypes.h"
+
+DECLARE_STATS_GROUP(TEXT("OculusXRMovement"), STATGROUP_OculusXRMovement, STATCAT_Advanced);
+// Game thread cost of the component path
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Body Tracking Component"), STAT_OculusXRBodyTrackingComponent, STATGROUP_OculusXRMovement, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Eye Tracking Component"), STAT_OculusXREyeTrackingComponent, STATGROUP_OculusXRMovement, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Face Tracking Component"), STAT_OculusXRFaceTrackingComponent, STATGROUP_OculusXRMovement, );
+// Game thread cost of the anim node path
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Latch Tracking State"), STAT_OculusXRLatchTrackingState, STATGROUP_OculusXRMovement, );
+// Worker thread cost of the anim node path
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Body Tracking Anim Node"), STAT_OculusXRBodyTrackingAnimNode, STATGROUP_OculusXRMovement, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Eye Tracking Anim Node"), STAT_OculusXREyeTrackingAnimNode, STATGROUP_OculusXRMovement, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Face Tracking Anim Node"), STAT_OculusXRFaceTrackingAnimNode, STATGROUP_OculusXRMovement, );
+
+namespace OculusXRMovement
+{
+	/**
+	 * Tracking states latched once per frame on the game thread and shared by all the anim nodes. The states are
+	 * immutable, nodes keep a reference to the state of their frame while the animation is evaluated on a worker thread.
+	 * The functions return null if the state isn't available, e.g. because the tracking wasn't started.
+	 */
+	TSharedPtr<const FOculusXRBodyState, ESPMode::ThreadSafe> LatchBodyState(float WorldToMeters);
+	TSharedPtr<const FOculusXRFaceState, ESPMode::ThreadSafe> LatchFaceState();
+	TSharedPtr<const FOculusXREyeGazesState, ESPMode::ThreadSafe> LatchEyeGazesState(float WorldToMeters);
+} // namespace OculusXRMovement
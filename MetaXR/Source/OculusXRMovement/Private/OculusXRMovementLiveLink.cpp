@@ -11,13 +11,32 @@
 
 #include "Roles/LiveLinkAnimationTypes.h"
 #include "ILiveLinkClient.h"
+#include "HAL/IConsoleManager.h"
 
 #define LOCTEXT_NAMESPACE "MetaOculusXRMovement"
 
 namespace
 {
 	constexpr int32 NoParent = -1;
-}
+
+	// Tracker and platform clocks drifting apart by more than this (e.g. after the tracker restarted) resync the offset
+	constexpr double MaxTrackerTimeDrift = 0.1;
+} // namespace
+
+static TAutoConsoleVariable<float> CVarOVRLiveLinkMaxPushRateEye(
+	TEXT("ovr.LiveLink.MaxPushRate.Eye"),
+	0.0f,
+	TEXT("Maximum rate in Hz at which the MovementSDK LiveLink source pushes eye frames. 0 pushes every new tracker sample.\n"));
+
+static TAutoConsoleVariable<float> CVarOVRLiveLinkMaxPushRateFace(
+	TEXT("ovr.LiveLink.MaxPushRate.Face"),
+	0.0f,
+	TEXT("Maximum rate in Hz at which the MovementSDK LiveLink source pushes face frames. 0 pushes every new tracker sample.\n"));
+
+static TAutoConsoleVariable<float> CVarOVRLiveLinkMaxPushRateBody(
+	TEXT("ovr.LiveLink.MaxPushRate.Body"),
+	0.0f,
+	TEXT("Maximum rate in Hz at which the MovementSDK LiveLink source pushes body frames. 0 pushes every new tracker sample.\n"));
 
 namespace MetaXRMovement
 {
@@ -66,11 +85,45 @@ namespace MetaXRMovement
 		return StaticDataStruct;
 	}
 	template <typename MetaXRState, typename RoleTypeStaticData, typename RoleTypeFrameData, typename Role>
-	FLiveLinkFrameDataStruct TSubject<MetaXRState, RoleTypeStaticData, RoleTypeFrameData, Role>::FrameData()
+	bool TSubject<MetaXRState, RoleTypeStaticData, RoleTypeFrameData, Role>::PollState(double CurrentTime)
+	{
+		bLastFrameIsValid = QueryState();
+		if (!bLastFrameIsValid)
+		{
+			return false;
+		}
+
+		// Runtimes that don't report a sample time get a new sample every poll
+		const double SampleTime = LastState.PreciseTime > 0.0 ? LastState.PreciseTime : CurrentTime;
+		if (SampleTime == LastPushedSampleTime)
+		{
+			return false;
+		}
+
+		if (const float MaxPushRate = GetMaxPushRate(); MaxPushRate > 0.f && CurrentTime - LastPushTime < 1.0 / MaxPushRate)
+		{
+			return false;
+		}
+
+		const double Offset = CurrentTime - SampleTime;
+		if (!TrackerTimeOffset || FMath::Abs(Offset - *TrackerTimeOffset) > MaxTrackerTimeDrift)
+		{
+			TrackerTimeOffset = Offset;
+		}
+
+		LastPushedSampleTime = SampleTime;
+		LastPushTime = CurrentTime;
+		return true;
+	}
+
+	template <typename MetaXRState, typename RoleTypeStaticData, typename RoleTypeFrameData, typename Role>
+	FLiveLinkFrameDataStruct TSubject<MetaXRState, RoleTypeStaticData, RoleTypeFrameData, Role>::FrameData() const
 	{
+		// LiveLink takes ownership of the pushed frame, so this is the only allocation per pushed sample.
 		FLiveLinkFrameDataStruct FrameDataStruct(RoleTypeFrameData::StaticStruct());
 		RoleTypeFrameData& FrameData(*FrameDataStruct.Cast<RoleTypeFrameData>());
 		UpdateFrame(FrameData);
+		FrameData.WorldTime = FLiveLinkWorldTime(LastPushedSampleTime, TrackerTimeOffset.Get(0.0));
 		return FrameDataStruct;
 	}
 
@@ -79,6 +132,8 @@ namespace MetaXRMovement
 		: Name(TEXT("Eye"))
 		, bLastFrameIsValid(false)
 		, bStarted(false)
+		, LastPushedSampleTime(-1.0)
+		, LastPushTime(0.0)
 	{
 	}
 	template <>
@@ -86,6 +141,8 @@ namespace MetaXRMovement
 		: Name(TEXT("Face"))
 		, bLastFrameIsValid(false)
 		, bStarted(false)
+		, LastPushedSampleTime(-1.0)
+		, LastPushTime(0.0)
 	{
 	}
 	template <>
@@ -93,6 +150,8 @@ namespace MetaXRMovement
 		: Name(TEXT("Body"))
 		, bLastFrameIsValid(false)
 		, bStarted(false)
+		, LastPushedSampleTime(-1.0)
+		, LastPushTime(0.0)
 	{
 	}
 	template <>
@@ -165,51 +224,66 @@ namespace MetaXRMovement
 		return OculusXRMovement::IsBodyTrackingSupported();
 	}
 	template <>
-	void FEyeSubject::UpdateFrame(FLiveLinkAnimationFrameData& FrameData)
+	float FEyeSubject::GetMaxPushRate()
+	{
+		return CVarOVRLiveLinkMaxPushRateEye.GetValueOnGameThread();
+	}
+	template <>
+	float FFaceSubject::GetMaxPushRate()
 	{
-		bLastFrameIsValid = OculusXRMovement::GetEyeGazesState(LastState, 1.f)
+		return CVarOVRLiveLinkMaxPushRateFace.GetValueOnGameThread();
+	}
+	template <>
+	float FBodySubject::GetMaxPushRate()
+	{
+		return CVarOVRLiveLinkMaxPushRateBody.GetValueOnGameThread();
+	}
+	template <>
+	bool FEyeSubject::QueryState()
+	{
+		return OculusXRMovement::GetEyeGazesState(LastState, 1.f)
 			&& (LastState.EyeGazes[0].bIsValid || LastState.EyeGazes[1].bIsValid);
-		if (bLastFrameIsValid)
+	}
+	template <>
+	bool FFaceSubject::QueryState()
+	{
+		return OculusXRMovement::GetFaceState(LastState) && (LastState.bIsValid);
+	}
+	template <>
+	bool FBodySubject::QueryState()
+	{
+		return OculusXRMovement::GetBodyState(LastState, 1.f) && (LastState.IsActive) && (LastState.SkeletonChangedCount > 0);
+	}
+	template <>
+	void FEyeSubject::UpdateFrame(FLiveLinkAnimationFrameData& FrameData) const
+	{
+		constexpr auto FieldsCount = static_cast<uint8>(EOculusXREye::COUNT);
+		FrameData.Transforms.SetNumUninitialized(FieldsCount);
+		for (uint8 i = 0u; i < FieldsCount; ++i)
 		{
-			constexpr auto FieldsCount = static_cast<uint8>(EOculusXREye::COUNT);
-			FrameData.Transforms.Reserve(FieldsCount);
-			for (uint8 i = 0u; i < FieldsCount; ++i)
-			{
-				const auto& EyeGaze = LastState.EyeGazes[i];
-				FrameData.Transforms.Emplace(EyeGaze.Orientation, EyeGaze.Position);
-			}
-			FrameData.WorldTime = FPlatformTime::Seconds();
+			const auto& EyeGaze = LastState.EyeGazes[i];
+			FrameData.Transforms[i] = FTransform(EyeGaze.Orientation, EyeGaze.Position);
 		}
 	}
 	template <>
-	void FFaceSubject::UpdateFrame(FLiveLinkBaseFrameData& FrameData)
+	void FFaceSubject::UpdateFrame(FLiveLinkBaseFrameData& FrameData) const
 	{
-		bLastFrameIsValid = OculusXRMovement::GetFaceState(LastState) && (LastState.bIsValid);
-		if (bLastFrameIsValid)
+		constexpr auto FieldsCount = static_cast<uint8>(EOculusXRFaceExpression::COUNT);
+		FrameData.PropertyValues.SetNumUninitialized(FieldsCount);
+		for (uint8 i = 0u; i < FieldsCount; ++i)
 		{
-			constexpr auto FieldsCount = static_cast<uint8>(EOculusXRFaceExpression::COUNT);
-			FrameData.PropertyValues.Reserve(FieldsCount);
-			for (uint8 i = 0u; i < FieldsCount; ++i)
-			{
-				FrameData.PropertyValues.Emplace(LastState.ExpressionWeights[i]);
-			}
-			FrameData.WorldTime = FPlatformTime::Seconds();
+			FrameData.PropertyValues[i] = LastState.ExpressionWeights[i];
 		}
 	}
 	template <>
-	void FBodySubject::UpdateFrame(FLiveLinkAnimationFrameData& FrameData)
+	void FBodySubject::UpdateFrame(FLiveLinkAnimationFrameData& FrameData) const
 	{
-		bLastFrameIsValid = OculusXRMovement::GetBodyState(LastState, 1.f) && (LastState.IsActive) && (LastState.SkeletonChangedCount > 0);
-		if (bLastFrameIsValid)
+		constexpr auto FieldsCount = static_cast<uint8>(EOculusXRBoneID::COUNT);
+		FrameData.Transforms.SetNumUninitialized(FieldsCount);
+		for (uint8 i = 0u; i < FieldsCount; ++i)
 		{
-			constexpr auto FieldsCount = static_cast<uint8>(EOculusXRBoneID::COUNT);
-			FrameData.Transforms.Reserve(FieldsCount);
-			for (uint8 i = 0u; i < FieldsCount; ++i)
-			{
-				const auto& Joint = LastState.Joints[i];
-				FrameData.Transforms.Emplace(Joint.Orientation, Joint.Position);
-			}
-			FrameData.WorldTime = FPlatformTime::Seconds();
+			const auto& Joint = LastState.Joints[i];
+			FrameData.Transforms[i] = FTransform(Joint.Orientation, Joint.Position);
 		}
 	}
 
@@ -328,15 +402,16 @@ namespace MetaXRMovement
 		if (Key)
 		{
 			const bool bPreviousFrameValid = Subject.IsLastFrameValid();
-			auto FrameData = Subject.FrameData();
+			const bool bNewSample = Subject.PollState(FPlatformTime::Seconds());
 			const bool bFrameValid = Subject.IsLastFrameValid();
 			if (bPreviousFrameValid != bFrameValid)
 			{
 				UE_LOG(LogOculusXRMovement, Log, TEXT("LiveLink subject %s became %s."), *Subject.Name.ToString(), bFrameValid ? TEXT("valid") : TEXT("invalid"));
 			}
-			if (bFrameValid)
+			// Unchanged samples aren't pushed again, LiveLink keeps evaluating the last frame
+			if (bNewSample)
 			{
-				Client->PushSubjectFrameData_AnyThread(*Key, MoveTemp(FrameData));
+				Client->PushSubjectFrameData_AnyThread(*Key, Subject.FrameData());
 			}
 		}
 	}
@@ -27,7 +27,11 @@ namespace MetaXRMovement
 		const FLiveLinkSubjectName Name;
 
 		FLiveLinkStaticDataStruct StaticData() const;
-		FLiveLinkFrameDataStruct FrameData();
+		// Queries the tracker. Returns true if it produced a sample that should be pushed, i.e. one that wasn't
+		// pushed yet and that doesn't exceed the push rate of the subject.
+		bool PollState(double CurrentTime);
+		// Frame of the last polled sample
+		FLiveLinkFrameDataStruct FrameData() const;
 		bool IsLastFrameValid() const { return bLastFrameIsValid; };
 		bool Start();
 		bool Stop();
@@ -36,10 +40,20 @@ namespace MetaXRMovement
 	private:
 		bool bLastFrameIsValid;
 		bool bStarted;
+		// State buffer reused by every query
 		MetaXRState LastState;
 
+		// Tracker time of the last pushed sample
+		double LastPushedSampleTime;
+		// Platform time of the last push, for the push rate cap
+		double LastPushTime;
+		// Platform time minus tracker time, kept stable so LiveLink interpolates on the tracker's timeline
+		TOptional<double> TrackerTimeOffset;
+
 		void InitializeRoleStaticData(RoleTypeStaticData& StaticData) const;
-		void UpdateFrame(RoleTypeFrameData& FrameData);
+		bool QueryState();
+		void UpdateFrame(RoleTypeFrameData& FrameData) const;
+		static float GetMaxPushRate();
 	};
 
 	using FEyeSubject = TSubject<FOculusXREyeGazesState, FLiveLinkSkeletonStaticData, FLiveLinkAnimationFrameData, ULiveLinkAnimationRole>;
@@ -17,6 +17,7 @@ FOculusXRBodyState::FOculusXRBodyState()
 	, Confidence(0)
 	, SkeletonChangedCount(0)
 	, Time(0.f)
+	, PreciseTime(0.0)
 {
 	Joints.SetNum(static_cast<int32>(EOculusXRBoneID::COUNT));
 }
@@ -26,6 +27,7 @@ FOculusXRFaceState::FOculusXRFaceState()
 	: bIsValid(false)
 	, bIsEyeFollowingBlendshapesValid(false)
 	, Time(0.f)
+	, PreciseTime(0.0)
 {
 	ExpressionWeights.SetNum(static_cast<int32>(EOculusXRFaceExpression::COUNT));
 	ExpressionWeightConfidences.SetNum(static_cast<int32>(EOculusXRFaceConfidence::COUNT));
@@ -48,6 +50,7 @@ FOculusXREyeGazeState::FOculusXREyeGazeState()
 
 FOculusXREyeGazesState::FOculusXREyeGazesState()
 	: Time(0.f)
+	, PreciseTime(0.0)
 {
 	EyeGazes.SetNum(static_cast<int32>(EOculusXREye::COUNT));
 }
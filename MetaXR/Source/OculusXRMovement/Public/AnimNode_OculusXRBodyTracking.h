@@ -0,0 +1,72 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "OculusXRBodyTrackingComponent.h"
+#include "OculusXRMovementTypes.h"
+
+#include "AnimNode_OculusXRBodyTracking.generated.h"
+
+/**
+ * Applies the body tracking joints to the pose, the anim graph counterpart of UOculusXRBodyTrackingComponent.
+ * The body state is latched once per frame on the game thread, the joints are applied on the animation worker thread
+ * with bone indices cached per LOD. Body tracking has to be started, e.g. with UOculusXRMovementFunctionLibrary::StartBodyTracking.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct OCULUSXRMOVEMENT_API FAnimNode_OculusXRBodyTracking : public FAnimNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+public:
+	/** How the joints are applied */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement", meta = (PinHiddenByDefault))
+	EOculusXRBodyTrackingMode BodyTrackingMode = EOculusXRBodyTrackingMode::PositionAndRotation;
+
+	/** The body state is ignored while its confidence is lower than this value. Confidence is in range [0,1]. */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement", meta = (PinHiddenByDefault, ClampMin = "0", ClampMax = "1", UIMin = "0", UIMax = "1"))
+	float ConfidenceThreshold = 0.0f;
+
+	/**
+	 * The bones driven by the joints. Joints that aren't listed drive the bone with the name of the joint without
+	 * the Body prefix (e.g. BodyLeftArmUpper drives LeftArmUpper), same as the defaults of the component.
+	 * Map a joint to None to leave it out.
+	 */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement")
+	TMap<EOculusXRBoneID, FName> BoneNames;
+
+	// FAnimNode_Base interface
+	virtual bool HasPreUpdate() const override { return true; }
+	virtual void PreUpdate(const UAnimInstance* InAnimInstance) override;
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+	// End of FAnimNode_Base interface
+
+	// FAnimNode_SkeletalControlBase interface
+	virtual void EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms) override;
+	virtual bool IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones) override;
+	// End of FAnimNode_SkeletalControlBase interface
+
+private:
+	// FAnimNode_SkeletalControlBase interface
+	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
+	// End of FAnimNode_SkeletalControlBase interface
+
+	struct FJointBinding
+	{
+		int32 JointIndex;
+		FCompactPoseBoneIndex BoneIndex;
+	};
+
+	/** Bindings of the bones required by the current LOD, sorted by bone index so that parents come first */
+	TArray<FJointBinding> JointBindings;
+
+	/** Component space transforms of the bones up to the last bound one, reused between evaluations */
+	TArray<FTransform> ComponentSpaceScratch;
+
+	/** Body state of the frame, latched on the game thread */
+	TSharedPtr<const FOculusXRBodyState, ESPMode::ThreadSafe> BodyState;
+
+	// One meter in unreal world units.
+	float WorldToMeters = 100.0f;
+};
@@ -0,0 +1,76 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "OculusXRMovementTypes.h"
+
+#include "AnimNode_OculusXREyeTracking.generated.h"
+
+/**
+ * Applies the eye gazes to the eye bones, the anim graph counterpart of UOculusXREyeTrackingComponent.
+ * The eye gazes are latched once per frame on the game thread and applied on the animation worker thread.
+ * Eye tracking has to be started, e.g. with UOculusXRMovementFunctionLibrary::StartEyeTracking.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct OCULUSXRMOVEMENT_API FAnimNode_OculusXREyeTracking : public FAnimNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+public:
+	FAnimNode_OculusXREyeTracking();
+
+	/** The bones driven by the eye gazes */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement")
+	TMap<EOculusXREye, FName> EyeToBone;
+
+	/** Update the position of the eye bones */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement", meta = (PinHiddenByDefault))
+	bool bUpdatePosition = true;
+
+	/** Update the rotation of the eye bones */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement", meta = (PinHiddenByDefault))
+	bool bUpdateRotation = true;
+
+	/** Do not accept an eye gaze if its confidence is lower than this value. Confidence is in range [0,1]. */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement", meta = (PinHiddenByDefault, ClampMin = "0", ClampMax = "1", UIMin = "0", UIMax = "1"))
+	float ConfidenceThreshold = 0.0f;
+
+	/** Accept eye gazes that are marked as invalid. The confidence is still checked. */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement", meta = (PinHiddenByDefault))
+	bool bAcceptInvalid = false;
+
+	// FAnimNode_Base interface
+	virtual bool HasPreUpdate() const override { return true; }
+	virtual void PreUpdate(const UAnimInstance* InAnimInstance) override;
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+	// End of FAnimNode_Base interface
+
+	// FAnimNode_SkeletalControlBase interface
+	virtual void EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms) override;
+	virtual bool IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones) override;
+	// End of FAnimNode_SkeletalControlBase interface
+
+private:
+	// FAnimNode_SkeletalControlBase interface
+	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
+	// End of FAnimNode_SkeletalControlBase interface
+
+	struct FEyeBinding
+	{
+		int32 EyeIndex;
+		FCompactPoseBoneIndex BoneIndex;
+		/** Component space rotation of the bone in the reference pose */
+		FQuat InitialRotation;
+	};
+
+	/** Bindings of the bones required by the current LOD, sorted by bone index */
+	TArray<FEyeBinding> EyeBindings;
+
+	/** Eye gazes of the frame, latched on the game thread */
+	TSharedPtr<const FOculusXREyeGazesState, ESPMode::ThreadSafe> EyeGazesState;
+
+	// One meter in unreal world units.
+	float WorldToMeters = 100.0f;
+};
@@ -0,0 +1,85 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNodeBase.h"
+#include "OculusXRMovementTypes.h"
+#include "Misc/EngineVersionComparison.h"
+
+#include "AnimNode_OculusXRFaceTracking.generated.h"
+
+/**
+ * Outputs the face expression weights as curves, the anim graph counterpart of UOculusXRFaceTrackingComponent.
+ * The curves drive the morph targets of the same name. The face state is latched once per frame on the game thread
+ * and applied on the animation worker thread. Face tracking has to be started, e.g. with UOculusXRMovementFunctionLibrary::StartFaceTracking.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct OCULUSXRMOVEMENT_API FAnimNode_OculusXRFaceTracking : public FAnimNode_Base
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Links)
+	FPoseLink Source;
+
+	/** The curves the expressions are written to. Empty uses the defaults of UOculusXRFaceTrackingComponent. */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement")
+	TMap<EOculusXRFaceExpression, FName> ExpressionNames;
+
+	/** Modifiers applied to the expression weights. Empty uses the defaults of UOculusXRFaceTrackingComponent. */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement")
+	TArray<FOculusXRFaceExpressionModifier> ExpressionModifiers;
+
+	/** Apply the expression modifiers */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement", meta = (PinHiddenByDefault))
+	bool bUseModifiers = false;
+
+	/** The last weights are kept for this many seconds after the face state became invalid, then the curves are no longer written */
+	UPROPERTY(EditAnywhere, Category = "OculusXR|Movement", meta = (PinHiddenByDefault))
+	float InvalidFaceDataResetTime = 2.0f;
+
+	/**
+	 * Max LOD that this node is allowed to run. For example if you have LODThreshold at 2, it will run until LOD 2 (based on 0 index).
+	 * When the component LOD becomes 3, it will stop update/evaluate. A value of -1 forces the node to execute at all LOD levels.
+	 */
+	UPROPERTY(EditAnywhere, Category = Performance, meta = (DisplayName = "LOD Threshold"))
+	int32 LODThreshold = INDEX_NONE;
+
+	// FAnimNode_Base interface
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+	virtual void CacheBones_AnyThread(const FAnimationCacheBonesContext& Context) override;
+	virtual void Update_AnyThread(const FAnimationUpdateContext& Context) override;
+	virtual void Evaluate_AnyThread(FPoseContext& Output) override;
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+	virtual bool HasPreUpdate() const override { return true; }
+	virtual void PreUpdate(const UAnimInstance* InAnimInstance) override;
+	virtual bool NeedsOnInitializeAnimInstance() const override { return true; }
+	virtual void OnInitializeAnimInstance(const FAnimInstanceProxy* InProxy, const UAnimInstance* InAnimInstance) override;
+	virtual int32 GetLODThreshold() const override { return LODThreshold; }
+	// End of FAnimNode_Base interface
+
+private:
+	struct FCurveBinding
+	{
+		int32 ExpressionIndex;
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+		SmartName::UID_Type CurveUID;
+#else
+		FName CurveName;
+#endif
+	};
+
+	/** Resolved on the game thread when the anim instance is initialized */
+	TArray<FCurveBinding> CurveBindings;
+	TArray<FOculusXRFaceExpressionModifier> ActiveModifiers;
+
+	/** Weights of the last valid face state with the modifiers applied */
+	TStaticArray<float, static_cast<uint32>(EOculusXRFaceExpression::COUNT)> Weights;
+	bool bHasWeights = false;
+	bool bApplyWeights = false;
+	float InvalidFaceStateTime = 0.0f;
+
+	/** Face state of the frame, latched on the game thread */
+	TSharedPtr<const FOculusXRFaceState, ESPMode::ThreadSafe> FaceState;
+};
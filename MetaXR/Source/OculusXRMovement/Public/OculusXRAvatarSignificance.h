@@ -0,0 +1,146 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include <atomic>
+
+#include "OculusXRAvatarSignificance.generated.h"
+
+class USkinnedMeshComponent;
+
+UENUM(BlueprintType)
+enum class EOculusXRAvatarLODTier : uint8
+{
+	Full = 0,
+	Reduced = 1,
+	Low = 2,
+	Minimal = 3,
+	COUNT = 4 UMETA(Hidden),
+};
+
+USTRUCT(BlueprintType)
+struct OCULUSXRMOVEMENT_API FOculusXRAvatarLODTierSettings
+{
+	GENERATED_BODY()
+public:
+	FOculusXRAvatarLODTierSettings();
+	FOculusXRAvatarLODTierSettings(float InMinScreenSize, int32 InMaxAvatars, float InUpdateRate, bool bInUpdateFace, bool bInUpdateFingers);
+
+	/** Avatars with a smaller screen size (bounds radius relative to the half screen) go to a lower tier */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Movement")
+	float MinScreenSize;
+
+	/** Budget of the tier. Avatars over the budget go to the next tier. 0 is unlimited, the last tier is always unlimited. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Movement")
+	int32 MaxAvatars;
+
+	/** Retarget rate in Hz, the pose is interpolated in between. 0 retargets every frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Movement")
+	float UpdateRate;
+
+	/** Apply the face expression curves */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Movement")
+	bool bUpdateFace;
+
+	/** Retarget the finger bones */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Movement")
+	bool bUpdateFingers;
+};
+
+USTRUCT(BlueprintType)
+struct OCULUSXRMOVEMENT_API FOculusXRAvatarSignificanceStats
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "OculusXR|Movement")
+	int32 NumAvatars = 0;
+
+	/** Number of avatars per EOculusXRAvatarLODTier */
+	UPROPERTY(BlueprintReadOnly, Category = "OculusXR|Movement")
+	TArray<int32> NumAvatarsPerTier;
+};
+
+/**
+ * Significance of one avatar, written on the game thread and read by the retargeting on the animation threads.
+ */
+struct FOculusXRAvatarSignificanceState
+{
+	std::atomic<EOculusXRAvatarLODTier> Tier{ EOculusXRAvatarLODTier::Full };
+	/** Seconds between two retargets, 0 for every frame */
+	std::atomic<float> UpdateInterval{ 0.0f };
+	std::atomic<bool> bUpdateFace{ true };
+	std::atomic<bool> bUpdateFingers{ true };
+};
+
+/**
+ * Scores the tracked avatars of the world by screen size, which accounts for the distance, and visibility. Local
+ * avatars are always at full detail. The score picks the LOD tier of the avatar, which sets the retarget rate and
+ * whether the face curves and the fingers are applied. The tiers and their budgets are read from the config:
+ *
+ * [/Script/OculusXRMovement.OculusXRAvatarSignificanceSubsystem]
+ * !Tiers=ClearArray
+ * +Tiers=(MinScreenSize=0.25,MaxAvatars=4,UpdateRate=0,bUpdateFace=True,bUpdateFingers=True)
+ *
+ * The LiveLink retarget assets register their avatar on first use.
+ */
+UCLASS(Config = Engine)
+class OCULUSXRMOVEMENT_API UOculusXRAvatarSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UOculusXRAvatarSignificanceSubsystem();
+
+	/** Settings per EOculusXRAvatarLODTier, from the highest to the lowest */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Config, Category = "OculusXR|Movement")
+	TArray<FOculusXRAvatarLODTierSettings> Tiers;
+
+	/** Screen size scale of avatars that weren't rendered recently. 0 puts them into the lowest tier. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Config, Category = "OculusXR|Movement")
+	float OffscreenScreenSizeScale;
+
+	/** Registers the avatar or returns the state it already has. Can be called from any thread. */
+	TSharedPtr<FOculusXRAvatarSignificanceState, ESPMode::ThreadSafe> RegisterAvatar(USkinnedMeshComponent* Mesh);
+
+	/** Overrides whether the avatar is local, by default the avatars of locally controlled pawns are */
+	UFUNCTION(BlueprintCallable, Category = "OculusXR|Movement")
+	void SetAvatarIsLocal(USkinnedMeshComponent* Mesh, bool bIsLocal);
+
+	UFUNCTION(BlueprintPure, Category = "OculusXR|Movement")
+	EOculusXRAvatarLODTier GetAvatarTier(USkinnedMeshComponent* Mesh) const;
+
+	UFUNCTION(BlueprintPure, Category = "OculusXR|Movement")
+	FOculusXRAvatarSignificanceStats GetStats() const;
+
+	void DumpStats(FOutputDevice& Ar) const;
+
+	/** Finds the subsystem of the world of the retarget asset and registers its avatar */
+	static TSharedPtr<FOculusXRAvatarSignificanceState, ESPMode::ThreadSafe> RegisterRetargetAsset(const UObject* RetargetAsset);
+
+	// UTickableWorldSubsystem interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UOculusXRAvatarSignificanceSubsystem, STATGROUP_Tickables); }
+	// End of UTickableWorldSubsystem interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FAvatar
+	{
+		TWeakObjectPtr<USkinnedMeshComponent> Mesh;
+		TSharedPtr<FOculusXRAvatarSignificanceState, ESPMode::ThreadSafe> State;
+		TOptional<bool> bIsLocalOverride;
+		float Score = 0.0f;
+	};
+
+	void ApplyTier(FAvatar& Avatar, EOculusXRAvatarLODTier Tier) const;
+
+	/** Guards Avatars, registration happens on the animation threads */
+	mutable FCriticalSection AvatarsLock;
+	TArray<FAvatar> Avatars;
+
+	TStaticArray<int32, static_cast<uint32>(EOculusXRAvatarLODTier::COUNT)> NumAvatarsPerTier;
+};
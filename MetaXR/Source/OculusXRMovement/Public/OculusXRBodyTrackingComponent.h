@@ -6,6 +6,7 @@
 #include "Components/PoseableMeshComponent.h"
 
 #include "OculusXRMovementTypes.h"
+#include "OculusXRWorkloadThrottle.h"
 
 #include "OculusXRBodyTrackingComponent.generated.h"
 
@@ -18,7 +19,7 @@ enum class EOculusXRBodyTrackingMode : uint8
 };
 
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent, DisplayName = "OculusXR Body Tracking Component"), ClassGroup = OculusXRHMD)
-class OCULUSXRMOVEMENT_API UOculusXRBodyTrackingComponent : public UPoseableMeshComponent
+class OCULUSXRMOVEMENT_API UOculusXRBodyTrackingComponent : public UPoseableMeshComponent, public IOculusXRWorkloadThrottleable
 {
 	GENERATED_BODY()
 public:
@@ -28,6 +29,10 @@ public:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	// IOculusXRWorkloadThrottleable
+	virtual void OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy) override;
+	virtual void OnWorkloadRestored_Implementation() override;
+
 	/**
 	* Restore all bones to their initial transforms
 	*/
@@ -66,4 +71,7 @@ private:
 
 	// Stop the tracker just once.
 	static int TrackingInstanceCount;
+
+	// Whether the tick was paused while the workload is throttled.
+	bool bPausedByWorkloadThrottle = false;
 };
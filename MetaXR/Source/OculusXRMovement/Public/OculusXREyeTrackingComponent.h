@@ -7,6 +7,7 @@
 #include "Components/PoseableMeshComponent.h"
 
 #include "OculusXRMovementTypes.h"
+#include "OculusXRWorkloadThrottle.h"
 
 #include "OculusXREyeTrackingComponent.generated.h"
 
@@ -25,7 +26,7 @@ public:
 };
 
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent, DisplayName = "OculusXR Eye Tracking Component"), ClassGroup = OculusXRHMD)
-class OCULUSXRMOVEMENT_API UOculusXREyeTrackingComponent : public UActorComponent
+class OCULUSXRMOVEMENT_API UOculusXREyeTrackingComponent : public UActorComponent, public IOculusXRWorkloadThrottleable
 {
 	GENERATED_BODY()
 public:
@@ -35,6 +36,10 @@ public:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	// IOculusXRWorkloadThrottleable
+	virtual void OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy) override;
+	virtual void OnWorkloadRestored_Implementation() override;
+
 	/**
 	* Reset the rotation values of the eyes to their initial rotation
 	*/
@@ -81,8 +86,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Movement")
 	bool bAcceptInvalid;
 
+protected:
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
+
 private:
 	bool InitializeEyes();
+	void UpdateEyes(const FOculusXREyeGazesState& EyeGazesState);
+	static void TickBatch(TArrayView<UActorComponent* const> Components, TArrayView<const float> DeltaTimes);
 
 	// One meter in unreal world units.
 	float WorldToMeters;
@@ -96,4 +106,7 @@ private:
 
 	// Stop the tracker just once.
 	static int TrackingInstanceCount;
+
+	// Whether the tick was paused while the workload is throttled.
+	bool bPausedByWorkloadThrottle = false;
 };
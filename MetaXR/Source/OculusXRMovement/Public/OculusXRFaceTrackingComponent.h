@@ -6,11 +6,12 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "OculusXRMorphTargetsController.h"
 #include "OculusXRMovementTypes.h"
+#include "OculusXRWorkloadThrottle.h"
 
 #include "OculusXRFaceTrackingComponent.generated.h"
 
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent, DisplayName = "OculusXR Face Tracking Component"), ClassGroup = OculusXRHMD)
-class OCULUSXRMOVEMENT_API UOculusXRFaceTrackingComponent : public UActorComponent
+class OCULUSXRMOVEMENT_API UOculusXRFaceTrackingComponent : public UActorComponent, public IOculusXRWorkloadThrottleable
 {
 	GENERATED_BODY()
 public:
@@ -20,6 +21,10 @@ public:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	// IOculusXRWorkloadThrottleable
+	virtual void OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy) override;
+	virtual void OnWorkloadRestored_Implementation() override;
+
 	/**
 	 * Set face expression value with expression key and value(0-1).
 	 *
@@ -81,8 +86,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Movement")
 	bool bUseModifiers;
 
+protected:
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
+
 private:
 	bool InitializeFaceTracking();
+	void UpdateFace(float DeltaTime, bool bFaceStateValid);
+	static void TickBatch(TArrayView<UActorComponent* const> Components, TArrayView<const float> DeltaTimes);
 
 	// The mesh component targeted for expressions
 	UPROPERTY()
@@ -101,4 +111,7 @@ private:
 
 	// Stop the tracker just once.
 	static int TrackingInstanceCount;
+
+	// Whether the tick was paused while the workload is throttled.
+	bool bPausedByWorkloadThrottle = false;
 };
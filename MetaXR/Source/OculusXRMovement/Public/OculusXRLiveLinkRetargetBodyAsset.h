@@ -10,6 +10,8 @@
 
 #include "OculusXRLiveLinkRetargetBodyAsset.generated.h"
 
+struct FOculusXRAvatarSignificanceState;
+
 UENUM(BlueprintType, meta = (DisplayName = "Axis"))
 enum class EOculusXRAxis : uint8
 {
@@ -138,6 +140,22 @@ private:
 	// Compact pose indices per bone id
 	TStaticArray<FCompactPoseBoneIndex, static_cast<uint8>(EOculusXRBoneID::COUNT)> LastSkeletonBoneRemapping{ InPlace, FCompactPoseBoneIndex(INDEX_NONE) };
 
+	// Update rate and detail of the avatar, set by UOculusXRAvatarSignificanceSubsystem
+	TSharedPtr<FOculusXRAvatarSignificanceState, ESPMode::ThreadSafe> SignificanceState;
+
+	// Time since the last retarget, the pose is interpolated in between
+	float TimeSinceUpdate;
+
+	// Whether the local poses below hold a retarget for the current bone container
+	bool bHasRetargetedPoses;
+
+	// Local poses of the mapped bones of the two last retargets
+	TStaticArray<FTransform, static_cast<uint8>(EOculusXRBoneID::COUNT)> PreviousLocalPoses;
+	TStaticArray<FTransform, static_cast<uint8>(EOculusXRBoneID::COUNT)> CurrentLocalPoses;
+
 	// Recalculate skeleton dependent mappings
 	void OnBoneContainerChanged(const FBoneContainer& BoneContainer);
+
+	// Retarget the frame into OutPose, finger bones are left out if !bRetargetFingers
+	void RetargetPose(const FLiveLinkAnimationFrameData* InFrameData, bool bRetargetFingers, FCompactPose& OutPose);
 };
@@ -11,6 +11,8 @@
 
 #include "OculusXRLiveLinkRetargetFaceAsset.generated.h"
 
+struct FOculusXRAvatarSignificanceState;
+
 USTRUCT(BlueprintType)
 struct OCULUSXRMOVEMENT_API FOculusXRAnimCurveMapping
 {
@@ -55,6 +57,19 @@ private:
 	TStaticArray<TArray<FName>, static_cast<uint8>(EOculusXRFaceExpression::COUNT)> RemappingForLastSkeleton;
 #endif
 
+	// Update rate and detail of the avatar, set by UOculusXRAvatarSignificanceSubsystem
+	TSharedPtr<FOculusXRAvatarSignificanceState, ESPMode::ThreadSafe> SignificanceState;
+
+	// Time since the last update of the weights, they are interpolated in between
+	float TimeSinceUpdate = 0.f;
+
+	// Whether the weights below hold an update
+	bool bHasWeights = false;
+
+	// Expression weights of the two last updates
+	TStaticArray<float, static_cast<uint8>(EOculusXRFaceExpression::COUNT)> PreviousWeights{ InPlace, 0.f };
+	TStaticArray<float, static_cast<uint8>(EOculusXRFaceExpression::COUNT)> CurrentWeights{ InPlace, 0.f };
+
 	// Recalculate skeleton dependent mappings
 	void OnSkeletonChanged(const USkeleton* Skeleton);
 };
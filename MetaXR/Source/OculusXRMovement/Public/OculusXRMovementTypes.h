@@ -149,6 +149,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "OculusXR|Movement")
 	float Time;
 
+	// Time with the full precision of the runtime. Time is narrowed to a float for Blueprints and loses sub-frame
+	// precision after a few hours of uptime, so compare and stamp samples with this one.
+	double PreciseTime;
+
 	UPROPERTY(BlueprintReadOnly, Category = "OculusXR|Movement")
 	TArray<FOculusXRBodyJoint> Joints;
 };
@@ -269,6 +273,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "OculusXR|Movement")
 	float Time;
 
+	// Time with the full precision of the runtime. Time is narrowed to a float for Blueprints and loses sub-frame
+	// precision after a few hours of uptime, so compare and stamp samples with this one.
+	double PreciseTime;
+
 	UPROPERTY(BlueprintReadOnly, Category = "OculusXR|Movement")
 	EFaceTrackingDataSource DataSource;
 };
@@ -333,4 +341,8 @@ public:
 
 	UPROPERTY(BlueprintReadOnly, Category = "OculusXR|Movement")
 	float Time;
+
+	// Time with the full precision of the runtime. Time is narrowed to a float for Blueprints and loses sub-frame
+	// precision after a few hours of uptime, so compare and stamp samples with this one.
+	double PreciseTime;
 };
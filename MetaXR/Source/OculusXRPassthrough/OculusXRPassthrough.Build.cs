@@ -12,6 +12,12 @@ namespace UnrealBuildTool.Rules
 		{
 			bUseUnity = true;
 
+			PublicDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"OculusXRHMD",
+				});
+
 			PrivateDependencyModuleNames.AddRange(
 				new string[]
 				{
@@ -19,7 +25,6 @@ namespace UnrealBuildTool.Rules
 					"CoreUObject",
 					"Engine",
 					"ProceduralMeshComponent",
-					"OculusXRHMD",
 					"OculusXROpenXRHMD",
 					"KhronosOpenXRHeaders",
 					"OVRPluginXR",
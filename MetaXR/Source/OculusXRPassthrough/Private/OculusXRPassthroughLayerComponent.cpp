@@ -98,6 +98,47 @@ void UOculusXRPassthroughLayerComponent::OnRegister()
 	MarkStereoLayerDirty();
 }
 
+void UOculusXRPassthroughLayerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->RegisterThrottleable(this);
+	}
+}
+
+void UOculusXRPassthroughLayerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UOculusXRWorkloadThrottleSubsystem* WorkloadThrottle = GEngine->GetEngineSubsystem<UOculusXRWorkloadThrottleSubsystem>())
+	{
+		WorkloadThrottle->UnregisterThrottleable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UOculusXRPassthroughLayerComponent::OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy)
+{
+	// The layer stays visible, only the style and geometry updates stop
+	if (Policy.bPausePassthroughUpdates && IsComponentTickEnabled())
+	{
+		SetComponentTickEnabled(false);
+		bPausedByWorkloadThrottle = true;
+	}
+}
+
+void UOculusXRPassthroughLayerComponent::OnWorkloadRestored_Implementation()
+{
+	if (bPausedByWorkloadThrottle)
+	{
+		SetComponentTickEnabled(true);
+		bPausedByWorkloadThrottle = false;
+		// Push the changes that were made while paused
+		MarkStereoLayerDirty();
+	}
+}
+
 void UOculusXRPassthroughLayerComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	if (Texture == nullptr && !LayerRequiresTexture())
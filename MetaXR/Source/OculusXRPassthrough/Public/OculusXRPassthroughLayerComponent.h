@@ -11,6 +11,7 @@
 #include "OculusXRPassthroughLayerShapes.h"
 #include "OculusXRPassthroughColorLut.h"
 #include "OculusXRHMDRuntimeSettings.h"
+#include "OculusXRWorkloadThrottle.h"
 #include "OculusXRPassthroughLayerComponent.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogOculusPassthrough, Log, All);
@@ -205,13 +206,19 @@ private:
 class UProceduralMeshComponent;
 
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent), ClassGroup = OculusXRHMD)
-class OCULUSXRPASSTHROUGH_API UOculusXRPassthroughLayerComponent : public UStereoLayerComponent
+class OCULUSXRPASSTHROUGH_API UOculusXRPassthroughLayerComponent : public UStereoLayerComponent, public IOculusXRWorkloadThrottleable
 {
 	GENERATED_UCLASS_BODY()
 
 public:
 	void DestroyComponent(bool bPromoteChildren) override;
 	void OnRegister() override;
+	void BeginPlay() override;
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// IOculusXRWorkloadThrottleable
+	virtual void OnWorkloadThrottled_Implementation(const FOculusXRWorkloadThrottlePolicy& Policy) override;
+	virtual void OnWorkloadRestored_Implementation() override;
 
 	void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
@@ -257,4 +264,7 @@ private:
 
 	/** Passthrough style needs to be marked for update **/
 	bool bPassthroughStyleNeedsUpdate;
+
+	/** The tick was disabled by the workload throttling and has to be enabled again when it is restored */
+	bool bPausedByWorkloadThrottle = false;
 };
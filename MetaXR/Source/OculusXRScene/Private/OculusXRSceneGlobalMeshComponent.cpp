@@ -7,17 +7,34 @@
 #include "Engine/World.h"
 #include "GameFramework/WorldSettings.h"
 #include "Materials/MaterialInterface.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "IXRTrackingSystem.h"
+#include "HeadMountedDisplayTypes.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+	// Chunks lose their collision a bit further away than they gain it, so that they don't flicker at the border
+	constexpr double CollisionReleaseFactor = 1.1;
+} // namespace
 
 const FString UOculusXRSceneGlobalMeshComponent::GlobalMeshSemanticLabel = TEXT("GLOBAL_MESH");
 
 UOculusXRSceneGlobalMeshComponent::UOculusXRSceneGlobalMeshComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	// Only ticks to stream the collision of chunks in and out
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 void UOculusXRSceneGlobalMeshComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UpdateChunkCollision();
 }
 
 bool UOculusXRSceneGlobalMeshComponent::HasCollision() const
@@ -36,11 +53,47 @@ UClass* UOculusXRSceneGlobalMeshComponent::GetAnchorComponentClass() const
 	return sceneAnchorComponentInstanceClass;
 }
 
-void UOculusXRSceneGlobalMeshComponent::CreateMeshComponent(const FOculusXRUInt64& Space, AActor* GlobalMeshAnchor, const UOculusXRRoomLayoutManagerComponent* RoomLayoutManagerComponent) const
+FOculusXRGlobalMeshChunkStats UOculusXRSceneGlobalMeshComponent::GetChunkStats() const
+{
+	return ChunkStats;
+}
+
+UProceduralMeshComponent* UOculusXRSceneGlobalMeshComponent::CreateProceduralMesh(AActor* GlobalMeshAnchor) const
 {
-	bool hasCollision = HasCollision();
 	UProceduralMeshComponent* proceduralMeshComponent = NewObject<UProceduralMeshComponent>(GlobalMeshAnchor);
 	proceduralMeshComponent->RegisterComponent();
+	return proceduralMeshComponent;
+}
+
+void UOculusXRSceneGlobalMeshComponent::CreateMeshComponent(const FOculusXRUInt64& Space, AActor* GlobalMeshAnchor, const UOculusXRRoomLayoutManagerComponent* RoomLayoutManagerComponent)
+{
+	bool hasCollision = HasCollision();
+	const float worldToMeters = GetWorld()->GetWorldSettings()->WorldToMeters;
+
+	if (Chunked)
+	{
+		TArray<FVector> vertices;
+		TArray<int32> triangles;
+		bool bLoaded = RoomLayoutManagerComponent->GetTriangleMesh(Space.Value, vertices, triangles);
+		ensure(bLoaded);
+
+		// The mesh is in meters, the chunk size in world units
+		const double cellSize = ChunkSize / worldToMeters;
+		TWeakObjectPtr<UOculusXRSceneGlobalMeshComponent> weakThis(this);
+		TWeakObjectPtr<AActor> weakAnchor(GlobalMeshAnchor);
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [weakThis, weakAnchor, vertices = MoveTemp(vertices), triangles = MoveTemp(triangles), cellSize]() {
+			TArray<FChunkData> chunkData = PartitionMesh(vertices, triangles, cellSize);
+			AsyncTask(ENamedThreads::GameThread, [weakThis, weakAnchor, chunkData = MoveTemp(chunkData)]() mutable {
+				if (weakThis.IsValid() && weakAnchor.IsValid())
+				{
+					weakThis->CreateChunks(weakAnchor.Get(), MoveTemp(chunkData));
+				}
+			});
+		});
+		return;
+	}
+
+	UProceduralMeshComponent* proceduralMeshComponent = CreateProceduralMesh(GlobalMeshAnchor);
 
 	bool bLoaded = RoomLayoutManagerComponent->LoadTriangleMesh(Space.Value, proceduralMeshComponent, hasCollision);
 	ensure(bLoaded);
@@ -62,6 +115,204 @@ void UOculusXRSceneGlobalMeshComponent::CreateMeshComponent(const FOculusXRUInt6
 
 	proceduralMeshComponent->SetVisibility(IsVisible());
 
-	const float worldToMeters = GetWorld()->GetWorldSettings()->WorldToMeters;
 	proceduralMeshComponent->SetRelativeScale3D(FVector(worldToMeters, worldToMeters, worldToMeters));
 }
+
+TArray<UOculusXRSceneGlobalMeshComponent::FChunkData> UOculusXRSceneGlobalMeshComponent::PartitionMesh(const TArray<FVector>& Vertices, const TArray<int32>& Triangles, double CellSize)
+{
+	TArray<FChunkData> chunks;
+	TMap<FIntVector, int32> cellToChunk;
+	// Maps the vertex indices of the full mesh to the indices in the chunk, per chunk
+	TArray<TMap<int32, int32>> vertexRemaps;
+
+	for (int32 i = 0; i + 2 < Triangles.Num(); i += 3)
+	{
+		const int32 indices[3] = { Triangles[i], Triangles[i + 1], Triangles[i + 2] };
+		if (!Vertices.IsValidIndex(indices[0]) || !Vertices.IsValidIndex(indices[1]) || !Vertices.IsValidIndex(indices[2]))
+		{
+			continue;
+		}
+
+		// Triangles are assigned to the cell of their centroid, so no triangle gets split
+		const FVector centroid = (Vertices[indices[0]] + Vertices[indices[1]] + Vertices[indices[2]]) / 3.0;
+		const FIntVector cell(
+			FMath::FloorToInt32(centroid.X / CellSize),
+			FMath::FloorToInt32(centroid.Y / CellSize),
+			FMath::FloorToInt32(centroid.Z / CellSize));
+
+		int32 chunkIndex = INDEX_NONE;
+		if (const int32* found = cellToChunk.Find(cell))
+		{
+			chunkIndex = *found;
+		}
+		else
+		{
+			chunkIndex = chunks.AddDefaulted();
+			vertexRemaps.AddDefaulted();
+			cellToChunk.Add(cell, chunkIndex);
+		}
+
+		FChunkData& chunk = chunks[chunkIndex];
+		TMap<int32, int32>& remap = vertexRemaps[chunkIndex];
+		for (const int32 index : indices)
+		{
+			int32& chunkVertex = remap.FindOrAdd(index, INDEX_NONE);
+			if (chunkVertex == INDEX_NONE)
+			{
+				chunkVertex = chunk.Vertices.Add(Vertices[index]);
+				chunk.Bounds += Vertices[index];
+			}
+			chunk.Triangles.Add(chunkVertex);
+		}
+	}
+
+	return chunks;
+}
+
+void UOculusXRSceneGlobalMeshComponent::CreateChunks(AActor* GlobalMeshAnchor, TArray<FChunkData> ChunkData)
+{
+	const float worldToMeters = GetWorld()->GetWorldSettings()->WorldToMeters;
+	const FName refCollisionProfile = CollisionProfileName.Name;
+
+	TArray<FVector> emptyNormals;
+	TArray<FVector2D> emptyUV;
+	TArray<FColor> emptyVertexColors;
+	TArray<FProcMeshTangent> emptyTangents;
+
+	for (FChunkData& data : ChunkData)
+	{
+		UProceduralMeshComponent* proceduralMeshComponent = CreateProceduralMesh(GlobalMeshAnchor);
+		// Collision gets cooked later when the player comes close
+		proceduralMeshComponent->CreateMeshSection(0, data.Vertices, data.Triangles, emptyNormals, emptyUV, emptyVertexColors, emptyTangents, false);
+		if (Material != nullptr)
+		{
+			proceduralMeshComponent->SetMaterial(0, Material);
+		}
+		if (HasCollision())
+		{
+			proceduralMeshComponent->SetCollisionProfileName(refCollisionProfile);
+		}
+		proceduralMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+		GlobalMeshAnchor->AddOwnedComponent(proceduralMeshComponent);
+		proceduralMeshComponent->AttachToComponent(GlobalMeshAnchor->GetRootComponent(), FAttachmentTransformRules::KeepWorldTransform);
+		proceduralMeshComponent->SetRelativeLocation(FVector::ZeroVector, false, nullptr, ETeleportType::ResetPhysics);
+		proceduralMeshComponent->SetVisibility(IsVisible());
+		proceduralMeshComponent->SetRelativeScale3D(FVector(worldToMeters, worldToMeters, worldToMeters));
+
+		FChunk& chunk = Chunks.AddDefaulted_GetRef();
+		chunk.Component = proceduralMeshComponent;
+		chunk.LocalBounds = data.Bounds;
+	}
+
+	ChunkStats.NumChunks = Chunks.Num();
+	UE_LOG(LogOculusXRScene, Log, TEXT("GLOBAL MESH Split into %d chunks of %.0f units"), ChunkData.Num(), ChunkSize);
+
+	if (HasCollision())
+	{
+		SetComponentTickEnabled(true);
+		UpdateChunkCollision();
+	}
+}
+
+void UOculusXRSceneGlobalMeshComponent::GetCollisionSources(TArray<FVector, TInlineAllocator<3>>& OutPositions)
+{
+	const APlayerController* playerController = GetWorld()->GetFirstPlayerController();
+	if (playerController && playerController->PlayerCameraManager)
+	{
+		OutPositions.Add(playerController->PlayerCameraManager->GetCameraLocation());
+	}
+	else if (playerController && playerController->GetPawn())
+	{
+		OutPositions.Add(playerController->GetPawn()->GetActorLocation());
+	}
+
+	if (CollisionAroundHands && GEngine && GEngine->XRSystem.IsValid())
+	{
+		for (const EControllerHand hand : { EControllerHand::Left, EControllerHand::Right })
+		{
+			FXRMotionControllerData motionControllerData;
+			GEngine->XRSystem->GetMotionControllerData(this, hand, motionControllerData);
+			if (motionControllerData.bValid && motionControllerData.TrackingStatus != ETrackingStatus::NotTracked)
+			{
+				OutPositions.Add(motionControllerData.GripPosition);
+			}
+		}
+	}
+}
+
+void UOculusXRSceneGlobalMeshComponent::UpdateChunkCollision()
+{
+	if (Chunks.IsEmpty() || !HasCollision())
+	{
+		return;
+	}
+
+	TArray<FVector, TInlineAllocator<3>> sources;
+	GetCollisionSources(sources);
+
+	const double enableRadiusSquared = FMath::Square(CollisionRadius);
+	const double disableRadiusSquared = FMath::Square(CollisionRadius * CollisionReleaseFactor);
+	const FName refCollisionProfile = CollisionProfileName.Name;
+	int32 cooksLeft = MaxCollisionCooksPerFrame;
+	int32 numCollisionChunks = 0;
+
+	for (int32 i = 0; i < Chunks.Num(); ++i)
+	{
+		FChunk& chunk = Chunks[i];
+		UProceduralMeshComponent* proceduralMeshComponent = chunk.Component.Get();
+		if (!proceduralMeshComponent)
+		{
+			continue;
+		}
+
+		const FBox worldBounds = chunk.LocalBounds.TransformBy(proceduralMeshComponent->GetComponentTransform());
+		double distanceSquared = TNumericLimits<double>::Max();
+		for (const FVector& source : sources)
+		{
+			distanceSquared = FMath::Min(distanceSquared, worldBounds.ComputeSquaredDistanceToPoint(source));
+		}
+
+		const bool bWantsCollision = chunk.bCollisionEnabled ? distanceSquared <= disableRadiusSquared : distanceSquared <= enableRadiusSquared;
+		if (bWantsCollision && !chunk.bCollisionEnabled)
+		{
+			if (!chunk.bCooked)
+			{
+				if (cooksLeft <= 0)
+				{
+					continue;
+				}
+				--cooksLeft;
+
+				FProcMeshSection section = *proceduralMeshComponent->GetProcMeshSection(0);
+				section.bEnableCollision = true;
+				const double startTime = FPlatformTime::Seconds();
+				proceduralMeshComponent->SetProcMeshSection(0, section);
+				const double cookTimeMs = (FPlatformTime::Seconds() - startTime) * 1000.0;
+
+				chunk.bCooked = true;
+				++ChunkStats.NumCookedChunks;
+				TotalCookTimeMs += cookTimeMs;
+				ChunkStats.LastCookTimeMs = cookTimeMs;
+				ChunkStats.AverageCookTimeMs = TotalCookTimeMs / ChunkStats.NumCookedChunks;
+				ChunkStats.MaxCookTimeMs = FMath::Max(ChunkStats.MaxCookTimeMs, (float)cookTimeMs);
+				UE_LOG(LogOculusXRScene, Verbose, TEXT("GLOBAL MESH Cooked chunk %d (%d triangles) in %.2f ms"), i, section.ProcIndexBuffer.Num() / 3, cookTimeMs);
+			}
+			proceduralMeshComponent->SetCollisionProfileName(refCollisionProfile);
+			chunk.bCollisionEnabled = true;
+		}
+		else if (!bWantsCollision && chunk.bCollisionEnabled)
+		{
+			proceduralMeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			chunk.bCollisionEnabled = false;
+		}
+
+		numCollisionChunks += chunk.bCollisionEnabled ? 1 : 0;
+	}
+
+	if (numCollisionChunks != ChunkStats.NumCollisionChunks)
+	{
+		UE_LOG(LogOculusXRScene, Verbose, TEXT("GLOBAL MESH %d of %d chunks have collision"), numCollisionChunks, Chunks.Num());
+	}
+	ChunkStats.NumCollisionChunks = numCollisionChunks;
+}
@@ -9,6 +9,37 @@
 #include "OculusXRSceneGlobalMeshComponent.generated.h"
 
 class UMaterialInterface;
+class UProceduralMeshComponent;
+
+USTRUCT(BlueprintType)
+struct OCULUSXRSCENE_API FOculusXRGlobalMeshChunkStats
+{
+	GENERATED_BODY()
+
+	// Number of chunks the global mesh was split into
+	UPROPERTY(BlueprintReadOnly, Category = "OculusXR")
+	int32 NumChunks = 0;
+
+	// Number of chunks that currently have collision enabled
+	UPROPERTY(BlueprintReadOnly, Category = "OculusXR")
+	int32 NumCollisionChunks = 0;
+
+	// Number of chunks whose collision has been cooked so far
+	UPROPERTY(BlueprintReadOnly, Category = "OculusXR")
+	int32 NumCookedChunks = 0;
+
+	// Cook time of the last cooked chunk in milliseconds
+	UPROPERTY(BlueprintReadOnly, Category = "OculusXR")
+	float LastCookTimeMs = 0.0f;
+
+	// Average cook time per chunk in milliseconds
+	UPROPERTY(BlueprintReadOnly, Category = "OculusXR")
+	float AverageCookTimeMs = 0.0f;
+
+	// Longest cook time of a chunk in milliseconds
+	UPROPERTY(BlueprintReadOnly, Category = "OculusXR")
+	float MaxCookTimeMs = 0.0f;
+};
 
 /**
 * DEPRECATED: AOculusXRSceneActor and associated classes are deprecated (v65), please use MR Utility Kit instead
@@ -24,7 +55,7 @@ class OCULUSXRSCENE_API UOculusXRSceneGlobalMeshComponent : public UActorCompone
 public:
 	UOculusXRSceneGlobalMeshComponent(const FObjectInitializer& ObjectInitializer);
 
-	void CreateMeshComponent(const FOculusXRUInt64& Space, AActor* GlobalMeshAnchor, const UOculusXRRoomLayoutManagerComponent* RoomLayoutManagerComponent) const;
+	void CreateMeshComponent(const FOculusXRUInt64& Space, AActor* GlobalMeshAnchor, const UOculusXRRoomLayoutManagerComponent* RoomLayoutManagerComponent);
 
 	static const FString GlobalMeshSemanticLabel;
 
@@ -44,10 +75,62 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "OculusXR")
 	TSoftClassPtr<UOculusXRSceneAnchorComponent> SceneAnchorComponent = TSoftClassPtr<UOculusXRSceneAnchorComponent>(FSoftClassPath(UOculusXRSceneAnchorComponent::StaticClass()));
 
+	// Split the global mesh into a uniform grid of mesh components. Every chunk is culled by its own bounds and
+	// collision is only cooked and enabled for chunks close to the player.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "OculusXR|Chunking")
+	bool Chunked = false;
+
+	// Edge length of a grid cell in world units
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "OculusXR|Chunking", meta = (EditCondition = "Chunked", ClampMin = "10.0"))
+	float ChunkSize = 200.0f;
+
+	// Chunks closer than this distance in world units to the player camera get collision
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "OculusXR|Chunking", meta = (EditCondition = "Chunked", ClampMin = "0.0"))
+	float CollisionRadius = 300.0f;
+
+	// Also enable collision for chunks close to the tracked hands or controllers
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "OculusXR|Chunking", meta = (EditCondition = "Chunked"))
+	bool CollisionAroundHands = true;
+
+	// Upper limit of chunks whose collision gets cooked in a single frame, to spread the cost over several frames
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "OculusXR|Chunking", meta = (EditCondition = "Chunked", ClampMin = "1"))
+	int32 MaxCollisionCooksPerFrame = 2;
+
 public:
 	bool HasCollision() const;
 
 	bool IsVisible() const;
 
 	UClass* GetAnchorComponentClass() const;
+
+	UFUNCTION(BlueprintCallable, Category = "OculusXR")
+	FOculusXRGlobalMeshChunkStats GetChunkStats() const;
+
+private:
+	struct FChunkData
+	{
+		TArray<FVector> Vertices;
+		TArray<int32> Triangles;
+		FBox Bounds{ ForceInit };
+	};
+
+	struct FChunk
+	{
+		TWeakObjectPtr<UProceduralMeshComponent> Component;
+		// Bounds in the local space of the component
+		FBox LocalBounds{ ForceInit };
+		bool bCooked = false;
+		bool bCollisionEnabled = false;
+	};
+
+	static TArray<FChunkData> PartitionMesh(const TArray<FVector>& Vertices, const TArray<int32>& Triangles, double CellSize);
+
+	UProceduralMeshComponent* CreateProceduralMesh(AActor* GlobalMeshAnchor) const;
+	void CreateChunks(AActor* GlobalMeshAnchor, TArray<FChunkData> ChunkData);
+	void UpdateChunkCollision();
+	void GetCollisionSources(TArray<FVector, TInlineAllocator<3>>& OutPositions);
+
+	TArray<FChunk> Chunks;
+	double TotalCookTimeMs = 0.0;
+	FOculusXRGlobalMeshChunkStats ChunkStats;
 };